@@ -236,28 +236,45 @@ static struct net_pkt *prepare_pkt(struct eth_context *ctx,
 
 static int read_data(struct eth_context *ctx, int fd)
 {
+	struct net_pkt *pkts[CONFIG_ETH_NATIVE_TAP_RX_BUDGET];
 	struct net_if *iface = ctx->iface;
 	struct net_pkt *pkt = NULL;
-	int status;
+	int status = 0;
+	int received = 0;
 	int count;
 
-	count = nsi_host_read(fd, ctx->recv, sizeof(ctx->recv));
-	if (count <= 0) {
-		return 0;
-	}
+	/* Read the frames already waiting in the host, up to the RX budget,
+	 * and pass them to the network stack at once.
+	 */
+	do {
+		count = nsi_host_read(fd, ctx->recv, sizeof(ctx->recv));
+		if (count <= 0) {
+			break;
+		}
 
-	pkt = prepare_pkt(ctx, count, &status);
-	if (!pkt) {
-		return status;
-	}
+		pkt = prepare_pkt(ctx, count, &status);
+		if (!pkt) {
+			break;
+		}
 
-	update_gptp(iface, pkt, false);
+		update_gptp(iface, pkt, false);
 
-	if (net_recv_data(iface, pkt) < 0) {
-		net_pkt_unref(pkt);
+		pkts[received++] = pkt;
+	} while (received < CONFIG_ETH_NATIVE_TAP_RX_BUDGET && !eth_wait_data(fd));
+
+	if (received == 1) {
+		if (net_recv_data(iface, pkts[0]) < 0) {
+			net_pkt_unref(pkts[0]);
+		}
+	} else if (received > 1) {
+		if (net_recv_data_batch(iface, pkts, received) < 0) {
+			for (int i = 0; i < received; i++) {
+				net_pkt_unref(pkts[i]);
+			}
+		}
 	}
 
-	return 0;
+	return status;
 }
 
 static void eth_rx(void *p1, void *p2, void *p3)
@@ -51,6 +51,15 @@ uint32_t z_log_dropped_read_and_clear(void);
  */
 bool z_log_dropped_pending(void);
 
+/** @brief Get the number of messages dropped since the initialization.
+ *
+ * Unlike z_log_dropped_read_and_clear(), the counter is not cleared when
+ * the drops are reported to the backends.
+ *
+ * @return Total dropped count.
+ */
+uint32_t z_log_dropped_total(void);
+
 /** @brief Free allocated buffer.
  *
  * @param buf Buffer.
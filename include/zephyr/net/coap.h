@@ -316,6 +316,15 @@ struct coap_packet {
 	uint8_t hdr_len;  /**< CoAP header length */
 	uint16_t opt_len; /**< Total options length (delta + len + value) */
 	uint16_t delta;   /**< Used for delta calculation in CoAP packet */
+#if defined(CONFIG_COAP_OPTION_INDEX) || defined(DOXYGEN)
+	/**
+	 * Offset of the first option of each number, 0 if there is none.
+	 * Only available when @kconfig{CONFIG_COAP_OPTION_INDEX} is enabled.
+	 */
+	uint16_t opt_index[CONFIG_COAP_OPTION_INDEX_SIZE];
+	/** The option index is up to date */
+	bool opt_indexed;
+#endif
 #if defined(CONFIG_COAP_KEEP_USER_DATA) || defined(DOXYGEN)
 	/**
 	 * Application specific user data.
@@ -615,6 +624,33 @@ int coap_find_options(const struct coap_packet *cpkt, uint16_t code,
 int coap_packet_append_option(struct coap_packet *cpkt, uint16_t code,
 			      const uint8_t *value, uint16_t len);
 
+/**
+ * @brief Option to be added with coap_packet_append_options().
+ */
+struct coap_packet_option {
+	uint16_t code;         /**< Option code, see #coap_option_num */
+	uint16_t len;          /**< Size of the option value */
+	const uint8_t *value;  /**< Option value, copied to the packet */
+};
+
+/**
+ * @brief Appends a set of options to the packet.
+ *
+ * The options are sorted by code first, keeping the order of the options
+ * having the same code, and then written in one pass. Unlike adding the
+ * options one by one out of order, the packet data is not moved around,
+ * as long as the codes are not below the ones of the options already in
+ * the packet.
+ *
+ * @param cpkt Packet to be updated
+ * @param options Options to add, sorted in place
+ * @param num Number of options
+ *
+ * @return 0 in case of success or negative in case of error.
+ */
+int coap_packet_append_options(struct coap_packet *cpkt, struct coap_packet_option *options,
+			       size_t num);
+
 /**
  * @brief Remove an option from the packet.
  *
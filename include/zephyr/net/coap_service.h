@@ -47,6 +47,18 @@ struct coap_service_data {
 	int sock_fd;
 	struct coap_observer observers[CONFIG_COAP_SERVICE_OBSERVERS];
 	struct coap_pending pending[CONFIG_COAP_SERVICE_PENDING_MESSAGES];
+
+	/* Lookup tables, chaining the observers and pending messages by their
+	 * index in the above arrays plus one, 0 ending a chain.
+	 */
+	struct coap_resource *observer_res[CONFIG_COAP_SERVICE_OBSERVERS];
+	uint16_t observer_hash[CONFIG_COAP_SERVICE_HASH_SIZE];
+	uint16_t observer_next[CONFIG_COAP_SERVICE_OBSERVERS];
+	uint16_t observer_free;
+	uint16_t pending_hash[CONFIG_COAP_SERVICE_HASH_SIZE];
+	uint16_t pending_next[CONFIG_COAP_SERVICE_PENDING_MESSAGES];
+	uint16_t pending_free;
+	bool indexed;
 };
 
 struct coap_service {
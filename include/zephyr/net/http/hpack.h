@@ -12,6 +12,7 @@
 #ifndef ZEPHYR_INCLUDE_NET_HTTP_SERVER_HPACK_H_
 #define ZEPHYR_INCLUDE_NET_HTTP_SERVER_HPACK_H_
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -127,6 +128,53 @@ struct http_hpack_header_buf {
 	size_t datalen;
 };
 
+#if defined(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE) || defined(__DOXYGEN__)
+
+/** @cond INTERNAL_HIDDEN */
+
+/* Size accounted for each dynamic table entry on top of its name and value,
+ * as defined in RFC7541, ch 4.1.
+ */
+#define HTTP_HPACK_ENTRY_OVERHEAD 32
+
+#define HTTP_HPACK_DYNAMIC_TABLE_SIZE CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE
+
+/** @endcond */
+
+/** HPACK encoder context, holding the dynamic table of an HTTP/2 connection. */
+struct http_hpack_encoder {
+	/** Names and values of the dynamic table entries, oldest first. */
+	uint8_t data[HTTP_HPACK_DYNAMIC_TABLE_SIZE - HTTP_HPACK_ENTRY_OVERHEAD];
+
+	/** Name and value lengths of the dynamic table entries, oldest first. */
+	struct {
+		/** Length of the header field name. */
+		uint16_t name_len;
+		/** Length of the header field value. */
+		uint16_t value_len;
+	} entries[HTTP_HPACK_DYNAMIC_TABLE_SIZE / HTTP_HPACK_ENTRY_OVERHEAD];
+
+	/** Number of entries in the dynamic table. */
+	uint16_t count;
+
+	/** Length of the data of the dynamic table entries. */
+	uint16_t data_len;
+
+	/** Size of the dynamic table, as defined in RFC7541, ch 4.1. */
+	uint16_t size;
+
+	/** Maximum size of the dynamic table. */
+	uint16_t max_size;
+
+	/** Smallest maximum size set since the last header block. */
+	uint16_t min_size;
+
+	/** A dynamic table size update is due in the next header block. */
+	bool size_update;
+};
+
+#endif /* CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE */
+
 /** @cond INTERNAL_HIDDEN */
 
 int http_hpack_huffman_decode(const uint8_t *encoded_buf, size_t encoded_len,
@@ -138,6 +186,15 @@ int http_hpack_decode_header(const uint8_t *buf, size_t datalen,
 int http_hpack_encode_header(uint8_t *buf, size_t buflen,
 			     struct http_hpack_header_buf *header);
 
+#if defined(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE)
+void http_hpack_encoder_init(struct http_hpack_encoder *encoder);
+void http_hpack_encoder_set_max_size(struct http_hpack_encoder *encoder,
+				     uint32_t max_size);
+int http_hpack_encoder_encode_header(struct http_hpack_encoder *encoder,
+				     uint8_t *buf, size_t buflen,
+				     struct http_hpack_header_buf *header);
+#endif
+
 /** @endcond */
 
 #ifdef __cplusplus
@@ -136,6 +136,12 @@ struct http_resource_detail_static_fs {
 
 	/** Path in the local filesystem */
 	const char *fs_path;
+
+	/** Generation of the files, used to build their entity tags. The
+	 * application must change it whenever a file under @p fs_path is
+	 * modified. Zero disables the ETag header and If-None-Match handling.
+	 */
+	uint32_t generation;
 };
 
 /** @brief HTTP compressions */
@@ -440,6 +446,11 @@ struct http_client_ctx {
 	/** HTTP/2 header parser context. */
 	struct http_hpack_header_buf header_field;
 
+#if defined(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE) || defined(__DOXYGEN__)
+	/** HTTP/2 response header encoder context. */
+	struct http_hpack_encoder hpack_encoder;
+#endif
+
 	/** HTTP/2 streams context. */
 	struct http2_stream_ctx streams[HTTP_SERVER_MAX_STREAMS];
 
@@ -490,6 +501,18 @@ struct http_client_ctx {
 	IF_ENABLED(CONFIG_HTTP_SERVER_COMPRESSION, (uint8_t supported_compression));
 /** @endcond */
 
+/** @cond INTERNAL_HIDDEN */
+	/** Request Range header value. */
+	IF_ENABLED(CONFIG_FILE_SYSTEM, (char range[HTTP_SERVER_MAX_HEADER_LEN]));
+
+	/** Request If-None-Match header value. */
+	IF_ENABLED(CONFIG_FILE_SYSTEM, (char if_none_match[HTTP_SERVER_MAX_HEADER_LEN]));
+
+	/** Buffer used to stream a static filesystem resource. */
+	IF_ENABLED(CONFIG_FILE_SYSTEM,
+		   (char fs_chunk[CONFIG_HTTP_SERVER_STATIC_FS_CHUNK_SIZE]));
+/** @endcond */
+
 	/** Flag indicating that HTTP2 preface was sent. */
 	bool preface_sent : 1;
 
@@ -511,6 +534,15 @@ struct http_client_ctx {
 	/** Flag indicating accept encoding is being processed. */
 	IF_ENABLED(CONFIG_HTTP_SERVER_COMPRESSION, (bool accept_encoding_next: 1));
 
+	/** Flag indicating range is being processed. */
+	IF_ENABLED(CONFIG_FILE_SYSTEM, (bool range_next : 1));
+
+	/** Flag indicating if-none-match is being processed. */
+	IF_ENABLED(CONFIG_FILE_SYSTEM, (bool if_none_match_next : 1));
+
+	/** Flag indicating that if-range header was present in the request. */
+	IF_ENABLED(CONFIG_FILE_SYSTEM, (bool has_if_range : 1));
+
 	/** The next frame on the stream is expectd to be a continuation frame. */
 	bool expect_continuation : 1;
 };
@@ -65,8 +65,14 @@ struct http_resource_desc {
 
 /** @cond INTERNAL_HIDDEN */
 
+struct http_resource_index_node;
+
 struct http_service_runtime_data {
 	int num_clients;
+#if defined(CONFIG_HTTP_SERVER_RESOURCE_INDEX)
+	/* Root of the resource index, NULL if the service is not indexed */
+	struct http_resource_index_node *index;
+#endif
 };
 
 struct http_service_desc {
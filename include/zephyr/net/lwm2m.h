@@ -200,6 +200,24 @@ enum lwm2m_socket_states {
 	LWM2M_SOCKET_STATE_NO_DATA,	 /**< No more data is expected. */
 };
 
+/**
+ * @brief Notification counters of a LwM2M connection.
+ */
+struct lwm2m_notify_stats {
+	/** Notifications sent. */
+	uint32_t sent;
+
+	/** Notifications sent ahead of their schedule, together with a due one.
+	 *  See @kconfig{CONFIG_LWM2M_ENGINE_NOTIFY_ALIGN_WINDOW}.
+	 */
+	uint32_t aligned;
+
+	/** Resource updates reported by an already scheduled notification,
+	 *  without requiring one of their own.
+	 */
+	uint32_t coalesced;
+};
+
 /**
  * @brief LwM2M context structure to maintain information for a single
  * LwM2M connection.
@@ -322,6 +340,9 @@ struct lwm2m_ctx {
 	 * saving modes.
 	 */
 	void (*set_socket_state)(int fd, enum lwm2m_socket_states state);
+
+	/** Notification counters. */
+	struct lwm2m_notify_stats notify_stats;
 };
 
 /**
@@ -884,6 +884,31 @@ struct mqtt_internal {
 	/** Internal. MQTT 5.0 disconnect reason set in case of processing errors. */
 	enum mqtt_disconnect_reason_code disconnect_reason;
 #endif /* CONFIG_MQTT_VERSION_5_0 */
+
+#if defined(CONFIG_MQTT_TOPIC_ALIAS_AUTO) || defined(__DOXYGEN__)
+	/** Internal. MQTT 5.0 topic aliases assigned to published messages. */
+	struct mqtt_topic_alias tx_topic_aliases[CONFIG_MQTT_TOPIC_ALIAS_MAX];
+
+	/** Internal. Number of topic aliases assigned to published messages. */
+	uint16_t tx_topic_alias_count;
+
+	/** Internal. Number of topic aliases accepted by the server. */
+	uint16_t tx_topic_alias_max;
+#endif /* CONFIG_MQTT_TOPIC_ALIAS_AUTO */
+
+#if defined(CONFIG_MQTT_PUBLISH_QUEUE) || defined(__DOXYGEN__)
+	/** Internal. Length of the packets in the publish queue buffer. */
+	uint32_t tx_queue_datalen;
+
+	/** Internal. Message ids of the messages not acknowledged yet. */
+	uint16_t inflight_ids[CONFIG_MQTT_PUBLISH_INFLIGHT_MAX];
+
+	/** Internal. Number of messages not acknowledged yet. */
+	uint16_t inflight_count;
+
+	/** Internal. Maximum number of messages in flight on the connection. */
+	uint16_t inflight_max;
+#endif /* CONFIG_MQTT_PUBLISH_QUEUE */
 };
 
 /**
@@ -966,6 +991,17 @@ struct mqtt_client {
 	/** Size of transmit buffer. */
 	uint32_t tx_buf_size;
 
+#if defined(CONFIG_MQTT_PUBLISH_QUEUE) || defined(__DOXYGEN__)
+	/** Buffer collecting the packets queued with mqtt_publish_queue(),
+	 *  to write them to the transport at once. Can be NULL, in which
+	 *  case the queued messages are sent right away.
+	 */
+	uint8_t *tx_queue_buf;
+
+	/** Size of publish queue buffer. */
+	uint32_t tx_queue_buf_size;
+#endif /* CONFIG_MQTT_PUBLISH_QUEUE */
+
 	/** Keepalive interval for this client in seconds.
 	 *  Default is CONFIG_MQTT_KEEPALIVE.
 	 */
@@ -1071,16 +1107,67 @@ int mqtt_connect(struct mqtt_client *client);
 /**
  * @brief API to publish messages on topics.
  *
+ * With @kconfig{CONFIG_MQTT_PUBLISH_QUEUE}, QoS 1 and QoS 2 messages are
+ * tracked until acknowledged, and share the in-flight window of
+ * @ref mqtt_publish_queue.
+ *
  * @param[in] client Client instance for which the procedure is requested.
  *                   Shall not be NULL.
  * @param[in] param Parameters to be used for the publish message.
  *                  Shall not be NULL.
  *
- * @return 0 or a negative error code (errno.h) indicating reason of failure.
+ * @retval 0 If the message was sent.
+ * @retval -EAGAIN If the maximum number of messages is in flight.
+ * @retval -EBUSY If a message with the same message id is in flight, and
+ *         the message is not a retransmission.
+ * @return Other negative error code (errno.h) indicating reason of failure.
  */
 int mqtt_publish(struct mqtt_client *client,
 		 const struct mqtt_publish_param *param);
 
+#if defined(CONFIG_MQTT_PUBLISH_QUEUE) || defined(__DOXYGEN__)
+/**
+ * @brief API to queue messages for publishing.
+ *
+ * The PUBLISH packet, payload included, is appended to the publish queue
+ * buffer of the client. The queued packets are written to the transport at
+ * once when the buffer is full, or on @ref mqtt_publish_flush,
+ * @ref mqtt_publish, @ref mqtt_disconnect and @ref mqtt_live. A message
+ * which does not fit into the buffer is sent right away, after the queued
+ * ones.
+ *
+ * QoS 1 and QoS 2 messages are tracked until acknowledged, up to
+ * @kconfig{CONFIG_MQTT_PUBLISH_INFLIGHT_MAX} messages, or the Receive Maximum
+ * of an MQTT 5.0 server if lower.
+ *
+ * @param[in] client Client instance for which the procedure is requested.
+ *                   Shall not be NULL.
+ * @param[in] param Parameters to be used for the publish message.
+ *                  Shall not be NULL. The payload is copied, and can be
+ *                  reused when the function returns.
+ *
+ * @retval 0 If the message was queued or sent.
+ * @retval -EAGAIN If the maximum number of messages is in flight. Retry once
+ *         acknowledgments have been processed with @ref mqtt_input.
+ * @retval -EBUSY If a message with the same message id is in flight, and
+ *         the message is not a retransmission.
+ * @return Other negative error code (errno.h) indicating reason of failure.
+ */
+int mqtt_publish_queue(struct mqtt_client *client,
+		       const struct mqtt_publish_param *param);
+
+/**
+ * @brief API to write the messages queued with @ref mqtt_publish_queue to
+ *        the transport.
+ *
+ * @param[in] client Client instance for which the procedure is requested.
+ *                   Shall not be NULL.
+ *
+ * @return 0 or a negative error code (errno.h) indicating reason of failure.
+ */
+int mqtt_publish_flush(struct mqtt_client *client);
+#endif /* CONFIG_MQTT_PUBLISH_QUEUE */
+
 /**
  * @brief API used by client to send acknowledgment on receiving QoS1 publish
  *        message. Should be called on reception of @ref MQTT_EVT_PUBLISH with
@@ -1310,6 +1310,30 @@ int net_context_sendmsg(struct net_context *context,
 			k_timeout_t timeout,
 			void *user_data);
 
+/**
+ * @brief Send a caller provided network buffer chain without copying it.
+ *
+ * @details The fragments are linked to the outgoing packet after the
+ * protocol headers instead of being copied into buffers allocated by the
+ * stack. The packet takes its own reference to @p frags and releases it once
+ * the packet has been sent, so the caller can detect TX completion through
+ * the destroy callback of the buffer pool. Only UDP is supported and the
+ * data must fit into a single datagram.
+ *
+ * @param context The network context to use.
+ * @param frags The payload to send. The caller keeps its reference.
+ * @param dst_addr Destination address, or NULL for a connected context.
+ * @param addrlen Length of the address.
+ * @param timeout Timeout for queueing the packet for transmission.
+ *
+ * @return numbers of bytes sent on success, a negative errno otherwise
+ */
+int net_context_send_buf(struct net_context *context,
+			 struct net_buf *frags,
+			 const struct sockaddr *dst_addr,
+			 socklen_t addrlen,
+			 k_timeout_t timeout);
+
 /**
  * @brief Receive network data from a peer specified by context.
  *
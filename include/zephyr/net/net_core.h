@@ -123,6 +123,25 @@ enum net_verdict {
  */
 int net_recv_data(struct net_if *iface, struct net_pkt *pkt);
 
+/**
+ * @brief Called by network device driver when a batch of network packets has
+ * been received, typically from a budgeted RX poll loop. The packets are
+ * pushed up in the network stack like with net_recv_data(), but the packets
+ * of a given traffic class are queued at once so that the RX thread is woken
+ * up only once for the whole batch. The order of the packets is preserved.
+ *
+ * The packets are consumed by this function, also the ones that could not be
+ * processed, unless an error is returned.
+ *
+ * @param iface Network interface where the packets were received.
+ * @param pkts Array of received network packets.
+ * @param count Number of packets in the array.
+ *
+ * @return Number of packets passed to the network stack, <0 if error.
+ */
+int net_recv_data_batch(struct net_if *iface, struct net_pkt **pkts,
+			size_t count);
+
 /**
  * @brief Try sending data to network.
  *
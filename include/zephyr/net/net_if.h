@@ -41,6 +41,9 @@
 #if defined(CONFIG_NET_IPV4_AUTO) && defined(CONFIG_NET_NATIVE_IPV4)
 #include <zephyr/net/ipv4_autoconf.h>
 #endif
+#if defined(CONFIG_NET_QDISC)
+#include <zephyr/net/net_qdisc.h>
+#endif
 
 #include <zephyr/net/prometheus/collector.h>
 
@@ -735,6 +738,11 @@ struct net_if {
 	int tx_pending;
 #endif
 
+#if defined(CONFIG_NET_QDISC)
+	/** Transmit queueing discipline state of this network interface */
+	struct net_if_qdisc qdisc;
+#endif
+
 	/** Mutex protecting this network interface instance */
 	struct k_mutex lock;
 
@@ -264,6 +264,12 @@ struct msghdr {
 	int           msg_flags;      /**< Flags on received message */
 };
 
+/** Message vector element used by zsock_sendmmsg() and zsock_recvmmsg() */
+struct mmsghdr {
+	struct msghdr msg_hdr; /**< Message header */
+	unsigned int  msg_len; /**< Number of bytes transmitted for the message */
+};
+
 /** Control message ancillary data */
 struct cmsghdr {
 	socklen_t cmsg_len;    /**< Number of bytes, including header */
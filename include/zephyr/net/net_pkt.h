@@ -184,6 +184,11 @@ struct net_pkt {
 	struct net_pkt_alloc_stats_slab *alloc_stats;
 #endif /* CONFIG_NET_PKT_ALLOC_STATS */
 
+#if defined(CONFIG_NET_QDISC)
+	/* Time when the packet was queued for transmission, in cycles */
+	uint32_t qdisc_time;
+#endif
+
 	/** Reference counter */
 	atomic_t atomic_ref;
 
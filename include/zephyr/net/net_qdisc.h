@@ -0,0 +1,106 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Network transmit queueing discipline
+ */
+
+#ifndef ZEPHYR_INCLUDE_NET_NET_QDISC_H_
+#define ZEPHYR_INCLUDE_NET_NET_QDISC_H_
+
+#include <zephyr/types.h>
+#include <zephyr/net/net_mgmt.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Network transmit queueing discipline
+ * @defgroup net_qdisc Network Queueing Discipline
+ * @since 4.2
+ * @version 0.1.0
+ * @ingroup networking
+ * @{
+ *
+ * When enabled, the packets of each TX traffic class are queued per flow and
+ * served in a round robin fashion, flows with a standing queue being
+ * controlled by CoDel. The transmission rate of each network interface can
+ * also be limited by a token bucket shaper.
+ */
+
+/** Queueing discipline parameters of a network interface */
+struct net_qdisc_params {
+	/** Shaper rate in bytes per second, 0 if the interface is not shaped */
+	uint32_t rate;
+
+	/** Shaper bucket size in bytes, i.e. the maximum burst length */
+	uint32_t burst;
+
+	/** CoDel target queueing delay in microseconds */
+	uint32_t target;
+
+	/** CoDel interval in microseconds */
+	uint32_t interval;
+};
+
+/** @cond INTERNAL_HIDDEN */
+
+#define NET_QDISC_LAYER	NET_MGMT_LAYER_L2
+#define NET_QDISC_CODE	NET_MGMT_LAYER_CODE_QDISC
+#define NET_QDISC_BASE	(NET_MGMT_IFACE_BIT |				\
+			 NET_MGMT_LAYER(NET_QDISC_LAYER) |		\
+			 NET_MGMT_LAYER_CODE(NET_QDISC_CODE))
+
+enum net_request_qdisc_cmd {
+	NET_REQUEST_QDISC_CMD_SET_PARAMS = 1,
+	NET_REQUEST_QDISC_CMD_GET_PARAMS,
+};
+
+/* Per interface state, kept in struct net_if */
+struct net_if_qdisc {
+	struct net_qdisc_params params;
+
+	/* Parameters converted to cycles */
+	uint32_t target;
+	uint32_t interval;
+
+	/* Available shaper tokens in bytes, might be negative */
+	int32_t tokens;
+	uint32_t tokens_time;
+};
+
+/** @endcond */
+
+/**
+ * Set the queueing discipline parameters of a network interface, the data
+ * being a struct net_qdisc_params.
+ */
+#define NET_REQUEST_QDISC_SET_PARAMS					\
+	(NET_QDISC_BASE | NET_REQUEST_QDISC_CMD_SET_PARAMS)
+
+/**
+ * Get the queueing discipline parameters of a network interface, the data
+ * being a struct net_qdisc_params.
+ */
+#define NET_REQUEST_QDISC_GET_PARAMS					\
+	(NET_QDISC_BASE | NET_REQUEST_QDISC_CMD_GET_PARAMS)
+
+/** @cond INTERNAL_HIDDEN */
+NET_MGMT_DEFINE_REQUEST_HANDLER(NET_REQUEST_QDISC_SET_PARAMS);
+NET_MGMT_DEFINE_REQUEST_HANDLER(NET_REQUEST_QDISC_GET_PARAMS);
+/** @endcond */
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_NET_NET_QDISC_H_ */
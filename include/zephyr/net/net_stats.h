@@ -275,6 +275,34 @@ struct net_stats_dns {
 	net_stats_t drop;
 };
 
+/**
+ * @brief Receive packet steering statistics
+ */
+struct net_stats_rps {
+	/** Number of received packets steered to each CPU */
+	net_stats_t pkts[CONFIG_MP_MAX_NUM_CPUS];
+};
+
+/**
+ * @brief Transmit queueing discipline statistics
+ */
+struct net_stats_qdisc {
+	/** Number of packets dropped by CoDel */
+	net_stats_t dropped;
+
+	/** Number of times the transmission was delayed by the shaper */
+	net_stats_t throttled;
+
+	/** Sum of the queueing delays in microseconds */
+	uint64_t delay_sum;
+
+	/** Maximum queueing delay in microseconds */
+	uint32_t delay_max;
+
+	/** Number of packets dequeued */
+	net_stats_t count;
+};
+
 /**
  * @brief Network packet transfer times for calculating average TX time
  */
@@ -480,6 +508,16 @@ struct net_stats {
 	struct net_stats_tc tc;
 #endif
 
+#if defined(CONFIG_NET_TC_RX_RPS)
+	/** Receive packet steering statistics */
+	struct net_stats_rps rps;
+#endif
+
+#if defined(CONFIG_NET_QDISC)
+	/** Transmit queueing discipline statistics */
+	struct net_stats_qdisc qdisc;
+#endif
+
 #if defined(CONFIG_NET_PKT_TXTIME_STATS)
 	/** Network packet TX time statistics */
 	struct net_stats_tx_time tx_time;
@@ -89,6 +89,15 @@ struct prometheus_collector {
 				   GET_ARGS_LESS_N(1, __VA_ARGS__)))),	\
 	}
 
+/**
+ * @brief Collector of the system statistics
+ *
+ * Exposes the statistics of the threads, memory slabs and heaps, and the
+ * number of dropped log messages. The statistics are read when the collector
+ * is scraped. Available when CONFIG_PROMETHEUS_SYSTEM_STATS is enabled.
+ */
+extern struct prometheus_collector prometheus_system_collector;
+
 /**
  * @brief Register a metric with a Prometheus collector
  *
@@ -128,6 +137,7 @@ struct prometheus_collector_walk_context {
 	struct prometheus_collector *collector;
 	struct prometheus_metric *metric;
 	struct prometheus_metric *tmp;
+	struct prometheus_metric *prev;
 	enum prometheus_walk_state state;
 };
 
@@ -166,6 +176,7 @@ static inline int prometheus_collector_walk_init(struct prometheus_collector_wal
 	ctx->state = PROMETHEUS_WALK_START;
 	ctx->metric = NULL;
 	ctx->tmp = NULL;
+	ctx->prev = NULL;
 
 	return 0;
 }
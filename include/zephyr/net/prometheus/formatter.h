@@ -18,6 +18,81 @@
 
 #include <zephyr/net/prometheus/collector.h>
 
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief Exposition formats
+ */
+enum prometheus_format {
+	/** Prometheus text-based format, version 0.0.4 */
+	PROMETHEUS_FORMAT_TEXT = 0,
+	/** Compact OpenMetrics text format, without HELP lines. Counter samples
+	 * carry the _total suffix and the exposition ends with # EOF.
+	 */
+	PROMETHEUS_FORMAT_OPENMETRICS,
+};
+
+/** @cond INTERNAL_HIDDEN */
+
+struct prometheus_exposition_cache_entry {
+	const struct prometheus_metric *metric;
+	bool header;
+	uint64_t fingerprint;
+	uint64_t labels;
+	size_t offset;
+	size_t len;
+};
+
+/** @endcond */
+
+/**
+ * @brief Cache of the exposition text of a collector
+ *
+ * Keeps the text rendered for each metric at the previous scrape, so that
+ * metrics which did not change are copied as is, and the other ones only
+ * get their values formatted again.
+ */
+struct prometheus_exposition_cache {
+	/** Collector whose metrics are cached */
+	struct prometheus_collector *collector;
+	/** Format of the exposition */
+	enum prometheus_format format;
+	/** @cond INTERNAL_HIDDEN */
+	struct prometheus_exposition_cache_entry *entries;
+	size_t max_entries;
+	size_t num_entries;
+	char *text;
+	size_t text_size;
+	/** @endcond */
+};
+
+/**
+ * @brief Define an exposition cache
+ *
+ * The text size should hold the whole exposition of the collector, otherwise
+ * nothing is cached. The metrics of the collector past the maximum count are
+ * always formatted from scratch.
+ *
+ * @param _name Name of the cache.
+ * @param _collector Collector whose metrics are cached.
+ * @param _format Exposition format, see @ref prometheus_format.
+ * @param _max_metrics Maximum number of metrics cached.
+ * @param _text_size Size of the cached text, in bytes.
+ */
+#define PROMETHEUS_EXPOSITION_CACHE_DEFINE(_name, _collector, _format, _max_metrics,	\
+					   _text_size)					\
+	static struct prometheus_exposition_cache_entry _name##_entries[_max_metrics];	\
+	static char _name##_text[_text_size];						\
+	struct prometheus_exposition_cache _name = {					\
+		.collector = &(_collector),						\
+		.format = (_format),							\
+		.entries = _name##_entries,						\
+		.max_entries = (_max_metrics),						\
+		.text = _name##_text,							\
+		.text_size = (_text_size),						\
+	}
+
 /**
  * @brief Format exposition data for Prometheus
  *
@@ -49,6 +124,38 @@ int prometheus_format_exposition(struct prometheus_collector *collector, char *b
 int prometheus_format_one_metric(struct prometheus_metric *metric, char *buffer,
 				 size_t buffer_size, int *written);
 
+/**
+ * @brief Format exposition data using a cache
+ *
+ * Formats the exposition data of the collector of the cache into the provided
+ * buffer, like prometheus_format_exposition(). The text of the metrics whose
+ * values did not change since the previous call is copied from the cache, the
+ * other ones only get their values formatted again, or are formatted from
+ * scratch if their labels changed. The names and buckets of a metric must not
+ * change once it has been scraped, unless prometheus_exposition_cache_reset()
+ * is called.
+ *
+ * The cache is protected by the lock of the collector.
+ *
+ * @param cache Pointer to the exposition cache.
+ * @param buffer Pointer to the buffer where the formatted exposition data will be stored.
+ * @param buffer_size Size of the buffer.
+ *
+ * @return 0 on success, negative errno on error.
+ */
+int prometheus_format_exposition_cached(struct prometheus_exposition_cache *cache, char *buffer,
+					size_t buffer_size);
+
+/**
+ * @brief Drop the cached exposition text
+ *
+ * The next call to prometheus_format_exposition_cached() formats all the
+ * metrics from scratch.
+ *
+ * @param cache Pointer to the exposition cache.
+ */
+void prometheus_exposition_cache_reset(struct prometheus_exposition_cache *cache);
+
 /**
  * @}
  */
@@ -77,6 +77,8 @@ extern "C" {
 #define ZSOCK_MSG_DONTWAIT 0x40
 /** zsock_recv: block until the full amount of data can be returned */
 #define ZSOCK_MSG_WAITALL 0x100
+/** zsock_recvmmsg: block only until the first message has been received */
+#define ZSOCK_MSG_WAITFORONE 0x10000
 /** @} */
 
 /**
@@ -192,7 +194,9 @@ extern "C" {
  */
 #define TLS_SESSION_CACHE 12
 /** Write-only socket option to purge session cache immediately.
- *  This option accepts any value.
+ *  This option accepts any value. Set on a listening TLS socket or a DTLS
+ *  server socket, it only purges the sessions the servers can resume, and
+ *  the sessions stored by the clients are kept.
  */
 #define TLS_SESSION_CACHE_PURGE 13
 /** Write-only socket option to control DTLS CID.
@@ -475,6 +479,28 @@ static inline ssize_t zsock_send(int sock, const void *buf, size_t len,
 __syscall ssize_t zsock_sendmsg(int sock, const struct msghdr *msg,
 				int flags);
 
+/**
+ * @brief Send multiple messages with a single call
+ *
+ * @details
+ * Linux-compatible extension, see man 2 sendmmsg. Each element of @p msgvec
+ * is sent as with zsock_sendmsg(), and the number of bytes sent for it is
+ * stored in its @c msg_len field. The socket is locked once for the whole
+ * batch instead of once per message.
+ * This function is also exposed as `sendmmsg()`
+ * if @kconfig{CONFIG_POSIX_API} is defined.
+ *
+ * @param sock Socket to send on
+ * @param msgvec Array of messages to send
+ * @param vlen Number of elements in @p msgvec
+ * @param flags Flags, as for zsock_sendmsg()
+ *
+ * @return Number of messages sent, or -1 with errno set if the first message
+ *         could not be sent.
+ */
+__syscall int zsock_sendmmsg(int sock, struct mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
 /**
  * @brief Receive data from an arbitrary network address
  *
@@ -501,6 +527,35 @@ __syscall ssize_t zsock_recvfrom(int sock, void *buf, size_t max_len,
  */
 __syscall ssize_t zsock_recvmsg(int sock, struct msghdr *msg, int flags);
 
+/**
+ * @brief Receive multiple messages with a single call
+ *
+ * @details
+ * Linux-compatible extension, see man 2 recvmmsg. Each element of @p msgvec
+ * is filled as with zsock_recvmsg(), and the number of bytes received for it
+ * is stored in its @c msg_len field. The socket is locked once for the whole
+ * batch instead of once per message.
+ *
+ * With @ref ZSOCK_MSG_WAITFORONE, the call blocks only for the first message
+ * and then returns the messages that are already queued. Otherwise it blocks
+ * until @p vlen messages are received or @p timeout expires. As on Linux,
+ * the timeout is checked only after each received message.
+ * This function is also exposed as `recvmmsg()`
+ * if @kconfig{CONFIG_POSIX_API} is defined.
+ *
+ * @param sock Socket to receive from
+ * @param msgvec Array of messages to fill
+ * @param vlen Number of elements in @p msgvec
+ * @param flags Flags, as for zsock_recvmsg(), plus @ref ZSOCK_MSG_WAITFORONE
+ * @param timeout Timeout in milliseconds for the whole batch, or -1 to wait
+ *                for all @p vlen messages
+ *
+ * @return Number of messages received, or -1 with errno set if no message
+ *         could be received.
+ */
+__syscall int zsock_recvmmsg(int sock, struct mmsghdr *msgvec,
+			     unsigned int vlen, int flags, int timeout);
+
 /**
  * @brief Receive data from a connected peer
  *
@@ -517,6 +572,59 @@ static inline ssize_t zsock_recv(int sock, void *buf, size_t max_len,
 	return zsock_recvfrom(sock, buf, max_len, flags, NULL, NULL);
 }
 
+struct net_buf;
+
+/**
+ * @brief Receive data as network buffers, without copying
+ *
+ * @details
+ * Zero-copy variant of zsock_recvfrom() for kernel mode consumers. Instead of
+ * copying the data into a user buffer, the fragments holding the payload of
+ * the next received datagram (or TCP segment for stream sockets) are handed
+ * over to the caller, who must release them with net_buf_unref() once done.
+ * The fragments come from the network RX buffer pool, so they should not be
+ * held for long. The first fragment belongs to the caller alone, the ones
+ * after it may still be shared with other users of the received packet and
+ * must not be modified while their reference count is above one. Only
+ * native (non-offloaded, non-TLS) UDP and TCP sockets are supported, and
+ * @ref ZSOCK_MSG_PEEK is not. If no buffer is available to reference the
+ * data, the call fails with ENOMEM and the data stays queued.
+ *
+ * @param sock Socket to receive from
+ * @param frags Set to the received fragment chain, or NULL if no data
+ * @param flags Flags, as for zsock_recvfrom()
+ * @param src_addr Optional buffer for the source address of a datagram
+ * @param addrlen Length of @p src_addr, updated with the actual length
+ *
+ * @return Number of bytes in @p frags, 0 on end of stream, or -1 with errno
+ *         set on error.
+ */
+ssize_t zsock_recv_buf(int sock, struct net_buf **frags, int flags,
+		       struct sockaddr *src_addr, socklen_t *addrlen);
+
+/**
+ * @brief Send a network buffer chain, without copying
+ *
+ * @details
+ * Zero-copy variant of zsock_sendto() for kernel mode consumers. The
+ * fragments are linked to the outgoing packet as its payload instead of
+ * being copied. The caller's reference to @p frags is consumed in all cases;
+ * the stack keeps its own reference until the packet has been transmitted,
+ * so TX completion is signalled by the destroy callback of the pool the
+ * buffers were allocated from. Only native UDP sockets are supported and
+ * the data must fit into a single datagram.
+ *
+ * @param sock Socket to send on
+ * @param frags Payload to send
+ * @param flags Flags, as for zsock_sendto()
+ * @param dest_addr Destination address, or NULL for a connected socket
+ * @param addrlen Length of @p dest_addr
+ *
+ * @return Number of bytes sent, or -1 with errno set on error.
+ */
+ssize_t zsock_send_buf(int sock, struct net_buf *frags, int flags,
+		       const struct sockaddr *dest_addr, socklen_t addrlen);
+
 /**
  * @brief Control blocking/non-blocking mode of a socket
  *
@@ -756,6 +864,29 @@ int zsock_getaddrinfo(const char *host, const char *service,
  */
 void zsock_freeaddrinfo(struct zsock_addrinfo *ai);
 
+/**
+ * @brief Connect to one of the addresses returned by zsock_getaddrinfo()
+ *
+ * @details
+ * The addresses are tried alternating between IPv6 and IPv4, starting with
+ * IPv6. A new attempt is started when the previous one has failed or has not
+ * completed within @kconfig{CONFIG_NET_SOCKETS_CONNECT_ATTEMPT_DELAY}
+ * milliseconds, without aborting it, as described in RFC 8305 (Happy
+ * Eyeballs). The first connection established is kept and the other attempts
+ * are aborted.
+ *
+ * Available if @kconfig{CONFIG_NET_SOCKETS_CONNECT_ADDRINFO} is enabled.
+ *
+ * @param res List of addresses as returned by zsock_getaddrinfo(), the
+ *        socket type and protocol of each entry are used to create the socket.
+ * @param timeout_ms Time to wait for a connection in milliseconds, or
+ *        SYS_FOREVER_MS to wait until all the attempts have failed.
+ *
+ * @return Connected blocking socket, or -1 with errno set to the error of the
+ *         last failed attempt, or to ETIMEDOUT.
+ */
+int zsock_connect_addrinfo(const struct zsock_addrinfo *res, int timeout_ms);
+
 /**
  * @brief Convert zsock_getaddrinfo() error code to textual message
  *
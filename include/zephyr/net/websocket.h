@@ -178,6 +178,51 @@ int websocket_recv_msg(int ws_sock, uint8_t *buf, size_t buf_len,
 		       uint32_t *message_type, uint64_t *remaining,
 		       int32_t timeout);
 
+/**
+ * @typedef websocket_fragment_cb_t
+ * @brief Callback used to hand over the payload received by
+ *        websocket_recv_stream().
+ *
+ * @param ws_sock Websocket id.
+ * @param data Unmasked payload data. It is only valid during the callback.
+ *        NULL for a frame without payload.
+ * @param len Length of the payload data.
+ * @param message_type Type of the message, see WEBSOCKET_FLAG_* values.
+ * @param remaining How much payload there is left in the frame after this
+ *        fragment.
+ * @param user_data User data given to websocket_recv_stream().
+ *
+ * @return 0 to continue, <0 to stop receiving and return the error from
+ *         websocket_recv_stream().
+ */
+typedef int (*websocket_fragment_cb_t)(int ws_sock, const uint8_t *data, size_t len,
+				       uint32_t message_type, uint64_t remaining,
+				       void *user_data);
+
+/**
+ * @brief Receive a websocket frame from peer without buffering it.
+ *
+ * @details The payload is unmasked in the receive buffer given to
+ * websocket_connect() or websocket_register() and handed over to the callback
+ * as it is received from the network, so the size of a frame is not limited
+ * by the size of a buffer. The function returns once the end of the frame has
+ * been handed over, or when the timeout expires after part of it has been.
+ *
+ * @param ws_sock Websocket id returned by websocket_connect().
+ * @param cb Callback called for each payload fragment received.
+ * @param user_data User data passed to the callback.
+ * @param timeout How long to try to receive the frame.
+ *        The value is in milliseconds. Value SYS_FOREVER_MS means to wait
+ *        forever.
+ *
+ * @retval >=0 amount of payload bytes handed over.
+ * @retval -EAGAIN on timeout before any payload was received.
+ * @retval -ENOTCONN on socket close.
+ * @retval -errno other negative errno value in case of failure.
+ */
+int websocket_recv_stream(int ws_sock, websocket_fragment_cb_t cb, void *user_data,
+			  int32_t timeout);
+
 /**
  * @brief Close websocket.
  *
@@ -1070,6 +1070,17 @@ struct net_buf_data_alloc {
 
 /** @endcond */
 
+/** @cond INTERNAL_HIDDEN */
+#if defined(CONFIG_NET_BUF_POOL_CACHE)
+/* Free buffers kept aside for the allocations made on one CPU */
+struct net_buf_pool_cache {
+	struct k_spinlock lock;
+	uint8_t count;
+	struct net_buf *bufs[CONFIG_NET_BUF_POOL_CACHE_SIZE];
+};
+#endif
+/** @endcond */
+
 /**
  * @brief Network buffer pool representation.
  *
@@ -1103,8 +1114,25 @@ struct net_buf_pool {
 
 	/** Name of the pool. Used when printing pool information. */
 	const char *name;
+
+#if defined(CONFIG_NET_BUF_POOL_CACHE) || defined(DOXYGEN)
+	/** Number of allocations served by the per-CPU caches. */
+	atomic_t cache_hits;
+
+	/** Number of allocations not served by the per-CPU caches. */
+	atomic_t cache_misses;
+#endif /* CONFIG_NET_BUF_POOL_CACHE */
 #endif /* CONFIG_NET_BUF_POOL_USAGE */
 
+#if defined(CONFIG_NET_BUF_POOL_CACHE)
+	/** @cond INTERNAL_HIDDEN */
+	/* Number of threads waiting for a buffer in the free LIFO */
+	atomic_t cache_waiters;
+
+	struct net_buf_pool_cache cache[CONFIG_MP_MAX_NUM_CPUS];
+	/** @endcond */
+#endif /* CONFIG_NET_BUF_POOL_CACHE */
+
 	/** Optional destroy callback when buffer is freed. */
 	void (*const destroy)(struct net_buf *buf);
 
@@ -1423,6 +1451,28 @@ struct net_buf * __must_check net_buf_alloc_with_data(struct net_buf_pool *pool,
 						      k_timeout_t timeout);
 #endif
 
+/**
+ * @brief Allocate a chain of buffers from a pool.
+ *
+ * Allocate @a count buffers able to fit @a size bytes each, linked together
+ * as fragments of the first one. Either all the buffers are allocated or
+ * none of them. With CONFIG_NET_BUF_POOL_CACHE, the buffers available in
+ * the cache of the current CPU are taken at once. The whole chain is freed
+ * with net_buf_unref().
+ *
+ * @param pool Which pool to allocate the buffers from.
+ * @param size Amount of data each buffer must be able to fit.
+ * @param count Number of buffers to allocate.
+ * @param timeout Affects the action taken should the pool be empty, the
+ *        same way as for net_buf_alloc_len(). This is the time allowed for
+ *        the whole chain.
+ *
+ * @return Head of the chain or NULL if out of buffers.
+ */
+struct net_buf * __must_check net_buf_alloc_bulk(struct net_buf_pool *pool,
+						 size_t size, size_t count,
+						 k_timeout_t timeout);
+
 /**
  * @brief Destroy buffer from custom destroy callback
  *
@@ -1485,7 +1535,10 @@ struct net_buf * __must_check net_buf_slist_get(sys_slist_t *list);
 /**
  * @brief Decrements the reference count of a buffer.
  *
- * The buffer is put back into the pool if the reference count reaches zero.
+ * The buffer is put back into the pool if the reference count reaches zero,
+ * and so are its fragments. With CONFIG_NET_BUF_POOL_CACHE, the fragments
+ * freed from a pool without destroy callback are put back in one go into
+ * the cache of the current CPU.
  *
  * @param buf A valid pointer on a buffer
  */
@@ -2320,6 +2320,22 @@
  */
 #define sys_port_trace_socket_sendmsg_exit(socket, ret)
 
+/**
+ * @brief Trace sendmmsg of network sockets
+ * @param socket Socket object
+ * @param msgvec Array of messages to send
+ * @param vlen Number of messages in the array
+ * @param flags Flags for this send operation
+ */
+#define sys_port_trace_socket_sendmmsg_enter(socket, msgvec, vlen, flags)
+
+/**
+ * @brief Trace network socket sendmmsg attempt
+ * @param socket Socket object
+ * @param ret Return value
+ */
+#define sys_port_trace_socket_sendmmsg_exit(socket, ret)
+
 /**
  * @brief Trace recvfrom of network sockets
  * @param socket Socket object
@@ -2355,6 +2371,24 @@
  */
 #define sys_port_trace_socket_recvmsg_exit(socket, msg, ret)
 
+/**
+ * @brief Trace recvmmsg of network sockets
+ * @param socket Socket object
+ * @param msgvec Array of message buffers to receive
+ * @param vlen Number of messages in the array
+ * @param flags Flags for this receive operation
+ * @param timeout Timeout for the whole batch in milliseconds
+ */
+#define sys_port_trace_socket_recvmmsg_enter(socket, msgvec, vlen, flags, timeout)
+
+/**
+ * @brief Trace network socket recvmmsg attempt
+ * @param socket Socket object
+ * @param msgvec Array of message buffers received
+ * @param ret Return value
+ */
+#define sys_port_trace_socket_recvmmsg_exit(socket, msgvec, ret)
+
 /**
  * @brief Trace fcntl of network sockets
  * @param socket Socket object
@@ -222,6 +222,147 @@ static uint8_t *data_ref(struct net_buf *buf, uint8_t *data)
 	return pool->alloc->cb->ref(buf, data);
 }
 
+#if defined(CONFIG_NET_BUF_POOL_CACHE)
+#if CONFIG_MP_MAX_NUM_CPUS > 1
+/* The thread might migrate right after, it then only uses the cache of
+ * another CPU which is protected by its own lock anyway.
+ */
+#define POOL_CACHE_CPU() (arch_curr_cpu()->id)
+#else
+#define POOL_CACHE_CPU() 0
+#endif
+
+static void pool_cache_account(struct net_buf_pool *pool, size_t hits,
+			       size_t misses)
+{
+#if defined(CONFIG_NET_BUF_POOL_USAGE)
+	atomic_add(&pool->cache_hits, hits);
+	atomic_add(&pool->cache_misses, misses);
+#else
+	ARG_UNUSED(pool);
+	ARG_UNUSED(hits);
+	ARG_UNUSED(misses);
+#endif
+}
+
+/* Move up to count buffers from the cache of a CPU to a fragment chain */
+static size_t pool_cache_get(struct net_buf_pool *pool, int cpu,
+			     struct net_buf **head, size_t count)
+{
+	struct net_buf_pool_cache *cache = &pool->cache[cpu];
+	k_spinlock_key_t key;
+	size_t got = 0;
+
+	key = k_spin_lock(&cache->lock);
+
+	while (got < count && cache->count > 0U) {
+		struct net_buf *buf = cache->bufs[--cache->count];
+
+		buf->frags = *head;
+		*head = buf;
+		got++;
+	}
+
+	k_spin_unlock(&cache->lock, key);
+
+	return got;
+}
+
+/* Take a buffer left in the cache of any CPU before waiting for one */
+static struct net_buf *pool_cache_steal(struct net_buf_pool *pool)
+{
+	struct net_buf *buf = NULL;
+
+	for (int cpu = 0; cpu < CONFIG_MP_MAX_NUM_CPUS; cpu++) {
+		if (pool_cache_get(pool, cpu, &buf, 1) > 0) {
+			break;
+		}
+	}
+
+	return buf;
+}
+
+static void pool_cache_release_data(struct net_buf_pool *pool,
+				    struct net_buf *buf)
+{
+	if (buf->__buf) {
+		if (!(buf->flags & NET_BUF_EXTERNAL_DATA)) {
+			pool->alloc->cb->unref(buf, buf->__buf);
+		}
+		buf->__buf = NULL;
+	}
+}
+
+/* Put a list of freed buffers into the cache of the current CPU, the ones
+ * which do not fit going back to the pool.
+ */
+static void pool_cache_put(struct net_buf_pool *pool, sys_slist_t *list)
+{
+	struct net_buf_pool_cache *cache = &pool->cache[POOL_CACHE_CPU()];
+	k_spinlock_key_t key;
+	sys_snode_t *node;
+
+	key = k_spin_lock(&cache->lock);
+
+	/* The waiting threads only look at the free LIFO. This is checked with
+	 * the cache locked, as they look at the caches after registering.
+	 */
+	if (atomic_get(&pool->cache_waiters) == 0) {
+		while (cache->count < CONFIG_NET_BUF_POOL_CACHE_SIZE) {
+			node = sys_slist_get(list);
+			if (!node) {
+				break;
+			}
+
+			cache->bufs[cache->count++] = CONTAINER_OF(node, struct net_buf, node);
+		}
+	}
+
+	k_spin_unlock(&cache->lock, key);
+
+	while ((node = sys_slist_get(list)) != NULL) {
+		k_lifo_put(&pool->free, CONTAINER_OF(node, struct net_buf, node));
+	}
+}
+#endif /* CONFIG_NET_BUF_POOL_CACHE */
+
+/* Prepare a buffer taken from the pool to be handed out */
+static int buf_setup(struct net_buf_pool *pool, struct net_buf *buf,
+		     size_t size, k_timepoint_t end)
+{
+	if (size) {
+#if __ASSERT_ON
+		size_t req_size = size;
+#endif
+		buf->__buf = data_alloc(buf, &size, sys_timepoint_timeout(end));
+		if (!buf->__buf) {
+			net_buf_destroy(buf);
+			return -ENOMEM;
+		}
+
+#if __ASSERT_ON
+		NET_BUF_ASSERT(req_size <= size);
+#endif
+	} else {
+		buf->__buf = NULL;
+	}
+
+	buf->ref   = 1U;
+	buf->flags = 0U;
+	buf->frags = NULL;
+	buf->size  = size;
+	memset(buf->user_data, 0, buf->user_data_size);
+	net_buf_reset(buf);
+
+#if defined(CONFIG_NET_BUF_POOL_USAGE)
+	atomic_dec(&pool->avail_count);
+	__ASSERT_NO_MSG(atomic_get(&pool->avail_count) >= 0);
+	pool->max_used = MAX(pool->max_used,
+			     pool->buf_count - atomic_get(&pool->avail_count));
+#endif
+	return 0;
+}
+
 #if defined(CONFIG_NET_BUF_LOG)
 struct net_buf *net_buf_alloc_len_debug(struct net_buf_pool *pool, size_t size,
 					k_timeout_t timeout, const char *func,
@@ -239,6 +380,16 @@ struct net_buf *net_buf_alloc_len(struct net_buf_pool *pool, size_t size,
 
 	NET_BUF_DBG("%s():%d: pool %p size %zu", func, line, pool, size);
 
+#if defined(CONFIG_NET_BUF_POOL_CACHE)
+	buf = NULL;
+	if (pool_cache_get(pool, POOL_CACHE_CPU(), &buf, 1) > 0) {
+		pool_cache_account(pool, 1, 0);
+		goto success;
+	}
+
+	pool_cache_account(pool, 0, 1);
+#endif
+
 	/* We need to prevent race conditions
 	 * when accessing pool->uninit_count.
 	 */
@@ -271,6 +422,17 @@ struct net_buf *net_buf_alloc_len(struct net_buf_pool *pool, size_t size,
 
 	k_spin_unlock(&pool->lock, key);
 
+#if defined(CONFIG_NET_BUF_POOL_CACHE)
+	/* From now on the freed buffers go to the free LIFO */
+	atomic_inc(&pool->cache_waiters);
+
+	buf = pool_cache_steal(pool);
+	if (buf) {
+		atomic_dec(&pool->cache_waiters);
+		goto success;
+	}
+#endif
+
 #if defined(CONFIG_NET_BUF_LOG) && (CONFIG_NET_BUF_LOG_LEVEL >= LOG_LEVEL_WRN)
 	if (K_TIMEOUT_EQ(timeout, K_FOREVER)) {
 		uint32_t ref = k_uptime_get_32();
@@ -299,6 +461,9 @@ struct net_buf *net_buf_alloc_len(struct net_buf_pool *pool, size_t size,
 	}
 #else
 	buf = k_lifo_get(&pool->free, timeout);
+#endif
+#if defined(CONFIG_NET_BUF_POOL_CACHE)
+	atomic_dec(&pool->cache_waiters);
 #endif
 	if (!buf) {
 		NET_BUF_ERR("%s():%d: Failed to get free buffer", func, line);
@@ -308,40 +473,70 @@ struct net_buf *net_buf_alloc_len(struct net_buf_pool *pool, size_t size,
 success:
 	NET_BUF_DBG("allocated buf %p", buf);
 
-	if (size) {
-#if __ASSERT_ON
-		size_t req_size = size;
+	if (buf_setup(pool, buf, size, end) < 0) {
+		NET_BUF_ERR("%s():%d: Failed to allocate data", func, line);
+		return NULL;
+	}
+
+	return buf;
+}
+
+struct net_buf *net_buf_alloc_bulk(struct net_buf_pool *pool, size_t size,
+				   size_t count, k_timeout_t timeout)
+{
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	struct net_buf *head = NULL;
+	struct net_buf *cached = NULL;
+
+	__ASSERT_NO_MSG(pool);
+	__ASSERT_NO_MSG(count > 0);
+
+#if defined(CONFIG_NET_BUF_POOL_CACHE)
+	pool_cache_account(pool, pool_cache_get(pool, POOL_CACHE_CPU(), &cached, count), 0);
 #endif
-		timeout = sys_timepoint_timeout(end);
-		buf->__buf = data_alloc(buf, &size, timeout);
-		if (!buf->__buf) {
-			NET_BUF_ERR("%s():%d: Failed to allocate data",
-				    func, line);
-			net_buf_destroy(buf);
-			return NULL;
+
+	for (size_t i = 0; i < count; i++) {
+		struct net_buf *buf;
+
+		if (cached) {
+			buf = cached;
+			cached = buf->frags;
+
+			if (buf_setup(pool, buf, size, end) < 0) {
+				buf = NULL;
+			}
+		} else {
+			buf = net_buf_alloc_len(pool, size, sys_timepoint_timeout(end));
 		}
 
-#if __ASSERT_ON
-		NET_BUF_ASSERT(req_size <= size);
-#endif
-	} else {
-		buf->__buf = NULL;
+		if (!buf) {
+			NET_BUF_ERR("Failed to allocate %zu buffers", count);
+			goto fail;
+		}
+
+		buf->frags = head;
+		head = buf;
 	}
 
-	buf->ref   = 1U;
-	buf->flags = 0U;
-	buf->frags = NULL;
-	buf->size  = size;
-	memset(buf->user_data, 0, buf->user_data_size);
-	net_buf_reset(buf);
+	NET_BUF_DBG("allocated %zu buffers", count);
 
-#if defined(CONFIG_NET_BUF_POOL_USAGE)
-	atomic_dec(&pool->avail_count);
-	__ASSERT_NO_MSG(atomic_get(&pool->avail_count) >= 0);
-	pool->max_used = MAX(pool->max_used,
-			     pool->buf_count - atomic_get(&pool->avail_count));
-#endif
-	return buf;
+	return head;
+
+fail:
+	/* Give back the cached buffers not set up yet as is */
+	while (cached) {
+		struct net_buf *buf = cached;
+
+		cached = buf->frags;
+		buf->frags = NULL;
+		net_buf_destroy(buf);
+	}
+
+	if (head) {
+		net_buf_unref(head);
+	}
+
+	return NULL;
 }
 
 #if defined(CONFIG_NET_BUF_LOG)
@@ -424,6 +619,13 @@ void net_buf_unref_debug(struct net_buf *buf, const char *func, int line)
 void net_buf_unref(struct net_buf *buf)
 #endif
 {
+#if defined(CONFIG_NET_BUF_POOL_CACHE)
+	struct net_buf_pool *freed_pool = NULL;
+	sys_slist_t freed;
+
+	sys_slist_init(&freed);
+#endif
+
 	__ASSERT_NO_MSG(buf);
 
 	while (buf) {
@@ -434,14 +636,14 @@ void net_buf_unref(struct net_buf *buf)
 		if (!buf->ref) {
 			NET_BUF_ERR("%s():%d: buf %p double free", func, line,
 				    buf);
-			return;
+			break;
 		}
 #endif
 		NET_BUF_DBG("buf %p ref %u pool_id %u frags %p", buf, buf->ref,
 			    buf->pool_id, buf->frags);
 
 		if (--buf->ref > 0) {
-			return;
+			break;
 		}
 
 		buf->data = NULL;
@@ -454,6 +656,27 @@ void net_buf_unref(struct net_buf *buf)
 		__ASSERT_NO_MSG(atomic_get(&pool->avail_count) <= pool->buf_count);
 #endif
 
+#if defined(CONFIG_NET_BUF_POOL_CACHE)
+		/* Gather the fragments coming from the same pool to cache them
+		 * all at once.
+		 */
+		if (!pool->destroy) {
+			if (pool != freed_pool) {
+				if (freed_pool) {
+					pool_cache_put(freed_pool, &freed);
+				}
+
+				freed_pool = pool;
+			}
+
+			pool_cache_release_data(pool, buf);
+			sys_slist_append(&freed, &buf->node);
+
+			buf = frags;
+			continue;
+		}
+#endif
+
 		if (pool->destroy) {
 			pool->destroy(buf);
 		} else {
@@ -462,6 +685,12 @@ void net_buf_unref(struct net_buf *buf)
 
 		buf = frags;
 	}
+
+#if defined(CONFIG_NET_BUF_POOL_CACHE)
+	if (freed_pool) {
+		pool_cache_put(freed_pool, &freed);
+	}
+#endif
 }
 
 struct net_buf *net_buf_ref(struct net_buf *buf)
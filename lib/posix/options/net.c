@@ -6,6 +6,7 @@
  */
 
 #include <ctype.h>
+#include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -355,6 +356,31 @@ ssize_t recvmsg(int sock, struct msghdr *msg, int flags)
 	return zsock_recvmsg(sock, msg, flags);
 }
 
+int recvmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen, int flags,
+	     struct timespec *timeout)
+{
+	int timeout_ms = -1;
+
+	if (timeout != NULL) {
+		int64_t ms;
+
+		if (timeout->tv_sec < 0 || timeout->tv_nsec < 0 ||
+		    timeout->tv_nsec >= NSEC_PER_SEC) {
+			errno = EINVAL;
+			return -1;
+		}
+
+		/* Anything longer than INT_MAX milliseconds is close enough
+		 * to forever for the socket layer.
+		 */
+		ms = (int64_t)timeout->tv_sec * MSEC_PER_SEC +
+		     timeout->tv_nsec / NSEC_PER_MSEC;
+		timeout_ms = (int)MIN(ms, INT_MAX);
+	}
+
+	return zsock_recvmmsg(sock, msgvec, vlen, flags, timeout_ms);
+}
+
 ssize_t send(int sock, const void *buf, size_t len, int flags)
 {
 	return zsock_send(sock, buf, len, flags);
@@ -365,6 +391,11 @@ ssize_t sendmsg(int sock, const struct msghdr *message, int flags)
 	return zsock_sendmsg(sock, message, flags);
 }
 
+int sendmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen, int flags)
+{
+	return zsock_sendmmsg(sock, msgvec, vlen, flags);
+}
+
 ssize_t sendto(int sock, const void *buf, size_t len, int flags, const struct sockaddr *dest_addr,
 	       socklen_t addrlen)
 {
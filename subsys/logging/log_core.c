@@ -109,6 +109,7 @@ static bool panic_mode;
 static bool backend_attached;
 static atomic_t buffered_cnt;
 static atomic_t dropped_cnt;
+static atomic_t dropped_total;
 static k_tid_t proc_tid;
 static struct k_timer log_process_thread_timer;
 
@@ -257,6 +258,7 @@ void log_core_init(void)
 {
 	panic_mode = false;
 	dropped_cnt = 0;
+	dropped_total = 0;
 	buffered_cnt = 0;
 
 	if (IS_ENABLED(CONFIG_LOG_FRONTEND)) {
@@ -628,6 +630,7 @@ uint32_t z_vrfy_log_buffered_cnt(void)
 void z_log_dropped(bool buffered)
 {
 	atomic_inc(&dropped_cnt);
+	atomic_inc(&dropped_total);
 	if (buffered) {
 		atomic_dec(&buffered_cnt);
 	}
@@ -648,6 +651,11 @@ bool z_log_dropped_pending(void)
 	return dropped_cnt > 0;
 }
 
+uint32_t z_log_dropped_total(void)
+{
+	return (uint32_t)atomic_get(&dropped_total);
+}
+
 void z_log_msg_init(void)
 {
 #ifdef CONFIG_MPSC_PBUF
@@ -335,6 +335,18 @@ static inline void net_ipv4_set_ecn(uint8_t *tos, uint8_t ecn)
 }
 
 #if defined(CONFIG_NET_IPV4_FRAGMENT)
+/**
+ * Most fragment payload bytes held by all the pending IPv4 reassemblies.
+ * Unless configured, every reassembly may hold its largest number of
+ * fragments, each filling a 1500 byte frame, the largest supported MTU.
+ */
+#if CONFIG_NET_IPV4_FRAGMENT_MAX_BYTES > 0
+#define NET_IPV4_FRAGMENT_MAX_BYTES CONFIG_NET_IPV4_FRAGMENT_MAX_BYTES
+#else
+#define NET_IPV4_FRAGMENT_MAX_BYTES \
+	(CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT * CONFIG_NET_IPV4_FRAGMENT_MAX_PKT * 1500)
+#endif
+
 /** Store pending IPv4 fragment information that is needed for reassembly. */
 struct net_ipv4_reassembly {
 	/** IPv4 source address of the fragment */
@@ -343,18 +355,27 @@ struct net_ipv4_reassembly {
 	/** IPv4 destination address of the fragment */
 	struct in_addr dst;
 
-	/**
-	 * Timeout for cancelling the reassembly. The timer is used
-	 * also to detect if this reassembly slot is used or not.
-	 */
+	/** Timeout for cancelling the reassembly. */
 	struct k_work_delayable timer;
 
-	/** Pointers to pending fragments */
+	/** Pointers to pending fragments, sorted by fragment offset */
 	struct net_pkt *pkt[CONFIG_NET_IPV4_FRAGMENT_MAX_PKT];
 
+	/** Number of payload bytes received */
+	uint32_t received;
+
+	/** Payload length of the packet, zero until the last fragment is received */
+	uint32_t total;
+
+	/** Next reassembly in the same hash bucket or in the free list */
+	int16_t next;
+
 	/** IPv4 fragment identification */
 	uint16_t id;
 	uint8_t protocol;
+
+	/** Number of pending fragments */
+	uint8_t count;
 };
 #else
 struct net_ipv4_reassembly;
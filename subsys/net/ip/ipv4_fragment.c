@@ -28,87 +28,120 @@ LOG_MODULE_DECLARE(net_ipv4, CONFIG_NET_IPV4_LOG_LEVEL);
 /* Timeout for various buffer allocations in this file. */
 #define NET_BUF_TIMEOUT K_MSEC(100)
 
+#define REASSEMBLY_NONE -1
+
 static void reassembly_timeout(struct k_work *work);
 
 static struct net_ipv4_reassembly reassembly[CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT];
 
+/* The reassemblies in progress are found through a hash table whose buckets
+ * are chained through the next field. Unused reassemblies are kept in a free
+ * list chained the same way.
+ */
+static int16_t reassembly_hash[CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT];
+static int16_t reassembly_free;
+
+/* Fragment payload bytes held by all the reassemblies */
+static size_t reassembly_bytes;
+
+/* Protects the reassemblies from the RX thread and the timeout handler */
+static K_MUTEX_DEFINE(reassembly_lock);
+
+BUILD_ASSERT(CONFIG_NET_IPV4_FRAGMENT_MAX_PKT <= UINT8_MAX);
+
+static int reassembly_bucket(uint16_t id, const struct in_addr *src, const struct in_addr *dst,
+			     uint8_t protocol)
+{
+	uint32_t hash = UNALIGNED_GET(&src->s_addr) ^ UNALIGNED_GET(&dst->s_addr) ^
+			((uint32_t)id << 8) ^ protocol;
+
+	hash ^= hash >> 16;
+	hash ^= hash >> 8;
+
+	return hash % CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT;
+}
+
 static struct net_ipv4_reassembly *reassembly_get(uint16_t id, struct in_addr *src,
 						  struct in_addr *dst, uint8_t protocol)
 {
-	int i, avail = -1;
+	int bucket = reassembly_bucket(id, src, dst, protocol);
+	struct net_ipv4_reassembly *reass;
+	int16_t idx;
 
-	for (i = 0; i < CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT; i++) {
-		if (k_work_delayable_remaining_get(&reassembly[i].timer) &&
-		    reassembly[i].id == id &&
-		    net_ipv4_addr_cmp(src, &reassembly[i].src) &&
-		    net_ipv4_addr_cmp(dst, &reassembly[i].dst) &&
-		    reassembly[i].protocol == protocol) {
-			return &reassembly[i];
-		}
+	for (idx = reassembly_hash[bucket]; idx != REASSEMBLY_NONE; idx = reassembly[idx].next) {
+		reass = &reassembly[idx];
 
-		if (k_work_delayable_remaining_get(&reassembly[i].timer)) {
-			continue;
-		}
-
-		if (avail < 0) {
-			avail = i;
+		if (reass->id == id && reass->protocol == protocol &&
+		    net_ipv4_addr_cmp(src, &reass->src) &&
+		    net_ipv4_addr_cmp(dst, &reass->dst)) {
+			return reass;
 		}
 	}
 
-	if (avail < 0) {
+	idx = reassembly_free;
+	if (idx == REASSEMBLY_NONE) {
 		return NULL;
 	}
 
-	k_work_reschedule(&reassembly[avail].timer, K_SECONDS(CONFIG_NET_IPV4_FRAGMENT_TIMEOUT));
+	reass = &reassembly[idx];
+	reassembly_free = reass->next;
+
+	reass->next = reassembly_hash[bucket];
+	reassembly_hash[bucket] = idx;
 
-	net_ipaddr_copy(&reassembly[avail].src, src);
-	net_ipaddr_copy(&reassembly[avail].dst, dst);
+	k_work_reschedule(&reass->timer, K_SECONDS(CONFIG_NET_IPV4_FRAGMENT_TIMEOUT));
 
-	reassembly[avail].protocol = protocol;
-	reassembly[avail].id = id;
+	net_ipaddr_copy(&reass->src, src);
+	net_ipaddr_copy(&reass->dst, dst);
 
-	return &reassembly[avail];
+	reass->protocol = protocol;
+	reass->id = id;
+	reass->received = 0U;
+	reass->total = 0U;
+	reass->count = 0U;
+
+	return reass;
 }
 
-static bool reassembly_cancel(uint32_t id, struct in_addr *src, struct in_addr *dst)
+/* Release the reassembly and the fragments it still holds */
+static void reassembly_cancel(struct net_ipv4_reassembly *reass)
 {
-	int i, j;
+	int16_t *idx;
+	int i;
 
-	LOG_DBG("Cancel 0x%x", id);
+	LOG_DBG("IPv4 reassembly id 0x%x remaining %d ms", reass->id,
+		k_ticks_to_ms_ceil32(k_work_delayable_remaining_get(&reass->timer)));
 
-	for (i = 0; i < CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT; i++) {
-		int32_t remaining;
+	k_work_cancel_delayable(&reass->timer);
 
-		if (reassembly[i].id != id ||
-		    !net_ipv4_addr_cmp(src, &reassembly[i].src) ||
-		    !net_ipv4_addr_cmp(dst, &reassembly[i].dst)) {
+	for (i = 0; i < reass->count; i++) {
+		if (!reass->pkt[i]) {
 			continue;
 		}
 
-		remaining = k_ticks_to_ms_ceil32(
-			k_work_delayable_remaining_get(&reassembly[i].timer));
-		k_work_cancel_delayable(&reassembly[i].timer);
+		LOG_DBG("[%d] IPv4 reassembly pkt %p %zd bytes data", i, reass->pkt[i],
+			net_pkt_get_len(reass->pkt[i]));
 
-		LOG_DBG("IPv4 reassembly id 0x%x remaining %d ms", reassembly[i].id, remaining);
-
-		reassembly[i].id = 0U;
+		net_pkt_unref(reass->pkt[i]);
+		reass->pkt[i] = NULL;
+	}
 
-		for (j = 0; j < CONFIG_NET_IPV4_FRAGMENT_MAX_PKT; j++) {
-			if (!reassembly[i].pkt[j]) {
-				continue;
-			}
+	idx = &reassembly_hash[reassembly_bucket(reass->id, &reass->src, &reass->dst,
+						  reass->protocol)];
+	while (&reassembly[*idx] != reass) {
+		idx = &reassembly[*idx].next;
+	}
 
-			LOG_DBG("[%d] IPv4 reassembly pkt %p %zd bytes data", j,
-				reassembly[i].pkt[j], net_pkt_get_len(reassembly[i].pkt[j]));
+	*idx = reass->next;
+	reass->next = reassembly_free;
+	reassembly_free = reass - reassembly;
 
-			net_pkt_unref(reassembly[i].pkt[j]);
-			reassembly[i].pkt[j] = NULL;
-		}
+	reassembly_bytes -= reass->received;
 
-		return true;
-	}
-
-	return false;
+	reass->id = 0U;
+	reass->received = 0U;
+	reass->total = 0U;
+	reass->count = 0U;
 }
 
 static void reassembly_info(char *str, struct net_ipv4_reassembly *reass)
@@ -126,15 +159,29 @@ static void reassembly_timeout(struct k_work *work)
 	struct net_ipv4_reassembly *reass =
 		CONTAINER_OF(dwork, struct net_ipv4_reassembly, timer);
 
+	k_mutex_lock(&reassembly_lock, K_FOREVER);
+
+	/* The reassembly might have been completed, or released and reused,
+	 * while the timeout was waiting for the lock.
+	 */
+	if (reass->count == 0U || k_work_delayable_remaining_get(&reass->timer) > 0) {
+		goto out;
+	}
+
 	reassembly_info("Reassembly cancelled", reass);
 
+	net_stats_update_ip_errors_fragerr(net_pkt_iface(reass->pkt[0]));
+
 	/* Send a ICMPv4 Time Exceeded only if we received the first fragment */
-	if (reass->pkt[0] && net_pkt_ipv4_fragment_offset(reass->pkt[0]) == 0) {
+	if (net_pkt_ipv4_fragment_offset(reass->pkt[0]) == 0) {
 		net_icmpv4_send_error(reass->pkt[0], NET_ICMPV4_TIME_EXCEEDED,
 				      NET_ICMPV4_TIME_EXCEEDED_FRAGMENT_REASSEMBLY_TIME);
 	}
 
-	reassembly_cancel(reass->id, &reass->src, &reass->dst);
+	reassembly_cancel(reass);
+
+out:
+	k_mutex_unlock(&reassembly_lock);
 }
 
 static void reassemble_packet(struct net_ipv4_reassembly *reass)
@@ -145,25 +192,20 @@ static void reassemble_packet(struct net_ipv4_reassembly *reass)
 	struct net_buf *last;
 	int i;
 
-	k_work_cancel_delayable(&reass->timer);
-
 	NET_ASSERT(reass->pkt[0]);
 
 	last = net_buf_frag_last(reass->pkt[0]->buffer);
 
 	/* We start from 2nd packet which is then appended to the first one */
-	for (i = 1; i < CONFIG_NET_IPV4_FRAGMENT_MAX_PKT; i++) {
+	for (i = 1; i < reass->count; i++) {
 		pkt = reass->pkt[i];
-		if (!pkt) {
-			break;
-		}
 
 		net_pkt_cursor_init(pkt);
 
 		/* Get rid of IPv4 header which is at the beginning of the fragment. */
 		ipv4_hdr = (struct net_ipv4_hdr *)net_pkt_get_data(pkt, &ipv4_access);
 		if (!ipv4_hdr) {
-			goto error;
+			goto cancel;
 		}
 
 		LOG_DBG("Removing %d bytes from start of pkt %p", net_pkt_ip_hdr_len(pkt),
@@ -171,8 +213,7 @@ static void reassemble_packet(struct net_ipv4_reassembly *reass)
 
 		if (net_pkt_pull(pkt, net_pkt_ip_hdr_len(pkt))) {
 			LOG_ERR("Failed to pull headers");
-			reassembly_cancel(reass->id, &reass->src, &reass->dst);
-			return;
+			goto cancel;
 		}
 
 		/* Attach the data to the previous packet */
@@ -188,6 +229,9 @@ static void reassemble_packet(struct net_ipv4_reassembly *reass)
 	pkt = reass->pkt[0];
 	reass->pkt[0] = NULL;
 
+	/* All the fragments are now part of pkt, release the reassembly */
+	reassembly_cancel(reass);
+
 	/* Update the header details for the packet */
 	net_pkt_cursor_init(pkt);
 
@@ -220,128 +264,145 @@ static void reassemble_packet(struct net_ipv4_reassembly *reass)
 
 error:
 	net_pkt_unref(pkt);
+	return;
+
+cancel:
+	net_stats_update_ip_errors_fragerr(net_pkt_iface(reass->pkt[0]));
+	reassembly_cancel(reass);
 }
 
 void net_ipv4_frag_foreach(net_ipv4_frag_cb_t cb, void *user_data)
 {
 	int i;
+	int16_t idx;
+
+	k_mutex_lock(&reassembly_lock, K_FOREVER);
 
 	for (i = 0; i < CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT; i++) {
-		if (!k_work_delayable_remaining_get(&reassembly[i].timer)) {
-			continue;
+		for (idx = reassembly_hash[i]; idx != REASSEMBLY_NONE;
+		     idx = reassembly[idx].next) {
+			cb(&reassembly[idx], user_data);
 		}
+	}
+
+	k_mutex_unlock(&reassembly_lock);
+}
+
+static inline unsigned int fragment_offset(struct net_pkt *pkt)
+{
+	return net_pkt_ipv4_fragment_offset(pkt);
+}
 
-		cb(&reassembly[i], user_data);
+static inline unsigned int fragment_end(struct net_pkt *pkt)
+{
+	return fragment_offset(pkt) + net_pkt_get_len(pkt) - net_pkt_ip_hdr_len(pkt);
+}
+
+/* Position of the first stored fragment starting after the given offset */
+static int fragment_find(struct net_ipv4_reassembly *reass, unsigned int offset)
+{
+	int low = 0;
+	int high = reass->count;
+
+	while (low < high) {
+		int mid = (low + high) / 2;
+
+		if (fragment_offset(reass->pkt[mid]) <= offset) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
 	}
+
+	return low;
 }
 
-/* Verify that we have all the fragments received and in correct order.
+/* Store the fragment in the reassembly, keeping the fragments sorted by
+ * offset. As the stored fragments never overlap, the packet is complete
+ * when the payload bytes received add up to the length given by the last
+ * fragment.
  * Return:
- * - a negative value if the fragments are erroneous and must be dropped
+ * - a negative value if the fragment is erroneous or cannot be stored, the
+ *   whole packet must then be dropped
  * - zero if we are expecting more fragments
  * - a positive value if we can proceed with the reassembly
  */
-static int fragments_are_ready(struct net_ipv4_reassembly *reass)
+static int fragment_insert(struct net_ipv4_reassembly *reass, struct net_pkt *pkt)
 {
-	unsigned int expected_offset = 0;
-	bool more = true;
-	int i;
-
-	/* Fragments can arrive in any order, for example in reverse order:
-	 *   1 -> Fragment3(M=0, offset=x2)
-	 *   2 -> Fragment2(M=1, offset=x1)
-	 *   3 -> Fragment1(M=1, offset=0)
-	 * We have to test several requirements before proceeding with the reassembly:
-	 * - We received the first fragment (Fragment Offset is 0)
-	 * - All intermediate fragments are contiguous
-	 * - The More bit of the last fragment is 0
-	 */
-	for (i = 0; i < CONFIG_NET_IPV4_FRAGMENT_MAX_PKT; i++) {
-		struct net_pkt *pkt = reass->pkt[i];
-		unsigned int offset;
-		int payload_len;
-
-		if (!pkt) {
-			break;
-		}
-
-		offset = net_pkt_ipv4_fragment_offset(pkt);
+	unsigned int offset = fragment_offset(pkt);
+	int payload_len = net_pkt_get_len(pkt) - net_pkt_ip_hdr_len(pkt);
+	unsigned int end = offset + payload_len;
+	int pos;
 
-		if (offset < expected_offset) {
-			/* Overlapping or duplicated, drop it */
-			return -EBADMSG;
-		} else if (offset != expected_offset) {
-			/* Not contiguous, let's wait for fragments */
-			return 0;
-		}
+	if (payload_len < 0) {
+		return -EBADMSG;
+	}
 
-		payload_len = net_pkt_get_len(pkt) - net_pkt_ip_hdr_len(pkt);
+	/* The reassembled packet must fit in the IPv4 total length field */
+	if (end + net_pkt_ip_hdr_len(pkt) > UINT16_MAX) {
+		return -EMSGSIZE;
+	}
 
-		if (payload_len < 0) {
+	if (!net_pkt_ipv4_fragment_more(pkt)) {
+		if ((reass->total != 0U && reass->total != end) ||
+		    (reass->count > 0 && fragment_end(reass->pkt[reass->count - 1]) > end)) {
 			return -EBADMSG;
 		}
 
-		expected_offset += payload_len;
-		more = net_pkt_ipv4_fragment_more(pkt);
+		reass->total = end;
+	} else if (reass->total != 0U && end > reass->total) {
+		return -EBADMSG;
 	}
 
-	if (more) {
-		return 0;
+	if (reass->count >= CONFIG_NET_IPV4_FRAGMENT_MAX_PKT) {
+		LOG_DBG("No slots available for 0x%x", reass->id);
+		return -ENOMEM;
 	}
 
-	return 1;
-}
+	if (reassembly_bytes + payload_len > NET_IPV4_FRAGMENT_MAX_BYTES) {
+		LOG_DBG("Reassembly memory budget exceeded for 0x%x", reass->id);
+		return -ENOMEM;
+	}
 
-static int shift_packets(struct net_ipv4_reassembly *reass, int pos)
-{
-	int i;
+	/* Fragments usually arrive in order, so try to append first */
+	pos = reass->count;
+	if (pos > 0 && offset < fragment_offset(reass->pkt[pos - 1])) {
+		pos = fragment_find(reass, offset);
+	}
 
-	for (i = pos + 1; i < CONFIG_NET_IPV4_FRAGMENT_MAX_PKT; i++) {
-		if (!reass->pkt[i]) {
-			LOG_DBG("Moving [%d] %p (offset 0x%x) to [%d]", pos, reass->pkt[pos],
-				net_pkt_ipv4_fragment_offset(reass->pkt[pos]), pos + 1);
+	/* Overlapping or duplicated fragments, drop them */
+	if ((pos > 0 && fragment_end(reass->pkt[pos - 1]) > offset) ||
+	    (pos < reass->count && fragment_offset(reass->pkt[pos]) < end)) {
+		return -EBADMSG;
+	}
 
-			/* pkt[i] is free, so shift everything between [pos] and [i - 1] by one
-			 * element
-			 */
-			memmove(&reass->pkt[pos + 1], &reass->pkt[pos],
-				sizeof(void *) * (i - pos));
+	LOG_DBG("Storing pkt %p to slot %d offset %u", pkt, pos, offset);
 
-			/* pkt[pos] is now free */
-			reass->pkt[pos] = NULL;
+	memmove(&reass->pkt[pos + 1], &reass->pkt[pos],
+		sizeof(reass->pkt[0]) * (reass->count - pos));
+	reass->pkt[pos] = pkt;
+	reass->count++;
 
-			return 0;
-		}
-	}
+	reass->received += payload_len;
+	reassembly_bytes += payload_len;
 
-	/* We do not have free space left in the array */
-	return -ENOMEM;
+	return (reass->total != 0U && reass->received == reass->total) ? 1 : 0;
 }
 
 enum net_verdict net_ipv4_handle_fragment_hdr(struct net_pkt *pkt, struct net_ipv4_hdr *hdr)
 {
-	struct net_ipv4_reassembly *reass = NULL;
+	struct net_ipv4_reassembly *reass;
 	uint16_t flag;
-	bool found;
-	uint8_t more;
 	uint16_t id;
 	int ret;
-	int i;
 
 	flag = ntohs(*((uint16_t *)&hdr->offset));
 	id = ntohs(*((uint16_t *)&hdr->id));
 
-	reass = reassembly_get(id, (struct in_addr *)hdr->src,
-			       (struct in_addr *)hdr->dst, hdr->proto);
-	if (!reass) {
-		LOG_ERR("Cannot get reassembly slot, dropping pkt %p", pkt);
-		goto drop;
-	}
-
-	more = (flag & NET_IPV4_MORE_FRAG_MASK) ? true : false;
 	net_pkt_set_ipv4_fragment_flags(pkt, flag);
 
-	if (more && (net_pkt_get_len(pkt) - net_pkt_ip_hdr_len(pkt)) % 8) {
+	if (net_pkt_ipv4_fragment_more(pkt) &&
+	    (net_pkt_get_len(pkt) - net_pkt_ip_hdr_len(pkt)) % 8) {
 		/* Fragment length is not multiple of 8, discard the packet and send bad IP
 		 * header error.
 		 */
@@ -350,73 +411,42 @@ enum net_verdict net_ipv4_handle_fragment_hdr(struct net_pkt *pkt, struct net_ip
 		goto drop;
 	}
 
-	/* The fragments might come in wrong order so place them in the reassembly chain in the
-	 * correct order.
-	 */
-	for (i = 0, found = false; i < CONFIG_NET_IPV4_FRAGMENT_MAX_PKT; i++) {
-		if (reass->pkt[i]) {
-			if (net_pkt_ipv4_fragment_offset(reass->pkt[i]) <
-			    net_pkt_ipv4_fragment_offset(pkt)) {
-				continue;
-			}
-
-			/* Make room for this fragment. If there is no room then it will discard
-			 * the whole reassembly.
-			 */
-			if (shift_packets(reass, i)) {
-				break;
-			}
-		}
-
-		LOG_DBG("Storing pkt %p to slot %d offset %d", pkt, i,
-			net_pkt_ipv4_fragment_offset(pkt));
-		reass->pkt[i] = pkt;
-		found = true;
-
-		break;
-	}
+	k_mutex_lock(&reassembly_lock, K_FOREVER);
 
-	if (!found) {
-		/* We could not add this fragment into our saved fragment list. The whole packet
-		 * must be discarded at this point.
-		 */
-		LOG_ERR("No slots available for 0x%x", reass->id);
-		net_pkt_unref(pkt);
+	reass = reassembly_get(id, (struct in_addr *)hdr->src,
+			       (struct in_addr *)hdr->dst, hdr->proto);
+	if (!reass) {
+		k_mutex_unlock(&reassembly_lock);
+		LOG_ERR("Cannot get reassembly slot, dropping pkt %p", pkt);
 		goto drop;
 	}
 
-	ret = fragments_are_ready(reass);
+	ret = fragment_insert(reass, pkt);
 	if (ret < 0) {
-		LOG_ERR("Reassembled IPv4 verify failed, dropping id %u", reass->id);
+		LOG_ERR("Reassembled IPv4 verify failed, dropping id %u (%d)", reass->id, ret);
 
-		/* Let the caller release the already inserted pkt */
-		if (i < CONFIG_NET_IPV4_FRAGMENT_MAX_PKT) {
-			reass->pkt[i] = NULL;
-		}
+		net_stats_update_ip_errors_fragerr(net_pkt_iface(pkt));
 
+		/* The fragment was not stored, release it with the others */
 		net_pkt_unref(pkt);
-		goto drop;
+		reassembly_cancel(reass);
 	} else if (ret == 0) {
 		reassembly_info("Reassembly nth pkt", reass);
 
 		LOG_DBG("More fragments to be received");
-		goto accept;
-	}
+	} else {
+		reassembly_info("Reassembly last pkt", reass);
 
-	reassembly_info("Reassembly last pkt", reass);
+		/* The last fragment received, reassemble the packet */
+		reassemble_packet(reass);
+	}
 
-	/* The last fragment received, reassemble the packet */
-	reassemble_packet(reass);
+	k_mutex_unlock(&reassembly_lock);
 
-accept:
 	return NET_OK;
 
 drop:
-	if (reass) {
-		if (reassembly_cancel(reass->id, &reass->src, &reass->dst)) {
-			return NET_OK;
-		}
-	}
+	net_stats_update_ip_errors_fragerr(net_pkt_iface(pkt));
 
 	return NET_DROP;
 }
@@ -687,5 +717,11 @@ void net_ipv4_setup_fragment_buffers(void)
 	 */
 	for (int i = 0; i < CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT; i++) {
 		k_work_init_delayable(&reassembly[i].timer, reassembly_timeout);
+
+		reassembly[i].next = (i + 1 < CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT) ?
+				     i + 1 : REASSEMBLY_NONE;
+		reassembly_hash[i] = REASSEMBLY_NONE;
 	}
+
+	reassembly_free = 0;
 }
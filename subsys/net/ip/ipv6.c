@@ -323,6 +323,20 @@ static enum net_verdict ipv6_route_packet(struct net_pkt *pkt,
 	struct in6_addr *nexthop;
 	bool found;
 
+	/* Packets of an already seen flow skip the route lookup */
+	if (IS_ENABLED(CONFIG_NET_ROUTE_FLOW_CACHE) && net_route_flow_lookup(pkt)) {
+		int ret;
+
+		ret = net_send_data(pkt);
+		if (ret < 0) {
+			NET_DBG("Cannot forward pkt %p at iface %p (%d)",
+				pkt, net_pkt_iface(pkt), ret);
+			goto drop;
+		}
+
+		return NET_OK;
+	}
+
 	/* Check if the packet can be routed */
 	if (IS_ENABLED(CONFIG_NET_ROUTING)) {
 		found = net_route_get_info(NULL, (struct in6_addr *)hdr->dst,
@@ -422,6 +422,18 @@ static inline void net_ipv6_nbr_set_reachable_timer(struct net_if *iface,
 #endif
 
 #if defined(CONFIG_NET_IPV6_FRAGMENT)
+/**
+ * Most fragment payload bytes held by all the pending IPv6 reassemblies.
+ * Unless configured, every reassembly may hold its largest number of
+ * fragments, each filling a 1500 byte frame, the largest supported MTU.
+ */
+#if CONFIG_NET_IPV6_FRAGMENT_MAX_BYTES > 0
+#define NET_IPV6_FRAGMENT_MAX_BYTES CONFIG_NET_IPV6_FRAGMENT_MAX_BYTES
+#else
+#define NET_IPV6_FRAGMENT_MAX_BYTES \
+	(CONFIG_NET_IPV6_FRAGMENT_MAX_COUNT * CONFIG_NET_IPV6_FRAGMENT_MAX_PKT * 1500)
+#endif
+
 /** Store pending IPv6 fragment information that is needed for reassembly. */
 struct net_ipv6_reassembly {
 	/** IPv6 source address of the fragment */
@@ -430,17 +442,26 @@ struct net_ipv6_reassembly {
 	/** IPv6 destination address of the fragment */
 	struct in6_addr dst;
 
-	/**
-	 * Timeout for cancelling the reassembly. The timer is used
-	 * also to detect if this reassembly slot is used or not.
-	 */
+	/** Timeout for cancelling the reassembly. */
 	struct k_work_delayable timer;
 
-	/** Pointers to pending fragments */
+	/** Pointers to pending fragments, sorted by fragment offset */
 	struct net_pkt *pkt[CONFIG_NET_IPV6_FRAGMENT_MAX_PKT];
 
+	/** Number of payload bytes received */
+	uint32_t received;
+
+	/** Payload length of the packet, zero until the last fragment is received */
+	uint32_t total;
+
 	/** IPv6 fragment identification */
 	uint32_t id;
+
+	/** Next reassembly in the same hash bucket or in the free list */
+	int16_t next;
+
+	/** Number of pending fragments */
+	uint8_t count;
 };
 #else
 struct net_ipv6_reassembly;
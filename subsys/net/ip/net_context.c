@@ -2293,6 +2293,7 @@ static void set_pkt_txtime(struct net_pkt *pkt, const struct msghdr *msghdr)
 static int context_sendto(struct net_context *context,
 			  const void *buf,
 			  size_t len,
+			  struct net_buf *frags,
 			  const struct sockaddr *dst_addr,
 			  socklen_t addrlen,
 			  net_context_send_cb_t cb,
@@ -2561,6 +2562,19 @@ static int context_sendto(struct net_context *context,
 		return -ENETDOWN;
 	}
 
+	if (frags != NULL) {
+		/* Caller provided buffers are only linked to a UDP packet,
+		 * other protocols need the data in their own buffers.
+		 */
+		if (!IS_ENABLED(CONFIG_NET_UDP) ||
+		    net_context_get_proto(context) != IPPROTO_UDP ||
+		    net_if_is_ip_offloaded(iface)) {
+			return -EOPNOTSUPP;
+		}
+
+		len = net_buf_frags_len(frags);
+	}
+
 	context->send_cb = cb;
 	context->user_data = user_data;
 
@@ -2570,14 +2584,20 @@ static int context_sendto(struct net_context *context,
 		goto skip_alloc;
 	}
 
-	pkt = context_alloc_pkt(context, family, len, PKT_WAIT_TIME);
+	pkt = context_alloc_pkt(context, family, frags ? 0 : len, PKT_WAIT_TIME);
 	if (!pkt) {
 		NET_ERR("Failed to allocate net_pkt");
 		return -ENOBUFS;
 	}
 
-	tmp_len = net_pkt_available_payload_buffer(
+	if (frags != NULL) {
+		tmp_len = net_if_get_mtu(net_pkt_iface(pkt)) -
+			  (family == AF_INET6 ? NET_IPV6UDPH_LEN : NET_IPV4UDPH_LEN);
+	} else {
+		tmp_len = net_pkt_available_payload_buffer(
 				pkt, net_context_get_proto(context));
+	}
+
 	if (tmp_len < len) {
 		if (net_context_get_type(context) == SOCK_DGRAM ||
 		    net_context_get_type(context) == SOCK_RAW) {
@@ -2640,10 +2660,23 @@ skip_alloc:
 		ret = net_try_send_data(pkt, timeout);
 	} else if (IS_ENABLED(CONFIG_NET_UDP) &&
 	    net_context_get_proto(context) == IPPROTO_UDP) {
-		ret = context_setup_udp_packet(context, family, pkt, buf, len, msghdr,
-					       dst_addr, addrlen);
-		if (ret < 0) {
-			goto fail;
+		if (frags != NULL) {
+			ret = context_setup_udp_packet(context, family, pkt, NULL, 0,
+						       NULL, dst_addr, addrlen);
+			if (ret < 0) {
+				goto fail;
+			}
+
+			/* The packet holds its own reference to the caller's
+			 * buffers, they are released once the packet is sent.
+			 */
+			net_pkt_append_buffer(pkt, net_buf_ref(frags));
+		} else {
+			ret = context_setup_udp_packet(context, family, pkt, buf, len,
+						       msghdr, dst_addr, addrlen);
+			if (ret < 0) {
+				goto fail;
+			}
 		}
 
 		context_finalize_packet(context, family, pkt);
@@ -2833,7 +2866,7 @@ int net_context_send(struct net_context *context,
 		}
 	}
 
-	ret = context_sendto(context, buf, len, &context->remote,
+	ret = context_sendto(context, buf, len, NULL, &context->remote,
 			     addrlen, cb, timeout, user_data, false);
 unlock:
 	k_mutex_unlock(&context->lock);
@@ -2852,7 +2885,7 @@ int net_context_sendmsg(struct net_context *context,
 
 	k_mutex_lock(&context->lock, K_FOREVER);
 
-	ret = context_sendto(context, msghdr, 0, NULL, 0,
+	ret = context_sendto(context, msghdr, 0, NULL, NULL, 0,
 			     cb, timeout, user_data, true);
 
 	k_mutex_unlock(&context->lock);
@@ -2873,7 +2906,7 @@ int net_context_sendto(struct net_context *context,
 
 	k_mutex_lock(&context->lock, K_FOREVER);
 
-	ret = context_sendto(context, buf, len, dst_addr, addrlen,
+	ret = context_sendto(context, buf, len, NULL, dst_addr, addrlen,
 			     cb, timeout, user_data, true);
 
 	k_mutex_unlock(&context->lock);
@@ -2881,6 +2914,40 @@ int net_context_sendto(struct net_context *context,
 	return ret;
 }
 
+int net_context_send_buf(struct net_context *context,
+			 struct net_buf *frags,
+			 const struct sockaddr *dst_addr,
+			 socklen_t addrlen,
+			 k_timeout_t timeout)
+{
+	int ret;
+
+	if (frags == NULL) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&context->lock, K_FOREVER);
+
+	if (dst_addr == NULL) {
+		if (!(context->flags & NET_CONTEXT_REMOTE_ADDR_SET) ||
+		    net_sin(&context->remote)->sin_port == 0) {
+			ret = -EDESTADDRREQ;
+			goto unlock;
+		}
+
+		dst_addr = &context->remote;
+		addrlen = net_context_get_family(context) == AF_INET6 ?
+			  sizeof(struct sockaddr_in6) : sizeof(struct sockaddr_in);
+	}
+
+	ret = context_sendto(context, NULL, 0, frags, dst_addr, addrlen,
+			     NULL, timeout, NULL, true);
+unlock:
+	k_mutex_unlock(&context->lock);
+
+	return ret;
+}
+
 enum net_verdict net_context_packet_received(struct net_conn *conn,
 					     struct net_pkt *pkt,
 					     union net_ip_header *ip_hdr,
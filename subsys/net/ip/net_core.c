@@ -518,7 +518,8 @@ void net_process_rx_packet(struct net_pkt *pkt)
 	net_rx(net_pkt_iface(pkt), pkt);
 }
 
-static void net_queue_rx(struct net_if *iface, struct net_pkt *pkt)
+static void net_queue_rx(struct net_if *iface, struct net_pkt *pkt,
+			 sys_slist_t *batch)
 {
 	size_t len = net_pkt_get_len(pkt);
 	uint8_t prio = net_pkt_priority(pkt);
@@ -531,6 +532,10 @@ static void net_queue_rx(struct net_if *iface, struct net_pkt *pkt)
 	if ((IS_ENABLED(CONFIG_NET_TC_RX_SKIP_FOR_HIGH_PRIO) &&
 	     prio >= NET_PRIORITY_CA) || NET_TC_RX_COUNT == 0) {
 		net_process_rx_packet(pkt);
+	} else if (batch != NULL) {
+		if (net_tc_add_to_rx_batch(tc, pkt, &batch[tc]) != NET_OK) {
+			goto drop;
+		}
 	} else {
 		if (net_tc_submit_to_rx_queue(tc, pkt) != NET_OK) {
 			goto drop;
@@ -548,8 +553,8 @@ drop:
 	return;
 }
 
-/* Called by driver when a packet has been received */
-int net_recv_data(struct net_if *iface, struct net_pkt *pkt)
+static int recv_data(struct net_if *iface, struct net_pkt *pkt,
+		     sys_slist_t *batch)
 {
 	int ret;
 #if defined(CONFIG_NET_DSA) && !defined(CONFIG_NET_DSA_DEPRECATED)
@@ -597,7 +602,7 @@ int net_recv_data(struct net_if *iface, struct net_pkt *pkt)
 		net_stats_update_filter_rx_drop(net_pkt_iface(pkt));
 		net_pkt_unref(pkt);
 	} else {
-		net_queue_rx(iface, pkt);
+		net_queue_rx(iface, pkt, batch);
 	}
 
 	ret = 0;
@@ -608,6 +613,51 @@ err:
 	return ret;
 }
 
+/* Called by driver when a packet has been received */
+int net_recv_data(struct net_if *iface, struct net_pkt *pkt)
+{
+	return recv_data(iface, pkt, NULL);
+}
+
+/* Called by driver when a batch of packets has been received */
+int net_recv_data_batch(struct net_if *iface, struct net_pkt **pkts,
+			size_t count)
+{
+	sys_slist_t batch[MAX(NET_TC_RX_COUNT, 1)];
+	int queued = 0;
+
+	if (!iface || !pkts) {
+		return -EINVAL;
+	}
+
+	if (!net_if_flag_is_set(iface, NET_IF_UP)) {
+		return -ENETDOWN;
+	}
+
+	for (int tc = 0; tc < ARRAY_SIZE(batch); tc++) {
+		sys_slist_init(&batch[tc]);
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		if (recv_data(iface, pkts[i], batch) < 0) {
+			if (pkts[i] != NULL) {
+				net_pkt_unref(pkts[i]);
+			}
+
+			continue;
+		}
+
+		queued++;
+	}
+
+	/* Queue the packets of each traffic class at once */
+	for (int tc = 0; tc < ARRAY_SIZE(batch); tc++) {
+		net_tc_submit_rx_batch(tc, &batch[tc]);
+	}
+
+	return queued;
+}
+
 static inline void l3_init(void)
 {
 	net_pmtu_init();
@@ -648,6 +698,15 @@ int net_recv_data(struct net_if *iface, struct net_pkt *pkt)
 
 	return -ENOTSUP;
 }
+int net_recv_data_batch(struct net_if *iface, struct net_pkt **pkts,
+			size_t count)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(pkts);
+	ARG_UNUSED(count);
+
+	return -ENOTSUP;
+}
 #endif /* CONFIG_NET_NATIVE */
 
 static void init_rx_queues(void)
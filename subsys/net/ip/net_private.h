@@ -206,6 +206,14 @@ static inline void net_tc_rx_init(void) { }
 enum net_verdict net_tc_try_submit_to_tx_queue(uint8_t tc, struct net_pkt *pkt,
 					       k_timeout_t timeout);
 extern enum net_verdict net_tc_submit_to_rx_queue(uint8_t tc, struct net_pkt *pkt);
+extern enum net_verdict net_tc_add_to_rx_batch(uint8_t tc, struct net_pkt *pkt,
+					       sys_slist_t *batch);
+extern void net_tc_submit_rx_batch(uint8_t tc, sys_slist_t *batch);
+#if defined(CONFIG_NET_QDISC)
+extern void net_qdisc_init(uint8_t tc, struct k_sem *slot);
+extern void net_qdisc_enqueue(uint8_t tc, struct net_pkt *pkt);
+extern struct net_pkt *net_qdisc_dequeue(uint8_t tc);
+#endif
 extern enum net_verdict net_promisc_mode_input(struct net_pkt *pkt);
 
 char *net_sprint_addr(sa_family_t af, const void *addr);
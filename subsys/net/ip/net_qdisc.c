@@ -0,0 +1,524 @@
+/** @file
+ * @brief Fair queueing and shaping of the transmitted packets.
+ */
+
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_tc, CONFIG_NET_TC_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/slist.h>
+
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_mgmt.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/net_qdisc.h>
+
+#include "net_private.h"
+#include "net_stats.h"
+
+/* Each TX traffic class has its own set of flow queues. The packets are
+ * hashed to a flow queue by their network context, or by their addresses
+ * for the packets without a context like the forwarded ones. The flows are
+ * served by deficit round robin as in FQ-CoDel (RFC 8290), the flows that
+ * just became active being served first. Sparse flows, like interactive or
+ * control traffic, are thus not delayed by the bulk flows. Each flow queue
+ * is managed by CoDel (RFC 8289), which drops packets from the flows having
+ * a standing queue.
+ *
+ * On top of that, the transmission rate of a network interface can be
+ * limited by a token bucket. The flows whose next packet goes to an
+ * interface without tokens are skipped until the bucket is refilled.
+ *
+ * A single lock protects all the traffic classes, as the shaper state of
+ * an interface is shared by them.
+ */
+
+struct qdisc_flow {
+	/** Node in the new or old flows list */
+	sys_snode_t node;
+
+	/** Queued packets, linked by their fifo field */
+	sys_slist_t queue;
+	uint16_t backlog;
+
+	int32_t deficit;
+
+	/** CoDel state */
+	uint32_t first_above_time;
+	uint32_t drop_next;
+	uint32_t drop_count;
+	uint32_t last_count;
+	bool dropping : 1;
+
+	/** Set if the flow is in the new or old flows list */
+	bool active : 1;
+};
+
+struct qdisc {
+	struct qdisc_flow flows[CONFIG_NET_QDISC_FLOWS];
+	sys_slist_t new_flows;
+	sys_slist_t old_flows;
+	int active_flows;
+
+	/** Given when a packet is queued or the parameters change */
+	struct k_sem wait;
+
+	/** Slots of the traffic class, released when a packet is dropped */
+	struct k_sem *slot;
+	uint8_t tc;
+};
+
+static struct qdisc qdiscs[NET_TC_TX_COUNT];
+static struct k_spinlock qdisc_lock;
+
+static inline bool time_after_eq(uint32_t a, uint32_t b)
+{
+	return (int32_t)(a - b) >= 0;
+}
+
+static void qdisc_params_set(struct net_if_qdisc *qd, const struct net_qdisc_params *params)
+{
+	qd->params = *params;
+	qd->target = k_us_to_cyc_ceil32(params->target);
+	qd->interval = k_us_to_cyc_ceil32(params->interval);
+	qd->tokens = params->burst;
+	qd->tokens_time = k_cycle_get_32();
+}
+
+/* The interfaces get the default parameters on first use */
+static struct net_if_qdisc *iface_qdisc(struct net_if *iface)
+{
+	struct net_if_qdisc *qd = &iface->qdisc;
+
+	if (qd->target == 0U) {
+		struct net_qdisc_params params = {
+			.target = CONFIG_NET_QDISC_TARGET,
+			.interval = CONFIG_NET_QDISC_INTERVAL,
+		};
+
+		qdisc_params_set(qd, &params);
+	}
+
+	return qd;
+}
+
+static uint32_t flow_hash(struct net_pkt *pkt)
+{
+	uint32_t hash = POINTER_TO_UINT(net_pkt_iface(pkt));
+	struct net_buf *buf = pkt->buffer;
+
+	if (net_pkt_context(pkt) != NULL) {
+		hash ^= POINTER_TO_UINT(net_pkt_context(pkt));
+	} else if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET &&
+		   buf != NULL && buf->len >= sizeof(struct net_ipv4_hdr)) {
+		struct net_ipv4_hdr *hdr = (struct net_ipv4_hdr *)buf->data;
+
+		hash ^= UNALIGNED_GET((uint32_t *)hdr->src) ^
+			UNALIGNED_GET((uint32_t *)hdr->dst) ^ hdr->proto;
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) && net_pkt_family(pkt) == AF_INET6 &&
+		   buf != NULL && buf->len >= sizeof(struct net_ipv6_hdr)) {
+		struct net_ipv6_hdr *hdr = (struct net_ipv6_hdr *)buf->data;
+
+		hash ^= UNALIGNED_GET((uint32_t *)&hdr->src[8]) ^
+			UNALIGNED_GET((uint32_t *)&hdr->src[12]) ^
+			UNALIGNED_GET((uint32_t *)&hdr->dst[8]) ^
+			UNALIGNED_GET((uint32_t *)&hdr->dst[12]) ^ hdr->nexthdr;
+	}
+
+	hash ^= hash >> 16;
+	hash ^= hash >> 8;
+
+	return hash % CONFIG_NET_QDISC_FLOWS;
+}
+
+/* Returns true if the interface has tokens left, otherwise updates the time
+ * to wait for the bucket to be refilled.
+ */
+static bool shaper_ready(struct net_if *iface, uint32_t now, uint32_t *wait)
+{
+	struct net_if_qdisc *qd = iface_qdisc(iface);
+	uint32_t hz = sys_clock_hw_cycles_per_sec();
+	uint32_t rate = qd->params.rate;
+	uint64_t refill, needed;
+	uint32_t elapsed;
+
+	if (rate == 0U) {
+		return true;
+	}
+
+	elapsed = now - qd->tokens_time;
+	refill = (uint64_t)elapsed * rate / hz;
+
+	if (refill > 0U) {
+		if ((int64_t)qd->tokens + refill >= qd->params.burst) {
+			qd->tokens = qd->params.burst;
+			qd->tokens_time = now;
+		} else {
+			/* Only account for the time of the whole bytes added */
+			qd->tokens += (int32_t)refill;
+			qd->tokens_time += (uint32_t)(refill * hz / rate);
+		}
+	}
+
+	if (qd->tokens > 0) {
+		return true;
+	}
+
+	needed = DIV_ROUND_UP((uint64_t)(1 - qd->tokens) * hz, rate);
+	elapsed = now - qd->tokens_time;
+	needed = (needed > elapsed) ? needed - elapsed : 1U;
+
+	if (*wait == 0U || needed < *wait) {
+		*wait = (uint32_t)MIN(needed, UINT32_MAX);
+	}
+
+	return false;
+}
+
+static struct net_pkt *codel_dodequeue(struct qdisc_flow *flow, uint32_t now, bool *ok_to_drop)
+{
+	struct net_if_qdisc *qd;
+	struct net_pkt *pkt;
+
+	*ok_to_drop = false;
+
+	pkt = (struct net_pkt *)sys_slist_get(&flow->queue);
+	if (pkt == NULL) {
+		flow->first_above_time = 0U;
+		return NULL;
+	}
+
+	flow->backlog--;
+	qd = iface_qdisc(net_pkt_iface(pkt));
+
+	/* A single packet cannot build a standing queue */
+	if (now - pkt->qdisc_time < qd->target || flow->backlog == 0U) {
+		flow->first_above_time = 0U;
+	} else if (flow->first_above_time == 0U) {
+		flow->first_above_time = (now + qd->interval) | 1U;
+	} else if (time_after_eq(now, flow->first_above_time)) {
+		*ok_to_drop = true;
+	}
+
+	return pkt;
+}
+
+static uint32_t codel_control_law(uint32_t t, uint32_t interval, uint32_t count)
+{
+	uint32_t root = 1U;
+
+	while ((root + 1U) * (root + 1U) <= count) {
+		root++;
+	}
+
+	return t + interval / root;
+}
+
+static struct net_pkt *codel_dequeue(struct qdisc_flow *flow, uint32_t now,
+				     sys_slist_t *dropped)
+{
+	struct net_pkt *pkt;
+	uint32_t interval;
+	bool ok_to_drop;
+
+	pkt = codel_dodequeue(flow, now, &ok_to_drop);
+
+	if (flow->dropping) {
+		if (!ok_to_drop) {
+			flow->dropping = false;
+		}
+
+		while (flow->dropping && time_after_eq(now, flow->drop_next)) {
+			interval = iface_qdisc(net_pkt_iface(pkt))->interval;
+			sys_slist_append(dropped, (sys_snode_t *)pkt);
+			flow->drop_count++;
+
+			pkt = codel_dodequeue(flow, now, &ok_to_drop);
+			if (!ok_to_drop) {
+				flow->dropping = false;
+			} else {
+				flow->drop_next = codel_control_law(flow->drop_next, interval,
+								    flow->drop_count);
+			}
+		}
+	} else if (ok_to_drop) {
+		uint32_t delta = flow->drop_count - flow->last_count;
+
+		interval = iface_qdisc(net_pkt_iface(pkt))->interval;
+		sys_slist_append(dropped, (sys_snode_t *)pkt);
+
+		pkt = codel_dodequeue(flow, now, &ok_to_drop);
+		flow->dropping = true;
+
+		/* Resume from the previous drop rate if the flow was dropping
+		 * packets recently.
+		 */
+		if (delta > 1U && (int32_t)(now - flow->drop_next) < 16 * (int64_t)interval) {
+			flow->drop_count = delta;
+		} else {
+			flow->drop_count = 1U;
+		}
+
+		flow->drop_next = codel_control_law(now, interval, flow->drop_count);
+		flow->last_count = flow->drop_count;
+	}
+
+	return pkt;
+}
+
+/* Charges the shaper of the interface for the packet being sent */
+static void shaper_charge(struct net_pkt *pkt)
+{
+	struct net_if *iface = net_pkt_iface(pkt);
+
+	if (iface_qdisc(iface)->params.rate > 0U) {
+		iface->qdisc.tokens -= (int32_t)net_pkt_get_len(pkt);
+	}
+}
+
+static struct net_pkt *qdisc_select(struct qdisc *q, sys_slist_t *dropped, uint32_t *wait)
+{
+	struct net_if *throttled = NULL;
+	uint32_t now = k_cycle_get_32();
+	struct qdisc_flow *flow;
+	struct net_if *head;
+	struct net_pkt *pkt;
+	sys_slist_t *list;
+	int skipped = 0;
+
+	*wait = 0U;
+
+	while (skipped < q->active_flows) {
+		list = &q->new_flows;
+		flow = SYS_SLIST_PEEK_HEAD_CONTAINER(list, flow, node);
+		if (flow == NULL) {
+			list = &q->old_flows;
+			flow = SYS_SLIST_PEEK_HEAD_CONTAINER(list, flow, node);
+		}
+
+		if (flow->deficit <= 0) {
+			flow->deficit += CONFIG_NET_QDISC_QUANTUM;
+			(void)sys_slist_get(list);
+			sys_slist_append(&q->old_flows, &flow->node);
+			skipped = 0;
+			continue;
+		}
+
+		pkt = (struct net_pkt *)sys_slist_peek_head(&flow->queue);
+		head = (pkt != NULL) ? net_pkt_iface(pkt) : NULL;
+
+		if (head != NULL && !shaper_ready(head, now, wait)) {
+			throttled = head;
+			(void)sys_slist_get(list);
+			sys_slist_append(&q->old_flows, &flow->node);
+			skipped++;
+			continue;
+		}
+
+		pkt = codel_dequeue(flow, now, dropped);
+
+		/* CoDel may have dropped the head, and the flows are shared by
+		 * the interfaces, so the packet returned can be for another
+		 * interface whose shaper is not ready yet.
+		 */
+		if (pkt != NULL && net_pkt_iface(pkt) != head &&
+		    !shaper_ready(net_pkt_iface(pkt), now, wait)) {
+			throttled = net_pkt_iface(pkt);
+			sys_slist_prepend(&flow->queue, (sys_snode_t *)pkt);
+			flow->backlog++;
+			(void)sys_slist_get(list);
+			sys_slist_append(&q->old_flows, &flow->node);
+			skipped++;
+			continue;
+		}
+		if (pkt == NULL) {
+			/* A new flow goes through the old flows list before
+			 * being removed, so that it cannot get the priority of
+			 * a new flow again right away.
+			 */
+			(void)sys_slist_get(list);
+
+			if (list == &q->new_flows && !sys_slist_is_empty(&q->old_flows)) {
+				sys_slist_append(&q->old_flows, &flow->node);
+			} else {
+				flow->active = false;
+				q->active_flows--;
+			}
+
+			skipped = 0;
+			continue;
+		}
+
+		flow->deficit -= net_pkt_get_len(pkt);
+		shaper_charge(pkt);
+
+		net_stats_update_qdisc_delay(net_pkt_iface(pkt), now - pkt->qdisc_time);
+
+		return pkt;
+	}
+
+	if (throttled != NULL) {
+		net_stats_update_qdisc_throttled(throttled);
+	}
+
+	return NULL;
+}
+
+static void qdisc_release(struct qdisc *q, sys_slist_t *dropped)
+{
+	struct net_pkt *pkt;
+	struct net_if *iface;
+
+	while ((pkt = (struct net_pkt *)sys_slist_get(dropped)) != NULL) {
+		iface = net_pkt_iface(pkt);
+
+		NET_DBG("TC %d dropping pkt %p", q->tc, pkt);
+
+		net_stats_update_qdisc_dropped(iface);
+		net_stats_update_tc_sent_dropped(iface, q->tc);
+#if defined(CONFIG_NET_POWER_MANAGEMENT)
+		iface->tx_pending--;
+#endif
+		net_pkt_unref(pkt);
+
+		if (q->slot != NULL) {
+			k_sem_give(q->slot);
+		}
+	}
+}
+
+void net_qdisc_enqueue(uint8_t tc, struct net_pkt *pkt)
+{
+	struct qdisc *q = &qdiscs[tc];
+	struct qdisc_flow *flow;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&qdisc_lock);
+
+	pkt->qdisc_time = k_cycle_get_32();
+
+	flow = &q->flows[flow_hash(pkt)];
+	sys_slist_append(&flow->queue, (sys_snode_t *)pkt);
+	flow->backlog++;
+
+	if (!flow->active) {
+		flow->active = true;
+		flow->deficit = CONFIG_NET_QDISC_QUANTUM;
+		sys_slist_append(&q->new_flows, &flow->node);
+		q->active_flows++;
+	}
+
+	k_spin_unlock(&qdisc_lock, key);
+
+	k_sem_give(&q->wait);
+}
+
+struct net_pkt *net_qdisc_dequeue(uint8_t tc)
+{
+	struct qdisc *q = &qdiscs[tc];
+	k_spinlock_key_t key;
+	sys_slist_t dropped;
+	struct net_pkt *pkt;
+	uint32_t wait;
+
+	sys_slist_init(&dropped);
+
+	while (true) {
+		key = k_spin_lock(&qdisc_lock);
+		pkt = qdisc_select(q, &dropped, &wait);
+		k_spin_unlock(&qdisc_lock, key);
+
+		qdisc_release(q, &dropped);
+
+		if (pkt != NULL) {
+			return pkt;
+		}
+
+		/* Wait for a new packet, or for the shaper to have tokens */
+		(void)k_sem_take(&q->wait, wait == 0U ? K_FOREVER : K_CYC(wait));
+	}
+}
+
+void net_qdisc_init(uint8_t tc, struct k_sem *slot)
+{
+	struct qdisc *q = &qdiscs[tc];
+
+	memset(q, 0, sizeof(*q));
+
+	sys_slist_init(&q->new_flows);
+	sys_slist_init(&q->old_flows);
+	k_sem_init(&q->wait, 0, 1);
+
+	for (int i = 0; i < ARRAY_SIZE(q->flows); i++) {
+		sys_slist_init(&q->flows[i].queue);
+	}
+
+	q->slot = slot;
+	q->tc = tc;
+}
+
+static int qdisc_set_params(uint32_t mgmt_request, struct net_if *iface,
+			    void *data, size_t len)
+{
+	struct net_qdisc_params *params = data;
+	k_spinlock_key_t key;
+
+	ARG_UNUSED(mgmt_request);
+
+	if (iface == NULL || params == NULL || len != sizeof(*params)) {
+		return -EINVAL;
+	}
+
+	/* Longer intervals might not fit the cycle counter */
+	if (params->target == 0U || params->interval < params->target ||
+	    params->interval > USEC_PER_SEC ||
+	    params->burst > INT32_MAX || (params->rate > 0U && params->burst == 0U)) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&qdisc_lock);
+	qdisc_params_set(&iface->qdisc, params);
+	k_spin_unlock(&qdisc_lock, key);
+
+	NET_DBG("iface %d rate %u burst %u target %u interval %u",
+		net_if_get_by_iface(iface), params->rate, params->burst,
+		params->target, params->interval);
+
+	/* Throttled flows might be allowed to send now */
+	for (int i = 0; i < ARRAY_SIZE(qdiscs); i++) {
+		k_sem_give(&qdiscs[i].wait);
+	}
+
+	return 0;
+}
+
+NET_MGMT_REGISTER_REQUEST_HANDLER(NET_REQUEST_QDISC_SET_PARAMS, qdisc_set_params);
+
+static int qdisc_get_params(uint32_t mgmt_request, struct net_if *iface,
+			    void *data, size_t len)
+{
+	struct net_qdisc_params *params = data;
+	k_spinlock_key_t key;
+
+	ARG_UNUSED(mgmt_request);
+
+	if (iface == NULL || params == NULL || len != sizeof(*params)) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&qdisc_lock);
+	*params = iface_qdisc(iface)->params;
+	k_spin_unlock(&qdisc_lock, key);
+
+	return 0;
+}
+
+NET_MGMT_REGISTER_REQUEST_HANDLER(NET_REQUEST_QDISC_GET_PARAMS, qdisc_get_params);
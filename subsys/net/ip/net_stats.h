@@ -48,6 +48,11 @@ static inline void net_stats_update_ip_errors_vhlerr(struct net_if *iface)
 	UPDATE_STAT(iface, stats.ip_errors.vhlerr++);
 }
 
+static inline void net_stats_update_ip_errors_fragerr(struct net_if *iface)
+{
+	UPDATE_STAT(iface, stats.ip_errors.fragerr++);
+}
+
 static inline void net_stats_update_bytes_recv(struct net_if *iface,
 					       uint32_t bytes)
 {
@@ -102,6 +107,7 @@ static inline void net_stats_update_filter_rx_local_drop(struct net_if *iface)
 #define net_stats_update_processing_error(iface)
 #define net_stats_update_ip_errors_protoerr(iface)
 #define net_stats_update_ip_errors_vhlerr(iface)
+#define net_stats_update_ip_errors_fragerr(iface)
 #define net_stats_update_bytes_recv(iface, bytes)
 #define net_stats_update_bytes_sent(iface, bytes)
 #define net_stats_update_filter_rx_drop(iface)
@@ -456,6 +462,48 @@ static inline void net_stats_update_dns_drop(struct net_if *iface)
 #define net_stats_update_dns_drop(iface)
 #endif /* CONFIG_NET_STATISTICS_DNS */
 
+#if defined(CONFIG_NET_TC_RX_RPS) && defined(CONFIG_NET_STATISTICS) \
+	&& defined(CONFIG_NET_NATIVE)
+static inline void net_stats_update_rps_pkt(struct net_if *iface,
+					    unsigned int cpu)
+{
+	UPDATE_STAT(iface, stats.rps.pkts[cpu]++);
+}
+#else
+#define net_stats_update_rps_pkt(iface, cpu)
+#endif /* CONFIG_NET_TC_RX_RPS && CONFIG_NET_STATISTICS */
+
+#if defined(CONFIG_NET_QDISC) && defined(CONFIG_NET_STATISTICS) \
+	&& defined(CONFIG_NET_NATIVE)
+static inline void net_stats_update_qdisc_delay(struct net_if *iface,
+						uint32_t cycles)
+{
+	uint32_t delay = k_cyc_to_us_floor32(cycles);
+
+	UPDATE_STAT(iface, stats.qdisc.delay_sum += delay);
+	UPDATE_STAT(iface, stats.qdisc.count++);
+
+	UPDATE_STAT_GLOBAL(stats.qdisc.delay_max =
+			   MAX(net_stats.qdisc.delay_max, delay));
+	SET_STAT(iface->stats.qdisc.delay_max =
+		 MAX(iface->stats.qdisc.delay_max, delay));
+}
+
+static inline void net_stats_update_qdisc_dropped(struct net_if *iface)
+{
+	UPDATE_STAT(iface, stats.qdisc.dropped++);
+}
+
+static inline void net_stats_update_qdisc_throttled(struct net_if *iface)
+{
+	UPDATE_STAT(iface, stats.qdisc.throttled++);
+}
+#else
+#define net_stats_update_qdisc_delay(iface, cycles)
+#define net_stats_update_qdisc_dropped(iface)
+#define net_stats_update_qdisc_throttled(iface)
+#endif /* CONFIG_NET_QDISC && CONFIG_NET_STATISTICS */
+
 #if defined(CONFIG_NET_PKT_TXTIME_STATS) && defined(CONFIG_NET_STATISTICS)
 static inline void net_stats_update_tx_time(struct net_if *iface,
 					    uint32_t start_time,
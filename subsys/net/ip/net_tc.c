@@ -13,6 +13,7 @@ LOG_MODULE_REGISTER(net_tc, CONFIG_NET_TC_LOG_LEVEL);
 #include <zephyr/net/net_core.h>
 #include <zephyr/net/net_pkt.h>
 #include <zephyr/net/net_stats.h>
+#include <zephyr/net/ethernet.h>
 
 #include "net_private.h"
 #include "net_stats.h"
@@ -46,15 +47,28 @@ BUILD_ASSERT(NET_TC_TX_SLOTS > 0,
 /* Template for thread name. The "xx" is either "TX" denoting transmit thread,
  * or "RX" denoting receive thread. The "q[y]" denotes the traffic class queue
  * where y indicates the traffic class id. The value of y can be from 0 to 7.
+ * With receive packet steering, the "/zz" suffix denotes the CPU of the RX
+ * queue.
  */
-#define MAX_NAME_LEN sizeof("xx_q[y]")
+#define MAX_NAME_LEN sizeof("xx_q[y]/zz")
+
+/* With receive packet steering, each RX traffic class has one queue and
+ * thread per CPU. The first queue of a class holds the slots of the class.
+ */
+#if defined(CONFIG_NET_TC_RX_RPS)
+#define NET_TC_RX_CPUS CONFIG_MP_MAX_NUM_CPUS
+#else
+#define NET_TC_RX_CPUS 1
+#endif
+
+#define NET_TC_RX_QUEUES (NET_TC_RX_COUNT * NET_TC_RX_CPUS)
 
 /* Stacks for TX work queue */
 K_KERNEL_STACK_ARRAY_DEFINE(tx_stack, NET_TC_TX_COUNT,
 			    CONFIG_NET_TX_STACK_SIZE);
 
 /* Stacks for RX work queue */
-K_KERNEL_STACK_ARRAY_DEFINE(rx_stack, NET_TC_RX_COUNT,
+K_KERNEL_STACK_ARRAY_DEFINE(rx_stack, NET_TC_RX_QUEUES,
 			    CONFIG_NET_RX_STACK_SIZE);
 
 #if NET_TC_TX_COUNT > 0
@@ -62,7 +76,109 @@ static struct net_traffic_class tx_classes[NET_TC_TX_COUNT];
 #endif
 
 #if NET_TC_RX_COUNT > 0
-static struct net_traffic_class rx_classes[NET_TC_RX_COUNT];
+static struct net_traffic_class rx_classes[NET_TC_RX_QUEUES];
+
+#define RX_CLASS(tc) (&rx_classes[(tc) * NET_TC_RX_CPUS])
+#endif
+
+#if defined(CONFIG_NET_TC_RX_RPS)
+/* Hash the addresses and the ports of the packet, so that all the packets
+ * of a flow are processed in order by the same CPU. Only the interfaces whose
+ * link layer header is known are parsed, the packets of the other interfaces
+ * and the packets that cannot be parsed from the first buffer are all
+ * processed by the first CPU.
+ */
+static uint32_t rx_flow_hash(struct net_pkt *pkt)
+{
+	const struct net_l2 *l2 = net_if_l2(net_pkt_iface(pkt));
+	const uint8_t *data = pkt->buffer->data;
+	size_t len = pkt->buffer->len;
+	size_t hdr_len;
+	uint32_t hash;
+	uint8_t proto;
+
+	if (IS_ENABLED(CONFIG_NET_L2_ETHERNET) && l2 == &NET_L2_GET_NAME(ETHERNET)) {
+		uint16_t type;
+
+		if (len < sizeof(struct net_eth_hdr)) {
+			return 0U;
+		}
+
+		type = UNALIGNED_GET(&((struct net_eth_hdr *)data)->type);
+		hdr_len = sizeof(struct net_eth_hdr);
+
+		if (type == htons(NET_ETH_PTYPE_VLAN)) {
+			if (len < sizeof(struct net_eth_vlan_hdr)) {
+				return 0U;
+			}
+
+			type = UNALIGNED_GET(&((struct net_eth_vlan_hdr *)data)->type);
+			hdr_len = sizeof(struct net_eth_vlan_hdr);
+		}
+
+		if (type != htons(NET_ETH_PTYPE_IP) && type != htons(NET_ETH_PTYPE_IPV6)) {
+			return 0U;
+		}
+
+		data += hdr_len;
+		len -= hdr_len;
+	} else if (!IS_ENABLED(CONFIG_NET_L2_DUMMY) || l2 != &NET_L2_GET_NAME(DUMMY)) {
+		return 0U;
+	}
+
+	if (len >= NET_IPV4H_LEN && (data[0] >> 4) == 4) {
+		hash = UNALIGNED_GET((uint32_t *)&data[12]) ^
+		       UNALIGNED_GET((uint32_t *)&data[16]);
+		hdr_len = (data[0] & 0x0f) * 4U;
+		proto = data[9];
+
+		/* Only the first fragment has the ports, so all the fragments
+		 * of a datagram, the first one included, are hashed on the
+		 * addresses and the protocol only to keep them together.
+		 */
+		if (UNALIGNED_GET((uint16_t *)&data[6]) & htons(NET_IPV4_MORE_FRAG_MASK |
+								 NET_IPV4_FRAGH_OFFSET_MASK)) {
+			hash ^= proto;
+			proto = IPPROTO_IP;
+		}
+	} else if (len >= NET_IPV6H_LEN && (data[0] >> 4) == 6) {
+		hash = UNALIGNED_GET((uint32_t *)&data[16]) ^
+		       UNALIGNED_GET((uint32_t *)&data[20]) ^
+		       UNALIGNED_GET((uint32_t *)&data[32]) ^
+		       UNALIGNED_GET((uint32_t *)&data[36]);
+		hdr_len = NET_IPV6H_LEN;
+		proto = data[6];
+	} else {
+		return 0U;
+	}
+
+	if ((proto == IPPROTO_TCP || proto == IPPROTO_UDP) && len >= hdr_len + 4U) {
+		hash ^= UNALIGNED_GET((uint32_t *)&data[hdr_len]);
+	}
+
+	hash ^= hash >> 16;
+	hash ^= hash >> 8;
+
+	return hash;
+}
+#endif
+
+#if NET_TC_RX_COUNT > 0
+/* RX queue of the traffic class the packet is to be processed by */
+static struct net_traffic_class *rx_queue(uint8_t tc, struct net_pkt *pkt)
+{
+#if defined(CONFIG_NET_TC_RX_RPS)
+	unsigned int cpu = rx_flow_hash(pkt) % arch_num_cpus();
+
+	net_stats_update_rps_pkt(net_pkt_iface(pkt), cpu);
+
+	return &RX_CLASS(tc)[cpu];
+#else
+	ARG_UNUSED(pkt);
+
+	return RX_CLASS(tc);
+#endif
+}
 #endif
 
 enum net_verdict net_tc_try_submit_to_tx_queue(uint8_t tc, struct net_pkt *pkt,
@@ -77,7 +193,11 @@ enum net_verdict net_tc_try_submit_to_tx_queue(uint8_t tc, struct net_pkt *pkt,
 	}
 #endif
 
+#if defined(CONFIG_NET_QDISC)
+	net_qdisc_enqueue(tc, pkt);
+#else
 	k_fifo_put(&tx_classes[tc].fifo, pkt);
+#endif
 	return NET_OK;
 #else
 	ARG_UNUSED(tc);
@@ -95,7 +215,7 @@ enum net_verdict net_tc_submit_to_rx_queue(uint8_t tc, struct net_pkt *pkt)
 	net_pkt_set_rx_stats_tick(pkt, k_cycle_get_32());
 
 #if NET_TC_RX_EFFECTIVE_COUNT > 1
-	while (k_sem_take(&rx_classes[tc].fifo_slot, K_NO_WAIT) != 0) {
+	while (k_sem_take(&RX_CLASS(tc)->fifo_slot, K_NO_WAIT) != 0) {
 		if (k_is_in_isr() || retry_cnt == 0) {
 			return NET_DROP;
 		}
@@ -108,7 +228,7 @@ enum net_verdict net_tc_submit_to_rx_queue(uint8_t tc, struct net_pkt *pkt)
 	}
 #endif
 
-	k_fifo_put(&rx_classes[tc].fifo, pkt);
+	k_fifo_put(&rx_queue(tc, pkt)->fifo, pkt);
 	return NET_OK;
 #else
 	ARG_UNUSED(tc);
@@ -117,6 +237,67 @@ enum net_verdict net_tc_submit_to_rx_queue(uint8_t tc, struct net_pkt *pkt)
 #endif
 }
 
+/* Reserve a slot in the RX queue for the packet and add it to the batch. The
+ * batch is queued at once by net_tc_submit_rx_batch(), so that the handler
+ * thread is woken up only once for the whole batch.
+ */
+enum net_verdict net_tc_add_to_rx_batch(uint8_t tc, struct net_pkt *pkt,
+					sys_slist_t *batch)
+{
+#if NET_TC_RX_COUNT > 0
+	net_pkt_set_rx_stats_tick(pkt, k_cycle_get_32());
+
+#if NET_TC_RX_EFFECTIVE_COUNT > 1
+	if (k_sem_take(&RX_CLASS(tc)->fifo_slot, K_NO_WAIT) != 0) {
+		return NET_DROP;
+	}
+#endif
+
+	/* The first word of the packet is reserved for the fifo */
+	sys_slist_append(batch, (sys_snode_t *)pkt);
+	return NET_OK;
+#else
+	ARG_UNUSED(tc);
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(batch);
+	return NET_DROP;
+#endif
+}
+
+void net_tc_submit_rx_batch(uint8_t tc, sys_slist_t *batch)
+{
+#if defined(CONFIG_NET_TC_RX_RPS)
+	sys_slist_t queues[NET_TC_RX_CPUS];
+	sys_snode_t *node;
+	int cpu;
+
+	for (cpu = 0; cpu < NET_TC_RX_CPUS; cpu++) {
+		sys_slist_init(&queues[cpu]);
+	}
+
+	/* Split the batch per CPU, keeping the order of the packets */
+	while ((node = sys_slist_get(batch)) != NULL) {
+		cpu = rx_queue(tc, (struct net_pkt *)node) - RX_CLASS(tc);
+		sys_slist_append(&queues[cpu], node);
+	}
+
+	for (cpu = 0; cpu < NET_TC_RX_CPUS; cpu++) {
+		if (!sys_slist_is_empty(&queues[cpu])) {
+			k_fifo_put_slist(&RX_CLASS(tc)[cpu].fifo, &queues[cpu]);
+		}
+	}
+#elif NET_TC_RX_COUNT > 0
+	if (sys_slist_is_empty(batch)) {
+		return;
+	}
+
+	k_fifo_put_slist(&RX_CLASS(tc)->fifo, batch);
+#else
+	ARG_UNUSED(tc);
+	ARG_UNUSED(batch);
+#endif
+}
+
 int net_tx_priority2tc(enum net_priority prio)
 {
 #if NET_TC_TX_COUNT > 0
@@ -315,9 +496,15 @@ static void tc_rx_handler(void *p1, void *p2, void *p3)
 #if NET_TC_TX_COUNT > 0
 static void tc_tx_handler(void *p1, void *p2, void *p3)
 {
-	ARG_UNUSED(p3);
+#if defined(CONFIG_NET_QDISC)
+	uint8_t tc = POINTER_TO_UINT(p3);
 
+	ARG_UNUSED(p1);
+#else
 	struct k_fifo *fifo = p1;
+
+	ARG_UNUSED(p3);
+#endif
 #if NET_TC_TX_EFFECTIVE_COUNT > 1
 	struct k_sem *fifo_slot = p2;
 #else
@@ -326,7 +513,11 @@ static void tc_tx_handler(void *p1, void *p2, void *p3)
 	struct net_pkt *pkt;
 
 	while (1) {
+#if defined(CONFIG_NET_QDISC)
+		pkt = net_qdisc_dequeue(tc);
+#else
 		pkt = k_fifo_get(fifo, K_FOREVER);
+#endif
 		if (pkt == NULL) {
 			continue;
 		}
@@ -383,6 +574,12 @@ void net_tc_tx_init(void)
 		k_sem_init(&tx_classes[i].fifo_slot, NET_TC_TX_SLOTS, NET_TC_TX_SLOTS);
 #endif
 
+#if defined(CONFIG_NET_QDISC) && NET_TC_TX_EFFECTIVE_COUNT > 1
+		net_qdisc_init(i, &tx_classes[i].fifo_slot);
+#elif defined(CONFIG_NET_QDISC)
+		net_qdisc_init(i, NULL);
+#endif
+
 		tid = k_thread_create(&tx_classes[i].handler, tx_stack[i],
 				      K_KERNEL_STACK_SIZEOF(tx_stack[i]),
 				      tc_tx_handler,
@@ -392,7 +589,7 @@ void net_tc_tx_init(void)
 #else
 				      NULL,
 #endif
-				      NULL,
+				      UINT_TO_POINTER(i),
 				      priority, 0, K_FOREVER);
 		if (!tid) {
 			NET_ERR("Cannot create TC handler thread %d", i);
@@ -425,12 +622,19 @@ void net_tc_rx_init(void)
 	net_if_foreach(net_tc_rx_stats_priority_setup, NULL);
 #endif
 
-	for (i = 0; i < NET_TC_RX_COUNT; i++) {
+	for (i = 0; i < NET_TC_RX_QUEUES; i++) {
+		uint8_t tc = i / NET_TC_RX_CPUS;
+		unsigned int cpu = i % NET_TC_RX_CPUS;
 		uint8_t thread_priority;
 		int priority;
 		k_tid_t tid;
 
-		thread_priority = rx_tc2thread(i);
+		/* No queue for the CPUs that are not present */
+		if (cpu >= arch_num_cpus()) {
+			continue;
+		}
+
+		thread_priority = rx_tc2thread(tc);
 
 		priority = IS_ENABLED(CONFIG_NET_TC_THREAD_COOPERATIVE) ?
 			K_PRIO_COOP(thread_priority) :
@@ -448,7 +652,9 @@ void net_tc_rx_init(void)
 		k_fifo_init(&rx_classes[i].fifo);
 
 #if NET_TC_RX_EFFECTIVE_COUNT > 1
-		k_sem_init(&rx_classes[i].fifo_slot, NET_TC_RX_SLOTS, NET_TC_RX_SLOTS);
+		if (cpu == 0) {
+			k_sem_init(&rx_classes[i].fifo_slot, NET_TC_RX_SLOTS, NET_TC_RX_SLOTS);
+		}
 #endif
 
 		tid = k_thread_create(&rx_classes[i].handler, rx_stack[i],
@@ -456,7 +662,7 @@ void net_tc_rx_init(void)
 				      tc_rx_handler,
 				      &rx_classes[i].fifo,
 #if NET_TC_RX_EFFECTIVE_COUNT > 1
-				      &rx_classes[i].fifo_slot,
+				      &RX_CLASS(tc)->fifo_slot,
 #else
 				      NULL,
 #endif
@@ -467,10 +673,21 @@ void net_tc_rx_init(void)
 			continue;
 		}
 
+#if defined(CONFIG_NET_TC_RX_RPS)
+		if (k_thread_cpu_pin(tid, cpu) < 0) {
+			NET_ERR("Cannot pin TC handler thread %d to CPU %u", tc, cpu);
+		}
+#endif
+
 		if (IS_ENABLED(CONFIG_THREAD_NAME)) {
 			char name[MAX_NAME_LEN];
 
-			snprintk(name, sizeof(name), "rx_q[%d]", i);
+			if (IS_ENABLED(CONFIG_NET_TC_RX_RPS)) {
+				snprintk(name, sizeof(name), "rx_q[%d]/%u", tc, cpu);
+			} else {
+				snprintk(name, sizeof(name), "rx_q[%d]", tc);
+			}
+
 			k_thread_name_set(tid, name);
 		}
 
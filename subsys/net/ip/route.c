@@ -267,15 +267,13 @@ static inline void update_route_access(struct net_route_entry *route)
 	sys_slist_prepend(&routes, &route->node);
 }
 
-struct net_route_entry *net_route_lookup(struct net_if *iface,
-					 struct in6_addr *dst)
+static struct net_route_entry *route_lookup_linear(struct net_if *iface,
+						  struct in6_addr *dst)
 {
 	struct net_route_entry *route, *found = NULL;
 	uint8_t longest_match = 0U;
 	int i;
 
-	net_ipv6_nbr_lock();
-
 	for (i = 0; i < CONFIG_NET_MAX_ROUTES && longest_match < 128; i++) {
 		struct net_nbr *nbr = get_nbr(i);
 
@@ -298,6 +296,22 @@ struct net_route_entry *net_route_lookup(struct net_if *iface,
 		}
 	}
 
+	return found;
+}
+
+struct net_route_entry *net_route_lookup(struct net_if *iface,
+					 struct in6_addr *dst)
+{
+	struct net_route_entry *found;
+
+	net_ipv6_nbr_lock();
+
+	if (IS_ENABLED(CONFIG_NET_ROUTE_TRIE)) {
+		found = net_route_trie_lookup(iface, dst);
+	} else {
+		found = route_lookup_linear(iface, dst);
+	}
+
 	if (found) {
 		net_route_info("Found", found, dst);
 
@@ -442,6 +456,18 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 	route->iface = iface;
 	route->preference = preference;
 
+	if (IS_ENABLED(CONFIG_NET_ROUTE_TRIE) && net_route_trie_add(route) < 0) {
+		NET_ERR("No route trie node available!");
+		release_nexthop_route(nexthop_route);
+		nbr_free(nbr);
+		route = NULL;
+		goto exit;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_ROUTE_FLOW_CACHE)) {
+		net_route_flow_flush();
+	}
+
 	net_route_update_lifetime(route, lifetime);
 
 	sys_slist_prepend(&routes, &route->node);
@@ -596,6 +622,14 @@ int net_route_del(struct net_route_entry *route)
 
 	net_route_info("Deleted", route, &route->addr);
 
+	if (IS_ENABLED(CONFIG_NET_ROUTE_TRIE)) {
+		net_route_trie_del(route);
+	}
+
+	if (IS_ENABLED(CONFIG_NET_ROUTE_FLOW_CACHE)) {
+		net_route_flow_flush();
+	}
+
 	SYS_SLIST_FOR_EACH_CONTAINER(&route->nexthop, nexthop_route, node) {
 		if (!nexthop_route->nbr) {
 			continue;
@@ -1075,6 +1109,11 @@ int net_route_packet(struct net_pkt *pkt, struct in6_addr *nexthop)
 
 	net_pkt_set_forwarding(pkt, true);
 
+	if (IS_ENABLED(CONFIG_NET_ROUTE_FLOW_CACHE)) {
+		net_route_flow_add(pkt, nbr, is_ll_addr_supported(net_pkt_iface(pkt)),
+				   lladdr != NULL);
+	}
+
 	/* Set the source ll address of the iface (if relevant) and the
 	 * destination address to be the nexthop recipient.
 	 */
@@ -1131,5 +1170,13 @@ void net_route_init(void)
 #if defined(CONFIG_NET_ROUTE_MCAST)
 	memset(route_mcast_entries, 0, sizeof(route_mcast_entries));
 #endif
+	if (IS_ENABLED(CONFIG_NET_ROUTE_TRIE)) {
+		net_route_trie_init();
+	}
+
+	if (IS_ENABLED(CONFIG_NET_ROUTE_FLOW_CACHE)) {
+		net_route_flow_init();
+	}
+
 	k_work_init_delayable(&route_lifetime_timer, route_lifetime_timeout);
 }
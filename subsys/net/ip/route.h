@@ -68,6 +68,13 @@ struct net_route_entry {
 
 	/** Is the route valid forever */
 	uint8_t is_infinite : 1;
+
+#if defined(CONFIG_NET_ROUTE_TRIE)
+	/** Node in the list of routes having the same prefix in the
+	 * route lookup trie.
+	 */
+	sys_snode_t trie_node;
+#endif
 };
 
 /* Route preference values, as defined in RFC 4191 */
@@ -328,6 +335,34 @@ int net_route_packet(struct net_pkt *pkt, struct in6_addr *nexthop);
  */
 int net_route_packet_if(struct net_pkt *pkt, struct net_if *iface);
 
+/* Route lookup trie, called with the IPv6 neighbor lock held */
+int net_route_trie_add(struct net_route_entry *route);
+void net_route_trie_del(struct net_route_entry *route);
+struct net_route_entry *net_route_trie_lookup(struct net_if *iface,
+					      const struct in6_addr *dst);
+void net_route_trie_init(void);
+
+/**
+ * @brief Prepare a packet for forwarding using the flow cache.
+ *
+ * @details If the forwarding decision for the packet flow is cached, the
+ * interface and link layer addresses of the packet are set as
+ * net_route_packet() would have done, and the packet can be passed
+ * directly to net_send_data().
+ *
+ * @param pkt Network packet received for another host.
+ *
+ * @return True if the packet was prepared, false if the flow is not cached
+ * in which case the packet is not modified.
+ */
+bool net_route_flow_lookup(struct net_pkt *pkt);
+
+/* Route flow cache, called with the IPv6 neighbor lock held */
+void net_route_flow_add(struct net_pkt *pkt, struct net_nbr *nbr, bool set_src_lladdr,
+			bool set_dst_lladdr);
+void net_route_flow_flush(void);
+void net_route_flow_init(void);
+
 #if defined(CONFIG_NET_ROUTE) && defined(CONFIG_NET_NATIVE)
 void net_route_init(void);
 #else
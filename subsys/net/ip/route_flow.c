@@ -0,0 +1,213 @@
+/** @file
+ * @brief Flow cache for forwarded IPv6 packets.
+ */
+
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_route, CONFIG_NET_ROUTE_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_mgmt.h>
+#include <zephyr/net/net_pkt.h>
+
+#include "net_private.h"
+#include "ipv6.h"
+#include "nbr.h"
+#include "route.h"
+
+/* The flow cache remembers the forwarding decision taken for a source and
+ * destination address pair received on a given interface, so that the next
+ * packets of the flow skip the neighbor, route and default router lookups.
+ *
+ * The cache is direct mapped. The entries reference the next hop neighbor
+ * which is validated on every hit, so a removed or reused neighbor, or a
+ * changed link layer address, is noticed without any notification. Changes
+ * that affect the routing decision itself invalidate the whole cache by
+ * bumping the generation counter.
+ *
+ * net_route_flow_add() and net_route_flow_flush() are called with the IPv6
+ * neighbor lock held.
+ */
+
+struct route_flow {
+	struct in6_addr src;
+	struct in6_addr dst;
+	struct in6_addr nexthop;
+
+	/** Interface the packets of the flow are received on */
+	struct net_if *iface;
+
+	/** Interface of the route, used for the source link layer address */
+	struct net_if *route_iface;
+
+	struct net_nbr *nbr;
+	uint32_t gen;
+
+	/** Set the link layer addresses when forwarding */
+	bool set_src_lladdr : 1;
+	bool set_dst_lladdr : 1;
+};
+
+static struct route_flow flow_cache[CONFIG_NET_ROUTE_FLOW_CACHE_SIZE];
+
+/* Generation 0 marks unused entries */
+static uint32_t flow_gen = 1U;
+
+static struct net_mgmt_event_callback flow_mgmt_cb;
+
+/* The addresses are taken from the packet header, so they might not be aligned */
+static struct route_flow *flow_entry(struct net_if *iface, const uint8_t *src,
+				     const uint8_t *dst)
+{
+	uint32_t hash = UNALIGNED_GET((uint32_t *)&src[8]) ^ UNALIGNED_GET((uint32_t *)&src[12]) ^
+			UNALIGNED_GET((uint32_t *)&dst[8]) ^ UNALIGNED_GET((uint32_t *)&dst[12]) ^
+			POINTER_TO_UINT(iface);
+
+	hash ^= hash >> 16;
+	hash ^= hash >> 8;
+
+	return &flow_cache[hash % CONFIG_NET_ROUTE_FLOW_CACHE_SIZE];
+}
+
+void net_route_flow_add(struct net_pkt *pkt, struct net_nbr *nbr, bool set_src_lladdr,
+			bool set_dst_lladdr)
+{
+	struct net_ipv6_hdr *hdr = NET_IPV6_HDR(pkt);
+	struct net_if *iface = net_pkt_orig_iface(pkt);
+	struct route_flow *flow;
+
+	flow = flow_entry(iface, hdr->src, hdr->dst);
+
+	net_ipv6_addr_copy_raw(flow->src.s6_addr, hdr->src);
+	net_ipv6_addr_copy_raw(flow->dst.s6_addr, hdr->dst);
+	net_ipaddr_copy(&flow->nexthop, &net_ipv6_nbr_data(nbr)->addr);
+	flow->iface = iface;
+	flow->route_iface = net_pkt_iface(pkt);
+	flow->nbr = nbr;
+	flow->set_src_lladdr = set_src_lladdr;
+	flow->set_dst_lladdr = set_dst_lladdr;
+	flow->gen = flow_gen;
+
+	NET_DBG("Cached flow %s -> %s via %s",
+		net_sprint_ipv6_addr(&flow->src),
+		net_sprint_ipv6_addr(&flow->dst),
+		net_sprint_ipv6_addr(&flow->nexthop));
+}
+
+static struct route_flow *flow_find(struct net_pkt *pkt)
+{
+	struct net_ipv6_hdr *hdr = NET_IPV6_HDR(pkt);
+	struct net_if *iface = net_pkt_iface(pkt);
+	struct route_flow *flow;
+
+	flow = flow_entry(iface, hdr->src, hdr->dst);
+
+	if (flow->gen != flow_gen || flow->iface != iface ||
+	    !net_ipv6_addr_cmp_raw(flow->dst.s6_addr, hdr->dst) ||
+	    !net_ipv6_addr_cmp_raw(flow->src.s6_addr, hdr->src)) {
+		return NULL;
+	}
+
+	/* The neighbor entry might have been released or reused */
+	if (flow->nbr->ref == 0U ||
+	    !net_ipv6_addr_cmp(&net_ipv6_nbr_data(flow->nbr)->addr, &flow->nexthop)) {
+		flow->gen = 0U;
+		return NULL;
+	}
+
+	return flow;
+}
+
+bool net_route_flow_lookup(struct net_pkt *pkt)
+{
+	struct net_linkaddr *lladdr = NULL;
+	struct route_flow *flow;
+	bool found = false;
+
+	net_ipv6_nbr_lock();
+
+	flow = flow_find(pkt);
+	if (flow == NULL) {
+		goto out;
+	}
+
+	/* Same sanity checks as in net_route_packet(), anything unusual is
+	 * left to the regular forwarding path.
+	 */
+	if (flow->set_dst_lladdr) {
+		if (flow->nbr->idx == NET_NBR_LLADDR_UNKNOWN) {
+			goto out;
+		}
+
+		lladdr = net_nbr_get_lladdr(flow->nbr->idx);
+		if (lladdr == NULL || net_pkt_lladdr_src(pkt)->len == 0U ||
+		    !memcmp(net_pkt_lladdr_src(pkt)->addr, lladdr->addr, lladdr->len)) {
+			goto out;
+		}
+	}
+
+	net_pkt_set_orig_iface(pkt, net_pkt_iface(pkt));
+	net_pkt_set_iface(pkt, flow->route_iface);
+	net_pkt_set_forwarding(pkt, true);
+
+	if (flow->set_src_lladdr) {
+		(void)net_linkaddr_copy(net_pkt_lladdr_src(pkt), net_pkt_lladdr_if(pkt));
+	}
+
+	if (lladdr != NULL) {
+		(void)net_linkaddr_copy(net_pkt_lladdr_dst(pkt), lladdr);
+	}
+
+	net_pkt_set_iface(pkt, flow->nbr->iface);
+	found = true;
+
+out:
+	net_ipv6_nbr_unlock();
+
+	return found;
+}
+
+void net_route_flow_flush(void)
+{
+	flow_gen++;
+
+	/* Skip the value marking unused entries */
+	if (flow_gen == 0U) {
+		flow_gen++;
+	}
+}
+
+static void flow_event_handler(struct net_mgmt_event_callback *cb,
+			       uint32_t mgmt_event, struct net_if *iface)
+{
+	ARG_UNUSED(cb);
+	ARG_UNUSED(mgmt_event);
+	ARG_UNUSED(iface);
+
+	net_ipv6_nbr_lock();
+	net_route_flow_flush();
+	net_ipv6_nbr_unlock();
+}
+
+void net_route_flow_init(void)
+{
+	memset(flow_cache, 0, sizeof(flow_cache));
+	net_route_flow_flush();
+
+	/* A new neighbor or a change of the default routers can make the
+	 * cached next hop obsolete. Route changes flush the cache directly.
+	 */
+	net_mgmt_init_event_callback(&flow_mgmt_cb, flow_event_handler,
+				     NET_EVENT_IPV6_NBR_ADD |
+				     NET_EVENT_IPV6_NBR_DEL |
+				     NET_EVENT_IPV6_ROUTER_ADD |
+				     NET_EVENT_IPV6_ROUTER_DEL);
+	net_mgmt_add_event_callback(&flow_mgmt_cb);
+}
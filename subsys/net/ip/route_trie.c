@@ -0,0 +1,375 @@
+/** @file
+ * @brief Longest prefix match trie for route lookups.
+ */
+
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_route, CONFIG_NET_ROUTE_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/slist.h>
+
+#include <zephyr/net/net_ip.h>
+
+#include "net_private.h"
+#include "route.h"
+
+/* The routes are kept in a path compressed binary trie indexed by the route
+ * prefix. Every node is either a prefix node holding the routes with that
+ * exact prefix, or a glue node without routes branching into two sub-tries.
+ * As a glue node always has two children, the trie never needs more than
+ * 2 * CONFIG_NET_MAX_ROUTES - 1 nodes.
+ *
+ * All the functions are called with the IPv6 neighbor lock held.
+ */
+
+#define TRIE_SIZE (2 * CONFIG_NET_MAX_ROUTES)
+#define TRIE_NONE -1
+
+BUILD_ASSERT(TRIE_SIZE <= INT16_MAX, "Too many routes for the route trie");
+
+struct route_trie_node {
+	/** Prefix of the node, only the first len bits are relevant */
+	struct in6_addr prefix;
+
+	/** Routes having this prefix, empty for a glue node */
+	sys_slist_t routes;
+
+	int16_t parent;
+	int16_t child[2];
+
+	/** Prefix length */
+	uint8_t len;
+};
+
+static struct route_trie_node trie_nodes[TRIE_SIZE];
+static int16_t trie_root = TRIE_NONE;
+static int16_t trie_free = TRIE_NONE;
+
+/* Generation of the trie content, used to invalidate the lookup cache */
+static uint32_t trie_gen = 1U;
+
+#if CONFIG_NET_ROUTE_TRIE_CACHE_SIZE > 0
+struct route_cache_entry {
+	struct in6_addr dst;
+	struct net_if *iface;
+	struct net_route_entry *route;
+	uint32_t gen;
+};
+
+static struct route_cache_entry route_cache[CONFIG_NET_ROUTE_TRIE_CACHE_SIZE];
+#endif
+
+static inline int prefix_bit(const struct in6_addr *addr, uint8_t pos)
+{
+	return (addr->s6_addr[pos / 8U] >> (7U - (pos % 8U))) & 1;
+}
+
+/* Length of the common prefix of the two addresses, at most max bits */
+static uint8_t common_prefix_len(const struct in6_addr *a, const struct in6_addr *b,
+				 uint8_t max)
+{
+	uint8_t len = 128U;
+
+	for (int i = 0; i < sizeof(a->s6_addr); i++) {
+		uint8_t diff = a->s6_addr[i] ^ b->s6_addr[i];
+
+		if (diff != 0U) {
+			len = i * 8U + (__builtin_clz(diff) - 24U);
+			break;
+		}
+	}
+
+	return MIN(len, max);
+}
+
+static int16_t node_alloc(const struct in6_addr *prefix, uint8_t len, int16_t parent)
+{
+	struct route_trie_node *node;
+	int16_t idx = trie_free;
+
+	if (idx == TRIE_NONE) {
+		return TRIE_NONE;
+	}
+
+	node = &trie_nodes[idx];
+	trie_free = node->child[0];
+
+	net_ipaddr_copy(&node->prefix, prefix);
+	sys_slist_init(&node->routes);
+	node->len = len;
+	node->parent = parent;
+	node->child[0] = TRIE_NONE;
+	node->child[1] = TRIE_NONE;
+
+	return idx;
+}
+
+static void node_free(int16_t idx)
+{
+	trie_nodes[idx].child[0] = trie_free;
+	trie_free = idx;
+}
+
+/* Location where the given node is linked from */
+static int16_t *node_slot(int16_t idx)
+{
+	int16_t parent = trie_nodes[idx].parent;
+
+	if (parent == TRIE_NONE) {
+		return &trie_root;
+	}
+
+	return &trie_nodes[parent].child[trie_nodes[parent].child[1] == idx];
+}
+
+static int16_t node_find_exact(const struct in6_addr *prefix, uint8_t len)
+{
+	int16_t idx = trie_root;
+
+	while (idx != TRIE_NONE) {
+		struct route_trie_node *node = &trie_nodes[idx];
+
+		if (node->len > len ||
+		    common_prefix_len(prefix, &node->prefix, node->len) < node->len) {
+			break;
+		}
+
+		if (node->len == len) {
+			return idx;
+		}
+
+		idx = node->child[prefix_bit(prefix, node->len)];
+	}
+
+	return TRIE_NONE;
+}
+
+static int16_t node_insert(const struct in6_addr *prefix, uint8_t len)
+{
+	int16_t *slot = &trie_root;
+	int16_t parent = TRIE_NONE;
+	struct route_trie_node *node;
+	int16_t idx, glue, cur;
+	uint8_t common;
+
+	/* Walk down while the node prefix is a prefix of the new one */
+	while (*slot != TRIE_NONE) {
+		cur = *slot;
+		node = &trie_nodes[cur];
+		common = common_prefix_len(prefix, &node->prefix, MIN(len, node->len));
+
+		if (common == node->len) {
+			if (node->len == len) {
+				return cur;
+			}
+
+			parent = cur;
+			slot = &node->child[prefix_bit(prefix, node->len)];
+			continue;
+		}
+
+		if (common == len) {
+			/* The new prefix covers the current node */
+			idx = node_alloc(prefix, len, parent);
+			if (idx == TRIE_NONE) {
+				return TRIE_NONE;
+			}
+
+			trie_nodes[idx].child[prefix_bit(&node->prefix, len)] = cur;
+			node->parent = idx;
+			*slot = idx;
+
+			return idx;
+		}
+
+		/* The prefixes diverge, branch with a glue node */
+		glue = node_alloc(prefix, common, parent);
+		if (glue == TRIE_NONE) {
+			return TRIE_NONE;
+		}
+
+		idx = node_alloc(prefix, len, glue);
+		if (idx == TRIE_NONE) {
+			node_free(glue);
+			return TRIE_NONE;
+		}
+
+		trie_nodes[glue].child[prefix_bit(prefix, common)] = idx;
+		trie_nodes[glue].child[prefix_bit(&node->prefix, common)] = cur;
+		node->parent = glue;
+		*slot = glue;
+
+		return idx;
+	}
+
+	idx = node_alloc(prefix, len, parent);
+	if (idx != TRIE_NONE) {
+		*slot = idx;
+	}
+
+	return idx;
+}
+
+/* Remove nodes that are no longer needed, starting from the given one */
+static void node_prune(int16_t idx)
+{
+	while (idx != TRIE_NONE) {
+		struct route_trie_node *node = &trie_nodes[idx];
+		int16_t parent = node->parent;
+		int16_t child;
+
+		if (!sys_slist_is_empty(&node->routes) ||
+		    (node->child[0] != TRIE_NONE && node->child[1] != TRIE_NONE)) {
+			break;
+		}
+
+		child = (node->child[0] != TRIE_NONE) ? node->child[0] : node->child[1];
+
+		*node_slot(idx) = child;
+		node_free(idx);
+
+		if (child != TRIE_NONE) {
+			trie_nodes[child].parent = parent;
+			break;
+		}
+
+		/* The parent lost a child, it might be a redundant glue node now */
+		idx = parent;
+	}
+}
+
+int net_route_trie_add(struct net_route_entry *route)
+{
+	struct net_route_entry *cur;
+	sys_snode_t *prev = NULL;
+	int16_t idx;
+
+	idx = node_insert(&route->addr, route->prefix_len);
+	if (idx == TRIE_NONE) {
+		return -ENOMEM;
+	}
+
+	/* Keep the routes in routing table slot order, i.e. in the order the
+	 * linear lookup visits them, so that ties are broken the same way.
+	 * The entries live in one array, so their addresses give that order.
+	 */
+	SYS_SLIST_FOR_EACH_CONTAINER(&trie_nodes[idx].routes, cur, trie_node) {
+		if (POINTER_TO_UINT(cur) > POINTER_TO_UINT(route)) {
+			break;
+		}
+
+		prev = &cur->trie_node;
+	}
+
+	sys_slist_insert(&trie_nodes[idx].routes, prev, &route->trie_node);
+	trie_gen++;
+
+	return 0;
+}
+
+void net_route_trie_del(struct net_route_entry *route)
+{
+	int16_t idx;
+
+	idx = node_find_exact(&route->addr, route->prefix_len);
+	if (idx == TRIE_NONE) {
+		return;
+	}
+
+	if (!sys_slist_find_and_remove(&trie_nodes[idx].routes, &route->trie_node)) {
+		return;
+	}
+
+	trie_gen++;
+	node_prune(idx);
+}
+
+static struct net_route_entry *trie_lookup(struct net_if *iface, const struct in6_addr *dst)
+{
+	struct net_route_entry *route, *found = NULL;
+	int16_t idx = trie_root;
+
+	while (idx != TRIE_NONE) {
+		struct route_trie_node *node = &trie_nodes[idx];
+
+		if (!net_ipv6_is_prefix(dst->s6_addr, node->prefix.s6_addr, node->len)) {
+			break;
+		}
+
+		/* Same tie break as the linear lookup: the last matching slot
+		 * wins, except for host routes where its scan stops at the
+		 * first one.
+		 */
+		SYS_SLIST_FOR_EACH_CONTAINER(&node->routes, route, trie_node) {
+			if (iface != NULL && route->iface != iface) {
+				continue;
+			}
+
+			found = route;
+
+			if (node->len == 128U) {
+				break;
+			}
+		}
+
+		if (node->len == 128U) {
+			break;
+		}
+
+		idx = node->child[prefix_bit(dst, node->len)];
+	}
+
+	return found;
+}
+
+#if CONFIG_NET_ROUTE_TRIE_CACHE_SIZE > 0
+static struct route_cache_entry *cache_entry(struct net_if *iface, const struct in6_addr *dst)
+{
+	uint32_t hash = dst->s6_addr32[0] ^ dst->s6_addr32[1] ^
+			dst->s6_addr32[2] ^ dst->s6_addr32[3] ^ POINTER_TO_UINT(iface);
+
+	hash ^= hash >> 16;
+	hash ^= hash >> 8;
+
+	return &route_cache[hash % CONFIG_NET_ROUTE_TRIE_CACHE_SIZE];
+}
+#endif
+
+struct net_route_entry *net_route_trie_lookup(struct net_if *iface, const struct in6_addr *dst)
+{
+#if CONFIG_NET_ROUTE_TRIE_CACHE_SIZE > 0
+	struct route_cache_entry *entry = cache_entry(iface, dst);
+
+	if (entry->gen == trie_gen && entry->iface == iface &&
+	    net_ipv6_addr_cmp(&entry->dst, dst)) {
+		return entry->route;
+	}
+
+	entry->route = trie_lookup(iface, dst);
+	entry->iface = iface;
+	entry->gen = trie_gen;
+	net_ipaddr_copy(&entry->dst, dst);
+
+	return entry->route;
+#else
+	return trie_lookup(iface, dst);
+#endif
+}
+
+void net_route_trie_init(void)
+{
+	trie_root = TRIE_NONE;
+	trie_free = TRIE_NONE;
+
+	for (int i = TRIE_SIZE - 1; i >= 0; i--) {
+		node_free(i);
+	}
+
+	trie_gen++;
+}
@@ -67,6 +67,10 @@ static struct coap_transmission_parameters coap_transmission_params = {
 
 static int insert_option(struct coap_packet *cpkt, uint16_t code, const uint8_t *value,
 			 uint16_t len);
+static void option_index_reset(struct coap_packet *cpkt);
+static void option_index_invalidate(struct coap_packet *cpkt);
+static void option_index_add(struct coap_packet *cpkt, uint16_t code, uint16_t offset);
+static void option_index_build(struct coap_packet *cpkt);
 
 static inline void encode_u8(struct coap_packet *cpkt, uint16_t offset, uint8_t data)
 {
@@ -183,6 +187,7 @@ int coap_packet_init(struct coap_packet *cpkt, uint8_t *data, uint16_t max_len,
 	cpkt->offset = 0U;
 	cpkt->max_len = max_len;
 	cpkt->delta = 0U;
+	option_index_reset(cpkt);
 
 	hdr = (ver & 0x3) << 6;
 	hdr |= (type & 0x3) << 4;
@@ -344,6 +349,7 @@ static int encode_option(struct coap_packet *cpkt, uint16_t code, const uint8_t
 int coap_packet_append_option(struct coap_packet *cpkt, uint16_t code,
 			      const uint8_t *value, uint16_t len)
 {
+	uint16_t offset;
 	int r;
 
 	if (!cpkt) {
@@ -364,13 +370,49 @@ int coap_packet_append_option(struct coap_packet *cpkt, uint16_t code,
 		code = (code == cpkt->delta) ? 0 : code - cpkt->delta;
 	}
 
-	r = encode_option(cpkt, code, value, len, cpkt->hdr_len + cpkt->opt_len);
+	offset = cpkt->hdr_len + cpkt->opt_len;
+
+	r = encode_option(cpkt, code, value, len, offset);
 	if (r < 0) {
 		return -EINVAL;
 	}
 
 	cpkt->opt_len += r;
 	cpkt->delta += code;
+	option_index_add(cpkt, cpkt->delta, offset);
+
+	return 0;
+}
+
+int coap_packet_append_options(struct coap_packet *cpkt, struct coap_packet_option *options,
+			       size_t num)
+{
+	struct coap_packet_option tmp;
+	size_t i, j;
+	int r;
+
+	if (!cpkt || (num > 0 && !options)) {
+		return -EINVAL;
+	}
+
+	/* Insertion sort, stable so that repeated options keep their order */
+	for (i = 1; i < num; i++) {
+		tmp = options[i];
+
+		for (j = i; j > 0 && options[j - 1].code > tmp.code; j--) {
+			options[j] = options[j - 1];
+		}
+
+		options[j] = tmp;
+	}
+
+	for (i = 0; i < num; i++) {
+		r = coap_packet_append_option(cpkt, options[i].code, options[i].value,
+					      options[i].len);
+		if (r < 0) {
+			return r;
+		}
+	}
 
 	return 0;
 }
@@ -635,6 +677,106 @@ static int parse_option(uint8_t *data, uint16_t offset, uint16_t *pos,
 	return r;
 }
 
+#if defined(CONFIG_COAP_OPTION_INDEX)
+static void option_index_reset(struct coap_packet *cpkt)
+{
+	memset(cpkt->opt_index, 0, sizeof(cpkt->opt_index));
+	cpkt->opt_indexed = true;
+}
+
+static void option_index_invalidate(struct coap_packet *cpkt)
+{
+	cpkt->opt_indexed = false;
+}
+
+/* Record the offset of an option, if it is the first one with this code */
+static void option_index_add(struct coap_packet *cpkt, uint16_t code, uint16_t offset)
+{
+	if (cpkt->opt_indexed && code < CONFIG_COAP_OPTION_INDEX_SIZE &&
+	    cpkt->opt_index[code] == 0U) {
+		cpkt->opt_index[code] = offset;
+	}
+}
+
+/* Index all the options again, after the option data was moved */
+static void option_index_build(struct coap_packet *cpkt)
+{
+	const uint16_t end = cpkt->hdr_len + cpkt->opt_len;
+	uint16_t offset = cpkt->hdr_len;
+	uint16_t opt_delta = 0U;
+	uint16_t opt_len = 0U;
+	uint16_t start;
+
+	option_index_reset(cpkt);
+
+	while (offset < end) {
+		start = offset;
+		if (parse_option(cpkt->data, offset, &offset, end, &opt_delta, &opt_len,
+				 NULL) < 0) {
+			option_index_invalidate(cpkt);
+			return;
+		}
+
+		option_index_add(cpkt, opt_delta, start);
+	}
+}
+
+/* Find the options using the index. The delta of the first option is
+ * relative to the previous option, which is not known here, but the code
+ * of the option is.
+ */
+static int find_indexed_options(const struct coap_packet *cpkt, uint16_t code,
+				struct coap_option *options, uint16_t veclen)
+{
+	uint16_t offset = cpkt->opt_index[code];
+	uint16_t opt_len = 0U;
+	uint16_t prev_len;
+	uint16_t delta = 0U;
+	uint16_t num = 0U;
+	int r;
+
+	if (offset == 0U) {
+		return 0;
+	}
+
+	while (num < veclen) {
+		prev_len = opt_len;
+		r = parse_option(cpkt->data, offset, &offset, cpkt->max_len, &delta, &opt_len,
+				 &options[num]);
+		if (r < 0) {
+			return -EINVAL;
+		}
+
+		/* Payload marker reached */
+		if (opt_len == prev_len) {
+			break;
+		}
+
+		if (num == 0U) {
+			delta = code;
+			options[num].delta = code;
+		}
+
+		if (options[num].delta != code) {
+			break;
+		}
+
+		num++;
+
+		if (r == 0) {
+			break;
+		}
+	}
+
+	return num;
+}
+#else
+static void option_index_reset(struct coap_packet *cpkt) {}
+static void option_index_invalidate(struct coap_packet *cpkt) {}
+static void option_index_add(struct coap_packet *cpkt, uint16_t code, uint16_t offset) {}
+static void option_index_build(struct coap_packet *cpkt) {}
+#endif /* CONFIG_COAP_OPTION_INDEX */
+
 /* Remove the raw data of an option. Also adjusting offsets.
  * But not adjusting code delta of the option after the removed one.
  */
@@ -706,6 +848,7 @@ int coap_packet_remove_option(struct coap_packet *cpkt, uint16_t code)
 
 	offset = cpkt->hdr_len;
 	previous_offset = cpkt->hdr_len;
+	option_index_invalidate(cpkt);
 
 	/* Find the requested option */
 	while (offset < cpkt->hdr_len + cpkt->opt_len) {
@@ -720,6 +863,7 @@ int coap_packet_remove_option(struct coap_packet *cpkt, uint16_t code)
 		}
 
 		if (opt_delta > code) {
+			option_index_build(cpkt);
 			return 0;
 		}
 
@@ -740,6 +884,8 @@ int coap_packet_remove_option(struct coap_packet *cpkt, uint16_t code)
 		cpkt->delta = previous_code;
 	}
 
+	option_index_build(cpkt);
+
 	return 0;
 }
 
@@ -771,6 +917,7 @@ int coap_packet_parse(struct coap_packet *cpkt, uint8_t *data, uint16_t len,
 	cpkt->opt_len = 0U;
 	cpkt->hdr_len = 0U;
 	cpkt->delta = 0U;
+	option_index_reset(cpkt);
 
 	/* Token lengths 9-15 are reserved. */
 	tkl = cpkt->data[0] & 0x0f;
@@ -794,13 +941,22 @@ int coap_packet_parse(struct coap_packet *cpkt, uint8_t *data, uint16_t len,
 
 	while (1) {
 		struct coap_option *option;
+		uint16_t start = offset;
+		uint16_t prev_len = opt_len;
 
 		option = num < opt_num ? &options[num++] : NULL;
 		ret = parse_option(cpkt->data, offset, &offset, cpkt->max_len,
 				   &delta, &opt_len, option);
 		if (ret < 0) {
 			return -EILSEQ;
-		} else if (ret == 0) {
+		}
+
+		/* Nothing parsed when the payload marker is reached */
+		if (opt_len != prev_len) {
+			option_index_add(cpkt, delta, start);
+		}
+
+		if (ret == 0) {
 			break;
 		}
 	}
@@ -927,6 +1083,12 @@ int coap_find_options(const struct coap_packet *cpkt, uint16_t code,
 		return 0;
 	}
 
+#if defined(CONFIG_COAP_OPTION_INDEX)
+	if (cpkt->opt_indexed && code < CONFIG_COAP_OPTION_INDEX_SIZE) {
+		return find_indexed_options(cpkt, code, options, veclen);
+	}
+#endif
+
 	offset = cpkt->hdr_len;
 	opt_len = 0U;
 	delta = 0U;
@@ -1398,6 +1560,8 @@ int insert_option(struct coap_packet *cpkt, uint16_t code, const uint8_t *value,
 	struct coap_option option = {0};
 	int r;
 
+	option_index_invalidate(cpkt);
+
 	while (offset < cpkt->hdr_len + cpkt->opt_len) {
 		r = parse_option(cpkt->data, offset, &offset, cpkt->hdr_len + cpkt->opt_len,
 				 &opt_delta, &opt_len, &option);
@@ -1435,6 +1599,8 @@ int insert_option(struct coap_packet *cpkt, uint16_t code, const uint8_t *value,
 	}
 	cpkt->opt_len += r;
 
+	option_index_build(cpkt);
+
 	return 0;
 }
 
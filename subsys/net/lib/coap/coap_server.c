@@ -32,15 +32,39 @@ LOG_MODULE_DECLARE(net_coap, CONFIG_COAP_LOG_LEVEL);
 
 /* Shortened defines */
 #define MAX_OPTIONS    CONFIG_COAP_SERVER_MESSAGE_OPTIONS
+#define MESSAGE_SIZE   CONFIG_COAP_SERVER_MESSAGE_SIZE
 #define MAX_PENDINGS   CONFIG_COAP_SERVICE_PENDING_MESSAGES
 #define MAX_OBSERVERS  CONFIG_COAP_SERVICE_OBSERVERS
 #define MAX_POLL_FD    CONFIG_ZVFS_POLL_MAX
+#define HASH_SIZE      CONFIG_COAP_SERVICE_HASH_SIZE
+#define NUM_WORKERS    CONFIG_COAP_SERVER_NUM_WORKERS
 
 BUILD_ASSERT(CONFIG_ZVFS_POLL_MAX > 0, "CONFIG_ZVFS_POLL_MAX can't be 0");
+BUILD_ASSERT(MAX_OBSERVERS < UINT16_MAX, "Too many CoAP service observers");
+BUILD_ASSERT(MAX_PENDINGS < UINT16_MAX, "Too many CoAP service pending messages");
 
 static K_MUTEX_DEFINE(lock);
 static int control_sock;
 
+#if NUM_WORKERS > 0
+struct coap_server_request {
+	int sock_fd;
+	ssize_t len;
+	struct sockaddr addr;
+	socklen_t addr_len;
+	uint8_t buf[CONFIG_COAP_SERVER_MESSAGE_SIZE];
+};
+
+K_MEM_SLAB_DEFINE_STATIC(request_slab, sizeof(struct coap_server_request),
+			 CONFIG_COAP_SERVER_WORKER_QUEUE_SIZE, 4);
+K_MSGQ_DEFINE(request_q, sizeof(struct coap_server_request *),
+	      CONFIG_COAP_SERVER_WORKER_QUEUE_SIZE, 4);
+
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, NUM_WORKERS,
+				   CONFIG_COAP_SERVER_WORKER_STACK_SIZE);
+static struct k_thread workers[NUM_WORKERS];
+#endif /* NUM_WORKERS > 0 */
+
 #if defined(CONFIG_COAP_SERVER_PENDING_ALLOCATOR_STATIC)
 K_MEM_SLAB_DEFINE_STATIC(pending_data, CONFIG_COAP_SERVER_MESSAGE_SIZE,
 			 CONFIG_COAP_SERVER_PENDING_ALLOCATOR_STATIC_BLOCKS, 4);
@@ -82,20 +106,122 @@ static inline void coap_server_free(void *ptr)
 #endif
 }
 
+static inline uint16_t token_hash(const uint8_t *token, uint8_t tkl)
+{
+	uint32_t hash = 0U;
+
+	for (uint8_t i = 0; i < tkl; i++) {
+		hash = hash * 31U + token[i];
+	}
+
+	return hash % HASH_SIZE;
+}
+
+static void coap_service_index_init(struct coap_service_data *data)
+{
+	memset(data->observer_hash, 0, sizeof(data->observer_hash));
+	memset(data->pending_hash, 0, sizeof(data->pending_hash));
+
+	data->observer_free = 0U;
+	for (int i = MAX_OBSERVERS - 1; i >= 0; i--) {
+		data->observer_next[i] = data->observer_free;
+		data->observer_free = i + 1;
+	}
+
+	data->pending_free = 0U;
+	for (int i = MAX_PENDINGS - 1; i >= 0; i--) {
+		data->pending_next[i] = data->pending_free;
+		data->pending_free = i + 1;
+	}
+
+	data->indexed = true;
+}
+
+static struct coap_observer *coap_service_add_observer(const struct coap_service *service,
+							struct coap_resource *resource,
+							const struct coap_packet *request,
+							const struct sockaddr *addr)
+{
+	struct coap_service_data *data = service->data;
+	uint16_t idx = data->observer_free;
+	struct coap_observer *obs;
+	uint16_t bucket;
+
+	if (idx == 0U) {
+		return NULL;
+	}
+
+	obs = &data->observers[idx - 1];
+	data->observer_free = data->observer_next[idx - 1];
+
+	coap_observer_init(obs, request, addr);
+
+	bucket = token_hash(obs->token, obs->tkl);
+	data->observer_next[idx - 1] = data->observer_hash[bucket];
+	data->observer_hash[bucket] = idx;
+	data->observer_res[idx - 1] = resource;
+
+	coap_register_observer(resource, obs);
+
+	return obs;
+}
+
+/* Find an observer by token, and by address if not NULL */
+static struct coap_observer *coap_service_find_observer(const struct coap_service *service,
+							 const struct sockaddr *addr,
+							 const uint8_t *token, uint8_t tkl)
+{
+	struct coap_service_data *data = service->data;
+	struct coap_observer *obs;
+
+	for (uint16_t idx = data->observer_hash[token_hash(token, tkl)]; idx != 0U;
+	     idx = data->observer_next[idx - 1]) {
+		obs = &data->observers[idx - 1];
+
+		if (addr != NULL) {
+			if (coap_find_observer(obs, 1, addr, token, tkl) != NULL) {
+				return obs;
+			}
+		} else if (coap_find_observer_by_token(obs, 1, token, tkl) != NULL) {
+			return obs;
+		}
+	}
+
+	return NULL;
+}
+
+static void coap_service_free_observer(const struct coap_service *service,
+				       struct coap_observer *obs)
+{
+	struct coap_service_data *data = service->data;
+	uint16_t idx = obs - data->observers + 1;
+	uint16_t *prev = &data->observer_hash[token_hash(obs->token, obs->tkl)];
+
+	while (*prev != 0U && *prev != idx) {
+		prev = &data->observer_next[*prev - 1];
+	}
+
+	if (*prev == idx) {
+		*prev = data->observer_next[idx - 1];
+	}
+
+	memset(obs, 0, sizeof(*obs));
+	data->observer_res[idx - 1] = NULL;
+	data->observer_next[idx - 1] = data->observer_free;
+	data->observer_free = idx;
+}
+
 static int coap_service_remove_observer(const struct coap_service *service,
 					struct coap_resource *resource,
 					const struct sockaddr *addr,
 					const uint8_t *token, uint8_t tkl)
 {
 	struct coap_observer *obs;
+	struct coap_resource *owner;
 
-	if (tkl > 0 && addr != NULL) {
-		/* Prefer addr+token to find the observer */
-		obs = coap_find_observer(service->data->observers, MAX_OBSERVERS, addr, token, tkl);
-	} else if (tkl > 0) {
-		/* Then try to find the observer by token */
-		obs = coap_find_observer_by_token(service->data->observers, MAX_OBSERVERS, token,
-						  tkl);
+	if (tkl > 0) {
+		/* Prefer addr+token to find the observer, then the token only */
+		obs = coap_service_find_observer(service, addr, token, tkl);
 	} else if (addr != NULL) {
 		obs = coap_find_observer_by_addr(service->data->observers, MAX_OBSERVERS, addr);
 	} else {
@@ -107,43 +233,141 @@ static int coap_service_remove_observer(const struct coap_service *service,
 		return 0;
 	}
 
-	if (resource == NULL) {
-		COAP_SERVICE_FOREACH_RESOURCE(service, it) {
-			if (coap_remove_observer(it, obs)) {
-				memset(obs, 0, sizeof(*obs));
-				return 1;
+	owner = service->data->observer_res[obs - service->data->observers];
+	if (owner == NULL || (resource != NULL && resource != owner)) {
+		return 0;
+	}
+
+	if (!coap_remove_observer(owner, obs)) {
+		return 0;
+	}
+
+	coap_service_free_observer(service, obs);
+
+	return 1;
+}
+
+static struct coap_pending *coap_service_add_pending(const struct coap_service *service,
+						      const struct coap_packet *cpkt,
+						      const struct sockaddr *addr,
+						      const struct coap_transmission_parameters *params)
+{
+	struct coap_service_data *data = service->data;
+	uint16_t idx = data->pending_free;
+	struct coap_pending *pending;
+	uint16_t bucket;
+	int ret;
+
+	if (idx == 0U) {
+		LOG_WRN("No pending message available for %s", service->name);
+		return NULL;
+	}
+
+	pending = &data->pending[idx - 1];
+
+	ret = coap_pending_init(pending, cpkt, addr, params);
+	if (ret < 0) {
+		LOG_WRN("Failed to init pending message for %s (%d)", service->name, ret);
+		return NULL;
+	}
+
+	/* Replace tracked data with our allocated copy */
+	pending->data = coap_server_alloc(pending->len);
+	if (pending->data == NULL) {
+		LOG_WRN("Failed to allocate pending message data for %s", service->name);
+		coap_pending_clear(pending);
+		return NULL;
+	}
+	memcpy(pending->data, cpkt->data, pending->len);
+
+	data->pending_free = data->pending_next[idx - 1];
+
+	bucket = pending->id % HASH_SIZE;
+	data->pending_next[idx - 1] = data->pending_hash[bucket];
+	data->pending_hash[bucket] = idx;
+
+	return pending;
+}
+
+static struct coap_pending *coap_service_find_pending(const struct coap_service *service,
+						       uint16_t id)
+{
+	struct coap_service_data *data = service->data;
+	struct coap_pending *pending;
+
+	for (uint16_t idx = data->pending_hash[id % HASH_SIZE]; idx != 0U;
+	     idx = data->pending_next[idx - 1]) {
+		pending = &data->pending[idx - 1];
+
+		if (pending->timeout != 0U && pending->id == id) {
+			return pending;
+		}
+	}
+
+	return NULL;
+}
+
+static struct coap_pending *coap_service_next_to_expire(const struct coap_service *service)
+{
+	struct coap_service_data *data = service->data;
+	struct coap_pending *pending, *found = NULL;
+	int64_t expiry, min_expiry = INT64_MAX;
+
+	/* Only the pending messages in use are in the hash table */
+	ARRAY_FOR_EACH(data->pending_hash, bucket) {
+		for (uint16_t idx = data->pending_hash[bucket]; idx != 0U;
+		     idx = data->pending_next[idx - 1]) {
+			pending = &data->pending[idx - 1];
+
+			if (pending->timeout == 0U) {
+				continue;
+			}
+
+			expiry = pending->t0 + pending->timeout;
+			if (expiry < min_expiry) {
+				min_expiry = expiry;
+				found = pending;
 			}
 		}
-	} else if (coap_remove_observer(resource, obs)) {
-		memset(obs, 0, sizeof(*obs));
-		return 1;
 	}
 
-	return 0;
+	return found;
 }
 
-static int coap_server_process(int sock_fd)
+static void coap_service_free_pending(const struct coap_service *service,
+				      struct coap_pending *pending)
 {
-	static uint8_t buf[CONFIG_COAP_SERVER_MESSAGE_SIZE];
+	struct coap_service_data *data = service->data;
+	uint16_t idx = pending - data->pending + 1;
+	uint16_t *prev = &data->pending_hash[pending->id % HASH_SIZE];
 
-	struct sockaddr client_addr;
-	socklen_t client_addr_len = sizeof(client_addr);
-	struct coap_service *service = NULL;
-	struct coap_packet request;
-	struct coap_pending *pending;
-	struct coap_option options[MAX_OPTIONS] = { 0 };
-	uint8_t opt_num = MAX_OPTIONS;
-	uint8_t type;
+	while (*prev != 0U && *prev != idx) {
+		prev = &data->pending_next[*prev - 1];
+	}
+
+	if (*prev == idx) {
+		*prev = data->pending_next[idx - 1];
+	}
+
+	coap_server_free(pending->data);
+	coap_pending_clear(pending);
+
+	data->pending_next[idx - 1] = data->pending_free;
+	data->pending_free = idx;
+}
+
+static ssize_t coap_server_recv(int sock_fd, uint8_t *buf, struct sockaddr *client_addr,
+				socklen_t *client_addr_len)
+{
 	ssize_t received;
-	int ret;
 	int flags = ZSOCK_MSG_DONTWAIT;
 
 	if (IS_ENABLED(CONFIG_COAP_SERVER_TRUNCATE_MSGS)) {
 		flags |= ZSOCK_MSG_TRUNC;
 	}
 
-	received = zsock_recvfrom(sock_fd, buf, sizeof(buf), flags, &client_addr, &client_addr_len);
-
+	received = zsock_recvfrom(sock_fd, buf, MESSAGE_SIZE, flags, client_addr,
+				  client_addr_len);
 	if (received < 0) {
 		if (errno == EWOULDBLOCK) {
 			return 0;
@@ -153,7 +377,83 @@ static int coap_server_process(int sock_fd)
 		return -errno;
 	}
 
-	ret = coap_packet_parse(&request, buf, MIN(received, sizeof(buf)), options, opt_num);
+	return received;
+}
+
+/* Called without the lock held, the resource handlers may take some time */
+static int coap_server_handle_request(const struct coap_service *service,
+				      struct coap_packet *request,
+				      struct coap_option *options, uint8_t opt_num,
+				      struct sockaddr *client_addr, socklen_t client_addr_len)
+{
+	uint8_t type = coap_header_get_type(request);
+	int ret;
+
+	if (IS_ENABLED(CONFIG_COAP_SERVER_WELL_KNOWN_CORE) &&
+	    coap_header_get_code(request) == COAP_METHOD_GET &&
+	    coap_uri_path_match(COAP_WELL_KNOWN_CORE_PATH, options, opt_num)) {
+		uint8_t well_known_buf[CONFIG_COAP_SERVER_MESSAGE_SIZE];
+		struct coap_packet response;
+
+		ret = coap_well_known_core_get_len(service->res_begin,
+						   COAP_SERVICE_RESOURCE_COUNT(service),
+						   request, &response,
+						   well_known_buf, sizeof(well_known_buf));
+		if (ret < 0) {
+			LOG_ERR("Failed to build well known core for %s (%d)", service->name, ret);
+			return ret;
+		}
+
+		return coap_service_send(service, &response, client_addr, client_addr_len, NULL);
+	}
+
+	ret = coap_handle_request_len(request, service->res_begin,
+				      COAP_SERVICE_RESOURCE_COUNT(service),
+				      options, opt_num, client_addr, client_addr_len);
+
+	/* Translate errors to response codes */
+	switch (ret) {
+	case -ENOENT:
+		ret = COAP_RESPONSE_CODE_NOT_FOUND;
+		break;
+	case -ENOTSUP:
+		ret = COAP_RESPONSE_CODE_BAD_REQUEST;
+		break;
+	case -EPERM:
+		ret = COAP_RESPONSE_CODE_NOT_ALLOWED;
+		break;
+	}
+
+	/* Shortcut for replying a code without a body */
+	if (ret > 0 && type == COAP_TYPE_CON) {
+		/* Minimal sized ack buffer */
+		uint8_t ack_buf[COAP_TOKEN_MAX_LEN + 4U];
+		struct coap_packet ack;
+
+		ret = coap_ack_init(&ack, request, ack_buf, sizeof(ack_buf), (uint8_t)ret);
+		if (ret < 0) {
+			LOG_ERR("Failed to init ACK (%d)", ret);
+			return ret;
+		}
+
+		ret = coap_service_send(service, &ack, client_addr, client_addr_len, NULL);
+	}
+
+	return ret;
+}
+
+static int coap_server_handle(int sock_fd, uint8_t *buf, ssize_t received,
+			      struct sockaddr *client_addr, socklen_t client_addr_len)
+{
+	struct coap_service *service = NULL;
+	struct coap_packet request;
+	struct coap_pending *pending;
+	struct coap_option options[MAX_OPTIONS] = { 0 };
+	uint8_t opt_num = MAX_OPTIONS;
+	uint8_t type;
+	int ret;
+
+	ret = coap_packet_parse(&request, buf, MIN(received, MESSAGE_SIZE), options, opt_num);
 	if (ret < 0) {
 		LOG_ERR("Failed To parse coap message (%d)", ret);
 		return ret;
@@ -174,7 +474,7 @@ static int coap_server_process(int sock_fd)
 
 	type = coap_header_get_type(&request);
 
-	if (received > sizeof(buf)) {
+	if (received > MESSAGE_SIZE) {
 		/* The message was truncated and can't be processed further */
 		struct coap_packet response;
 		uint8_t token[COAP_TOKEN_MAX_LEN];
@@ -187,7 +487,7 @@ static int coap_server_process(int sock_fd)
 			type = COAP_TYPE_NON_CON;
 		}
 
-		ret = coap_packet_init(&response, buf, sizeof(buf), COAP_VERSION_1, type, tkl,
+		ret = coap_packet_init(&response, buf, MESSAGE_SIZE, COAP_VERSION_1, type, tkl,
 				       token, COAP_RESPONSE_CODE_REQUEST_TOO_LARGE, id);
 		if (ret < 0) {
 			LOG_ERR("Failed to init response (%d)", ret);
@@ -201,7 +501,7 @@ static int coap_server_process(int sock_fd)
 			goto unlock;
 		}
 
-		ret = coap_service_send(service, &response, &client_addr, client_addr_len, NULL);
+		ret = coap_service_send(service, &response, client_addr, client_addr_len, NULL);
 		if (ret < 0) {
 			LOG_ERR("Failed to reply \"Request Entity Too Large\" (%d)", ret);
 			goto unlock;
@@ -210,7 +510,7 @@ static int coap_server_process(int sock_fd)
 		goto unlock;
 	}
 
-	pending = coap_pending_received(&request, service->data->pending, MAX_PENDINGS);
+	pending = coap_service_find_pending(service, coap_header_get_id(&request));
 	if (pending) {
 		uint8_t token[COAP_TOKEN_MAX_LEN];
 		uint8_t tkl;
@@ -218,11 +518,10 @@ static int coap_server_process(int sock_fd)
 		switch (type) {
 		case COAP_TYPE_RESET:
 			tkl = coap_header_get_token(&request, token);
-			coap_service_remove_observer(service, NULL, &client_addr, token, tkl);
+			coap_service_remove_observer(service, NULL, client_addr, token, tkl);
 			__fallthrough;
 		case COAP_TYPE_ACK:
-			coap_server_free(pending->data);
-			coap_pending_clear(pending);
+			coap_service_free_pending(service, pending);
 			break;
 		default:
 			LOG_WRN("Unexpected pending type %d", type);
@@ -237,62 +536,94 @@ static int coap_server_process(int sock_fd)
 		goto unlock;
 	}
 
-	if (IS_ENABLED(CONFIG_COAP_SERVER_WELL_KNOWN_CORE) &&
-	    coap_header_get_code(&request) == COAP_METHOD_GET &&
-	    coap_uri_path_match(COAP_WELL_KNOWN_CORE_PATH, options, opt_num)) {
-		uint8_t well_known_buf[CONFIG_COAP_SERVER_MESSAGE_SIZE];
-		struct coap_packet response;
+	(void)k_mutex_unlock(&lock);
 
-		ret = coap_well_known_core_get_len(service->res_begin,
-						   COAP_SERVICE_RESOURCE_COUNT(service),
-						   &request, &response,
-						   well_known_buf, sizeof(well_known_buf));
-		if (ret < 0) {
-			LOG_ERR("Failed to build well known core for %s (%d)", service->name, ret);
-			goto unlock;
-		}
+	return coap_server_handle_request(service, &request, options, opt_num, client_addr,
+					  client_addr_len);
 
-		ret = coap_service_send(service, &response, &client_addr, client_addr_len, NULL);
-	} else {
-		ret = coap_handle_request_len(&request, service->res_begin,
-					      COAP_SERVICE_RESOURCE_COUNT(service),
-					      options, opt_num, &client_addr, client_addr_len);
-
-		/* Translate errors to response codes */
-		switch (ret) {
-		case -ENOENT:
-			ret = COAP_RESPONSE_CODE_NOT_FOUND;
-			break;
-		case -ENOTSUP:
-			ret = COAP_RESPONSE_CODE_BAD_REQUEST;
-			break;
-		case -EPERM:
-			ret = COAP_RESPONSE_CODE_NOT_ALLOWED;
-			break;
-		}
+unlock:
+	(void)k_mutex_unlock(&lock);
 
-		/* Shortcut for replying a code without a body */
-		if (ret > 0 && type == COAP_TYPE_CON) {
-			/* Minimal sized ack buffer */
-			uint8_t ack_buf[COAP_TOKEN_MAX_LEN + 4U];
-			struct coap_packet ack;
+	return ret;
+}
 
-			ret = coap_ack_init(&ack, &request, ack_buf, sizeof(ack_buf), (uint8_t)ret);
-			if (ret < 0) {
-				LOG_ERR("Failed to init ACK (%d)", ret);
-				goto unlock;
-			}
+#if NUM_WORKERS > 0
+static int coap_server_process(int sock_fd)
+{
+	static uint8_t drop_buf[CONFIG_COAP_SERVER_MESSAGE_SIZE];
+	struct coap_server_request *req;
+	struct sockaddr client_addr;
+	socklen_t client_addr_len = sizeof(client_addr);
+	ssize_t received;
 
-			ret = coap_service_send(service, &ack, &client_addr, client_addr_len, NULL);
-		}
+	if (k_mem_slab_alloc(&request_slab, (void **)&req, K_NO_WAIT) < 0) {
+		/* Drop the request, the client retransmits the confirmable ones */
+		LOG_WRN("CoAP server worker queue full, dropping request");
+		return coap_server_recv(sock_fd, drop_buf, &client_addr, &client_addr_len);
 	}
 
-unlock:
-	(void)k_mutex_unlock(&lock);
+	req->addr_len = sizeof(req->addr);
+	received = coap_server_recv(sock_fd, req->buf, &req->addr, &req->addr_len);
+	if (received <= 0) {
+		k_mem_slab_free(&request_slab, req);
+		return received;
+	}
 
-	return ret;
+	req->sock_fd = sock_fd;
+	req->len = received;
+
+	/* Cannot fail, there are as many queue entries as request buffers */
+	(void)k_msgq_put(&request_q, &req, K_NO_WAIT);
+
+	return 0;
 }
 
+static void coap_server_worker(void *p1, void *p2, void *p3)
+{
+	struct coap_server_request *req;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		(void)k_msgq_get(&request_q, &req, K_FOREVER);
+
+		(void)coap_server_handle(req->sock_fd, req->buf, req->len, &req->addr,
+					 req->addr_len);
+
+		k_mem_slab_free(&request_slab, req);
+	}
+}
+
+static void coap_server_start_workers(void)
+{
+	for (int i = 0; i < NUM_WORKERS; i++) {
+		k_thread_create(&workers[i], worker_stacks[i],
+				K_THREAD_STACK_SIZEOF(worker_stacks[i]),
+				coap_server_worker, NULL, NULL, NULL,
+				THREAD_PRIORITY, 0, K_NO_WAIT);
+		k_thread_name_set(&workers[i], "coap_server_worker");
+	}
+}
+#else
+static int coap_server_process(int sock_fd)
+{
+	static uint8_t buf[CONFIG_COAP_SERVER_MESSAGE_SIZE];
+
+	struct sockaddr client_addr;
+	socklen_t client_addr_len = sizeof(client_addr);
+	ssize_t received;
+
+	received = coap_server_recv(sock_fd, buf, &client_addr, &client_addr_len);
+	if (received <= 0) {
+		return received;
+	}
+
+	return coap_server_handle(sock_fd, buf, received, &client_addr, client_addr_len);
+}
+#endif /* NUM_WORKERS > 0 */
+
 static void coap_server_retransmit(void)
 {
 	struct coap_pending *pending;
@@ -307,7 +638,7 @@ static void coap_server_retransmit(void)
 			continue;
 		}
 
-		pending = coap_pending_next_to_expire(service->data->pending, MAX_PENDINGS);
+		pending = coap_service_next_to_expire(service);
 		if (pending == NULL) {
 			/* No work to be done */
 			continue;
@@ -331,8 +662,7 @@ static void coap_server_retransmit(void)
 			LOG_WRN("Packet retransmission failed for %s", service->name);
 
 			coap_service_remove_observer(service, NULL, &pending->addr, NULL, 0U);
-			coap_server_free(pending->data);
-			coap_pending_clear(pending);
+			coap_service_free_pending(service, pending);
 		}
 	}
 
@@ -346,12 +676,15 @@ static int coap_server_poll_timeout(void)
 	int64_t remaining;
 	int64_t now = k_uptime_get();
 
+	/* The workers might be updating the pending messages */
+	(void)k_mutex_lock(&lock, K_FOREVER);
+
 	COAP_SERVICE_FOREACH(svc) {
 		if (svc->data->sock_fd < -1) {
 			continue;
 		}
 
-		pending = coap_pending_next_to_expire(svc->data->pending, MAX_PENDINGS);
+		pending = coap_service_next_to_expire(svc);
 		if (pending == NULL) {
 			continue;
 		}
@@ -362,6 +695,8 @@ static int coap_server_poll_timeout(void)
 		}
 	}
 
+	(void)k_mutex_unlock(&lock);
+
 	if (result == INT64_MAX) {
 		return -1;
 	}
@@ -428,6 +763,10 @@ int coap_service_start(const struct coap_service *service)
 		goto end;
 	}
 
+	if (!service->data->indexed) {
+		coap_service_index_init(service->data);
+	}
+
 	/* set the default address (in6addr_any / INADDR_ANY are all 0) */
 	addr_storage = (struct sockaddr_storage){0};
 	if (IS_ENABLED(CONFIG_NET_IPV6) && service->host != NULL &&
@@ -609,28 +948,11 @@ int coap_service_send(const struct coap_service *service, const struct coap_pack
 	 * try to send.
 	 */
 	if (coap_header_get_type(cpkt) == COAP_TYPE_CON) {
-		struct coap_pending *pending = coap_pending_next_unused(service->data->pending,
-									MAX_PENDINGS);
+		struct coap_pending *pending = coap_service_add_pending(service, cpkt, addr, params);
 
 		if (pending == NULL) {
-			LOG_WRN("No pending message available for %s", service->name);
-			goto send;
-		}
-
-		ret = coap_pending_init(pending, cpkt, addr, params);
-		if (ret < 0) {
-			LOG_WRN("Failed to init pending message for %s (%d)", service->name, ret);
-			goto send;
-		}
-
-		/* Replace tracked data with our allocated copy */
-		pending->data = coap_server_alloc(pending->len);
-		if (pending->data == NULL) {
-			LOG_WRN("Failed to allocate pending message data for %s", service->name);
-			coap_pending_clear(pending);
 			goto send;
 		}
-		memcpy(pending->data, cpkt->data, pending->len);
 
 		coap_pending_cycle(pending);
 
@@ -705,22 +1027,18 @@ int coap_resource_parse_observe(struct coap_resource *resource, const struct coa
 		struct coap_observer *observer;
 
 		/* RFC7641 section 4.1 - Check if the current observer already exists */
-		observer = coap_find_observer(service->data->observers, MAX_OBSERVERS, addr, token,
-					      tkl);
+		observer = coap_service_find_observer(service, addr, token, tkl);
 		if (observer != NULL) {
 			/* Client refresh */
 			goto unlock;
 		}
 
 		/* New client */
-		observer = coap_observer_next_unused(service->data->observers, MAX_OBSERVERS);
+		observer = coap_service_add_observer(service, resource, request, addr);
 		if (observer == NULL) {
 			ret = -ENOMEM;
 			goto unlock;
 		}
-
-		coap_observer_init(observer, request, addr);
-		coap_register_observer(resource, observer);
 	} else if (ret == 1) {
 		ret = coap_service_remove_observer(service, resource, addr, token, tkl);
 		if (ret < 0) {
@@ -797,6 +1115,10 @@ static void coap_server_thread(void *p1, void *p2, void *p3)
 		return;
 	}
 
+#if NUM_WORKERS > 0
+	coap_server_start_workers();
+#endif
+
 	COAP_SERVICE_FOREACH(svc) {
 		if (svc->flags & COAP_SERVICE_AUTOSTART) {
 			ret = coap_service_start(svc);
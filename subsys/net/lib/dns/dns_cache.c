@@ -6,18 +6,148 @@
 
 #include <zephyr/net/dns_resolve.h>
 #include <zephyr/net/net_ip.h>
+#include <zephyr/sys/crc.h>
 #include "dns_cache.h"
 
 LOG_MODULE_REGISTER(net_dns_cache, CONFIG_DNS_RESOLVER_LOG_LEVEL);
 
-static void dns_cache_clean(struct dns_cache const *cache);
+#define ENTRY_IDX(cache, entry) ((uint16_t)((entry) - (cache)->entries) + 1U)
+#define IDX_ENTRY(cache, idx)   (&(cache)->entries[(idx) - 1U])
+
+static uint16_t *dns_cache_bucket(struct dns_cache *cache, char const *query)
+{
+	return &cache->buckets[crc16_ansi((const uint8_t *)query, strlen(query)) % cache->size];
+}
+
+/* Needs to be called when lock is already acquired, prev is the index of the
+ * entry before in the chain, 0 if the entry is the first one.
+ */
+static void dns_cache_release(struct dns_cache *cache, uint16_t *bucket, uint16_t prev,
+			      struct dns_cache_entry *entry)
+{
+	if (prev == 0U) {
+		*bucket = entry->next;
+	} else {
+		IDX_ENTRY(cache, prev)->next = entry->next;
+	}
+
+	entry->in_use = false;
+	sys_dlist_remove(&entry->node);
+	sys_dlist_append(&cache->free, &entry->node);
+}
+
+/* Needs to be called when lock is already acquired. Releases the entries of
+ * the query matching the address family, or the expired ones if family is
+ * AF_UNSPEC.
+ */
+static void dns_cache_clean(struct dns_cache *cache, uint16_t *bucket, char const *query,
+			    sa_family_t family)
+{
+	uint16_t prev = 0U;
+	uint16_t idx = *bucket;
+
+	while (idx != 0U) {
+		struct dns_cache_entry *entry = IDX_ENTRY(cache, idx);
+		uint16_t next = entry->next;
+
+		if (sys_timepoint_expired(entry->expiry) ||
+		    (family != AF_UNSPEC && entry->data.ai_family == family &&
+		     strcmp(entry->query, query) == 0)) {
+			NET_DBG("Remove \"%s\"", entry->query);
+			dns_cache_release(cache, bucket, prev, entry);
+		} else {
+			prev = idx;
+		}
+
+		idx = next;
+	}
+}
+
+/* Needs to be called when lock is already acquired */
+static struct dns_cache_entry *dns_cache_alloc(struct dns_cache *cache)
+{
+	struct dns_cache_entry *entry;
+	uint16_t *bucket;
+	uint16_t prev = 0U;
+	uint16_t idx;
+
+	if (!sys_dlist_is_empty(&cache->free)) {
+		entry = CONTAINER_OF(sys_dlist_get(&cache->free), struct dns_cache_entry, node);
+		return entry;
+	}
+
+	if (cache->used < cache->size) {
+		return &cache->entries[cache->used++];
+	}
+
+	entry = CONTAINER_OF(sys_dlist_peek_tail(&cache->lru), struct dns_cache_entry, node);
+
+	NET_DBG("Overwrite \"%s\"", entry->query);
+
+	bucket = dns_cache_bucket(cache, entry->query);
+	for (idx = *bucket; idx != ENTRY_IDX(cache, entry); idx = IDX_ENTRY(cache, idx)->next) {
+		prev = idx;
+	}
+
+	dns_cache_release(cache, bucket, prev, entry);
+
+	/* Take it back from the free list */
+	sys_dlist_remove(&entry->node);
+
+	return entry;
+}
+
+/* Needs to be called when lock is already acquired */
+static void dns_cache_insert(struct dns_cache *cache, char const *query,
+			     struct dns_addrinfo const *addrinfo, uint32_t ttl, bool negative)
+{
+	uint16_t *bucket = dns_cache_bucket(cache, query);
+	struct dns_cache_entry *entry;
+
+	/* An answer replaces a cached negative answer and the other way round */
+	dns_cache_clean(cache, bucket, query, AF_UNSPEC);
+
+	if (negative) {
+		dns_cache_clean(cache, bucket, query, addrinfo->ai_family);
+	} else {
+		for (uint16_t idx = *bucket; idx != 0U; idx = IDX_ENTRY(cache, idx)->next) {
+			entry = IDX_ENTRY(cache, idx);
+
+			if (entry->negative && entry->data.ai_family == addrinfo->ai_family &&
+			    strcmp(entry->query, query) == 0) {
+				dns_cache_clean(cache, bucket, query, addrinfo->ai_family);
+				break;
+			}
+		}
+	}
+
+	entry = dns_cache_alloc(cache);
+
+	strncpy(entry->query, query, CONFIG_DNS_RESOLVER_MAX_QUERY_LEN - 1);
+	entry->query[CONFIG_DNS_RESOLVER_MAX_QUERY_LEN - 1] = '\0';
+	entry->data = *addrinfo;
+	entry->expiry = sys_timepoint_calc(K_SECONDS(ttl));
+	entry->negative = negative;
+	entry->in_use = true;
+
+	/* The entry may have been evicted from the same chain */
+	bucket = dns_cache_bucket(cache, query);
+	entry->next = *bucket;
+	*bucket = ENTRY_IDX(cache, entry);
+
+	sys_dlist_prepend(&cache->lru, &entry->node);
+}
 
 int dns_cache_flush(struct dns_cache *cache)
 {
 	k_mutex_lock(cache->lock, K_FOREVER);
 	for (size_t i = 0; i < cache->size; i++) {
 		cache->entries[i].in_use = false;
+		cache->buckets[i] = 0U;
 	}
+	sys_dlist_init(&cache->lru);
+	sys_dlist_init(&cache->free);
+	cache->used = 0;
 	k_mutex_unlock(cache->lock);
 
 	return 0;
@@ -26,10 +156,6 @@ int dns_cache_flush(struct dns_cache *cache)
 int dns_cache_add(struct dns_cache *cache, char const *query, struct dns_addrinfo const *addrinfo,
 		  uint32_t ttl)
 {
-	k_timepoint_t closest_to_expiry = sys_timepoint_calc(K_FOREVER);
-	size_t index_to_replace = 0;
-	bool found_empty = false;
-
 	if (cache == NULL || query == NULL || addrinfo == NULL || ttl == 0) {
 		return -EINVAL;
 	}
@@ -45,28 +171,42 @@ int dns_cache_add(struct dns_cache *cache, char const *query, struct dns_addrinf
 
 	NET_DBG("Add \"%s\" with TTL %" PRIu32, query, ttl);
 
-	dns_cache_clean(cache);
+	dns_cache_insert(cache, query, addrinfo, ttl, false);
 
-	for (size_t i = 0; i < cache->size; i++) {
-		if (!cache->entries[i].in_use) {
-			index_to_replace = i;
-			found_empty = true;
-			break;
-		} else if (sys_timepoint_cmp(closest_to_expiry, cache->entries[i].expiry) > 0) {
-			index_to_replace = i;
-			closest_to_expiry = cache->entries[i].expiry;
-		}
+	k_mutex_unlock(cache->lock);
+
+	return 0;
+}
+
+int dns_cache_add_negative(struct dns_cache *cache, char const *query, enum dns_query_type type,
+			   uint32_t ttl)
+{
+	struct dns_addrinfo addrinfo = { 0 };
+
+	if (cache == NULL || query == NULL || ttl == 0) {
+		return -EINVAL;
 	}
 
-	if (!found_empty) {
-		NET_DBG("Overwrite \"%s\"", cache->entries[index_to_replace].query);
+	if (type == DNS_QUERY_TYPE_A) {
+		addrinfo.ai_family = AF_INET;
+	} else if (type == DNS_QUERY_TYPE_AAAA) {
+		addrinfo.ai_family = AF_INET6;
+	} else {
+		return -EINVAL;
 	}
 
-	strncpy(cache->entries[index_to_replace].query, query,
-		CONFIG_DNS_RESOLVER_MAX_QUERY_LEN - 1);
-	cache->entries[index_to_replace].data = *addrinfo;
-	cache->entries[index_to_replace].expiry = sys_timepoint_calc(K_SECONDS(ttl));
-	cache->entries[index_to_replace].in_use = true;
+	if (strlen(query) >= CONFIG_DNS_RESOLVER_MAX_QUERY_LEN) {
+		NET_WARN("Query string to big to be processed %u >= "
+			 "CONFIG_DNS_RESOLVER_MAX_QUERY_LEN",
+			 strlen(query));
+		return -EINVAL;
+	}
+
+	k_mutex_lock(cache->lock, K_FOREVER);
+
+	NET_DBG("Add negative \"%s\" with TTL %" PRIu32, query, ttl);
+
+	dns_cache_insert(cache, query, &addrinfo, ttl, true);
 
 	k_mutex_unlock(cache->lock);
 
@@ -75,6 +215,10 @@ int dns_cache_add(struct dns_cache *cache, char const *query, struct dns_addrinf
 
 int dns_cache_remove(struct dns_cache *cache, char const *query)
 {
+	uint16_t *bucket;
+	uint16_t prev = 0U;
+	uint16_t idx;
+
 	NET_DBG("Remove all entries with query \"%s\"", query);
 	if (strlen(query) >= CONFIG_DNS_RESOLVER_MAX_QUERY_LEN) {
 		NET_WARN("Query string to big to be processed %u >= "
@@ -85,12 +229,20 @@ int dns_cache_remove(struct dns_cache *cache, char const *query)
 
 	k_mutex_lock(cache->lock, K_FOREVER);
 
-	dns_cache_clean(cache);
+	bucket = dns_cache_bucket(cache, query);
+	idx = *bucket;
 
-	for (size_t i = 0; i < cache->size; i++) {
-		if (cache->entries[i].in_use && strcmp(cache->entries[i].query, query) == 0) {
-			cache->entries[i].in_use = false;
+	while (idx != 0U) {
+		struct dns_cache_entry *entry = IDX_ENTRY(cache, idx);
+		uint16_t next = entry->next;
+
+		if (sys_timepoint_expired(entry->expiry) || strcmp(entry->query, query) == 0) {
+			dns_cache_release(cache, bucket, prev, entry);
+		} else {
+			prev = idx;
 		}
+
+		idx = next;
 	}
 
 	k_mutex_unlock(cache->lock);
@@ -98,11 +250,13 @@ int dns_cache_remove(struct dns_cache *cache, char const *query)
 	return 0;
 }
 
-int dns_cache_find(struct dns_cache const *cache, const char *query, enum dns_query_type type,
+int dns_cache_find(struct dns_cache *cache, const char *query, enum dns_query_type type,
 		   struct dns_addrinfo *addrinfo, size_t addrinfo_array_len)
 {
 	size_t found = 0;
+	bool negative = false;
 	sa_family_t family;
+	uint16_t *bucket;
 
 	NET_DBG("Find \"%s\"", query);
 	if (cache == NULL || query == NULL || addrinfo == NULL || addrinfo_array_len <= 0) {
@@ -124,23 +278,33 @@ int dns_cache_find(struct dns_cache const *cache, const char *query, enum dns_qu
 
 	k_mutex_lock(cache->lock, K_FOREVER);
 
-	dns_cache_clean(cache);
+	bucket = dns_cache_bucket(cache, query);
 
-	for (size_t i = 0; i < cache->size; i++) {
-		if (!cache->entries[i].in_use) {
+	dns_cache_clean(cache, bucket, query, AF_UNSPEC);
+
+	for (uint16_t idx = *bucket; idx != 0U; idx = IDX_ENTRY(cache, idx)->next) {
+		struct dns_cache_entry *entry = IDX_ENTRY(cache, idx);
+
+		if (strcmp(entry->query, query) != 0) {
 			continue;
 		}
-		if (strcmp(cache->entries[i].query, query) != 0) {
+		if (entry->data.ai_family != family) {
 			continue;
 		}
-		if (cache->entries[i].data.ai_family != family) {
+
+		sys_dlist_remove(&entry->node);
+		sys_dlist_prepend(&cache->lru, &entry->node);
+
+		if (entry->negative) {
+			negative = true;
 			continue;
 		}
+
 		if (found >= addrinfo_array_len) {
 			NET_WARN("Found \"%s\" but not enough space in provided buffer.", query);
 			found++;
 		} else {
-			addrinfo[found] = cache->entries[i].data;
+			addrinfo[found] = entry->data;
 			found++;
 			NET_DBG("Found \"%s\"", query);
 		}
@@ -153,22 +317,12 @@ int dns_cache_find(struct dns_cache const *cache, const char *query, enum dns_qu
 	}
 
 	if (found == 0) {
-		NET_DBG("Could not find \"%s\"", query);
-	}
-	return found;
-}
-
-/* Needs to be called when lock is already acquired */
-static void dns_cache_clean(struct dns_cache const *cache)
-{
-	for (size_t i = 0; i < cache->size; i++) {
-		if (!cache->entries[i].in_use) {
-			continue;
+		if (negative) {
+			NET_DBG("Found negative \"%s\"", query);
+			return -ENOENT;
 		}
 
-		if (sys_timepoint_expired(cache->entries[i].expiry)) {
-			NET_DBG("Remove \"%s\"", cache->entries[i].query);
-			cache->entries[i].in_use = false;
-		}
+		NET_DBG("Could not find \"%s\"", query);
 	}
+	return found;
 }
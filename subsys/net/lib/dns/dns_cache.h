@@ -17,17 +17,32 @@
 #include <zephyr/net/dns_resolve.h>
 #include <zephyr/kernel.h>
 #include <zephyr/sys_clock.h>
+#include <zephyr/sys/dlist.h>
 
 struct dns_cache_entry {
 	char query[CONFIG_DNS_RESOLVER_MAX_QUERY_LEN];
 	struct dns_addrinfo data;
 	k_timepoint_t expiry;
+	/* Node in the LRU list when in use, in the free list otherwise */
+	sys_dnode_t node;
+	/* Index + 1 of the next entry in the hash chain, 0 at the end */
+	uint16_t next;
 	bool in_use;
+	/* The query is known not to resolve for this address family */
+	bool negative;
 };
 
 struct dns_cache {
 	size_t size;
 	struct dns_cache_entry *entries;
+	/* Index + 1 of the first entry of each hash chain, 0 if empty */
+	uint16_t *buckets;
+	/* Entries in use, most recently used first */
+	sys_dlist_t lru;
+	/* Released entries */
+	sys_dlist_t free;
+	/* Number of entries taken from the array so far */
+	size_t used;
 	struct k_mutex *lock;
 };
 
@@ -41,10 +56,17 @@ struct dns_cache {
  * @param name Name of the cache.
  */
 #define DNS_CACHE_DEFINE(name, cache_size)                                                         \
+	BUILD_ASSERT(cache_size > 0 && cache_size < UINT16_MAX, "Invalid DNS cache size");         \
 	static K_MUTEX_DEFINE(name##_mutex);                                                       \
 	static struct dns_cache_entry name##_entries[cache_size];                                  \
+	static uint16_t name##_buckets[cache_size];                                                \
 	static struct dns_cache name = {                                                           \
-		.entries = name##_entries, .size = cache_size, .lock = &name##_mutex};
+		.entries = name##_entries,                                                         \
+		.size = cache_size,                                                                \
+		.buckets = name##_buckets,                                                         \
+		.lru = SYS_DLIST_STATIC_INIT(&name.lru),                                           \
+		.free = SYS_DLIST_STATIC_INIT(&name.free),                                         \
+		.lock = &name##_mutex};
 
 /**
  * @brief Flushes the dns cache removing all its entries.
@@ -56,8 +78,8 @@ struct dns_cache {
 int dns_cache_flush(struct dns_cache *cache);
 
 /**
- * @brief Adds a new entry to the dns cache removing the one closest to expiry
- * if no free space is available.
+ * @brief Adds a new entry to the dns cache removing the least recently used
+ * one if no free space is available.
  *
  * @param cache Cache where the entry should be added.
  * @param query Query which should be persisted in the cache.
@@ -71,6 +93,23 @@ int dns_cache_flush(struct dns_cache *cache);
 int dns_cache_add(struct dns_cache *cache, char const *query, struct dns_addrinfo const *addrinfo,
 		  uint32_t ttl);
 
+/**
+ * @brief Records in the dns cache that a query has no answer (RFC 2308).
+ *
+ * The entries of the query for the same address type are replaced, so that
+ * dns_cache_find() reports the name as not existing until the entry expires.
+ *
+ * @param cache Cache where the entry should be added.
+ * @param query Query which did not resolve.
+ * @param type Query type which did not resolve.
+ * @param ttl Time to live for the entry in seconds, usually taken from the
+ * SOA record of the negative response.
+ * @retval 0 on success
+ * @retval On error, a negative value is returned.
+ */
+int dns_cache_add_negative(struct dns_cache *cache, char const *query, enum dns_query_type type,
+			   uint32_t ttl);
+
 /**
  * @brief Removes all entries with the given query
  *
@@ -84,6 +123,8 @@ int dns_cache_remove(struct dns_cache *cache, char const *query);
 /**
  * @brief Tries to find the specified query entry within the cache.
  *
+ * The entries found become the most recently used ones.
+ *
  * @param cache Cache where the entry should be searched.
  * @param query Query which should be searched for.
  * @param type Query type which will control the types of addresses that will be found.
@@ -94,8 +135,9 @@ int dns_cache_remove(struct dns_cache *cache, char const *query);
  * @retval On error a negative value is returned.
  * -ENOSR means there was not enough space in the addrinfo array to accommodate all cache hits the
  * array will however be filled with valid data.
+ * -ENOENT means the query is cached as not resolving, see dns_cache_add_negative().
  */
-int dns_cache_find(struct dns_cache const *cache, const char *query, enum dns_query_type type,
+int dns_cache_find(struct dns_cache *cache, const char *query, enum dns_query_type type,
 		   struct dns_addrinfo *addrinfo, size_t addrinfo_array_len);
 
 #endif /* ZEPHYR_INCLUDE_NET_DNS_CACHE_H_ */
@@ -366,6 +366,52 @@ int dns_unpack_response_query(struct dns_msg_t *dns_msg)
 	return 0;
 }
 
+int dns_unpack_negative_ttl(struct dns_msg_t *dns_msg, uint32_t *ttl)
+{
+	uint16_t offset = dns_msg->answer_offset;
+	int nscount = dns_header_nscount(dns_msg->msg);
+
+	for (int i = 0; i < nscount; i++) {
+		uint8_t *record = dns_msg->msg + offset;
+		int rem_size = dns_msg->msg_size - offset;
+		int dname_len;
+		int hdr_len;
+		uint16_t rdlength;
+
+		dname_len = skip_fqdn(record, rem_size);
+		if (dname_len < 0) {
+			return dname_len;
+		}
+
+		hdr_len = dname_len + DNS_COMMON_UINT_SIZE + DNS_COMMON_UINT_SIZE +
+			  DNS_TTL_LEN + DNS_RDLENGTH_LEN;
+		if (hdr_len > rem_size) {
+			return -EINVAL;
+		}
+
+		rdlength = dns_answer_rdlength(dname_len, record);
+		if (rdlength > rem_size - hdr_len) {
+			return -EINVAL;
+		}
+
+		/* The MINIMUM field ends the SOA RDATA, after the two names
+		 * and four other 32-bit fields, RFC 1035 3.3.13.
+		 */
+		if (dns_answer_type(dname_len, record) == DNS_RR_TYPE_SOA &&
+		    rdlength >= 2 + 5 * DNS_TTL_LEN) {
+			uint8_t *rdata = record + hdr_len;
+
+			*ttl = MIN((uint32_t)dns_answer_ttl(dname_len, record),
+				   sys_get_be32(rdata + rdlength - DNS_TTL_LEN));
+			return 0;
+		}
+
+		offset += hdr_len + rdlength;
+	}
+
+	return -ENOENT;
+}
+
 int dns_copy_qname(uint8_t *buf, uint16_t *len, uint16_t size,
 		   struct dns_msg_t *dns_msg, uint16_t pos)
 {
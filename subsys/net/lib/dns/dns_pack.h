@@ -89,6 +89,7 @@ enum dns_rr_type {
 	DNS_RR_TYPE_INVALID = 0,
 	DNS_RR_TYPE_A	= 1,		/* IPv4  */
 	DNS_RR_TYPE_CNAME = 5,		/* CNAME */
+	DNS_RR_TYPE_SOA = 6,		/* SOA   */
 	DNS_RR_TYPE_PTR = 12,		/* PTR   */
 	DNS_RR_TYPE_TXT = 16,		/* TXT   */
 	DNS_RR_TYPE_AAAA = 28,		/* IPv6  */
@@ -402,6 +403,22 @@ int dns_msg_pack_query(uint8_t *buf, uint16_t *len, uint16_t size,
  */
 int dns_unpack_response_query(struct dns_msg_t *dns_msg);
 
+/**
+ * @brief Gets the TTL of a negative response from its SOA record
+ *
+ * @details As described in RFC 2308 section 5, the TTL is the minimum of
+ *          the SOA record TTL and of its MINIMUM field. The SOA record is
+ *          looked for in the authority section, that must start at
+ *          dns_msg->answer_offset, so the response must not carry answers.
+ *
+ * @param dns_msg Structure containing the message.
+ * @param ttl TTL of the negative response.
+ * @retval 0 on success
+ * @retval -ENOENT if the response has no SOA record
+ * @retval -EINVAL if a record is malformed
+ */
+int dns_unpack_negative_ttl(struct dns_msg_t *dns_msg, uint32_t *ttl);
+
 /**
  * @brief Copies the qname from dns_msg to buf
  *
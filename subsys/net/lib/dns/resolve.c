@@ -1135,6 +1135,16 @@ rr_qtype_aaaa:
 	}
 
 	if (items == 0) {
+#if defined(CONFIG_DNS_RESOLVER_CACHE) && CONFIG_DNS_RESOLVER_CACHE_NEGATIVE_TTL_MAX > 0
+		/* Remember that the name does not exist, RFC 2308 */
+		if (*dns_id > 0 && dns_header_rcode(dns_msg->msg) == DNS_HEADER_NAMEERROR &&
+		    dns_unpack_negative_ttl(dns_msg, &ttl) == 0) {
+			dns_cache_add_negative(&dns_cache, ctx->queries[*query_idx].query,
+					       ctx->queries[*query_idx].query_type,
+					       MIN(ttl, CONFIG_DNS_RESOLVER_CACHE_NEGATIVE_TTL_MAX));
+		}
+#endif /* CONFIG_DNS_RESOLVER_CACHE */
+
 		ret = DNS_EAI_NODATA;
 	} else {
 		ret = DNS_EAI_ALLDONE;
@@ -1577,6 +1587,15 @@ try_resolve:
 
 			return 0;
 		}
+
+		if (ret == -ENOENT) {
+			/* The name is cached as not existing, report it
+			 * like the server did.
+			 */
+			cb(DNS_EAI_NODATA, NULL, user_data);
+
+			return 0;
+		}
 	}
 #else
 	ARG_UNUSED(use_cache);
@@ -44,15 +44,31 @@ const char *http_compression_text(enum http_compression compression);
 int http_compression_from_text(enum http_compression *compression, const char *text);
 bool compression_value_is_valid(enum http_compression compression);
 
+/* Static filesystem resource handling */
+#define HTTP_SERVER_ETAG_MAX_LEN sizeof("W/\"ffffffffffffffff-ffffffff-ffffffff\"")
+#define HTTP_SERVER_CONTENT_RANGE_MAX_LEN                                                          \
+	sizeof("bytes 18446744073709551615-18446744073709551615/18446744073709551615")
+
 /* Others */
 struct http_resource_detail *get_resource_detail(const struct http_service_desc *service,
 						 const char *path, int *len, bool is_ws);
+bool http_server_resource_match(struct http_resource_desc *resource, const char *path,
+				bool is_ws, int *len);
+int http_server_resource_index_lookup(const struct http_service_desc *service,
+				      const char *path, bool is_ws, int *len,
+				      struct http_resource_desc **resource);
 int http_server_sendall(struct http_client_ctx *client, const void *buf, size_t len);
 void http_server_get_content_type_from_extension(char *url, char *content_type,
 						 size_t content_type_size);
 int http_server_find_file(char *fname, size_t fname_size, size_t *file_size,
 			  uint8_t supported_compression, enum http_compression *chosen_compression);
+int http_server_fs_etag(const char *fname, size_t file_size, uint32_t generation, char *buf,
+			size_t buflen);
+bool http_server_etag_match(const char *list, const char *etag);
+int http_server_parse_range(const char *value, size_t file_size, size_t *start, size_t *end);
 void http_client_timer_restart(struct http_client_ctx *client);
+bool http_server_resource_acquire(struct http_resource_detail_dynamic *dynamic_detail,
+				  struct http_client_ctx *client);
 bool http_response_is_final(struct http_response_ctx *rsp, enum http_data_status status);
 bool http_response_is_provided(struct http_response_ctx *rsp);
 
@@ -106,7 +106,10 @@ static int http_hpack_find_index(struct http_hpack_header_buf *header,
 	     i <= HTTP_SERVER_HPACK_WWW_AUTHENTICATE; i++) {
 		entry = &http_hpack_table_static[i];
 
-		if (entry->name != NULL &&
+		/* Header names are non-empty, check the first character
+		 * before going through the whole name.
+		 */
+		if (entry->name != NULL && entry->name[0] == header->name[0] &&
 		    strlen(entry->name) == header->name_len &&
 		    memcmp(entry->name, header->name, header->name_len) == 0) {
 			if (entry->value != NULL &&
@@ -465,7 +468,7 @@ static int hpack_integer_encode(uint8_t *buf, size_t buflen, int value,
 			return -ENOBUFS;
 		}
 
-		*buf = (uint8_t)((value % 128) + 128);
+		*buf++ = (uint8_t)((value % 128) + 128);
 		len++;
 		value /= 128;
 	}
@@ -529,23 +532,16 @@ static int hpack_string_encode(uint8_t *buf, size_t buflen,
 	return len;
 }
 
-static int hpack_encode_literal(uint8_t *buf, size_t buflen,
+/* Encode a literal header field, with the name given by its index, or as a
+ * literal string if the index is 0.
+ */
+static int hpack_encode_literal(uint8_t *buf, size_t buflen, int index,
+				uint8_t prefix, uint8_t prefix_len,
 				struct http_hpack_header_buf *header)
 {
 	int ret, len = 0;
 
-	ret = hpack_integer_encode(buf, buflen, 0,
-				   HPACK_PREFIX_LITERAL_NEVER_INDEXED,
-				   HPACK_PREFIX_LEN_LITERAL_NEVER_INDEXED);
-	if (ret < 0) {
-		return ret;
-	}
-
-	buf += ret;
-	buflen -= ret;
-	len += ret;
-
-	ret = hpack_string_encode(buf, buflen, HPACK_HEADER_NAME, header);
+	ret = hpack_integer_encode(buf, buflen, index, prefix, prefix_len);
 	if (ret < 0) {
 		return ret;
 	}
@@ -554,32 +550,17 @@ static int hpack_encode_literal(uint8_t *buf, size_t buflen,
 	buflen -= ret;
 	len += ret;
 
-	ret = hpack_string_encode(buf, buflen, HPACK_HEADER_VALUE, header);
-	if (ret < 0) {
-		return ret;
-	}
-
-	len += ret;
-
-	return len;
-}
-
-static int hpack_encode_literal_value(uint8_t *buf, size_t buflen, int index,
-				      struct http_hpack_header_buf *header)
-{
-	int ret, len = 0;
+	if (index == 0) {
+		ret = hpack_string_encode(buf, buflen, HPACK_HEADER_NAME, header);
+		if (ret < 0) {
+			return ret;
+		}
 
-	ret = hpack_integer_encode(buf, buflen, index,
-				   HPACK_PREFIX_LITERAL_NEVER_INDEXED,
-				   HPACK_PREFIX_LEN_LITERAL_NEVER_INDEXED);
-	if (ret < 0) {
-		return ret;
+		buf += ret;
+		buflen -= ret;
+		len += ret;
 	}
 
-	buf += ret;
-	buflen -= ret;
-	len += ret;
-
 	ret = hpack_string_encode(buf, buflen, HPACK_HEADER_VALUE, header);
 	if (ret < 0) {
 		return ret;
@@ -615,10 +596,16 @@ int http_hpack_encode_header(uint8_t *buf, size_t buflen,
 	ret = http_hpack_find_index(header, &name_only);
 	if (ret < 0) {
 		/* All literal */
-		len = hpack_encode_literal(buf, buflen, header);
+		len = hpack_encode_literal(buf, buflen, 0,
+					   HPACK_PREFIX_LITERAL_NEVER_INDEXED,
+					   HPACK_PREFIX_LEN_LITERAL_NEVER_INDEXED,
+					   header);
 	} else if (name_only) {
 		/* Literal value */
-		len = hpack_encode_literal_value(buf, buflen, ret, header);
+		len = hpack_encode_literal(buf, buflen, ret,
+					   HPACK_PREFIX_LITERAL_NEVER_INDEXED,
+					   HPACK_PREFIX_LEN_LITERAL_NEVER_INDEXED,
+					   header);
 	} else {
 		/* Indexed */
 		len = hpack_encode_indexed(buf, buflen, ret);
@@ -626,3 +613,270 @@ int http_hpack_encode_header(uint8_t *buf, size_t buflen,
 
 	return len;
 }
+
+#if defined(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE)
+
+#define HPACK_DYNAMIC_TABLE_FIRST (HTTP_SERVER_HPACK_WWW_AUTHENTICATE + 1)
+
+/* Evict the oldest entries until the table fits in max_size. */
+static void hpack_dynamic_evict(struct http_hpack_encoder *encoder,
+				size_t max_size)
+{
+	size_t evicted_len = 0;
+	int evicted = 0;
+
+	while (encoder->size > max_size) {
+		size_t entry_len = encoder->entries[evicted].name_len +
+				   encoder->entries[evicted].value_len;
+
+		encoder->size -= entry_len + HTTP_HPACK_ENTRY_OVERHEAD;
+		evicted_len += entry_len;
+		evicted++;
+	}
+
+	if (evicted == 0) {
+		return;
+	}
+
+	encoder->count -= evicted;
+	encoder->data_len -= evicted_len;
+
+	memmove(encoder->data, encoder->data + evicted_len, encoder->data_len);
+	memmove(encoder->entries, encoder->entries + evicted,
+		encoder->count * sizeof(encoder->entries[0]));
+}
+
+static void hpack_dynamic_insert(struct http_hpack_encoder *encoder,
+				 struct http_hpack_header_buf *header)
+{
+	size_t entry_len = header->name_len + header->value_len;
+	uint8_t *data;
+
+	hpack_dynamic_evict(encoder, encoder->max_size - entry_len -
+				     HTTP_HPACK_ENTRY_OVERHEAD);
+
+	data = encoder->data + encoder->data_len;
+	memcpy(data, header->name, header->name_len);
+	memcpy(data + header->name_len, header->value, header->value_len);
+
+	encoder->entries[encoder->count].name_len = header->name_len;
+	encoder->entries[encoder->count].value_len = header->value_len;
+	encoder->count++;
+	encoder->data_len += entry_len;
+	encoder->size += entry_len + HTTP_HPACK_ENTRY_OVERHEAD;
+}
+
+/* Find the newest entry matching the header, the newest entry having the
+ * lowest index.
+ */
+static int hpack_dynamic_find_index(struct http_hpack_encoder *encoder,
+				    struct http_hpack_header_buf *header,
+				    bool *name_only)
+{
+	const uint8_t *data = encoder->data + encoder->data_len;
+	int candidate = -ENOENT;
+
+	for (int i = encoder->count - 1; i >= 0; i--) {
+		size_t name_len = encoder->entries[i].name_len;
+		size_t value_len = encoder->entries[i].value_len;
+		int index = HPACK_DYNAMIC_TABLE_FIRST + encoder->count - 1 - i;
+
+		data -= name_len + value_len;
+
+		if (name_len != header->name_len ||
+		    memcmp(data, header->name, name_len) != 0) {
+			continue;
+		}
+
+		if (value_len == header->value_len &&
+		    memcmp(data + name_len, header->value, value_len) == 0) {
+			/* Got exact match. */
+			*name_only = false;
+			return index;
+		}
+
+		if (candidate < 0) {
+			candidate = index;
+		}
+	}
+
+	if (candidate > 0) {
+		/* Matched name only. */
+		*name_only = true;
+	}
+
+	return candidate;
+}
+
+/* Header fields changing with every response would only evict the reusable
+ * entries from the table.
+ */
+static bool hpack_dynamic_should_index(struct http_hpack_encoder *encoder,
+				       struct http_hpack_header_buf *header,
+				       int static_index)
+{
+	switch (static_index) {
+	case HTTP_SERVER_HPACK_AGE:
+	case HTTP_SERVER_HPACK_AUTHORIZATION:
+	case HTTP_SERVER_HPACK_CONTENT_LENGTH:
+	case HTTP_SERVER_HPACK_CONTENT_RANGE:
+	case HTTP_SERVER_HPACK_DATE:
+	case HTTP_SERVER_HPACK_ETAG:
+	case HTTP_SERVER_HPACK_EXPIRES:
+	case HTTP_SERVER_HPACK_LAST_MODIFIED:
+	case HTTP_SERVER_HPACK_SET_COOKIE:
+		return false;
+	default:
+		break;
+	}
+
+	return header->name_len + header->value_len + HTTP_HPACK_ENTRY_OVERHEAD <=
+	       encoder->max_size;
+}
+
+static int hpack_encode_size_update(struct http_hpack_encoder *encoder,
+				    uint8_t *buf, size_t buflen)
+{
+	int ret, len = 0;
+
+	/* Signal the smallest size the table went through first, so that
+	 * the decoder evicts the same entries.
+	 */
+	if (encoder->min_size < encoder->max_size) {
+		ret = hpack_integer_encode(buf, buflen, encoder->min_size,
+					   HPACK_PREFIX_DYNAMIC_TABLE_SIZE_UPDATE,
+					   HPACK_PREFIX_LEN_DYNAMIC_TABLE_SIZE_UPDATE);
+		if (ret < 0) {
+			return ret;
+		}
+
+		buf += ret;
+		buflen -= ret;
+		len += ret;
+	}
+
+	ret = hpack_integer_encode(buf, buflen, encoder->max_size,
+				   HPACK_PREFIX_DYNAMIC_TABLE_SIZE_UPDATE,
+				   HPACK_PREFIX_LEN_DYNAMIC_TABLE_SIZE_UPDATE);
+	if (ret < 0) {
+		return ret;
+	}
+
+	len += ret;
+
+	return len;
+}
+
+void http_hpack_encoder_init(struct http_hpack_encoder *encoder)
+{
+	encoder->count = 0;
+	encoder->data_len = 0;
+	encoder->size = 0;
+	encoder->max_size = CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE;
+	encoder->min_size = encoder->max_size;
+
+	/* The decoder starts with a 4096 bytes table, let it know about the
+	 * actual size with the first header block.
+	 */
+	encoder->size_update = true;
+}
+
+void http_hpack_encoder_set_max_size(struct http_hpack_encoder *encoder,
+				     uint32_t max_size)
+{
+	max_size = MIN(max_size, CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE);
+
+	if (max_size == encoder->max_size) {
+		return;
+	}
+
+	hpack_dynamic_evict(encoder, max_size);
+
+	if (!encoder->size_update || max_size < encoder->min_size) {
+		encoder->min_size = max_size;
+	}
+
+	encoder->max_size = max_size;
+	encoder->size_update = true;
+}
+
+int http_hpack_encoder_encode_header(struct http_hpack_encoder *encoder,
+				     uint8_t *buf, size_t buflen,
+				     struct http_hpack_header_buf *header)
+{
+	int static_index, index, ret, len = 0;
+	bool name_only, insert = false;
+
+	if (encoder == NULL || buf == NULL || header == NULL ||
+	    header->name == NULL || header->name_len == 0 ||
+	    header->value == NULL || header->value_len == 0) {
+		return -EINVAL;
+	}
+
+	if (buflen == 0) {
+		return -ENOBUFS;
+	}
+
+	if (encoder->size_update) {
+		ret = hpack_encode_size_update(encoder, buf, buflen);
+		if (ret < 0) {
+			return ret;
+		}
+
+		buf += ret;
+		buflen -= ret;
+		len += ret;
+	}
+
+	static_index = http_hpack_find_index(header, &name_only);
+	if (static_index > 0 && !name_only) {
+		/* Indexed from the static table */
+		ret = hpack_encode_indexed(buf, buflen, static_index);
+		goto out;
+	}
+
+	index = hpack_dynamic_find_index(encoder, header, &name_only);
+	if (index > 0 && !name_only) {
+		/* Indexed from the dynamic table */
+		ret = hpack_encode_indexed(buf, buflen, index);
+		goto out;
+	}
+
+	/* Prefer the static table for the name, it does not get evicted. */
+	if (static_index > 0) {
+		index = static_index;
+	} else if (index < 0) {
+		index = 0;
+	}
+
+	if (hpack_dynamic_should_index(encoder, header, static_index)) {
+		ret = hpack_encode_literal(buf, buflen, index,
+					   HPACK_PREFIX_LITERAL_INDEXING,
+					   HPACK_PREFIX_LEN_LITERAL_INDEXING,
+					   header);
+		insert = true;
+	} else {
+		ret = hpack_encode_literal(buf, buflen, index,
+					   HPACK_PREFIX_LITERAL_NEVER_INDEXED,
+					   HPACK_PREFIX_LEN_LITERAL_NEVER_INDEXED,
+					   header);
+	}
+
+out:
+	if (ret < 0) {
+		return ret;
+	}
+
+	/* Only update the table once the header field is encoded, as the
+	 * decoder does.
+	 */
+	if (insert) {
+		hpack_dynamic_insert(encoder, header);
+	}
+
+	encoder->size_update = false;
+
+	return len + ret;
+}
+
+#endif /* CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE */
@@ -286,41 +286,102 @@ static const struct decode_elem eos = {
 #define MSB_MASK(len) (UINT32_MAX << (UINT32_BITLEN - len))
 #define LSB_MASK(len) ((1UL << len) - 1UL)
 
-static bool huffman_bits_compare(uint32_t bits, const struct decode_elem *entry)
-{
-	uint32_t mask = MSB_MASK(entry->bitlen);
-	uint32_t code = sys_get_be32(entry->code);
+/* The codes are canonical, sorted by length and value in decode_table, so the
+ * symbol of a code of a given length is found with its offset from the first
+ * code of that length. The codes of up to 8 bits, used for the most common
+ * characters, are looked up directly with the first byte of the input.
+ */
+#define DECODE_LUT_BITS 8
+#define DECODE_LUT_NONE 0xff
+
+/* Index in decode_table of the code starting with the given byte. */
+static const uint8_t decode_lut[256] = {
+	  0,   0,   0,   0,   0,   0,   0,   0,   1,   1,   1,   1,   1,   1,   1,   1,
+	  2,   2,   2,   2,   2,   2,   2,   2,   3,   3,   3,   3,   3,   3,   3,   3,
+	  4,   4,   4,   4,   4,   4,   4,   4,   5,   5,   5,   5,   5,   5,   5,   5,
+	  6,   6,   6,   6,   6,   6,   6,   6,   7,   7,   7,   7,   7,   7,   7,   7,
+	  8,   8,   8,   8,   8,   8,   8,   8,   9,   9,   9,   9,   9,   9,   9,   9,
+	 10,  10,  10,  10,  11,  11,  11,  11,  12,  12,  12,  12,  13,  13,  13,  13,
+	 14,  14,  14,  14,  15,  15,  15,  15,  16,  16,  16,  16,  17,  17,  17,  17,
+	 18,  18,  18,  18,  19,  19,  19,  19,  20,  20,  20,  20,  21,  21,  21,  21,
+	 22,  22,  22,  22,  23,  23,  23,  23,  24,  24,  24,  24,  25,  25,  25,  25,
+	 26,  26,  26,  26,  27,  27,  27,  27,  28,  28,  28,  28,  29,  29,  29,  29,
+	 30,  30,  30,  30,  31,  31,  31,  31,  32,  32,  32,  32,  33,  33,  33,  33,
+	 34,  34,  34,  34,  35,  35,  35,  35,  36,  36,  37,  37,  38,  38,  39,  39,
+	 40,  40,  41,  41,  42,  42,  43,  43,  44,  44,  45,  45,  46,  46,  47,  47,
+	 48,  48,  49,  49,  50,  50,  51,  51,  52,  52,  53,  53,  54,  54,  55,  55,
+	 56,  56,  57,  57,  58,  58,  59,  59,  60,  60,  61,  61,  62,  62,  63,  63,
+	 64,  64,  65,  65,  66,  66,  67,  67,  68,  69,  70,  71,  72,  73, 255, 255,
+};
 
-	if (code == (bits & mask)) {
-		return true;
-	}
+struct decode_group {
+	uint8_t bitlen;
+	uint8_t index;
+	uint8_t count;
+	uint32_t first;
+};
 
-	return false;
-}
+/* Codes longer than DECODE_LUT_BITS, grouped by length. */
+static const struct decode_group decode_groups[] = {
+	{ 10,  74,  5, 0x000003f8 },
+	{ 11,  79,  3, 0x000007fa },
+	{ 12,  82,  2, 0x00000ffa },
+	{ 13,  84,  6, 0x00001ff8 },
+	{ 14,  90,  2, 0x00003ffc },
+	{ 15,  92,  3, 0x00007ffc },
+	{ 19,  95,  3, 0x0007fff0 },
+	{ 20,  98,  8, 0x000fffe6 },
+	{ 21, 106, 13, 0x001fffdc },
+	{ 22, 119, 26, 0x003fffd2 },
+	{ 23, 145, 29, 0x007fffd8 },
+	{ 24, 174, 12, 0x00ffffea },
+	{ 25, 186,  4, 0x01ffffec },
+	{ 26, 190, 15, 0x03ffffe0 },
+	{ 27, 205, 19, 0x07ffffde },
+	{ 28, 224, 29, 0x0fffffe2 },
+	{ 30, 253,  3, 0x3ffffffc },
+};
+
+/* Index in decode_table of each symbol. */
+static const uint8_t encode_index[256] = {
+	 84, 145, 224, 225, 226, 227, 228, 229, 230, 174, 253, 231, 232, 254, 233, 234,
+	235, 236, 237, 238, 239, 240, 255, 241, 242, 243, 244, 245, 246, 247, 248, 249,
+	 10,  74,  75,  82,  85,  11,  68,  79,  76,  77,  69,  80,  70,  12,  13,  14,
+	  0,   1,   2,  15,  16,  17,  18,  19,  20,  21,  36,  71,  92,  22,  83,  78,
+	 86,  23,  37,  38,  39,  40,  41,  42,  43,  44,  45,  46,  47,  48,  49,  50,
+	 51,  52,  53,  54,  55,  56,  57,  58,  72,  59,  73,  87,  95,  88,  90,  24,
+	 93,   3,  25,   4,  26,   5,  27,  28,  29,   6,  60,  61,  30,  31,  32,   7,
+	 33,  62,  34,   8,   9,  35,  63,  64,  65,  66,  67,  94,  81,  91,  89, 250,
+	 98, 119,  99, 100, 120, 121, 122, 146, 123, 147, 148, 149, 150, 151, 175, 152,
+	176, 177, 124, 153, 178, 154, 155, 156, 157, 106, 125, 158, 126, 159, 160, 179,
+	127, 107, 101, 128, 129, 161, 162, 108, 163, 130, 131, 180, 109, 132, 164, 165,
+	110, 111, 133, 112, 166, 134, 167, 168, 102, 135, 136, 137, 169, 138, 139, 170,
+	190, 191, 103,  96, 140, 171, 141, 186, 192, 193, 194, 205, 206, 195, 181, 187,
+	 97, 113, 196, 207, 208, 197, 209, 182, 114, 115, 198, 199, 251, 210, 211, 212,
+	104, 183, 105, 116, 142, 117, 118, 172, 143, 144, 188, 189, 184, 185, 200, 173,
+	201, 213, 202, 203, 214, 215, 216, 217, 218, 252, 219, 220, 221, 222, 223, 204,
+};
 
 static const struct decode_elem *huffman_decode_bits(uint32_t bits)
 {
-	for (int i = 0; i < ARRAY_SIZE(decode_table); i++) {
-		if (huffman_bits_compare(bits, &decode_table[i])) {
-			return &decode_table[i];
-		}
-	}
+	uint8_t index = decode_lut[bits >> (UINT32_BITLEN - DECODE_LUT_BITS)];
 
-	if (huffman_bits_compare(bits, &eos)) {
-		return &eos;
+	if (index != DECODE_LUT_NONE) {
+		return &decode_table[index];
 	}
 
-	return NULL;
-}
+	ARRAY_FOR_EACH_PTR(decode_groups, group) {
+		uint32_t offset = (bits >> (UINT32_BITLEN - group->bitlen)) - group->first;
 
-static const struct decode_elem *huffman_find_entry(uint8_t symbol)
-{
-	for (int i = 0; i < ARRAY_SIZE(decode_table); i++) {
-		if (decode_table[i].symbol == symbol) {
-			return &decode_table[i];
+		if (offset < group->count) {
+			return &decode_table[group->index + offset];
 		}
 	}
 
+	if ((bits & MSB_MASK(eos.bitlen)) == sys_get_be32(eos.code)) {
+		return &eos;
+	}
+
 	return NULL;
 }
 
@@ -330,49 +391,32 @@ int http_hpack_huffman_decode(const uint8_t *encoded_buf, size_t encoded_len,
 			      uint8_t *buf, size_t buflen)
 {
 	size_t encoded_bits_len = encoded_len * 8;
-	uint8_t bits_needed = UINT32_BITLEN;
 	const struct decode_elem *decoded;
-	uint8_t bits_in_byte_left = 8;
 	size_t decoded_len = 0;
-	uint32_t bits = 0;
+	uint8_t acc_bits = 0;
+	uint64_t acc = 0;
 
 	if (encoded_buf == NULL || buf == NULL || encoded_len == 0) {
 		return -EINVAL;
 	}
 
 	while (encoded_bits_len > 0) {
-		/* Refill the bits variable */
-		while (bits_needed > 0) {
-			if (encoded_len > 0) {
-				if (bits_in_byte_left <= bits_needed) {
-					/* Consume rest of the byte */
-					bits <<= bits_in_byte_left;
-					bits |= *encoded_buf &
-						    LSB_MASK(bits_in_byte_left);
-					bits_needed -= bits_in_byte_left;
-					bits_in_byte_left = 0;
-				} else {
-					/* Consume part of the byte */
-					bits <<= bits_needed;
-					bits |= (*encoded_buf >>
-						 (bits_in_byte_left - bits_needed)) &
-						LSB_MASK(bits_needed);
-					bits_in_byte_left -= bits_needed;
-					bits_needed = 0;
-				}
-			} else {
-				/* Pad with ones */
-				bits <<= bits_needed;
-				bits |= LSB_MASK(bits_needed);
-				bits_needed = 0;
-			}
+		uint32_t bits;
+
+		/* Refill the accumulator a byte at a time, the bits to decode
+		 * being kept left-aligned.
+		 */
+		while (acc_bits <= 56 && encoded_len > 0) {
+			acc |= (uint64_t)*encoded_buf << (56 - acc_bits);
+			acc_bits += 8;
+			encoded_buf++;
+			encoded_len--;
+		}
 
-			/* Move to next encoded byte */
-			if (bits_in_byte_left == 0) {
-				encoded_buf++;
-				encoded_len--;
-				bits_in_byte_left = 8;
-			}
+		bits = (uint32_t)(acc >> UINT32_BITLEN);
+		if (acc_bits < UINT32_BITLEN) {
+			/* Pad with ones */
+			bits |= UINT32_MAX >> acc_bits;
 		}
 
 		/* Pass to decoder */
@@ -396,8 +440,9 @@ int http_hpack_huffman_decode(const uint8_t *encoded_buf, size_t encoded_len,
 			return -EBADMSG;
 		}
 
-		/* Remove consumed bits from bits variable. */
-		bits_needed += decoded->bitlen;
+		/* Remove consumed bits from the accumulator. */
+		acc <<= decoded->bitlen;
+		acc_bits -= decoded->bitlen;
 		encoded_bits_len -= decoded->bitlen;
 
 		/* Store decoded symbol */
@@ -419,8 +464,8 @@ int http_hpack_huffman_encode(const uint8_t *str, size_t str_len,
 			      uint8_t *buf, size_t buflen)
 {
 	const struct decode_elem *entry;
-	size_t buflen_bits = buflen * 8;
-	uint8_t bit_offset = 0;
+	uint8_t acc_bits = 0;
+	uint64_t acc = 0;
 	int len = 0;
 
 	if (str == NULL || buf == NULL || str_len == 0) {
@@ -428,52 +473,35 @@ int http_hpack_huffman_encode(const uint8_t *str, size_t str_len,
 	}
 
 	while (str_len > 0) {
-		uint32_t code;
-		uint8_t bitlen;
-
-		entry = huffman_find_entry(*str);
-		if (entry == NULL) {
-			return -EINVAL;
-		}
-
-		if (entry->bitlen > buflen_bits) {
-			return -ENOBUFS;
-		}
+		entry = &decode_table[encode_index[*str]];
 
-		bitlen = entry->bitlen;
-		code = sys_get_be32(entry->code);
+		/* Append the code to the left-aligned pending bits, and output
+		 * the complete bytes.
+		 */
+		acc |= (uint64_t)sys_get_be32(entry->code) << (UINT32_BITLEN - acc_bits);
+		acc_bits += entry->bitlen;
 
-		while (bitlen > 0) {
-			uint8_t to_copy = MIN(8 - bit_offset, bitlen);
-			uint8_t byte = (uint8_t)((code & MSB_MASK(to_copy)) >>
-						 (24 + bit_offset));
-
-			/* This is way suboptimal */
-			if (bit_offset == 0) {
-				*buf = byte;
-			} else {
-				*buf |= byte;
+		while (acc_bits >= 8) {
+			if (len >= buflen) {
+				return -ENOBUFS;
 			}
 
-			code <<= to_copy;
-			bitlen -= to_copy;
-			bit_offset  = (bit_offset + to_copy) % 8;
-
-			if (bit_offset == 0) {
-				buf++;
-				len++;
-			}
+			buf[len++] = (uint8_t)(acc >> 56);
+			acc <<= 8;
+			acc_bits -= 8;
 		}
 
-		buflen_bits -= entry->bitlen;
 		str_len--;
 		str++;
 	}
 
 	/* Pad with ones. */
-	if (bit_offset > 0) {
-		*buf |= LSB_MASK((8 - bit_offset));
-		len++;
+	if (acc_bits > 0) {
+		if (len >= buflen) {
+			return -ENOBUFS;
+		}
+
+		buf[len++] = (uint8_t)(acc >> 56) | LSB_MASK((8 - acc_bits));
 	}
 
 	return len;
@@ -42,6 +42,50 @@ LOG_MODULE_REGISTER(net_http_server, CONFIG_NET_HTTP_SERVER_LOG_LEVEL);
 #define HTTP_SERVER_MAX_SERVICES CONFIG_HTTP_SERVER_NUM_SERVICES
 #define HTTP_SERVER_MAX_CLIENTS  CONFIG_HTTP_SERVER_MAX_CLIENTS
 #define HTTP_SERVER_SOCK_COUNT (1 + HTTP_SERVER_MAX_SERVICES + HTTP_SERVER_MAX_CLIENTS)
+#define HTTP_SERVER_NUM_WORKERS  CONFIG_HTTP_SERVER_NUM_WORKERS
+
+#if HTTP_SERVER_NUM_WORKERS > 0
+BUILD_ASSERT(HTTP_SERVER_MAX_CLIENTS >= HTTP_SERVER_NUM_WORKERS,
+	     "Each HTTP server worker needs at least one client slot");
+
+#define HTTP_SERVER_WORKER_MAX_CLIENTS \
+	DIV_ROUND_UP(HTTP_SERVER_MAX_CLIENTS, HTTP_SERVER_NUM_WORKERS)
+
+struct http_server_accept_msg {
+	int fd;
+	const struct http_service_desc *service;
+};
+
+struct http_server_worker {
+	struct k_thread thread;
+
+	/* Newly accepted connections handed over by the server thread */
+	struct k_msgq accept_q;
+	char __aligned(4) accept_q_buf[HTTP_SERVER_WORKER_MAX_CLIENTS *
+				       sizeof(struct http_server_accept_msg)];
+
+	/* First pollfd is eventfd used to wake up the worker, then we have
+	 * the accepted sockets owned by this worker.
+	 */
+	struct zsock_pollfd fds[1 + HTTP_SERVER_WORKER_MAX_CLIENTS];
+
+	/* Slice of the server client contexts owned by this worker */
+	struct http_client_ctx *clients;
+	int max_clients;
+
+	/* Connections dispatched to this worker and not yet released */
+	atomic_t num_clients;
+	bool stopping;
+};
+
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, HTTP_SERVER_NUM_WORKERS,
+				   CONFIG_HTTP_SERVER_WORKER_STACK_SIZE);
+
+/* Protects the per-service client counters shared by the server thread
+ * and the workers.
+ */
+static struct k_spinlock clients_lock;
+#endif /* HTTP_SERVER_NUM_WORKERS > 0 */
 
 struct http_server_ctx {
 	int listen_fds; /* max value of 1 + MAX_SERVICES */
@@ -52,6 +96,13 @@ struct http_server_ctx {
 	 */
 	struct zsock_pollfd fds[HTTP_SERVER_SOCK_COUNT];
 	struct http_client_ctx clients[HTTP_SERVER_MAX_CLIENTS];
+
+#if HTTP_SERVER_NUM_WORKERS > 0
+	struct http_server_worker workers[HTTP_SERVER_NUM_WORKERS];
+	atomic_t stop_requested;
+	atomic_t accept_paused;
+	atomic_t worker_error;
+#endif
 };
 
 static struct http_server_ctx server_ctx;
@@ -345,15 +396,63 @@ static void client_release_resources(struct http_client_ctx *client)
 	}
 }
 
-void http_server_release_client(struct http_client_ctx *client)
+bool http_server_resource_acquire(struct http_resource_detail_dynamic *dynamic_detail,
+				  struct http_client_ctx *client)
 {
-	int i;
-	struct k_work_sync sync;
+	/* With worker threads, clients served by different workers may race
+	 * for the same dynamic resource.
+	 */
+	if (atomic_ptr_cas((atomic_ptr_t *)&dynamic_detail->holder, NULL, client)) {
+		return true;
+	}
 
-	__ASSERT_NO_MSG(IS_ARRAY_ELEMENT(server_ctx.clients, client));
+	return dynamic_detail->holder == client;
+}
 
-	k_work_cancel_delayable_sync(&client->inactivity_timer, &sync);
-	client_release_resources(client);
+#if HTTP_SERVER_NUM_WORKERS > 0
+static struct http_server_worker *client_worker(struct http_client_ctx *client)
+{
+	ARRAY_FOR_EACH_PTR(server_ctx.workers, worker) {
+		if (client >= worker->clients &&
+		    client < worker->clients + worker->max_clients) {
+			return worker;
+		}
+	}
+
+	return NULL;
+}
+
+static void service_client_put(const struct http_service_desc *service)
+{
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&clients_lock);
+	service->data->num_clients--;
+	k_spin_unlock(&clients_lock, key);
+
+	/* Wake up the server thread so it can resume accepting connections
+	 * if it stopped doing so due to lack of free client slots.
+	 */
+	if (atomic_get(&server_ctx.accept_paused)) {
+		eventfd_write(server_ctx.fds[0].fd, 1);
+	}
+}
+
+static void worker_release_client(struct http_client_ctx *client)
+{
+	struct http_server_worker *worker = client_worker(client);
+
+	__ASSERT_NO_MSG(worker != NULL);
+
+	worker->fds[client - worker->clients + 1].fd = INVALID_SOCK;
+	atomic_dec(&worker->num_clients);
+
+	service_client_put(client->service);
+}
+#else
+static void server_release_client_slot(struct http_client_ctx *client)
+{
+	int i;
 
 	client->service->data->num_clients--;
 
@@ -369,6 +468,23 @@ void http_server_release_client(struct http_client_ctx *client)
 			break;
 		}
 	}
+}
+#endif /* HTTP_SERVER_NUM_WORKERS > 0 */
+
+void http_server_release_client(struct http_client_ctx *client)
+{
+	struct k_work_sync sync;
+
+	__ASSERT_NO_MSG(IS_ARRAY_ELEMENT(server_ctx.clients, client));
+
+	k_work_cancel_delayable_sync(&client->inactivity_timer, &sync);
+	client_release_resources(client);
+
+#if HTTP_SERVER_NUM_WORKERS > 0
+	worker_release_client(client);
+#else
+	server_release_client_slot(client);
+#endif
 
 	memset(client, 0, sizeof(struct http_client_ctx));
 	client->fd = INVALID_SOCK;
@@ -426,6 +542,10 @@ static void init_client_ctx(struct http_client_ctx *client, const struct http_se
 	client->preface_sent = false;
 	client->window_size = HTTP_SERVER_INITIAL_WINDOW_SIZE;
 
+#if defined(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE)
+	http_hpack_encoder_init(&client->hpack_encoder);
+#endif
+
 	memset(client->buffer, 0, sizeof(client->buffer));
 	memset(client->url_buffer, 0, sizeof(client->url_buffer));
 	k_work_init_delayable(&client->inactivity_timer, client_timeout);
@@ -544,9 +664,68 @@ static int handle_http_request(struct http_client_ctx *client)
 	return 0;
 }
 
+static void handle_client_poll(struct http_client_ctx *client, short revents)
+{
+	int ret;
+	int sock_error;
+	socklen_t optlen = sizeof(int);
+
+	if (revents & ZSOCK_POLLHUP) {
+		LOG_DBG("Client #%d has disconnected", ARRAY_INDEX(server_ctx.clients, client));
+		close_client_connection(client);
+		return;
+	}
+
+	if (revents & ZSOCK_POLLERR) {
+		(void)zsock_getsockopt(client->fd, SOL_SOCKET, SO_ERROR, &sock_error, &optlen);
+		LOG_DBG("Error on fd %d %d", client->fd, sock_error);
+		close_client_connection(client);
+		return;
+	}
+
+	if (!(revents & ZSOCK_POLLIN)) {
+		return;
+	}
+
+	ret = zsock_recv(client->fd, client->buffer + client->data_len,
+			 sizeof(client->buffer) - client->data_len, 0);
+	if (ret <= 0) {
+		if (ret == 0) {
+			LOG_DBG("Connection closed by peer for client #%d",
+				ARRAY_INDEX(server_ctx.clients, client));
+		} else {
+			ret = -errno;
+			LOG_DBG("ERROR reading from socket (%d)", ret);
+		}
+
+		close_client_connection(client);
+		return;
+	}
+
+	client->data_len += ret;
+
+	http_client_timer_restart(client);
+
+	ret = handle_http_request(client);
+	if (ret < 0 && ret != -EAGAIN) {
+		if (ret == -ENOTCONN) {
+			LOG_DBG("Client closed connection while handling request");
+		} else {
+			LOG_ERR("HTTP request handling error (%d)", ret);
+		}
+		close_client_connection(client);
+	} else if (client->data_len == sizeof(client->buffer)) {
+		/* If the RX buffer is still full after parsing,
+		 * it means we won't be able to handle this request
+		 * with the current buffer size.
+		 */
+		LOG_ERR("RX buffer too small to handle request");
+		close_client_connection(client);
+	}
+}
+
 static int http_server_run(struct http_server_ctx *ctx)
 {
-	struct http_client_ctx *client;
 	const struct http_service_desc *service;
 	eventfd_t value;
 	bool found_slot;
@@ -582,15 +761,13 @@ static int http_server_run(struct http_server_ctx *ctx)
 				continue;
 			}
 
-			if (ctx->fds[i].revents & ZSOCK_POLLHUP) {
-				if (i >= ctx->listen_fds) {
-					LOG_DBG("Client #%d has disconnected",
-						i - ctx->listen_fds);
-
-					client = &ctx->clients[i - ctx->listen_fds];
-					close_client_connection(client);
-				}
+			if (i >= ctx->listen_fds) {
+				handle_client_poll(&ctx->clients[i - ctx->listen_fds],
+						   ctx->fds[i].revents);
+				continue;
+			}
 
+			if (ctx->fds[i].revents & ZSOCK_POLLHUP) {
 				continue;
 			}
 
@@ -599,12 +776,6 @@ static int http_server_run(struct http_server_ctx *ctx)
 						       SO_ERROR, &sock_error, &optlen);
 				LOG_DBG("Error on fd %d %d", ctx->fds[i].fd, sock_error);
 
-				if (i >= ctx->listen_fds) {
-					client = &ctx->clients[i - ctx->listen_fds];
-					close_client_connection(client);
-					continue;
-				}
-
 				/* Listening socket error, abort. */
 				LOG_ERR("Listening socket error, aborting.");
 				ret = -sock_error;
@@ -616,100 +787,369 @@ static int http_server_run(struct http_server_ctx *ctx)
 				continue;
 			}
 
-			/* First check if we have something to accept */
-			if (i < ctx->listen_fds) {
-				service = lookup_service(ctx->fds[i].fd);
-				__ASSERT(NULL != service, "fd not associated with a service");
+			/* Listening socket, accept the new connection */
+			service = lookup_service(ctx->fds[i].fd);
+			__ASSERT(NULL != service, "fd not associated with a service");
 
-				if (service->data->num_clients >= service->concurrent) {
-					ctx->fds[i].events = 0;
-					continue;
-				}
+			if (service->data->num_clients >= service->concurrent) {
+				ctx->fds[i].events = 0;
+				continue;
+			}
+
+			new_socket = accept_new_client(ctx->fds[i].fd);
+			if (new_socket < 0) {
+				ret = -errno;
+				LOG_DBG("accept: %d", ret);
+				continue;
+			}
 
-				new_socket = accept_new_client(ctx->fds[i].fd);
-				if (new_socket < 0) {
-					ret = -errno;
-					LOG_DBG("accept: %d", ret);
+			found_slot = false;
+
+			for (j = ctx->listen_fds; j < ARRAY_SIZE(ctx->fds); j++) {
+				if (ctx->fds[j].fd != INVALID_SOCK) {
 					continue;
 				}
 
-				found_slot = false;
+				ctx->fds[j].fd = new_socket;
+				ctx->fds[j].events = ZSOCK_POLLIN;
+				ctx->fds[j].revents = 0;
 
-				for (j = ctx->listen_fds; j < ARRAY_SIZE(ctx->fds); j++) {
-					if (ctx->fds[j].fd != INVALID_SOCK) {
-						continue;
-					}
+				service->data->num_clients++;
 
-					ctx->fds[j].fd = new_socket;
-					ctx->fds[j].events = ZSOCK_POLLIN;
-					ctx->fds[j].revents = 0;
+				LOG_DBG("Init client #%d", j - ctx->listen_fds);
 
-					service->data->num_clients++;
+				init_client_ctx(&ctx->clients[j - ctx->listen_fds], service,
+						new_socket);
+				found_slot = true;
+				break;
+			}
 
-					LOG_DBG("Init client #%d", j - ctx->listen_fds);
+			if (!found_slot) {
+				LOG_DBG("No free slot found.");
+				zsock_close(new_socket);
+			}
+		}
+	}
 
-					init_client_ctx(&ctx->clients[j - ctx->listen_fds], service,
-							new_socket);
-					found_slot = true;
-					break;
-				}
+	return 0;
 
-				if (!found_slot) {
-					LOG_DBG("No free slot found.");
-					zsock_close(new_socket);
-				}
+closing:
+	/* Close all client connections and the server socket */
+	close_all_sockets(ctx);
+	return ret;
+}
 
-				continue;
-			}
+#if HTTP_SERVER_NUM_WORKERS > 0
+static void worker_add_client(struct http_server_worker *worker,
+			      const struct http_server_accept_msg *msg)
+{
+	for (int i = 1; i <= worker->max_clients; i++) {
+		if (worker->fds[i].fd != INVALID_SOCK) {
+			continue;
+		}
 
-			/* Client sock */
-			client = &ctx->clients[i - ctx->listen_fds];
+		worker->fds[i].fd = msg->fd;
+		worker->fds[i].events = ZSOCK_POLLIN;
+		worker->fds[i].revents = 0;
 
-			ret = zsock_recv(client->fd, client->buffer + client->data_len,
-					 sizeof(client->buffer) - client->data_len, 0);
-			if (ret <= 0) {
-				if (ret == 0) {
-					LOG_DBG("Connection closed by peer for client #%d",
-						i - ctx->listen_fds);
-				} else {
-					ret = -errno;
-					LOG_DBG("ERROR reading from socket (%d)", ret);
-				}
+		LOG_DBG("Init client #%d", ARRAY_INDEX(server_ctx.clients, &worker->clients[i - 1]));
+
+		init_client_ctx(&worker->clients[i - 1], msg->service, msg->fd);
+		return;
+	}
+
+	/* Should not happen, the server thread never dispatches more
+	 * connections than the worker has free slots.
+	 */
+	LOG_ERR("No free slot found.");
+	zsock_close(msg->fd);
+	atomic_dec(&worker->num_clients);
+	service_client_put(msg->service);
+}
+
+static void worker_close_clients(struct http_server_worker *worker)
+{
+	struct http_server_accept_msg msg;
+
+	for (int i = 1; i <= worker->max_clients; i++) {
+		if (worker->fds[i].fd != INVALID_SOCK) {
+			close_client_connection(&worker->clients[i - 1]);
+		}
+	}
+
+	/* Connections dispatched but never picked up */
+	while (k_msgq_get(&worker->accept_q, &msg, K_NO_WAIT) == 0) {
+		zsock_close(msg.fd);
+		atomic_dec(&worker->num_clients);
+		service_client_put(msg.service);
+	}
+}
+
+static void http_server_worker_thread(void *p1, void *p2, void *p3)
+{
+	struct http_server_worker *worker = p1;
+	struct http_server_accept_msg msg;
+	eventfd_t value;
+	int ret;
 
-				close_client_connection(client);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		ret = zsock_poll(worker->fds, 1 + worker->max_clients, -1);
+		if (ret < 0) {
+			LOG_ERR("Worker poll failed (%d)", -errno);
+
+			/* Let the server thread restart the server */
+			atomic_set(&server_ctx.worker_error, 1);
+			eventfd_write(server_ctx.fds[0].fd, 1);
+			break;
+		}
+
+		if (worker->fds[0].revents) {
+			eventfd_read(worker->fds[0].fd, &value);
+
+			if (worker->stopping) {
+				break;
+			}
+
+			while (k_msgq_get(&worker->accept_q, &msg, K_NO_WAIT) == 0) {
+				worker_add_client(worker, &msg);
+			}
+		}
+
+		for (int i = 1; i <= worker->max_clients; i++) {
+			if (worker->fds[i].fd < 0) {
 				continue;
 			}
 
-			client->data_len += ret;
+			handle_client_poll(&worker->clients[i - 1], worker->fds[i].revents);
+		}
+	}
+
+	worker_close_clients(worker);
+}
 
-			http_client_timer_restart(client);
+static void http_server_stop_workers(struct http_server_ctx *ctx, int count)
+{
+	for (int i = 0; i < count; i++) {
+		struct http_server_worker *worker = &ctx->workers[i];
 
-			ret = handle_http_request(client);
-			if (ret < 0 && ret != -EAGAIN) {
-				if (ret == -ENOTCONN) {
-					LOG_DBG("Client closed connection while handling request");
-				} else {
-					LOG_ERR("HTTP request handling error (%d)", ret);
-				}
-				close_client_connection(client);
-			} else if (client->data_len == sizeof(client->buffer)) {
-				/* If the RX buffer is still full after parsing,
-				 * it means we won't be able to handle this request
-				 * with the current buffer size.
-				 */
-				LOG_ERR("RX buffer too small to handle request");
-				close_client_connection(client);
-			}
+		worker->stopping = true;
+		eventfd_write(worker->fds[0].fd, 1);
+		(void)k_thread_join(&worker->thread, K_FOREVER);
+
+		zsock_close(worker->fds[0].fd);
+		worker->fds[0].fd = INVALID_SOCK;
+	}
+}
+
+static int http_server_start_workers(struct http_server_ctx *ctx)
+{
+	int fd;
+
+	for (int i = 0; i < HTTP_SERVER_NUM_WORKERS; i++) {
+		struct http_server_worker *worker = &ctx->workers[i];
+		int first = i * HTTP_SERVER_MAX_CLIENTS / HTTP_SERVER_NUM_WORKERS;
+		int last = (i + 1) * HTTP_SERVER_MAX_CLIENTS / HTTP_SERVER_NUM_WORKERS;
+
+		fd = eventfd(0, 0);
+		if (fd < 0) {
+			fd = -errno;
+			LOG_ERR("eventfd failed (%d)", fd);
+			http_server_stop_workers(ctx, i);
+			return fd;
 		}
+
+		for (int j = 0; j < ARRAY_SIZE(worker->fds); j++) {
+			worker->fds[j].fd = INVALID_SOCK;
+			worker->fds[j].events = 0;
+			worker->fds[j].revents = 0;
+		}
+
+		worker->fds[0].fd = fd;
+		worker->fds[0].events = ZSOCK_POLLIN;
+		worker->clients = &ctx->clients[first];
+		worker->max_clients = last - first;
+		worker->stopping = false;
+		atomic_set(&worker->num_clients, 0);
+
+		k_msgq_init(&worker->accept_q, worker->accept_q_buf,
+			    sizeof(struct http_server_accept_msg), worker->max_clients);
+
+		k_thread_create(&worker->thread, worker_stacks[i],
+				K_THREAD_STACK_SIZEOF(worker_stacks[i]),
+				http_server_worker_thread, worker, NULL, NULL,
+				THREAD_PRIORITY, 0, K_NO_WAIT);
+		k_thread_name_set(&worker->thread, "http_server_worker");
 	}
 
 	return 0;
+}
+
+/* Pick the worker serving the fewest clients that still has a free slot */
+static struct http_server_worker *select_worker(struct http_server_ctx *ctx)
+{
+	struct http_server_worker *selected = NULL;
+	atomic_val_t min_clients = 0;
+
+	ARRAY_FOR_EACH_PTR(ctx->workers, worker) {
+		atomic_val_t num_clients = atomic_get(&worker->num_clients);
+
+		if (num_clients >= worker->max_clients) {
+			continue;
+		}
+
+		if (selected == NULL || num_clients < min_clients) {
+			selected = worker;
+			min_clients = num_clients;
+		}
+	}
+
+	return selected;
+}
+
+static bool accept_paused_elsewhere(struct http_server_ctx *ctx)
+{
+	for (int i = 1; i < ctx->listen_fds; i++) {
+		if (ctx->fds[i].events == 0) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static void dispatch_new_client(struct http_server_ctx *ctx, int idx)
+{
+	const struct http_service_desc *service;
+	struct http_server_worker *worker;
+	struct http_server_accept_msg msg;
+	k_spinlock_key_t key;
+	bool service_full;
+	int new_socket;
+
+	service = lookup_service(ctx->fds[idx].fd);
+	__ASSERT(NULL != service, "fd not associated with a service");
+
+	/* Announce the pause before checking for free slots, so a worker
+	 * releasing a client concurrently is guaranteed to wake us up.
+	 */
+	atomic_set(&ctx->accept_paused, 1);
+
+	key = k_spin_lock(&clients_lock);
+	service_full = service->data->num_clients >= service->concurrent;
+	k_spin_unlock(&clients_lock, key);
+
+	worker = select_worker(ctx);
+	if (service_full || worker == NULL) {
+		ctx->fds[idx].events = 0;
+		return;
+	}
+
+	if (!accept_paused_elsewhere(ctx)) {
+		atomic_clear(&ctx->accept_paused);
+	}
+
+	new_socket = accept_new_client(ctx->fds[idx].fd);
+	if (new_socket < 0) {
+		LOG_DBG("accept: %d", new_socket);
+		return;
+	}
+
+	key = k_spin_lock(&clients_lock);
+	service->data->num_clients++;
+	k_spin_unlock(&clients_lock, key);
+
+	atomic_inc(&worker->num_clients);
+
+	msg.fd = new_socket;
+	msg.service = service;
+
+	/* Cannot fail, the queue has room for all the worker slots */
+	(void)k_msgq_put(&worker->accept_q, &msg, K_NO_WAIT);
+	eventfd_write(worker->fds[0].fd, 1);
+}
+
+/* The server thread only accepts new connections and hands them over to the
+ * workers, each of which runs its own event loop over the clients it owns.
+ */
+static int http_server_dispatch_run(struct http_server_ctx *ctx)
+{
+	eventfd_t value;
+	int ret, i;
+	int sock_error;
+	socklen_t optlen = sizeof(int);
+
+	atomic_clear(&ctx->accept_paused);
+	atomic_clear(&ctx->worker_error);
+
+	ret = http_server_start_workers(ctx);
+	if (ret < 0) {
+		close_all_sockets(ctx);
+		return ret;
+	}
+
+	while (1) {
+		ret = zsock_poll(ctx->fds, ctx->listen_fds, -1);
+		if (ret < 0) {
+			ret = -errno;
+			LOG_DBG("poll failed (%d)", ret);
+			goto closing;
+		}
+
+		if (ctx->fds[0].revents) {
+			eventfd_read(ctx->fds[0].fd, &value);
+
+			if (atomic_cas(&ctx->stop_requested, 1, 0)) {
+				LOG_DBG("Received stop event. exiting ..");
+				ret = 0;
+				goto closing;
+			}
+
+			if (atomic_get(&ctx->worker_error)) {
+				ret = -EIO;
+				goto closing;
+			}
+
+			/* A worker released a client, resume accepting */
+			atomic_clear(&ctx->accept_paused);
+
+			for (i = 1; i < ctx->listen_fds; i++) {
+				ctx->fds[i].events = ZSOCK_POLLIN;
+			}
+
+			continue;
+		}
+
+		for (i = 1; i < ctx->listen_fds; i++) {
+			if (ctx->fds[i].revents & ZSOCK_POLLHUP) {
+				continue;
+			}
+
+			if (ctx->fds[i].revents & ZSOCK_POLLERR) {
+				(void)zsock_getsockopt(ctx->fds[i].fd, SOL_SOCKET,
+						       SO_ERROR, &sock_error, &optlen);
+				LOG_ERR("Listening socket error, aborting.");
+				ret = -sock_error;
+				goto closing;
+			}
+
+			if (ctx->fds[i].revents & ZSOCK_POLLIN) {
+				dispatch_new_client(ctx, i);
+			}
+		}
+	}
 
 closing:
-	/* Close all client connections and the server socket */
+	/* Stop the workers, which close their client connections, then close
+	 * the server sockets.
+	 */
+	http_server_stop_workers(ctx, HTTP_SERVER_NUM_WORKERS);
 	close_all_sockets(ctx);
 	return ret;
 }
+#endif /* HTTP_SERVER_NUM_WORKERS > 0 */
 
 /* Compare a path and a resource string. The path string comes from the HTTP request and may be
  * terminated by either '?' or '\0'. The resource string is registered along with the resource and
@@ -760,32 +1200,61 @@ static bool skip_this(struct http_resource_desc *resource, bool is_websocket)
 	return false;
 }
 
-struct http_resource_detail *get_resource_detail(const struct http_service_desc *service,
-						 const char *path, int *path_len, bool is_websocket)
+bool http_server_resource_match(struct http_resource_desc *resource, const char *path,
+				bool is_websocket, int *path_len)
 {
-	HTTP_SERVICE_FOREACH_RESOURCE(service, resource) {
-		if (skip_this(resource, is_websocket)) {
-			continue;
-		}
+	if (skip_this(resource, is_websocket)) {
+		return false;
+	}
 
-		if (IS_ENABLED(CONFIG_HTTP_SERVER_RESOURCE_WILDCARD)) {
-			int ret;
+	if (IS_ENABLED(CONFIG_HTTP_SERVER_RESOURCE_WILDCARD)) {
+		int ret;
 
-			ret = fnmatch(resource->resource, path, (FNM_PATHNAME | FNM_LEADING_DIR));
-			if (ret == 0) {
-				*path_len = path_len_without_query(path);
-				return resource->detail;
-			}
+		ret = fnmatch(resource->resource, path, (FNM_PATHNAME | FNM_LEADING_DIR));
+		if (ret == 0) {
+			*path_len = path_len_without_query(path);
+			return true;
 		}
+	}
 
-		if (compare_strings(path, resource->resource) == 0) {
-			NET_DBG("Got match for %s", resource->resource);
+	if (compare_strings(path, resource->resource) == 0) {
+		NET_DBG("Got match for %s", resource->resource);
+
+		*path_len = strlen(resource->resource);
+		return true;
+	}
 
-			*path_len = strlen(resource->resource);
-			return resource->detail;
+	return false;
+}
+
+static struct http_resource_desc *find_resource(const struct http_service_desc *service,
+						const char *path, int *path_len,
+						bool is_websocket)
+{
+	HTTP_SERVICE_FOREACH_RESOURCE(service, resource) {
+		if (http_server_resource_match(resource, path, is_websocket, path_len)) {
+			return resource;
 		}
 	}
 
+	return NULL;
+}
+
+struct http_resource_detail *get_resource_detail(const struct http_service_desc *service,
+						 const char *path, int *path_len, bool is_websocket)
+{
+	struct http_resource_desc *resource = NULL;
+
+	if (!IS_ENABLED(CONFIG_HTTP_SERVER_RESOURCE_INDEX) ||
+	    http_server_resource_index_lookup(service, path, is_websocket, path_len,
+					      &resource) < 0) {
+		resource = find_resource(service, path, path_len, is_websocket);
+	}
+
+	if (resource != NULL) {
+		return resource->detail;
+	}
+
 	if (service->res_fallback != NULL) {
 		*path_len = path_len_without_query(path);
 		return service->res_fallback;
@@ -857,6 +1326,160 @@ return_filename:
 	return ret;
 }
 
+int http_server_fs_etag(const char *fname, size_t file_size, uint32_t generation, char *buf,
+			size_t buflen)
+{
+	/* 32-bit FNV-1a hash of the file name */
+	uint32_t hash = 2166136261U;
+	int ret;
+
+	/* The filesystem API does not provide the modification time, so only
+	 * the application can tell when the content changes.
+	 */
+	if (generation == 0U) {
+		if (buflen > 0) {
+			buf[0] = '\0';
+		}
+
+		return 0;
+	}
+
+	for (const char *c = fname; *c != '\0'; c++) {
+		hash = (hash ^ (uint8_t)*c) * 16777619U;
+	}
+
+	ret = snprintk(buf, buflen, "W/\"%zx-%08x-%x\"", file_size, hash, generation);
+	if (ret < 0 || (size_t)ret >= buflen) {
+		return -ENOBUFS;
+	}
+
+	return ret;
+}
+
+static const char *skip_weak_prefix(const char *tag, size_t *len)
+{
+	if (*len >= 2 && tag[0] == 'W' && tag[1] == '/') {
+		*len -= 2;
+		return tag + 2;
+	}
+
+	return tag;
+}
+
+bool http_server_etag_match(const char *list, const char *etag)
+{
+	size_t etag_len = strlen(etag);
+	const char *tag;
+	size_t len;
+
+	etag = skip_weak_prefix(etag, &etag_len);
+
+	while (*list != '\0') {
+		while (*list == ' ' || *list == '\t' || *list == ',') {
+			list++;
+		}
+
+		tag = list;
+		while (*list != '\0' && *list != ',') {
+			list++;
+		}
+
+		len = list - tag;
+		while (len > 0 && (tag[len - 1] == ' ' || tag[len - 1] == '\t')) {
+			len--;
+		}
+
+		if (len == 1 && tag[0] == '*') {
+			return true;
+		}
+
+		/* Weak comparison, see RFC 9110 chapter 8.8.3.2 */
+		tag = skip_weak_prefix(tag, &len);
+		if (len > 0 && len == etag_len && memcmp(tag, etag, len) == 0) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static bool parse_range_pos(const char **str, size_t *pos)
+{
+	const char *p = *str;
+	size_t val = 0;
+
+	if (*p < '0' || *p > '9') {
+		return false;
+	}
+
+	while (*p >= '0' && *p <= '9') {
+		if (val > (SIZE_MAX - (*p - '0')) / 10) {
+			return false;
+		}
+
+		val = val * 10 + (*p - '0');
+		p++;
+	}
+
+	*str = p;
+	*pos = val;
+
+	return true;
+}
+
+int http_server_parse_range(const char *value, size_t file_size, size_t *start, size_t *end)
+{
+	const char *p = value;
+	size_t first, last;
+
+	if (strncasecmp(p, "bytes=", sizeof("bytes=") - 1) != 0) {
+		return -ENOENT;
+	}
+
+	p += sizeof("bytes=") - 1;
+
+	/* Multiple ranges are not supported, the whole file is sent instead */
+	if (strchr(p, ',') != NULL) {
+		return -ENOENT;
+	}
+
+	if (*p == '-') {
+		/* Suffix range, i.e. the last N bytes of the file */
+		p++;
+		if (!parse_range_pos(&p, &last) || *p != '\0') {
+			return -ENOENT;
+		}
+
+		if (last == 0 || file_size == 0) {
+			return -ERANGE;
+		}
+
+		*start = file_size - MIN(last, file_size);
+		*end = file_size - 1;
+
+		return 0;
+	}
+
+	if (!parse_range_pos(&p, &first) || *p++ != '-') {
+		return -ENOENT;
+	}
+
+	if (*p == '\0') {
+		last = SIZE_MAX;
+	} else if (!parse_range_pos(&p, &last) || *p != '\0' || last < first) {
+		return -ENOENT;
+	}
+
+	if (first >= file_size) {
+		return -ERANGE;
+	}
+
+	*start = first;
+	*end = MIN(last, file_size - 1);
+
+	return 0;
+}
+
 void http_server_get_content_type_from_extension(char *url, char *content_type,
 						 size_t content_type_size)
 {
@@ -944,6 +1567,10 @@ int http_server_start(void)
 	}
 
 	server_running = true;
+#if HTTP_SERVER_NUM_WORKERS > 0
+	/* Cancel a stop request the server thread did not process yet */
+	atomic_clear(&server_ctx.stop_requested);
+#endif
 	k_sem_give(&server_start);
 
 	LOG_DBG("Starting HTTP server");
@@ -960,6 +1587,9 @@ int http_server_stop(void)
 
 	server_running = false;
 	k_sem_reset(&server_start);
+#if HTTP_SERVER_NUM_WORKERS > 0
+	atomic_set(&server_ctx.stop_requested, 1);
+#endif
 	eventfd_write(server_ctx.fds[0].fd, 1);
 
 	LOG_DBG("Stopping HTTP server");
@@ -985,7 +1615,11 @@ static void http_server_thread(void *p1, void *p2, void *p3)
 				goto again;
 			}
 
+#if HTTP_SERVER_NUM_WORKERS > 0
+			ret = http_server_dispatch_run(&server_ctx);
+#else
 			ret = http_server_run(&server_ctx);
+#endif
 			if (!server_running) {
 				continue;
 			}
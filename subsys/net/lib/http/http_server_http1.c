@@ -470,16 +470,27 @@ int handle_http1_static_fs_resource(struct http_resource_detail_static_fs *stati
 				    struct http_client_ctx *client)
 {
 #define RESPONSE_TEMPLATE_STATIC_FS                                                                \
-	"HTTP/1.1 200 OK\r\n"                                                                      \
+	"HTTP/1.1 %s\r\n"                                                                          \
 	"Content-Length: %zd\r\n"                                                                  \
-	"Content-Type: %s%s%s\r\n\r\n"
+	"Content-Type: %s%s%s\r\n"
+#define RESPONSE_TEMPLATE_NOT_MODIFIED                                                             \
+	"HTTP/1.1 304 Not Modified\r\n"                                                            \
+	"ETag: %s\r\n\r\n"
+#define RESPONSE_TEMPLATE_RANGE_NOT_SATISFIABLE                                                    \
+	"HTTP/1.1 416 Range Not Satisfiable\r\n"                                                   \
+	"Content-Length: 0\r\n"                                                                    \
+	"Content-Range: bytes */%zu\r\n\r\n"
+#define ETAG_HEADER "ETag: "
+#define CONTENT_RANGE_HEADER "Content-Range: "
 #define CONTENT_ENCODING_HEADER "\r\nContent-Encoding: "
 /* Add couple of bytes to response template size to have space
- * for the content type and encoding
+ * for the content type, encoding, entity tag and range
  */
 #define STATIC_FS_RESPONSE_BASE_SIZE                                                               \
 	sizeof(RESPONSE_TEMPLATE_STATIC_FS) + HTTP_SERVER_MAX_CONTENT_TYPE_LEN +                   \
-		sizeof("Content-Length: 01234567890123456789\r\n")
+		sizeof("206 Partial Content") + sizeof("01234567890123456789") +                   \
+		sizeof(ETAG_HEADER) + HTTP_SERVER_ETAG_MAX_LEN + sizeof(CONTENT_RANGE_HEADER) +    \
+		HTTP_SERVER_CONTENT_RANGE_MAX_LEN + sizeof("\r\n\r\n")
 #define CONTENT_ENCODING_HEADER_SIZE                                                               \
 	sizeof(CONTENT_ENCODING_HEADER) + HTTP_COMPRESSION_MAX_STRING_LEN + sizeof("\r\n")
 #define STATIC_FS_RESPONSE_SIZE                                                                    \
@@ -489,13 +500,18 @@ int handle_http1_static_fs_resource(struct http_resource_detail_static_fs *stati
 		(STATIC_FS_RESPONSE_BASE_SIZE))
 
 	enum http_compression chosen_compression = 0;
+	const char *encoding = "";
+	bool partial = false;
 	int len;
-	int remaining;
 	int ret;
 	size_t file_size;
+	size_t start = 0;
+	size_t end = 0;
+	size_t remaining;
 	struct fs_file_t file;
 	char fname[HTTP_SERVER_MAX_URL_LENGTH];
 	char content_type[HTTP_SERVER_MAX_CONTENT_TYPE_LEN] = "text/html";
+	char etag[HTTP_SERVER_ETAG_MAX_LEN];
 	char http_response[STATIC_FS_RESPONSE_SIZE];
 
 	if (client->method != HTTP_GET) {
@@ -525,27 +541,90 @@ int handle_http1_static_fs_resource(struct http_resource_detail_static_fs *stati
 		LOG_ERR("fs_stat %s: %d", fname, ret);
 		return send_http1_404(client);
 	}
+
+	ret = http_server_fs_etag(fname, file_size, static_fs_detail->generation, etag,
+				 sizeof(etag));
+	if (ret < 0) {
+		return ret;
+	}
+
+	/* The conditional request takes precedence over the range, see
+	 * RFC 9110 chapter 13.2.2
+	 */
+	if (etag[0] != '\0' && client->if_none_match[0] != '\0' &&
+	    http_server_etag_match(client->if_none_match, etag)) {
+		len = snprintk(http_response, sizeof(http_response),
+			       RESPONSE_TEMPLATE_NOT_MODIFIED, etag);
+		ret = http_server_sendall(client, http_response, len);
+		if (ret == 0) {
+			client->http1_headers_sent = true;
+		}
+
+		return ret;
+	}
+
+	/* Entity tags are weak, so If-Range can never match and the whole
+	 * file is sent instead of the range.
+	 */
+	if (client->range[0] != '\0' && !client->has_if_range) {
+		ret = http_server_parse_range(client->range, file_size, &start, &end);
+		if (ret == -ERANGE) {
+			len = snprintk(http_response, sizeof(http_response),
+				       RESPONSE_TEMPLATE_RANGE_NOT_SATISFIABLE, file_size);
+			ret = http_server_sendall(client, http_response, len);
+			if (ret == 0) {
+				client->http1_headers_sent = true;
+			}
+
+			return ret;
+		}
+
+		partial = (ret == 0);
+	}
+
 	fs_file_t_init(&file);
 	ret = fs_open(&file, fname, FS_O_READ);
 	if (ret < 0) {
 		LOG_ERR("fs_open %s: %d", fname, ret);
+		return ret;
+	}
+
+	if (partial) {
+		ret = fs_seek(&file, start, FS_SEEK_SET);
 		if (ret < 0) {
-			return ret;
+			LOG_ERR("fs_seek %s: %d", fname, ret);
+			goto close;
 		}
+
+		remaining = end - start + 1;
+	} else {
+		remaining = file_size;
 	}
 
-	LOG_DBG("found %s, file size: %zu", fname, file_size);
+	LOG_DBG("found %s, file size: %zu, sending %zu", fname, file_size, remaining);
 
 	/* send HTTP header */
 	if (IS_ENABLED(CONFIG_HTTP_SERVER_COMPRESSION) &&
 	    http_compression_text(chosen_compression)[0] != 0) {
-		len = snprintk(http_response, sizeof(http_response), RESPONSE_TEMPLATE_STATIC_FS,
-			       file_size, content_type, CONTENT_ENCODING_HEADER,
-			       http_compression_text(chosen_compression));
-	} else {
-		len = snprintk(http_response, sizeof(http_response), RESPONSE_TEMPLATE_STATIC_FS,
-			       file_size, content_type, "", "");
+		encoding = http_compression_text(chosen_compression);
+	}
+
+	len = snprintk(http_response, sizeof(http_response), RESPONSE_TEMPLATE_STATIC_FS,
+		       partial ? "206 Partial Content" : "200 OK", remaining, content_type,
+		       encoding[0] != 0 ? CONTENT_ENCODING_HEADER : "", encoding);
+	if (etag[0] != '\0') {
+		len += snprintk(http_response + len, sizeof(http_response) - len,
+				ETAG_HEADER "%s\r\n", etag);
+	}
+
+	if (partial) {
+		len += snprintk(http_response + len, sizeof(http_response) - len,
+				CONTENT_RANGE_HEADER "bytes %zu-%zu/%zu\r\n", start, end,
+				file_size);
 	}
+
+	len += snprintk(http_response + len, sizeof(http_response) - len, "\r\n");
+
 	ret = http_server_sendall(client, http_response, len);
 	if (ret < 0) {
 		goto close;
@@ -554,21 +633,22 @@ int handle_http1_static_fs_resource(struct http_resource_detail_static_fs *stati
 	client->http1_headers_sent = true;
 
 	/* read and send file */
-	remaining = file_size;
 	while (remaining > 0) {
-		len = fs_read(&file, http_response, sizeof(http_response));
-		if (len < 0) {
+		len = fs_read(&file, client->fs_chunk,
+			      MIN(sizeof(client->fs_chunk), remaining));
+		if (len <= 0) {
 			LOG_ERR("Filesystem read error (%d)", len);
+			ret = (len < 0) ? len : -EIO;
 			goto close;
 		}
 
-		ret = http_server_sendall(client, http_response, len);
+		ret = http_server_sendall(client, client->fs_chunk, len);
 		if (ret < 0) {
 			goto close;
 		}
+
 		remaining -= len;
 	}
-	ret = http_server_sendall(client, "\r\n\r\n", 4);
 
 close:
 	/* close file */
@@ -595,7 +675,7 @@ static int handle_http1_dynamic_resource(
 		return send_http1_405(client);
 	}
 
-	if (dynamic_detail->holder != NULL && dynamic_detail->holder != client) {
+	if (!http_server_resource_acquire(dynamic_detail, client)) {
 		ret = send_http1_409(client);
 		if (ret < 0) {
 			return ret;
@@ -604,8 +684,6 @@ static int handle_http1_dynamic_resource(
 		return enter_http_done_state(client);
 	}
 
-	dynamic_detail->holder = client;
-
 	switch (client->method) {
 	case HTTP_HEAD:
 		if (user_method & BIT(HTTP_HEAD)) {
@@ -724,6 +802,15 @@ static int on_header_field(struct http_parser *parser, const char *at,
 				ctx->accept_encoding_next = true;
 			}
 #endif /* CONFIG_HTTP_SERVER_COMPRESSION */
+#ifdef CONFIG_FILE_SYSTEM
+			else if (strcasecmp(ctx->header_buffer, "Range") == 0) {
+				ctx->range_next = true;
+			} else if (strcasecmp(ctx->header_buffer, "If-None-Match") == 0) {
+				ctx->if_none_match_next = true;
+			} else if (strcasecmp(ctx->header_buffer, "If-Range") == 0) {
+				ctx->has_if_range = true;
+			}
+#endif /* CONFIG_FILE_SYSTEM */
 
 			ctx->header_buffer[0] = '\0';
 		}
@@ -781,6 +868,12 @@ static int on_header_value(struct http_parser *parser,
 			ctx->header_capture_ctx.store_next_value = false;
 			ctx->header_capture_ctx.status = HTTP_HEADER_STATUS_DROPPED;
 		}
+
+#ifdef CONFIG_FILE_SYSTEM
+		/* A truncated value must not be used as a condition */
+		ctx->range_next = false;
+		ctx->if_none_match_next = false;
+#endif /* CONFIG_FILE_SYSTEM */
 	} else {
 		memcpy(ctx->header_buffer + offset, at, length);
 		offset += length;
@@ -816,6 +909,17 @@ static int on_header_value(struct http_parser *parser,
 				ctx->accept_encoding_next = false;
 			}
 #endif /* CONFIG_HTTP_SERVER_COMPRESSION */
+#ifdef CONFIG_FILE_SYSTEM
+			if (ctx->range_next) {
+				memcpy(ctx->range, ctx->header_buffer, offset + 1);
+				ctx->range_next = false;
+			}
+
+			if (ctx->if_none_match_next) {
+				memcpy(ctx->if_none_match, ctx->header_buffer, offset + 1);
+				ctx->if_none_match_next = false;
+			}
+#endif /* CONFIG_FILE_SYSTEM */
 
 			ctx->header_buffer[0] = '\0';
 		}
@@ -903,6 +1007,14 @@ int enter_http1_request(struct http_client_ctx *client)
 	memset(client->header_buffer, 0, sizeof(client->header_buffer));
 	memset(client->url_buffer, 0, sizeof(client->url_buffer));
 
+#ifdef CONFIG_FILE_SYSTEM
+	client->range[0] = '\0';
+	client->if_none_match[0] = '\0';
+	client->range_next = false;
+	client->if_none_match_next = false;
+	client->has_if_range = false;
+#endif /* CONFIG_FILE_SYSTEM */
+
 	return 0;
 }
 
@@ -117,7 +117,12 @@ static int add_header_field(struct http_client_ctx *client, uint8_t **buf,
 	client->header_field.value = value;
 	client->header_field.value_len = strlen(value);
 
+#if defined(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE)
+	ret = http_hpack_encoder_encode_header(&client->hpack_encoder, *buf,
+					       *buflen, &client->header_field);
+#else
 	ret = http_hpack_encode_header(*buf, *buflen, &client->header_field);
+#endif
 	if (ret < 0) {
 		LOG_DBG("Failed to encode header, err %d", ret);
 		return ret;
@@ -459,6 +464,10 @@ static int handle_http2_static_fs_resource(struct http_resource_detail_static_fs
 	struct fs_file_t file;
 	char fname[HTTP_SERVER_MAX_URL_LENGTH];
 	char content_type[HTTP_SERVER_MAX_CONTENT_TYPE_LEN] = "text/html";
+	char etag[HTTP_SERVER_ETAG_MAX_LEN];
+	char content_range[HTTP_SERVER_CONTENT_RANGE_MAX_LEN];
+	struct http_header extra_headers[2];
+	size_t num_headers = 0;
 	struct http_resource_detail res_detail = {
 		.bitmask_of_supported_http_methods =
 			static_fs_detail->common.bitmask_of_supported_http_methods,
@@ -467,9 +476,12 @@ static int handle_http2_static_fs_resource(struct http_resource_detail_static_fs
 		.type = static_fs_detail->common.type,
 	};
 	enum http_compression chosen_compression = 0;
+	bool partial = false;
+	size_t file_size;
+	size_t start = 0;
+	size_t end = 0;
+	size_t remaining;
 	int len;
-	int remaining;
-	char tmp[64];
 
 	if (client->method != HTTP_GET) {
 		return send_http2_405(client, frame);
@@ -493,10 +505,10 @@ static int handle_http2_static_fs_resource(struct http_resource_detail_static_fs
 
 	/* open file, if it exists */
 #ifdef CONFIG_HTTP_SERVER_COMPRESSION
-	ret = http_server_find_file(fname, sizeof(fname), &client->data_len,
+	ret = http_server_find_file(fname, sizeof(fname), &file_size,
 					client->supported_compression, &chosen_compression);
 #else
-	ret = http_server_find_file(fname, sizeof(fname), &client->data_len, 0, NULL);
+	ret = http_server_find_file(fname, sizeof(fname), &file_size, 0, NULL);
 #endif /* CONFIG_HTTP_SERVER_COMPRESSION */
 	if (ret < 0) {
 		LOG_ERR("fs_stat %s: %d", fname, ret);
@@ -508,37 +520,113 @@ static int handle_http2_static_fs_resource(struct http_resource_detail_static_fs
 		}
 		return ret;
 	}
+
+	ret = http_server_fs_etag(fname, file_size, static_fs_detail->generation, etag,
+				 sizeof(etag));
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (etag[0] != '\0') {
+		extra_headers[num_headers++] = (struct http_header){
+			.name = "etag",
+			.value = etag,
+		};
+	}
+
+	if (etag[0] != '\0' && client->if_none_match[0] != '\0' &&
+	    http_server_etag_match(client->if_none_match, etag)) {
+		ret = send_headers_frame(client, HTTP_304_NOT_MODIFIED, frame->stream_identifier,
+					 NULL, HTTP2_FLAG_END_STREAM, extra_headers, num_headers);
+		if (ret < 0) {
+			LOG_DBG("Cannot write to socket (%d)", ret);
+			return ret;
+		}
+
+		client->current_stream->end_stream_sent = true;
+
+		return 0;
+	}
+
+	/* Entity tags are weak, so If-Range can never match */
+	if (client->range[0] != '\0' && !client->has_if_range) {
+		ret = http_server_parse_range(client->range, file_size, &start, &end);
+		if (ret == -ERANGE) {
+			struct http_header range_header = {
+				.name = "content-range",
+				.value = content_range,
+			};
+
+			snprintk(content_range, sizeof(content_range), "bytes */%zu", file_size);
+
+			ret = send_headers_frame(client, HTTP_416_RANGE_NOT_SATISFIABLE,
+						 frame->stream_identifier, NULL,
+						 HTTP2_FLAG_END_STREAM, &range_header, 1);
+			if (ret < 0) {
+				LOG_DBG("Cannot write to socket (%d)", ret);
+				return ret;
+			}
+
+			client->current_stream->end_stream_sent = true;
+
+			return 0;
+		}
+
+		partial = (ret == 0);
+	}
+
 	fs_file_t_init(&file);
 	ret = fs_open(&file, fname, FS_O_READ);
 	if (ret < 0) {
 		LOG_ERR("fs_open %s: %d", fname, ret);
+		return ret;
+	}
+
+	if (partial) {
+		ret = fs_seek(&file, start, FS_SEEK_SET);
 		if (ret < 0) {
-			return ret;
+			LOG_ERR("fs_seek %s: %d", fname, ret);
+			goto out;
 		}
+
+		snprintk(content_range, sizeof(content_range), "bytes %zu-%zu/%zu", start, end,
+			 file_size);
+		extra_headers[num_headers++] = (struct http_header){
+			.name = "content-range",
+			.value = content_range,
+		};
+		remaining = end - start + 1;
+	} else {
+		remaining = file_size;
 	}
 
 	/* send headers */
-	if (IS_ENABLED(CONFIG_HTTP_SERVER_COMPRESSION)) {
+	if (IS_ENABLED(CONFIG_HTTP_SERVER_COMPRESSION) &&
+	    http_compression_text(chosen_compression)[0] != 0) {
 		res_detail.content_encoding = http_compression_text(chosen_compression);
 	}
-	ret = send_headers_frame(client, HTTP_200_OK, frame->stream_identifier, &res_detail, 0,
-				 NULL, 0);
+
+	ret = send_headers_frame(client, partial ? HTTP_206_PARTIAL_CONTENT : HTTP_200_OK,
+				 frame->stream_identifier, &res_detail,
+				 (remaining > 0) ? 0 : HTTP2_FLAG_END_STREAM, extra_headers,
+				 num_headers);
 	if (ret < 0) {
 		LOG_DBG("Cannot write to socket (%d)", ret);
 		goto out;
 	}
 
 	/* read and send file */
-	remaining = client->data_len;
 	while (remaining > 0) {
-		len = fs_read(&file, tmp, sizeof(tmp));
-		if (len < 0) {
+		len = fs_read(&file, client->fs_chunk,
+			      MIN(sizeof(client->fs_chunk), remaining));
+		if (len <= 0) {
 			LOG_ERR("Filesystem read error (%d)", len);
+			ret = (len < 0) ? len : -EIO;
 			goto out;
 		}
 
 		remaining -= len;
-		ret = send_data_frame(client, tmp, len, frame->stream_identifier,
+		ret = send_data_frame(client, client->fs_chunk, len, frame->stream_identifier,
 				      (remaining > 0) ? 0 : HTTP2_FLAG_END_STREAM);
 		if (ret < 0) {
 			LOG_DBG("Cannot write to socket (%d)", ret);
@@ -782,7 +870,7 @@ static int handle_http2_dynamic_resource(
 		return send_http2_405(client, frame);
 	}
 
-	if (dynamic_detail->holder != NULL && dynamic_detail->holder != client) {
+	if (!http_server_resource_acquire(dynamic_detail, client)) {
 		ret = send_http2_409(client, frame);
 		if (ret < 0) {
 			return ret;
@@ -791,8 +879,6 @@ static int handle_http2_dynamic_resource(
 		return enter_http_done_state(client);
 	}
 
-	dynamic_detail->holder = client;
-
 	switch (client->method) {
 	case HTTP_GET:
 	case HTTP_DELETE:
@@ -934,6 +1020,12 @@ static int enter_http_frame_headers_state(struct http_client_ctx *client)
 		client->header_capture_ctx.current_stream = stream;
 	}
 
+#ifdef CONFIG_FILE_SYSTEM
+	client->range[0] = '\0';
+	client->if_none_match[0] = '\0';
+	client->has_if_range = false;
+#endif /* CONFIG_FILE_SYSTEM */
+
 	client->server_state = HTTP_SERVER_FRAME_HEADERS_STATE;
 
 	return 0;
@@ -1405,6 +1497,25 @@ static int process_header(struct http_client_ctx *client,
 						       &client->supported_compression);
 	}
 #endif /* CONFIG_HTTP_SERVER_COMPRESSION */
+#ifdef CONFIG_FILE_SYSTEM
+	else if (header->name_len == (sizeof("range") - 1) &&
+		 memcmp(header->name, "range", header->name_len) == 0) {
+		/* Too long value is ignored, so the whole file is sent */
+		if (header->value_len < sizeof(client->range)) {
+			memcpy(client->range, header->value, header->value_len);
+			client->range[header->value_len] = '\0';
+		}
+	} else if (header->name_len == (sizeof("if-none-match") - 1) &&
+		   memcmp(header->name, "if-none-match", header->name_len) == 0) {
+		if (header->value_len < sizeof(client->if_none_match)) {
+			memcpy(client->if_none_match, header->value, header->value_len);
+			client->if_none_match[header->value_len] = '\0';
+		}
+	} else if (header->name_len == (sizeof("if-range") - 1) &&
+		   memcmp(header->name, "if-range", header->name_len) == 0) {
+		client->has_if_range = true;
+	}
+#endif /* CONFIG_FILE_SYSTEM */
 	else {
 		/* Just ignore for now. */
 		LOG_DBG("Ignoring field %.*s", (int)header->name_len, header->name);
@@ -1725,6 +1836,35 @@ int handle_http_frame_rst_stream(struct http_client_ctx *client)
 	return 0;
 }
 
+static void apply_peer_settings(struct http_client_ctx *client)
+{
+	struct http2_frame *frame = &client->current_frame;
+	size_t offset;
+
+	for (offset = 0;
+	     offset + sizeof(struct http2_settings_field) <= frame->length;
+	     offset += sizeof(struct http2_settings_field)) {
+		const uint8_t *field = client->cursor + offset;
+		uint16_t id = sys_get_be16(field);
+		uint32_t value = sys_get_be32(field + sizeof(uint16_t));
+
+		switch (id) {
+#if defined(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE)
+		case HTTP2_SETTINGS_HEADER_TABLE_SIZE:
+			/* The new size applies to the header blocks sent
+			 * after the acknowledgment.
+			 */
+			http_hpack_encoder_set_max_size(&client->hpack_encoder,
+							value);
+			break;
+#endif
+		default:
+			LOG_DBG("Ignoring setting %u: %u", id, value);
+			break;
+		}
+	}
+}
+
 int handle_http_frame_settings(struct http_client_ctx *client)
 {
 	struct http2_frame *frame = &client->current_frame;
@@ -1736,6 +1876,10 @@ int handle_http_frame_settings(struct http_client_ctx *client)
 		return -EAGAIN;
 	}
 
+	if (!is_header_flag_set(frame->flags, HTTP2_FLAG_SETTINGS_ACK)) {
+		apply_peer_settings(client);
+	}
+
 	bytes_consumed = client->current_frame.length;
 	client->data_len -= bytes_consumed;
 	client->cursor += bytes_consumed;
@@ -0,0 +1,288 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/net/http/service.h>
+
+LOG_MODULE_DECLARE(net_http_server, CONFIG_NET_HTTP_SERVER_LOG_LEVEL);
+
+#include "headers/server_internal.h"
+
+#define INDEX_SIZE CONFIG_HTTP_SERVER_RESOURCE_INDEX_SIZE
+#define INDEX_NONE -1
+
+/* The index is a trie of path segments built per service. Each resource is
+ * attached to the node of its literal leading segments, i.e. the segments
+ * before the first one containing a wildcard character. A request path can
+ * only be matched by resources attached to the nodes along its own segments,
+ * so only these are tested, using the regular matching rules.
+ */
+struct http_resource_index_node {
+	const char *seg;
+	uint16_t seg_len;
+	int16_t child;
+	int16_t sibling;
+
+	/* Resources attached to this node, in definition order */
+	uint16_t res_first;
+	uint16_t res_count;
+};
+
+static struct http_resource_index_node index_nodes[INDEX_SIZE];
+static int index_nodes_used;
+
+/* Indexes of the resources within their service, grouped by node */
+static uint16_t index_res[INDEX_SIZE];
+static int index_res_used;
+
+/* Node of each resource of the service being indexed */
+static int16_t index_res_node[INDEX_SIZE];
+
+static atomic_t index_built;
+static K_MUTEX_DEFINE(index_lock);
+
+static size_t segment_len(const char *seg, bool is_path)
+{
+	size_t len = 0;
+
+	while (seg[len] != '\0' && seg[len] != '/' && !(is_path && seg[len] == '?')) {
+		len++;
+	}
+
+	return len;
+}
+
+static bool segment_is_literal(const char *seg, size_t len)
+{
+	if (!IS_ENABLED(CONFIG_HTTP_SERVER_RESOURCE_WILDCARD)) {
+		return true;
+	}
+
+	for (size_t i = 0; i < len; i++) {
+		if (seg[i] == '*' || seg[i] == '?' || seg[i] == '[' || seg[i] == '\\') {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static int node_alloc(const char *seg, size_t len)
+{
+	struct http_resource_index_node *node;
+
+	if (index_nodes_used >= INDEX_SIZE || len > UINT16_MAX) {
+		return INDEX_NONE;
+	}
+
+	node = &index_nodes[index_nodes_used];
+	node->seg = seg;
+	node->seg_len = len;
+	node->child = INDEX_NONE;
+	node->sibling = INDEX_NONE;
+	node->res_first = 0;
+	node->res_count = 0;
+
+	return index_nodes_used++;
+}
+
+static int node_find_child(int parent, const char *seg, size_t len)
+{
+	for (int i = index_nodes[parent].child; i != INDEX_NONE; i = index_nodes[i].sibling) {
+		if (index_nodes[i].seg_len == len && memcmp(index_nodes[i].seg, seg, len) == 0) {
+			return i;
+		}
+	}
+
+	return INDEX_NONE;
+}
+
+static int node_add_child(int parent, const char *seg, size_t len)
+{
+	int child;
+
+	child = node_find_child(parent, seg, len);
+	if (child != INDEX_NONE) {
+		return child;
+	}
+
+	child = node_alloc(seg, len);
+	if (child == INDEX_NONE) {
+		return INDEX_NONE;
+	}
+
+	index_nodes[child].sibling = index_nodes[parent].child;
+	index_nodes[parent].child = child;
+
+	return child;
+}
+
+static int index_insert(int root, const char *resource)
+{
+	const char *seg = resource;
+	int node = root;
+	size_t len;
+
+	while (true) {
+		len = segment_len(seg, false);
+		if (!segment_is_literal(seg, len)) {
+			break;
+		}
+
+		node = node_add_child(node, seg, len);
+		if (node == INDEX_NONE || seg[len] == '\0') {
+			break;
+		}
+
+		seg += len + 1;
+	}
+
+	return node;
+}
+
+static int index_build_service(const struct http_service_desc *service)
+{
+	size_t count = HTTP_SERVICE_RESOURCE_COUNT(service);
+	int nodes_start = index_nodes_used;
+	int pos = index_res_used;
+	int root, node;
+
+	if (count > INDEX_SIZE - index_res_used) {
+		goto nomem;
+	}
+
+	root = node_alloc(NULL, 0);
+	if (root == INDEX_NONE) {
+		goto nomem;
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		node = index_insert(root, service->res_begin[i].resource);
+		if (node == INDEX_NONE) {
+			goto nomem;
+		}
+
+		index_res_node[i] = node;
+		index_nodes[node].res_count++;
+	}
+
+	/* Nodes of a service are allocated contiguously from its root */
+	for (node = root; node < index_nodes_used; node++) {
+		index_nodes[node].res_first = pos;
+		pos += index_nodes[node].res_count;
+		index_nodes[node].res_count = 0;
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		struct http_resource_index_node *n = &index_nodes[index_res_node[i]];
+
+		index_res[n->res_first + n->res_count++] = i;
+	}
+
+	index_res_used = pos;
+	service->data->index = &index_nodes[root];
+
+	LOG_DBG("Indexed %zu resources of %s:%u using %d nodes", count,
+		service->host ? service->host : "<any>", *service->port,
+		index_nodes_used - nodes_start);
+
+	return 0;
+
+nomem:
+	index_nodes_used = nodes_start;
+	LOG_WRN("Resource index full, %s:%u resources not indexed",
+		service->host ? service->host : "<any>", *service->port);
+
+	return -ENOMEM;
+}
+
+static void index_build(void)
+{
+	if (atomic_get(&index_built)) {
+		return;
+	}
+
+	k_mutex_lock(&index_lock, K_FOREVER);
+
+	if (!atomic_get(&index_built)) {
+		HTTP_SERVICE_FOREACH(service) {
+			(void)index_build_service(service);
+		}
+
+		atomic_set(&index_built, 1);
+	}
+
+	k_mutex_unlock(&index_lock);
+}
+
+static void node_match(const struct http_service_desc *service,
+		       const struct http_resource_index_node *node, const char *path,
+		       bool is_websocket, struct http_resource_desc **found, int *path_len)
+{
+	for (int i = 0; i < node->res_count; i++) {
+		struct http_resource_desc *resource =
+			&service->res_begin[index_res[node->res_first + i]];
+
+		/* Resources are sorted, a better match was already found */
+		if (*found != NULL && resource > *found) {
+			return;
+		}
+
+		if (http_server_resource_match(resource, path, is_websocket, path_len)) {
+			*found = resource;
+			return;
+		}
+	}
+}
+
+int http_server_resource_index_lookup(const struct http_service_desc *service,
+				      const char *path, bool is_websocket, int *path_len,
+				      struct http_resource_desc **resource)
+{
+	const struct http_resource_index_node *node;
+	const char *seg = path;
+	int match_len = 0;
+	size_t len;
+	int child;
+
+	index_build();
+
+	node = service->data->index;
+	if (node == NULL) {
+		return -ENOENT;
+	}
+
+	*resource = NULL;
+
+	while (true) {
+		node_match(service, node, path, is_websocket, resource, &match_len);
+
+		if (seg == NULL) {
+			break;
+		}
+
+		len = segment_len(seg, true);
+
+		child = node_find_child(node - index_nodes, seg, len);
+		if (child == INDEX_NONE) {
+			break;
+		}
+
+		node = &index_nodes[child];
+		seg = (seg[len] == '/') ? &seg[len + 1] : NULL;
+	}
+
+	if (*resource != NULL) {
+		*path_len = match_len;
+	}
+
+	return 0;
+}
@@ -599,6 +599,11 @@ static int64_t check_notifications(struct lwm2m_ctx *ctx, const int64_t timestam
 	int64_t next = INT64_MAX;
 
 	lwm2m_registry_lock();
+
+	if (CONFIG_LWM2M_ENGINE_NOTIFY_ALIGN_WINDOW > 0) {
+		(void)engine_observe_align_notifications(ctx, timestamp);
+	}
+
 	SYS_SLIST_FOR_EACH_CONTAINER(&ctx->observer, obs, node) {
 		if (!obs->event_timestamp) {
 			continue;
@@ -625,8 +630,10 @@ static int64_t check_notifications(struct lwm2m_ctx *ctx, const int64_t timestam
 			engine_observe_shedule_next_event(obs, ctx->srv_obj_inst, timestamp);
 		obs->last_timestamp = timestamp;
 
-		if (!rc) {
-			/* create at most one notification */
+		if (!rc && CONFIG_LWM2M_ENGINE_NOTIFY_ALIGN_WINDOW == 0) {
+			/* create at most one notification, unless aligned ones
+			 * are sent together
+			 */
 			goto cleanup;
 		}
 	}
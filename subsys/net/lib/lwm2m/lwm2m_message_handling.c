@@ -348,6 +348,11 @@ STATIC int build_msg_block_for_send(struct lwm2m_message *msg, uint16_t block_nu
 
 	msg->cpkt.delta = msg->body_encode_buffer.delta;
 
+#if defined(CONFIG_COAP_OPTION_INDEX)
+	/* The options were copied as is, they are not indexed */
+	msg->cpkt.opt_indexed = false;
+#endif
+
 	if (block_num == 0) {
 		ret = request_output_block_ctx(&msg->out.block_ctx);
 		if (ret < 0) {
@@ -3199,6 +3204,7 @@ msg_init:
 
 	obs->active_notify = msg;
 	obs->resource_update = false;
+	ctx->notify_stats.sent++;
 	lwm2m_information_interface_send(msg);
 #if defined(CONFIG_LWM2M_RESOURCE_DATA_CACHE_SUPPORT)
 	msg->cache_info = NULL;
@@ -386,6 +386,9 @@ int lwm2m_notify_observer_path(const struct lwm2m_obj_path *path)
 				if (!obs->event_timestamp || obs->event_timestamp > timestamp) {
 					obs->resource_update = true;
 					obs->event_timestamp = timestamp;
+				} else {
+					/* Reported by the notification already scheduled */
+					sock_ctx[i]->notify_stats.coalesced++;
 				}
 
 				LOG_DBG("NOTIFY EVENT %u/%u/%u", path->obj_id, path->obj_inst_id,
@@ -1449,6 +1452,51 @@ int64_t engine_observe_shedule_next_event(struct observe_node *obs, uint16_t srv
 	return t_s;
 }
 
+int engine_observe_align_notifications(struct lwm2m_ctx *ctx, const int64_t timestamp)
+{
+	const int64_t window_end =
+		timestamp + MSEC_PER_SEC * CONFIG_LWM2M_ENGINE_NOTIFY_ALIGN_WINDOW;
+	struct notification_attrs attrs;
+	struct observe_node *obs;
+	bool due = false;
+	int aligned = 0;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&ctx->observer, obs, node) {
+		if (obs->event_timestamp && obs->event_timestamp <= timestamp &&
+		    obs->active_notify == NULL) {
+			due = true;
+			break;
+		}
+	}
+
+	if (!due) {
+		return 0;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&ctx->observer, obs, node) {
+		if (!obs->event_timestamp || obs->event_timestamp <= timestamp ||
+		    obs->event_timestamp > window_end || obs->active_notify != NULL) {
+			continue;
+		}
+
+		if (engine_observe_attribute_list_get(&obs->path_list, &attrs,
+						      ctx->srv_obj_inst) < 0) {
+			continue;
+		}
+
+		/* Never notify more often than allowed by pmin */
+		if (obs->last_timestamp + MSEC_PER_SEC * attrs.pmin > timestamp) {
+			continue;
+		}
+
+		obs->event_timestamp = timestamp;
+		ctx->notify_stats.aligned++;
+		aligned++;
+	}
+
+	return aligned;
+}
+
 struct lwm2m_obj_path_list *lwm2m_engine_get_from_list(sys_slist_t *path_list)
 {
 	sys_snode_t *path_node = sys_slist_get(path_list);
@@ -54,6 +54,16 @@ int lwm2m_engine_observation_handler(struct lwm2m_message *msg, int observe, uin
 
 void engine_remove_observer_by_id(uint16_t obj_id, int32_t obj_inst_id);
 
+/**
+ * Bring forward the notifications scheduled within the alignment window whose
+ * minimum period has elapsed, when at least one notification is due.
+ *
+ * @param ctx LwM2M client context
+ * @param timestamp Current time
+ * @return Number of notifications brought forward
+ */
+int engine_observe_align_notifications(struct lwm2m_ctx *ctx, const int64_t timestamp);
+
 /* path object list */
 struct lwm2m_obj_path_list {
 	sys_snode_t node;
@@ -89,6 +89,25 @@ static const struct default_obj_version default_obj_versions[] = {
 static sys_slist_t engine_obj_list;
 static sys_slist_t engine_obj_inst_list;
 
+/* Hash tables indexing the objects by their ID and the object instances by
+ * their object and instance ID. The lists above keep the registration order.
+ */
+static sys_slist_t engine_obj_hash[CONFIG_LWM2M_ENGINE_REGISTRY_HASH_SIZE];
+static sys_slist_t engine_obj_inst_hash[CONFIG_LWM2M_ENGINE_REGISTRY_HASH_SIZE];
+
+static sys_slist_t *engine_obj_bucket(uint16_t obj_id)
+{
+	return &engine_obj_hash[obj_id % CONFIG_LWM2M_ENGINE_REGISTRY_HASH_SIZE];
+}
+
+static sys_slist_t *engine_obj_inst_bucket(uint16_t obj_id, uint16_t obj_inst_id)
+{
+	/* Consecutive instances of an object land in consecutive buckets */
+	uint32_t hash = (uint32_t)obj_id * 31U + obj_inst_id;
+
+	return &engine_obj_inst_hash[hash % CONFIG_LWM2M_ENGINE_REGISTRY_HASH_SIZE];
+}
+
 /* Resource wrappers */
 sys_slist_t *lwm2m_engine_obj_list(void) { return &engine_obj_list; }
 
@@ -113,6 +132,7 @@ void lwm2m_register_obj(struct lwm2m_engine_obj *obj)
 #endif /* CONFIG_LWM2M_RD_CLIENT_SUPPORT_BOOTSTRAP */
 #endif /* CONFIG_LWM2M_ACCESS_CONTROL_ENABLE */
 	sys_slist_append(&engine_obj_list, &obj->node);
+	sys_slist_append(engine_obj_bucket(obj->obj_id), &obj->hash_node);
 	k_mutex_unlock(&registry_lock);
 }
 
@@ -124,6 +144,7 @@ void lwm2m_unregister_obj(struct lwm2m_engine_obj *obj)
 #endif
 	engine_remove_observer_by_id(obj->obj_id, -1);
 	sys_slist_find_and_remove(&engine_obj_list, &obj->node);
+	sys_slist_find_and_remove(engine_obj_bucket(obj->obj_id), &obj->hash_node);
 	k_mutex_unlock(&registry_lock);
 }
 
@@ -131,7 +152,11 @@ struct lwm2m_engine_obj *get_engine_obj(int obj_id)
 {
 	struct lwm2m_engine_obj *obj;
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&engine_obj_list, obj, node) {
+	if (obj_id < 0 || obj_id > UINT16_MAX) {
+		return NULL;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(engine_obj_bucket(obj_id), obj, hash_node) {
 		if (obj->obj_id == obj_id) {
 			return obj;
 		}
@@ -176,6 +201,8 @@ static void engine_register_obj_inst(struct lwm2m_engine_obj_inst *obj_inst)
 #endif /* CONFIG_LWM2M_RD_CLIENT_SUPPORT_BOOTSTRAP */
 #endif /* CONFIG_LWM2M_ACCESS_CONTROL_ENABLE */
 	sys_slist_append(&engine_obj_inst_list, &obj_inst->node);
+	sys_slist_append(engine_obj_inst_bucket(obj_inst->obj->obj_id, obj_inst->obj_inst_id),
+			 &obj_inst->hash_node);
 }
 
 static void engine_unregister_obj_inst(struct lwm2m_engine_obj_inst *obj_inst)
@@ -185,13 +212,21 @@ static void engine_unregister_obj_inst(struct lwm2m_engine_obj_inst *obj_inst)
 #endif
 	engine_remove_observer_by_id(obj_inst->obj->obj_id, obj_inst->obj_inst_id);
 	sys_slist_find_and_remove(&engine_obj_inst_list, &obj_inst->node);
+	sys_slist_find_and_remove(engine_obj_inst_bucket(obj_inst->obj->obj_id,
+							 obj_inst->obj_inst_id),
+				  &obj_inst->hash_node);
 }
 
 struct lwm2m_engine_obj_inst *get_engine_obj_inst(int obj_id, int obj_inst_id)
 {
 	struct lwm2m_engine_obj_inst *obj_inst;
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&engine_obj_inst_list, obj_inst, node) {
+	if (obj_id < 0 || obj_id > UINT16_MAX || obj_inst_id < 0 || obj_inst_id > UINT16_MAX) {
+		return NULL;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(engine_obj_inst_bucket(obj_id, obj_inst_id), obj_inst,
+				     hash_node) {
 		if (obj_inst->obj->obj_id == obj_id && obj_inst->obj_inst_id == obj_inst_id) {
 			return obj_inst;
 		}
@@ -204,6 +239,16 @@ struct lwm2m_engine_obj_inst *next_engine_obj_inst(int obj_id, int obj_inst_id)
 {
 	struct lwm2m_engine_obj_inst *obj_inst, *next = NULL;
 
+	/* Instances are usually numbered consecutively, so that iterating
+	 * over the instances of an object only walks the list at the end.
+	 */
+	if (obj_inst_id < UINT16_MAX) {
+		next = get_engine_obj_inst(obj_id, obj_inst_id + 1);
+		if (next) {
+			return next;
+		}
+	}
+
 	SYS_SLIST_FOR_EACH_CONTAINER(&engine_obj_inst_list, obj_inst, node) {
 		if (obj_inst->obj->obj_id == obj_id && obj_inst->obj_inst_id > obj_inst_id &&
 		    (!next || next->obj_inst_id > obj_inst->obj_inst_id)) {
@@ -395,10 +440,18 @@ int path_to_objs(const struct lwm2m_obj_path *path, struct lwm2m_engine_obj_inst
 		return -ENOENT;
 	}
 
-	for (i = 0; i < oi->resource_count; i++) {
-		if (oi->resources[i].res_id == path->res_id) {
-			r = &oi->resources[i];
-			break;
+	/* The resources are usually initialized in the order of the object
+	 * fields, so try the matching index before walking the array.
+	 */
+	i = of - oi->obj->fields;
+	if (i < oi->resource_count && oi->resources[i].res_id == path->res_id) {
+		r = &oi->resources[i];
+	} else {
+		for (i = 0; i < oi->resource_count; i++) {
+			if (oi->resources[i].res_id == path->res_id) {
+				r = &oi->resources[i];
+				break;
+			}
 		}
 	}
 
@@ -412,10 +465,16 @@ int path_to_objs(const struct lwm2m_obj_path *path, struct lwm2m_engine_obj_inst
 		return -ENOENT;
 	}
 
-	for (i = 0; i < r->res_inst_count; i++) {
-		if (r->res_instances[i].res_inst_id == path->res_inst_id) {
-			ri = &r->res_instances[i];
-			break;
+	/* Same for the resource instances, usually numbered from 0 */
+	if (path->res_inst_id < r->res_inst_count &&
+	    r->res_instances[path->res_inst_id].res_inst_id == path->res_inst_id) {
+		ri = &r->res_instances[path->res_inst_id];
+	} else {
+		for (i = 0; i < r->res_inst_count; i++) {
+			if (r->res_instances[i].res_inst_id == path->res_inst_id) {
+				ri = &r->res_instances[i];
+				break;
+			}
 		}
 	}
 
@@ -1459,13 +1518,62 @@ bool lwm2m_engine_shall_report_obj_version(const struct lwm2m_engine_obj *obj)
 }
 
 #if defined(CONFIG_LWM2M_RESOURCE_DATA_CACHE_SUPPORT)
-static sys_slist_t lwm2m_timed_cache_list;
 static struct lwm2m_time_series_resource lwm2m_cache_entries[CONFIG_LWM2M_MAX_CACHED_RESOURCES];
 
+/* Allocated cache entries, sorted by path for binary search */
+static struct lwm2m_time_series_resource *lwm2m_cache_index[CONFIG_LWM2M_MAX_CACHED_RESOURCES];
+static size_t lwm2m_cache_index_len;
+
+static int lwm2m_cache_path_cmp(const struct lwm2m_obj_path *a, const struct lwm2m_obj_path *b)
+{
+	if (a->obj_id != b->obj_id) {
+		return a->obj_id < b->obj_id ? -1 : 1;
+	}
+
+	if (a->obj_inst_id != b->obj_inst_id) {
+		return a->obj_inst_id < b->obj_inst_id ? -1 : 1;
+	}
+
+	if (a->res_id != b->res_id) {
+		return a->res_id < b->res_id ? -1 : 1;
+	}
+
+	if (a->level != b->level) {
+		return a->level < b->level ? -1 : 1;
+	}
+
+	if (a->level == LWM2M_PATH_LEVEL_RESOURCE_INST && a->res_inst_id != b->res_inst_id) {
+		return a->res_inst_id < b->res_inst_id ? -1 : 1;
+	}
+
+	return 0;
+}
+
+/* Return the index of the entry for the path, or the position where it would
+ * be inserted.
+ */
+static size_t lwm2m_cache_index_find(const struct lwm2m_obj_path *path)
+{
+	size_t low = 0, high = lwm2m_cache_index_len;
+
+	while (low < high) {
+		size_t mid = low + (high - low) / 2;
+
+		if (lwm2m_cache_path_cmp(&lwm2m_cache_index[mid]->path, path) < 0) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+
+	return low;
+}
+
 static struct lwm2m_time_series_resource *
 lwm2m_cache_entry_allocate(const struct lwm2m_obj_path *path)
 {
 	int i;
+	size_t pos;
 	struct lwm2m_time_series_resource *entry;
 
 	entry = lwm2m_cache_entry_get_by_object(path);
@@ -1476,7 +1584,13 @@ lwm2m_cache_entry_allocate(const struct lwm2m_obj_path *path)
 	for (i = 0; i < ARRAY_SIZE(lwm2m_cache_entries); i++) {
 		if (lwm2m_cache_entries[i].path.level == 0) {
 			lwm2m_cache_entries[i].path = *path;
-			sys_slist_append(&lwm2m_timed_cache_list, &lwm2m_cache_entries[i].node);
+
+			pos = lwm2m_cache_index_find(path);
+			memmove(&lwm2m_cache_index[pos + 1], &lwm2m_cache_index[pos],
+				(lwm2m_cache_index_len - pos) * sizeof(lwm2m_cache_index[0]));
+			lwm2m_cache_index[pos] = &lwm2m_cache_entries[i];
+			lwm2m_cache_index_len++;
+
 			return &lwm2m_cache_entries[i];
 		}
 	}
@@ -1562,21 +1676,21 @@ struct lwm2m_time_series_resource *
 lwm2m_cache_entry_get_by_object(const struct lwm2m_obj_path *obj_path)
 {
 #if defined(CONFIG_LWM2M_RESOURCE_DATA_CACHE_SUPPORT)
-	struct lwm2m_time_series_resource *entry;
+	size_t pos;
 
 	if (obj_path->level < LWM2M_PATH_LEVEL_RESOURCE) {
 		LOG_ERR("Path level wrong for cache %u", obj_path->level);
 		return NULL;
 	}
 
-	if (sys_slist_is_empty(&lwm2m_timed_cache_list)) {
+	if (lwm2m_cache_index_len == 0) {
 		return NULL;
 	}
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&lwm2m_timed_cache_list, entry, node) {
-		if (lwm2m_obj_path_equal(&entry->path, obj_path)) {
-			return entry;
-		}
+	pos = lwm2m_cache_index_find(obj_path);
+	if (pos < lwm2m_cache_index_len &&
+	    lwm2m_obj_path_equal(&lwm2m_cache_index[pos]->path, obj_path)) {
+		return lwm2m_cache_index[pos];
 	}
 #endif /* CONFIG_LWM2M_RESOURCE_DATA_CACHE_SUPPORT */
 	return NULL;
@@ -1643,7 +1757,7 @@ static int lwm2m_engine_data_cache_init(void)
 {
 	int i;
 
-	sys_slist_init(&lwm2m_timed_cache_list);
+	lwm2m_cache_index_len = 0;
 
 	for (i = 0; i < ARRAY_SIZE(lwm2m_cache_entries); i++) {
 		lwm2m_cache_entries[i].path.level = LWM2M_PATH_LEVEL_NONE;
@@ -205,8 +205,6 @@ sys_slist_t *lwm2m_engine_obj_inst_list(void);
  * LwM2M Time series resoursce data storage
  */
 struct lwm2m_time_series_resource {
-	/* object list */
-	sys_snode_t node;
 	/* Resource Path url */
 	struct lwm2m_obj_path path;
 	/* Ring buffer */
@@ -710,6 +710,10 @@ static int cmd_observations(const struct shell *sh, size_t argc, char **argv)
 	}
 	lwm2m_registry_unlock();
 
+	shell_print(sh, "Notifications sent %u, aligned %u, coalesced updates %u",
+		    ctx->notify_stats.sent, ctx->notify_stats.aligned,
+		    ctx->notify_stats.coalesced);
+
 	return 0;
 }
 
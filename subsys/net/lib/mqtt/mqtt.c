@@ -25,6 +25,16 @@ static void client_reset(struct mqtt_client *client)
 	client->internal.last_activity = 0U;
 	client->internal.rx_buf_datalen = 0U;
 	client->internal.remaining_payload = 0U;
+
+#if defined(CONFIG_MQTT_TOPIC_ALIAS_AUTO)
+	client->internal.tx_topic_alias_count = 0U;
+	client->internal.tx_topic_alias_max = 0U;
+#endif
+#if defined(CONFIG_MQTT_PUBLISH_QUEUE)
+	client->internal.tx_queue_datalen = 0U;
+	client->internal.inflight_count = 0U;
+	client->internal.inflight_max = 0U;
+#endif
 }
 
 /** @brief Initialize tx buffer. */
@@ -293,14 +303,295 @@ static int verify_tx_state(const struct mqtt_client *client)
 	return 0;
 }
 
-int mqtt_publish(struct mqtt_client *client,
-		 const struct mqtt_publish_param *param)
+void publish_limits_set(struct mqtt_client *client,
+			const struct mqtt_connack_param *param)
+{
+	ARG_UNUSED(param);
+
+#if defined(CONFIG_MQTT_PUBLISH_QUEUE)
+	client->internal.inflight_max = CONFIG_MQTT_PUBLISH_INFLIGHT_MAX;
+#if defined(CONFIG_MQTT_VERSION_5_0)
+	if (mqtt_is_version_5_0(client) && param->prop.rx.has_receive_maximum) {
+		client->internal.inflight_max = MIN(client->internal.inflight_max,
+						    param->prop.receive_maximum);
+	}
+#endif
+#endif /* CONFIG_MQTT_PUBLISH_QUEUE */
+
+#if defined(CONFIG_MQTT_TOPIC_ALIAS_AUTO)
+	/* Topic Alias Maximum absent means the server accepts no alias. */
+	client->internal.tx_topic_alias_count = 0U;
+	client->internal.tx_topic_alias_max = 0U;
+	if (mqtt_is_version_5_0(client) && param->prop.rx.has_topic_alias_maximum) {
+		client->internal.tx_topic_alias_max =
+			MIN(param->prop.topic_alias_maximum, CONFIG_MQTT_TOPIC_ALIAS_MAX);
+	}
+#endif /* CONFIG_MQTT_TOPIC_ALIAS_AUTO */
+}
+
+#if defined(CONFIG_MQTT_TOPIC_ALIAS_AUTO)
+bool publish_topic_alias_apply(struct mqtt_client *client,
+			       struct mqtt_publish_param *param)
+{
+	struct mqtt_utf8 *topic = &param->message.topic.topic;
+	struct mqtt_topic_alias *alias;
+
+	if (!mqtt_is_version_5_0(client) || param->prop.topic_alias != 0U ||
+	    topic->size == 0U || topic->size > CONFIG_MQTT_TOPIC_ALIAS_STRING_MAX) {
+		return false;
+	}
+
+	for (uint16_t i = 0U; i < client->internal.tx_topic_alias_count; i++) {
+		alias = &client->internal.tx_topic_aliases[i];
+
+		if (alias->topic_size == topic->size &&
+		    memcmp(alias->topic_buf, topic->utf8, topic->size) == 0) {
+			param->prop.topic_alias = i + 1U;
+			topic->size = 0U;
+			return false;
+		}
+	}
+
+	if (client->internal.tx_topic_alias_count >= client->internal.tx_topic_alias_max) {
+		return false;
+	}
+
+	alias = &client->internal.tx_topic_aliases[client->internal.tx_topic_alias_count];
+	memcpy(alias->topic_buf, topic->utf8, topic->size);
+	alias->topic_size = topic->size;
+
+	param->prop.topic_alias = ++client->internal.tx_topic_alias_count;
+
+	return true;
+}
+#endif /* CONFIG_MQTT_TOPIC_ALIAS_AUTO */
+
+static int publish_write(struct mqtt_client *client,
+			 const struct mqtt_publish_param *param)
 {
 	int err_code;
 	struct buf_ctx packet;
 	struct iovec io_vector[2];
 	struct msghdr msg;
 
+	tx_buf_init(client, &packet);
+
+	err_code = publish_encode(client, param, &packet);
+	if (err_code < 0) {
+		return err_code;
+	}
+
+	io_vector[0].iov_base = packet.cur;
+	io_vector[0].iov_len = packet.end - packet.cur;
+	io_vector[1].iov_base = param->message.payload.data;
+	io_vector[1].iov_len = param->message.payload.len;
+
+	memset(&msg, 0, sizeof(msg));
+
+	msg.msg_iov = io_vector;
+	msg.msg_iovlen = ARRAY_SIZE(io_vector);
+
+	return client_write_msg(client, &msg);
+}
+
+#if defined(CONFIG_MQTT_PUBLISH_QUEUE)
+static int tx_queue_flush(struct mqtt_client *client)
+{
+	uint32_t datalen = client->internal.tx_queue_datalen;
+
+	if (datalen == 0U) {
+		return 0;
+	}
+
+	client->internal.tx_queue_datalen = 0U;
+
+	return client_write(client, client->tx_queue_buf, datalen);
+}
+
+/* Encode the packet in place at the end of the queue buffer, then move the
+ * header over the space reserved for the longest fixed header and append
+ * the payload.
+ */
+static int tx_queue_append(struct mqtt_client *client,
+			   const struct mqtt_publish_param *param)
+{
+	uint32_t datalen = client->internal.tx_queue_datalen;
+	uint8_t *pos = client->tx_queue_buf + datalen;
+	struct buf_ctx packet;
+	uint32_t hdr_len;
+	int err_code;
+
+	packet.cur = pos;
+	packet.end = client->tx_queue_buf + client->tx_queue_buf_size;
+
+	err_code = publish_encode(client, param, &packet);
+	if (err_code < 0) {
+		return err_code;
+	}
+
+	hdr_len = packet.end - packet.cur;
+	if (hdr_len + param->message.payload.len >
+	    client->tx_queue_buf_size - datalen) {
+		return -ENOMEM;
+	}
+
+	memmove(pos, packet.cur, hdr_len);
+	memcpy(pos + hdr_len, param->message.payload.data,
+	       param->message.payload.len);
+
+	client->internal.tx_queue_datalen += hdr_len + param->message.payload.len;
+
+	return 0;
+}
+
+static int tx_queue_publish(struct mqtt_client *client,
+			    const struct mqtt_publish_param *param)
+{
+	int err_code = -ENOMEM;
+
+	if (client->tx_queue_buf != NULL) {
+		err_code = tx_queue_append(client, param);
+		if (err_code == -ENOMEM && client->internal.tx_queue_datalen > 0U) {
+			/* Make room by writing out the queued packets. */
+			err_code = tx_queue_flush(client);
+			if (err_code < 0) {
+				return err_code;
+			}
+
+			err_code = tx_queue_append(client, param);
+		}
+	}
+
+	if (err_code == -ENOMEM) {
+		/* Too large for the queue buffer, send it on its own. */
+		err_code = publish_write(client, param);
+	}
+
+	return err_code;
+}
+
+static int inflight_find(const struct mqtt_client *client, uint16_t message_id)
+{
+	for (int i = 0; i < client->internal.inflight_count; i++) {
+		if (client->internal.inflight_ids[i] == message_id) {
+			return i;
+		}
+	}
+
+	return -ENOENT;
+}
+
+void publish_inflight_release(struct mqtt_client *client, uint16_t message_id)
+{
+	int idx = inflight_find(client, message_id);
+
+	if (idx < 0) {
+		return;
+	}
+
+	/* Order does not matter, move the last id into the free slot. */
+	client->internal.inflight_count--;
+	client->internal.inflight_ids[idx] =
+		client->internal.inflight_ids[client->internal.inflight_count];
+}
+
+/* QoS 1 and QoS 2 messages count against the Receive Maximum of the server,
+ * whether they are queued or sent directly. A retransmission keeps the slot
+ * of the original message.
+ */
+static int publish_inflight_check(const struct mqtt_client *client,
+				  const struct mqtt_publish_param *param, bool *track)
+{
+	*track = false;
+
+	if (param->message.topic.qos == MQTT_QOS_0_AT_MOST_ONCE) {
+		return 0;
+	}
+
+	if (inflight_find(client, param->message_id) >= 0) {
+		return param->dup_flag ? 0 : -EBUSY;
+	}
+
+	if (client->internal.inflight_count >= client->internal.inflight_max) {
+		return -EAGAIN;
+	}
+
+	*track = true;
+
+	return 0;
+}
+
+static void publish_inflight_add(struct mqtt_client *client, uint16_t message_id)
+{
+	client->internal.inflight_ids[client->internal.inflight_count++] = message_id;
+}
+#else
+static int tx_queue_flush(struct mqtt_client *client)
+{
+	ARG_UNUSED(client);
+
+	return 0;
+}
+
+static int publish_inflight_check(const struct mqtt_client *client,
+				  const struct mqtt_publish_param *param, bool *track)
+{
+	ARG_UNUSED(client);
+	ARG_UNUSED(param);
+
+	*track = false;
+
+	return 0;
+}
+
+static void publish_inflight_add(struct mqtt_client *client, uint16_t message_id)
+{
+	ARG_UNUSED(client);
+	ARG_UNUSED(message_id);
+}
+#endif /* CONFIG_MQTT_PUBLISH_QUEUE */
+
+static int publish_send(struct mqtt_client *client,
+			const struct mqtt_publish_param *param, bool queue)
+{
+	int err_code;
+
+#if defined(CONFIG_MQTT_TOPIC_ALIAS_AUTO)
+	struct mqtt_publish_param aliased = *param;
+	bool new_alias = publish_topic_alias_apply(client, &aliased);
+
+	param = &aliased;
+#endif
+
+#if defined(CONFIG_MQTT_PUBLISH_QUEUE)
+	if (queue) {
+		err_code = tx_queue_publish(client, param);
+	} else
+#endif
+	{
+		ARG_UNUSED(queue);
+
+		err_code = publish_write(client, param);
+	}
+
+#if defined(CONFIG_MQTT_TOPIC_ALIAS_AUTO)
+	/* The server did not learn the new alias, unless the connection was
+	 * closed on error, which drops all the aliases anyway.
+	 */
+	if (err_code < 0 && new_alias && client->internal.tx_topic_alias_count > 0U) {
+		client->internal.tx_topic_alias_count--;
+	}
+#endif
+
+	return err_code;
+}
+
+int mqtt_publish(struct mqtt_client *client,
+		 const struct mqtt_publish_param *param)
+{
+	bool track;
+	int err_code;
+
 	NULL_PARAM_CHECK(client);
 	NULL_PARAM_CHECK(param);
 
@@ -311,29 +602,30 @@ int mqtt_publish(struct mqtt_client *client,
 
 	mqtt_mutex_lock(client);
 
-	tx_buf_init(client, &packet);
-
 	err_code = verify_tx_state(client);
 	if (err_code < 0) {
 		goto error;
 	}
 
-	err_code = publish_encode(client, param, &packet);
+	err_code = publish_inflight_check(client, param, &track);
 	if (err_code < 0) {
 		goto error;
 	}
 
-	io_vector[0].iov_base = packet.cur;
-	io_vector[0].iov_len = packet.end - packet.cur;
-	io_vector[1].iov_base = param->message.payload.data;
-	io_vector[1].iov_len = param->message.payload.len;
-
-	memset(&msg, 0, sizeof(msg));
+	/* Keep the messages in order. */
+	err_code = tx_queue_flush(client);
+	if (err_code < 0) {
+		goto error;
+	}
 
-	msg.msg_iov = io_vector;
-	msg.msg_iovlen = ARRAY_SIZE(io_vector);
+	err_code = publish_send(client, param, false);
+	if (err_code < 0) {
+		goto error;
+	}
 
-	err_code = client_write_msg(client, &msg);
+	if (track) {
+		publish_inflight_add(client, param->message_id);
+	}
 
 error:
 	NET_DBG("[CID %p]:[State 0x%02x]: << result 0x%08x",
@@ -344,6 +636,72 @@ error:
 	return err_code;
 }
 
+#if defined(CONFIG_MQTT_PUBLISH_QUEUE)
+int mqtt_publish_queue(struct mqtt_client *client,
+		       const struct mqtt_publish_param *param)
+{
+	bool track;
+	int err_code;
+
+	NULL_PARAM_CHECK(client);
+	NULL_PARAM_CHECK(param);
+
+	NET_DBG("[CID %p]:[State 0x%02x]: >> Message id 0x%04x, "
+		 "Data size 0x%08x", client, client->internal.state,
+		 param->message_id, param->message.payload.len);
+
+	mqtt_mutex_lock(client);
+
+	err_code = verify_tx_state(client);
+	if (err_code < 0) {
+		goto error;
+	}
+
+	err_code = publish_inflight_check(client, param, &track);
+	if (err_code < 0) {
+		goto error;
+	}
+
+	err_code = publish_send(client, param, true);
+	if (err_code < 0) {
+		goto error;
+	}
+
+	if (track) {
+		publish_inflight_add(client, param->message_id);
+	}
+
+error:
+	NET_DBG("[CID %p]:[State 0x%02x]: << result 0x%08x",
+		 client, client->internal.state, err_code);
+
+	mqtt_mutex_unlock(client);
+
+	return err_code;
+}
+
+int mqtt_publish_flush(struct mqtt_client *client)
+{
+	int err_code;
+
+	NULL_PARAM_CHECK(client);
+
+	mqtt_mutex_lock(client);
+
+	err_code = verify_tx_state(client);
+	if (err_code < 0) {
+		goto error;
+	}
+
+	err_code = tx_queue_flush(client);
+
+error:
+	mqtt_mutex_unlock(client);
+
+	return err_code;
+}
+#endif /* CONFIG_MQTT_PUBLISH_QUEUE */
+
 int mqtt_publish_qos1_ack(struct mqtt_client *client,
 			  const struct mqtt_puback_param *param)
 {
@@ -512,6 +870,11 @@ int mqtt_disconnect(struct mqtt_client *client,
 		goto error;
 	}
 
+	err_code = tx_queue_flush(client);
+	if (err_code < 0) {
+		goto error;
+	}
+
 	err_code = disconnect_encode(client, param, &packet);
 	if (err_code < 0) {
 		goto error;
@@ -711,6 +1074,13 @@ int mqtt_live(struct mqtt_client *client)
 
 	mqtt_mutex_lock(client);
 
+	/* Queued messages are written out at least this often. */
+	err_code = tx_queue_flush(client);
+	if (err_code < 0) {
+		mqtt_mutex_unlock(client);
+		return err_code;
+	}
+
 	elapsed_time = mqtt_elapsed_time_in_ms_get(
 				client->internal.last_activity);
 	if ((client->keepalive > 0) &&
@@ -208,6 +208,46 @@ int mqtt_handle_rx(struct mqtt_client *client);
  */
 void mqtt_client_disconnect(struct mqtt_client *client, int result, bool notify);
 
+/**@brief Apply the limits of the server to the messages published.
+ *
+ * @param[in] client Identifies the client which connected.
+ * @param[in] param Connection acknowledgment received from the server.
+ */
+void publish_limits_set(struct mqtt_client *client,
+			const struct mqtt_connack_param *param);
+
+#if defined(CONFIG_MQTT_PUBLISH_QUEUE)
+/**@brief Release the message id of an acknowledged queued message.
+ *
+ * @param[in] client Identifies the client for which the message was queued.
+ * @param[in] message_id Message id acknowledged.
+ */
+void publish_inflight_release(struct mqtt_client *client, uint16_t message_id);
+#else
+static inline void publish_inflight_release(struct mqtt_client *client,
+					    uint16_t message_id)
+{
+	ARG_UNUSED(client);
+	ARG_UNUSED(message_id);
+}
+#endif /* CONFIG_MQTT_PUBLISH_QUEUE */
+
+#if defined(CONFIG_MQTT_TOPIC_ALIAS_AUTO)
+/**@brief Replace the topic of a message to publish with an alias.
+ *
+ * A new alias is assigned to the topic if it has none yet and the server
+ * accepts more aliases. In such case, the topic is kept in the message to
+ * let the server learn the alias.
+ *
+ * @param[in] client Identifies the client publishing the message.
+ * @param[inout] param Publish message parameters to update.
+ *
+ * @return true if a new alias was assigned, false otherwise.
+ */
+bool publish_topic_alias_apply(struct mqtt_client *client,
+			       struct mqtt_publish_param *param);
+#endif /* CONFIG_MQTT_TOPIC_ALIAS_AUTO */
+
 /**@brief Constructs/encodes Connect packet.
  *
  * @param[in] client Identifies the client for which the procedure is requested.
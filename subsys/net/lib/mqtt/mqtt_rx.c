@@ -45,6 +45,7 @@ static int mqtt_handle_packet(struct mqtt_client *client,
 						MQTT_CONNECTION_ACCEPTED) {
 				/* Set state. */
 				MQTT_SET_STATE(client, MQTT_STATE_CONNECTED);
+				publish_limits_set(client, &evt.param.connack);
 			} else {
 				err_code = -ECONNREFUSED;
 			}
@@ -80,6 +81,10 @@ static int mqtt_handle_packet(struct mqtt_client *client,
 		evt.type = MQTT_EVT_PUBACK;
 		err_code = publish_ack_decode(client, buf, &evt.param.puback);
 		evt.result = err_code;
+		if (err_code == 0) {
+			publish_inflight_release(client, evt.param.puback.message_id);
+		}
+
 		break;
 
 	case MQTT_PKT_TYPE_PUBREC:
@@ -89,6 +94,13 @@ static int mqtt_handle_packet(struct mqtt_client *client,
 		err_code = publish_receive_decode(client, buf,
 						  &evt.param.pubrec);
 		evt.result = err_code;
+#if defined(CONFIG_MQTT_VERSION_5_0)
+		/* A failure reason code ends the QoS 2 flow. */
+		if (err_code == 0 && mqtt_is_version_5_0(client) &&
+		    evt.param.pubrec.reason_code >= 0x80) {
+			publish_inflight_release(client, evt.param.pubrec.message_id);
+		}
+#endif
 		break;
 
 	case MQTT_PKT_TYPE_PUBREL:
@@ -107,6 +119,10 @@ static int mqtt_handle_packet(struct mqtt_client *client,
 		err_code = publish_complete_decode(client, buf,
 						   &evt.param.pubcomp);
 		evt.result = err_code;
+		if (err_code == 0) {
+			publish_inflight_release(client, evt.param.pubcomp.message_id);
+		}
+
 		break;
 
 	case MQTT_PKT_TYPE_SUBACK:
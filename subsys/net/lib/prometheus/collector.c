@@ -20,6 +20,8 @@
 #include <zephyr/kernel.h>
 #include <zephyr/sys/iterable_sections.h>
 
+#include "prometheus_internal.h"
+
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(pm_collector, CONFIG_PROMETHEUS_LOG_LEVEL);
 
@@ -175,20 +177,17 @@ int prometheus_collector_walk_metrics(struct prometheus_collector_walk_context *
 
 		/* Start of the loop is taken from
 		 * SYS_SLIST_FOR_EACH_CONTAINER_SAFE macro to simulate
-		 * a loop.
+		 * a loop. The first metric is taken below.
 		 */
 
-		ctx->metric = Z_GENLIST_PEEK_HEAD_CONTAINER(slist,
-							    &ctx->collector->metrics,
-							    ctx->metric,
-							    node);
-		ctx->tmp = Z_GENLIST_PEEK_NEXT_CONTAINER(slist,
-							 ctx->metric,
+		ctx->tmp = Z_GENLIST_PEEK_HEAD_CONTAINER(slist,
+							 &ctx->collector->metrics,
+							 ctx->tmp,
 							 node);
 	}
 
 	if (ctx->state == PROMETHEUS_WALK_CONTINUE) {
-		int len = 0;
+		size_t pos = strnlen(buffer, buffer_size);
 
 		ctx->metric = ctx->tmp;
 		ctx->tmp = Z_GENLIST_PEEK_NEXT_CONTAINER(slist,
@@ -215,12 +214,15 @@ int prometheus_collector_walk_metrics(struct prometheus_collector_walk_context *
 			}
 		}
 
-		ret = prometheus_format_one_metric(ctx->metric, buffer, buffer_size, &len);
+		ret = prometheus_format_metric(ctx->metric, ctx->prev, (char *)buffer, buffer_size,
+					       &pos);
 		if (ret < 0) {
 			ctx->state = PROMETHEUS_WALK_STOP;
 			goto out;
 		}
 
+		ctx->prev = ctx->metric;
+
 		ret = -EAGAIN;
 	}
 
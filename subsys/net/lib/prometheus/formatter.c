@@ -13,6 +13,7 @@
 #include <zephyr/net/prometheus/gauge.h>
 #include <zephyr/net/prometheus/counter.h>
 
+#include <math.h>
 #include <stdarg.h>
 #include <stdio.h>
 #include <string.h>
@@ -21,241 +22,640 @@
 
 #include <zephyr/kernel.h>
 
+#include "prometheus_internal.h"
+
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(pm_formatter, CONFIG_PROMETHEUS_LOG_LEVEL);
 
-static int write_metric_to_buffer(char *buffer, size_t buffer_size, const char *format, ...)
+#define COUNTER_SUFFIX "_total"
+
+static int write_metric_to_buffer(char *buffer, size_t buffer_size, size_t *pos,
+				  const char *format, ...)
 {
 	/* helper function to write formatted metric to buffer */
 	va_list args;
-	size_t len = strlen(buffer);
+	int len;
 
-	if (len >= buffer_size) {
+	if (*pos >= buffer_size) {
 		return -ENOMEM;
 	}
-	buffer += len;
-	buffer_size -= len;
 
 	va_start(args, format);
-	len = vsnprintf(buffer, buffer_size, format, args);
+	len = vsnprintf(buffer + *pos, buffer_size - *pos, format, args);
 	va_end(args);
-	if (len >= buffer_size) {
+	if (len < 0 || (size_t)len >= buffer_size - *pos) {
 		return -ENOMEM;
 	}
 
+	*pos += len;
+
 	return 0;
 }
 
-int prometheus_format_one_metric(struct prometheus_metric *metric, char *buffer,
-				 size_t buffer_size, int *written)
+static int copy_to_buffer(char *buffer, size_t buffer_size, size_t *pos, const char *src,
+			  size_t len)
 {
-	int ret = 0;
+	if (*pos >= buffer_size || len >= buffer_size - *pos) {
+		return -ENOMEM;
+	}
 
-	/* write HELP line if available */
-	if (metric->description[0] != '\0') {
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "# HELP %s %s\n", metric->name,
-					     metric->description);
-		if (ret < 0) {
-			LOG_ERR("Error writing to buffer");
-			goto out;
-		}
+	memcpy(buffer + *pos, src, len);
+	*pos += len;
+	buffer[*pos] = '\0';
+
+	return 0;
+}
+
+static const char *metric_type_name(enum prometheus_metric_type type)
+{
+	switch (type) {
+	case PROMETHEUS_COUNTER:
+		return "counter";
+	case PROMETHEUS_GAUGE:
+		return "gauge";
+	case PROMETHEUS_HISTOGRAM:
+		return "histogram";
+	case PROMETHEUS_SUMMARY:
+		return "summary";
+	default:
+		return "untyped";
 	}
+}
 
-	/* write TYPE line */
+/* OpenMetrics histograms end with a +Inf bucket, added if missing */
+static size_t histogram_bucket_count(const struct prometheus_histogram *histogram,
+				     enum prometheus_format format)
+{
+	size_t count = histogram->num_buckets;
+
+	if (format == PROMETHEUS_FORMAT_OPENMETRICS &&
+	    (count == 0 || !isinf(histogram->buckets[count - 1].upper_bound))) {
+		count++;
+	}
+
+	return count;
+}
+
+/* Number of samples of the metric, each one being a line of the exposition */
+static size_t metric_sample_count(const struct prometheus_metric *metric,
+				  enum prometheus_format format)
+{
 	switch (metric->type) {
 	case PROMETHEUS_COUNTER:
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "# TYPE %s counter\n", metric->name);
-		if (ret < 0) {
-			LOG_ERR("Error writing counter");
-			goto out;
+	case PROMETHEUS_GAUGE:
+		return MAX(metric->num_labels, 1);
+	case PROMETHEUS_HISTOGRAM:
+		return histogram_bucket_count(CONTAINER_OF(metric, struct prometheus_histogram,
+							   base), format) + 2;
+	case PROMETHEUS_SUMMARY:
+		return CONTAINER_OF(metric, struct prometheus_summary, base)->num_quantiles + 2;
+	default:
+		return 0;
+	}
+}
+
+/* Write the value of the sample at the given index, the samples being in
+ * exposition order: one per label for counters and gauges, then the buckets
+ * or quantiles followed by the sum and count for histograms and summaries.
+ */
+static int write_sample_value(const struct prometheus_metric *metric, size_t idx,
+			      enum prometheus_format format, char *buffer, size_t buffer_size,
+			      size_t *pos)
+{
+	switch (metric->type) {
+	case PROMETHEUS_COUNTER: {
+		const struct prometheus_counter *counter =
+			CONTAINER_OF(metric, struct prometheus_counter, base);
+
+		return write_metric_to_buffer(buffer, buffer_size, pos, "%llu\n",
+					      counter->value);
+	}
+
+	case PROMETHEUS_GAUGE: {
+		const struct prometheus_gauge *gauge =
+			CONTAINER_OF(metric, struct prometheus_gauge, base);
+
+		return write_metric_to_buffer(buffer, buffer_size, pos, "%f\n", gauge->value);
+	}
+
+	case PROMETHEUS_HISTOGRAM: {
+		const struct prometheus_histogram *histogram =
+			CONTAINER_OF(metric, struct prometheus_histogram, base);
+		size_t num_buckets = histogram_bucket_count(histogram, format);
+
+		if (idx < histogram->num_buckets) {
+			return write_metric_to_buffer(buffer, buffer_size, pos, "%lu\n",
+						      histogram->buckets[idx].count);
 		}
 
-		break;
+		if (idx == num_buckets) {
+			return write_metric_to_buffer(buffer, buffer_size, pos, "%f\n",
+						      histogram->sum);
+		}
+
+		return write_metric_to_buffer(buffer, buffer_size, pos, "%lu\n",
+					      histogram->count);
+	}
+
+	case PROMETHEUS_SUMMARY: {
+		const struct prometheus_summary *summary =
+			CONTAINER_OF(metric, struct prometheus_summary, base);
+
+		if (idx < summary->num_quantiles) {
+			return write_metric_to_buffer(buffer, buffer_size, pos, "%f\n",
+						      summary->quantiles[idx].value);
+		}
+
+		if (idx == summary->num_quantiles) {
+			return write_metric_to_buffer(buffer, buffer_size, pos, "%f\n",
+						      summary->sum);
+		}
+
+		return write_metric_to_buffer(buffer, buffer_size, pos, "%lu\n",
+					      summary->count);
+	}
+
+	default:
+		return -EINVAL;
+	}
+}
+
+/* Write the name and labels of the sample at the given index, up to and
+ * including the space separating them from the value.
+ */
+static int write_sample_prefix(const struct prometheus_metric *metric, size_t idx,
+			       enum prometheus_format format, char *buffer, size_t buffer_size,
+			       size_t *pos)
+{
+	bool openmetrics = (format == PROMETHEUS_FORMAT_OPENMETRICS);
+
+	switch (metric->type) {
+	case PROMETHEUS_COUNTER: {
+		const char *suffix = "";
+		size_t len = strlen(metric->name);
+
+		/* OpenMetrics counter samples carry the _total suffix */
+		if (openmetrics && (len < sizeof(COUNTER_SUFFIX) - 1 ||
+				    strcmp(&metric->name[len - (sizeof(COUNTER_SUFFIX) - 1)],
+					   COUNTER_SUFFIX) != 0)) {
+			suffix = COUNTER_SUFFIX;
+		}
+
+		if (metric->num_labels == 0) {
+			return write_metric_to_buffer(buffer, buffer_size, pos, "%s%s ",
+						      metric->name, suffix);
+		}
+
+		return write_metric_to_buffer(buffer, buffer_size, pos, "%s%s{%s=\"%s\"} ",
+					      metric->name, suffix, metric->labels[idx].key,
+					      metric->labels[idx].value);
+	}
 
 	case PROMETHEUS_GAUGE:
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "# TYPE %s gauge\n", metric->name);
-		if (ret < 0) {
-			LOG_ERR("Error writing gauge");
-			goto out;
+		if (metric->num_labels == 0) {
+			return write_metric_to_buffer(buffer, buffer_size, pos, "%s ",
+						      metric->name);
 		}
 
-		break;
+		return write_metric_to_buffer(buffer, buffer_size, pos, "%s{%s=\"%s\"} ",
+					      metric->name, metric->labels[idx].key,
+					      metric->labels[idx].value);
 
-	case PROMETHEUS_HISTOGRAM:
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "# TYPE %s histogram\n", metric->name);
-		if (ret < 0) {
-			LOG_ERR("Error writing histogram");
-			goto out;
+	case PROMETHEUS_HISTOGRAM: {
+		const struct prometheus_histogram *histogram =
+			CONTAINER_OF(metric, struct prometheus_histogram, base);
+		size_t num_buckets = histogram_bucket_count(histogram, format);
+
+		if (idx < histogram->num_buckets) {
+			if (openmetrics) {
+				return write_metric_to_buffer(buffer, buffer_size, pos,
+							      "%s_bucket{le=\"%g\"} ",
+							      metric->name,
+							      histogram->buckets[idx].upper_bound);
+			}
+
+			return write_metric_to_buffer(buffer, buffer_size, pos,
+						      "%s_bucket{le=\"%f\"} ", metric->name,
+						      histogram->buckets[idx].upper_bound);
 		}
 
-		break;
+		if (idx < num_buckets) {
+			return write_metric_to_buffer(buffer, buffer_size, pos,
+						      "%s_bucket{le=\"+Inf\"} ", metric->name);
+		}
 
-	case PROMETHEUS_SUMMARY:
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "# TYPE %s summary\n", metric->name);
-		if (ret < 0) {
-			LOG_ERR("Error writing summary");
-			goto out;
+		return write_metric_to_buffer(buffer, buffer_size, pos, "%s_%s ", metric->name,
+					      idx == num_buckets ? "sum" : "count");
+	}
+
+	case PROMETHEUS_SUMMARY: {
+		const struct prometheus_summary *summary =
+			CONTAINER_OF(metric, struct prometheus_summary, base);
+
+		if (idx < summary->num_quantiles) {
+			if (openmetrics) {
+				return write_metric_to_buffer(buffer, buffer_size, pos,
+							      "%s{quantile=\"%g\"} ",
+							      metric->name,
+							      summary->quantiles[idx].quantile);
+			}
+
+			return write_metric_to_buffer(buffer, buffer_size, pos,
+						      "%s{quantile=\"%f\"} ", metric->name,
+						      summary->quantiles[idx].quantile);
 		}
 
-		break;
+		return write_metric_to_buffer(buffer, buffer_size, pos, "%s_%s ", metric->name,
+					      idx == summary->num_quantiles ? "sum" : "count");
+	}
 
 	default:
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "# TYPE %s untyped\n", metric->name);
+		return -EINVAL;
+	}
+}
+
+/* Metrics of the same name following each other are the series of a single
+ * metric family, sharing the HELP and TYPE lines of the first one.
+ */
+static bool same_family(const struct prometheus_metric *prev,
+			const struct prometheus_metric *metric)
+{
+	return prev != NULL && prev->type == metric->type && strcmp(prev->name, metric->name) == 0;
+}
+
+static int write_metric_header(const struct prometheus_metric *metric,
+			       enum prometheus_format format, char *buffer, size_t buffer_size,
+			       size_t *pos)
+{
+	size_t name_len = strlen(metric->name);
+	int ret;
+
+	/* The OpenMetrics counter family is named without the _total suffix */
+	if (format == PROMETHEUS_FORMAT_OPENMETRICS && metric->type == PROMETHEUS_COUNTER &&
+	    name_len >= sizeof(COUNTER_SUFFIX) - 1 &&
+	    strcmp(&metric->name[name_len - (sizeof(COUNTER_SUFFIX) - 1)],
+		   COUNTER_SUFFIX) == 0) {
+		name_len -= sizeof(COUNTER_SUFFIX) - 1;
+	}
+
+	/* write HELP line if available, the compact format leaves it out */
+	if (format == PROMETHEUS_FORMAT_TEXT && metric->description[0] != '\0') {
+		ret = write_metric_to_buffer(buffer, buffer_size, pos, "# HELP %s %s\n",
+					     metric->name, metric->description);
 		if (ret < 0) {
-			LOG_ERR("Error writing untyped");
-			goto out;
+			LOG_ERR("Error writing to buffer");
+			return ret;
 		}
+	}
+
+	/* write TYPE line */
+	ret = write_metric_to_buffer(buffer, buffer_size, pos, "# TYPE %.*s %s\n", (int)name_len,
+				     metric->name, metric_type_name(metric->type));
+	if (ret < 0) {
+		LOG_ERR("Error writing %s", metric_type_name(metric->type));
+	}
+
+	return ret;
+}
+
+static int format_metric(const struct prometheus_metric *metric, enum prometheus_format format,
+			 bool header, char *buffer, size_t buffer_size, size_t *pos)
+{
+	size_t count;
+	int ret = 0;
+
+	if (metric->type != PROMETHEUS_COUNTER && metric->type != PROMETHEUS_GAUGE &&
+	    metric->type != PROMETHEUS_HISTOGRAM && metric->type != PROMETHEUS_SUMMARY) {
+		/* should not happen */
+		LOG_ERR("Unsupported metric type %d", metric->type);
+		return -EINVAL;
+	}
 
-		break;
+	if (header) {
+		ret = write_metric_header(metric, format, buffer, buffer_size, pos);
+		if (ret < 0) {
+			return ret;
+		}
 	}
 
 	/* write metric-specific fields */
-	switch (metric->type) {
-	case PROMETHEUS_COUNTER: {
-		const struct prometheus_counter *counter =
-			CONTAINER_OF(metric, struct prometheus_counter, base);
+	count = metric_sample_count(metric, format);
 
-		LOG_DBG("counter->value: %llu", counter->value);
+	for (size_t i = 0; i < count; i++) {
+		ret = write_sample_prefix(metric, i, format, buffer, buffer_size, pos);
+		if (ret < 0) {
+			break;
+		}
 
-		for (int i = 0; i < metric->num_labels; ++i) {
-			ret = write_metric_to_buffer(
-				buffer + *written, buffer_size - *written,
-				"%s{%s=\"%s\"} %llu\n", metric->name, metric->labels[i].key,
-				metric->labels[i].value, counter->value);
-			if (ret < 0) {
-				LOG_ERR("Error writing counter");
-				goto out;
-			}
+		ret = write_sample_value(metric, i, format, buffer, buffer_size, pos);
+		if (ret < 0) {
+			break;
 		}
+	}
 
-		break;
+	if (ret < 0) {
+		LOG_ERR("Error writing %s", metric_type_name(metric->type));
 	}
 
-	case PROMETHEUS_GAUGE: {
-		const struct prometheus_gauge *gauge =
-			CONTAINER_OF(metric, struct prometheus_gauge, base);
+	return ret;
+}
 
-		LOG_DBG("gauge->value: %f", gauge->value);
+int prometheus_format_one_metric(struct prometheus_metric *metric, char *buffer,
+				 size_t buffer_size, int *written)
+{
+	size_t pos;
+	int ret;
 
-		for (int i = 0; i < metric->num_labels; ++i) {
-			ret = write_metric_to_buffer(
-				buffer + *written, buffer_size - *written,
-				"%s{%s=\"%s\"} %f\n", metric->name, metric->labels[i].key,
-				metric->labels[i].value, gauge->value);
-			if (ret < 0) {
-				LOG_ERR("Error writing gauge");
-				goto out;
-			}
-		}
+	/* Append to what the buffer already holds */
+	pos = *written + strnlen(buffer + *written, buffer_size - *written);
 
-		break;
+	ret = format_metric(metric, PROMETHEUS_FORMAT_TEXT, true, buffer, buffer_size, &pos);
+	if (ret < 0) {
+		return ret;
 	}
 
-	case PROMETHEUS_HISTOGRAM: {
-		const struct prometheus_histogram *histogram =
-			CONTAINER_OF(metric, struct prometheus_histogram, base);
+	*written = pos;
+
+	return 0;
+}
 
-		LOG_DBG("histogram->count: %lu", histogram->count);
+int prometheus_format_metric(const struct prometheus_metric *metric,
+			     const struct prometheus_metric *prev, char *buffer,
+			     size_t buffer_size, size_t *pos)
+{
+	return format_metric(metric, PROMETHEUS_FORMAT_TEXT, !same_family(prev, metric), buffer,
+			     buffer_size, pos);
+}
 
-		for (int i = 0; i < histogram->num_buckets; ++i) {
-			ret = write_metric_to_buffer(
-				buffer + *written, buffer_size - *written,
-				"%s_bucket{le=\"%f\"} %lu\n", metric->name,
-				histogram->buckets[i].upper_bound,
-				histogram->buckets[i].count);
+int prometheus_format_exposition(struct prometheus_collector *collector, char *buffer,
+				 size_t buffer_size)
+{
+	struct prometheus_metric *metric;
+	struct prometheus_metric *tmp;
+	struct prometheus_metric *prev = NULL;
+	size_t pos;
+	int ret = 0;
+
+	if (collector == NULL || buffer == NULL || buffer_size == 0) {
+		LOG_ERR("Invalid arguments");
+		return -EINVAL;
+	}
+
+	/* Append to what the buffer already holds */
+	pos = strnlen(buffer, buffer_size);
+
+	k_mutex_lock(&collector->lock, K_FOREVER);
+
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&collector->metrics, metric, tmp, node) {
+
+		/* If there is a user callback, use it to update the metric data. */
+		if (collector->user_cb) {
+			ret = collector->user_cb(collector, metric, collector->user_data);
 			if (ret < 0) {
-				LOG_ERR("Error writing histogram");
+				if (ret == -EAGAIN) {
+					/* Skip this metric for now */
+					ret = 0;
+					continue;
+				}
+
+				LOG_ERR("Error in user callback (%d)", ret);
 				goto out;
 			}
 		}
 
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "%s_sum %f\n", metric->name, histogram->sum);
+		ret = prometheus_format_metric(metric, prev, buffer, buffer_size, &pos);
 		if (ret < 0) {
-			LOG_ERR("Error writing histogram");
 			goto out;
 		}
 
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "%s_count %lu\n", metric->name,
-					     histogram->count);
-		if (ret < 0) {
-			LOG_ERR("Error writing histogram");
-			goto out;
+		prev = metric;
+	}
+
+out:
+	k_mutex_unlock(&collector->lock);
+
+	return ret;
+}
+
+#define FINGERPRINT_BASIS 0xcbf29ce484222325ULL
+#define FINGERPRINT_PRIME 0x100000001b3ULL
+
+static uint64_t fingerprint_add(uint64_t fingerprint, uint64_t value)
+{
+	return (fingerprint ^ value) * FINGERPRINT_PRIME;
+}
+
+static uint64_t fingerprint_add_double(uint64_t fingerprint, double value)
+{
+	uint64_t bits = 0;
+
+	memcpy(&bits, &value, MIN(sizeof(value), sizeof(bits)));
+
+	return fingerprint_add(fingerprint, bits);
+}
+
+/* Digest of the values of a metric, telling whether the metric changed since
+ * it was last rendered.
+ */
+static uint64_t metric_fingerprint(const struct prometheus_metric *metric)
+{
+	uint64_t fingerprint = fingerprint_add(FINGERPRINT_BASIS,
+					       metric_sample_count(metric, PROMETHEUS_FORMAT_TEXT));
+
+	switch (metric->type) {
+	case PROMETHEUS_COUNTER: {
+		const struct prometheus_counter *counter =
+			CONTAINER_OF(metric, struct prometheus_counter, base);
+
+		return fingerprint_add(fingerprint, counter->value);
+	}
+
+	case PROMETHEUS_GAUGE: {
+		const struct prometheus_gauge *gauge =
+			CONTAINER_OF(metric, struct prometheus_gauge, base);
+
+		return fingerprint_add_double(fingerprint, gauge->value);
+	}
+
+	case PROMETHEUS_HISTOGRAM: {
+		const struct prometheus_histogram *histogram =
+			CONTAINER_OF(metric, struct prometheus_histogram, base);
+
+		for (size_t i = 0; i < histogram->num_buckets; i++) {
+			fingerprint = fingerprint_add(fingerprint, histogram->buckets[i].count);
 		}
 
-		break;
+		fingerprint = fingerprint_add_double(fingerprint, histogram->sum);
+
+		return fingerprint_add(fingerprint, histogram->count);
 	}
 
 	case PROMETHEUS_SUMMARY: {
 		const struct prometheus_summary *summary =
 			CONTAINER_OF(metric, struct prometheus_summary, base);
 
-		LOG_DBG("summary->count: %lu", summary->count);
+		for (size_t i = 0; i < summary->num_quantiles; i++) {
+			fingerprint = fingerprint_add_double(fingerprint,
+							     summary->quantiles[i].value);
+		}
+
+		fingerprint = fingerprint_add_double(fingerprint, summary->sum);
+
+		return fingerprint_add(fingerprint, summary->count);
+	}
+
+	default:
+		return fingerprint;
+	}
+}
+
+static uint64_t fingerprint_add_string(uint64_t fingerprint, const char *str)
+{
+	for (; *str != '\0'; str++) {
+		fingerprint = fingerprint_add(fingerprint, (uint8_t)*str);
+	}
 
-		for (int i = 0; i < summary->num_quantiles; ++i) {
-			ret = write_metric_to_buffer(
-				buffer + *written, buffer_size - *written,
-				"%s{%s=\"%f\"} %f\n", metric->name, "quantile",
-				summary->quantiles[i].quantile,
-				summary->quantiles[i].value);
+	/* Tell apart the key and value boundaries */
+	return fingerprint_add(fingerprint, 0);
+}
+
+/* Digest of the labels of a metric, which may be rewritten in place between
+ * scrapes, for example when a metric is reused for another object.
+ */
+static uint64_t label_fingerprint(const struct prometheus_metric *metric)
+{
+	uint64_t fingerprint = fingerprint_add(FINGERPRINT_BASIS, metric->num_labels);
+
+	for (int i = 0; i < metric->num_labels; i++) {
+		fingerprint = fingerprint_add_string(fingerprint, metric->labels[i].key);
+		fingerprint = fingerprint_add_string(fingerprint, metric->labels[i].value);
+	}
+
+	return fingerprint;
+}
+
+/* Render the metric again, reusing the names and labels from the text of the
+ * previous scrape and formatting only the values. Returns -ESTALE if the text
+ * does not match the samples of the metric anymore.
+ */
+static int update_metric(const struct prometheus_metric *metric, enum prometheus_format format,
+			 const char *text, size_t text_len, char *buffer, size_t buffer_size,
+			 size_t *pos)
+{
+	size_t count = metric_sample_count(metric, format);
+	const char *end = text + text_len;
+	size_t idx = 0;
+	int ret;
+
+	while (text < end) {
+		const char *eol = memchr(text, '\n', end - text);
+		const char *sep;
+
+		if (eol == NULL) {
+			return -ESTALE;
+		}
+
+		if (*text == '#') {
+			ret = copy_to_buffer(buffer, buffer_size, pos, text, eol + 1 - text);
 			if (ret < 0) {
-				LOG_ERR("Error writing summary");
-				goto out;
+				return ret;
 			}
+
+			text = eol + 1;
+			continue;
 		}
 
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "%s_sum %f\n", metric->name, summary->sum);
+		sep = eol;
+		while (sep > text && *(sep - 1) != ' ') {
+			sep--;
+		}
+
+		if (sep == text || idx >= count) {
+			return -ESTALE;
+		}
+
+		ret = copy_to_buffer(buffer, buffer_size, pos, text, sep - text);
 		if (ret < 0) {
-			LOG_ERR("Error writing summary");
-			goto out;
+			return ret;
 		}
 
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "%s_count %lu\n", metric->name,
-					     summary->count);
+		ret = write_sample_value(metric, idx++, format, buffer, buffer_size, pos);
 		if (ret < 0) {
-			LOG_ERR("Error writing summary");
-			goto out;
+			return ret;
 		}
 
-		break;
+		text = eol + 1;
 	}
 
-	default:
-		/* should not happen */
-		LOG_ERR("Unsupported metric type %d", metric->type);
-		ret = -EINVAL;
-		goto out;
+	return idx == count ? 0 : -ESTALE;
+}
+
+static int format_cached_metric(struct prometheus_exposition_cache *cache, size_t idx,
+				const struct prometheus_metric *metric, bool header, char *buffer,
+				size_t buffer_size, size_t *pos)
+{
+	struct prometheus_exposition_cache_entry *entry = &cache->entries[idx];
+	uint64_t fingerprint = metric_fingerprint(metric);
+	uint64_t labels = label_fingerprint(metric);
+	size_t start = *pos;
+	int ret = -ESTALE;
+
+	/* Changed labels cannot be reused from the text, format from scratch */
+	if (idx < cache->num_entries && entry->metric == metric && entry->header == header &&
+	    entry->labels == labels) {
+		if (entry->fingerprint == fingerprint) {
+			ret = copy_to_buffer(buffer, buffer_size, pos, &cache->text[entry->offset],
+					     entry->len);
+		} else {
+			ret = update_metric(metric, cache->format, &cache->text[entry->offset],
+					    entry->len, buffer, buffer_size, pos);
+		}
 	}
 
-out:
-	return ret;
+	if (ret == -ESTALE) {
+		*pos = start;
+		ret = format_metric(metric, cache->format, header, buffer, buffer_size, pos);
+	}
+
+	if (ret < 0) {
+		return ret;
+	}
+
+	/* The text is moved to the cache once the whole exposition is done */
+	entry->metric = metric;
+	entry->header = header;
+	entry->fingerprint = fingerprint;
+	entry->labels = labels;
+	entry->offset = start;
+	entry->len = *pos - start;
+
+	return 0;
 }
 
-int prometheus_format_exposition(struct prometheus_collector *collector, char *buffer,
-				 size_t buffer_size)
+int prometheus_format_exposition_cached(struct prometheus_exposition_cache *cache, char *buffer,
+					size_t buffer_size)
 {
+	struct prometheus_collector *collector;
 	struct prometheus_metric *metric;
 	struct prometheus_metric *tmp;
-	int written = 0;
+	struct prometheus_metric *prev = NULL;
+	size_t count = 0;
+	size_t pos = 0;
 	int ret = 0;
 
-	if (collector == NULL || buffer == NULL || buffer_size == 0) {
+	if (cache == NULL || cache->collector == NULL || buffer == NULL || buffer_size == 0) {
 		LOG_ERR("Invalid arguments");
 		return -EINVAL;
 	}
 
+	collector = cache->collector;
+	buffer[0] = '\0';
+
 	k_mutex_lock(&collector->lock, K_FOREVER);
 
 	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&collector->metrics, metric, tmp, node) {
+		size_t idx = count++;
+		bool header;
 
 		/* If there is a user callback, use it to update the metric data. */
 		if (collector->user_cb) {
@@ -263,6 +663,11 @@ int prometheus_format_exposition(struct prometheus_collector *collector, char *b
 			if (ret < 0) {
 				if (ret == -EAGAIN) {
 					/* Skip this metric for now */
+					if (idx < cache->max_entries) {
+						cache->entries[idx].metric = NULL;
+					}
+
+					ret = 0;
 					continue;
 				}
 
@@ -271,14 +676,53 @@ int prometheus_format_exposition(struct prometheus_collector *collector, char *b
 			}
 		}
 
-		ret = prometheus_format_one_metric(metric, buffer, buffer_size, &written);
+		header = !same_family(prev, metric);
+
+		if (idx < cache->max_entries) {
+			ret = format_cached_metric(cache, idx, metric, header, buffer, buffer_size,
+						   &pos);
+		} else {
+			ret = format_metric(metric, cache->format, header, buffer, buffer_size,
+					    &pos);
+		}
+
 		if (ret < 0) {
 			goto out;
 		}
+
+		prev = metric;
+	}
+
+	if (cache->format == PROMETHEUS_FORMAT_OPENMETRICS) {
+		ret = write_metric_to_buffer(buffer, buffer_size, &pos, "# EOF\n");
+		if (ret < 0) {
+			LOG_ERR("Error writing to buffer");
+			goto out;
+		}
+	}
+
+	/* Keep the text of the metrics for the next scrape */
+	if (pos <= cache->text_size) {
+		memcpy(cache->text, buffer, pos);
+		cache->num_entries = MIN(count, cache->max_entries);
+	} else {
+		LOG_DBG("Exposition of %zu bytes does not fit in the cache", pos);
+		cache->num_entries = 0;
 	}
 
 out:
+	if (ret < 0) {
+		cache->num_entries = 0;
+	}
+
 	k_mutex_unlock(&collector->lock);
 
 	return ret;
 }
+
+void prometheus_exposition_cache_reset(struct prometheus_exposition_cache *cache)
+{
+	k_mutex_lock(&cache->collector->lock, K_FOREVER);
+	cache->num_entries = 0;
+	k_mutex_unlock(&cache->collector->lock);
+}
@@ -0,0 +1,22 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_SUBSYS_NET_LIB_PROMETHEUS_INTERNAL_H_
+#define ZEPHYR_SUBSYS_NET_LIB_PROMETHEUS_INTERNAL_H_
+
+#include <stddef.h>
+
+#include <zephyr/net/prometheus/metric.h>
+
+/* Format a metric in the text format at the given position of the buffer.
+ * The HELP and TYPE lines are left out if the metric is part of the same
+ * family as the previous one formatted.
+ */
+int prometheus_format_metric(const struct prometheus_metric *metric,
+			     const struct prometheus_metric *prev, char *buffer,
+			     size_t buffer_size, size_t *pos);
+
+#endif /* ZEPHYR_SUBSYS_NET_LIB_PROMETHEUS_INTERNAL_H_ */
@@ -0,0 +1,374 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/net/prometheus/collector.h>
+#include <zephyr/net/prometheus/counter.h>
+#include <zephyr/net/prometheus/gauge.h>
+
+#include <zephyr/init.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log_internal.h>
+#include <zephyr/sys/mem_stats.h>
+#include <zephyr/sys/sys_heap.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(pm_system, CONFIG_PROMETHEUS_LOG_LEVEL);
+
+#define MAX_OBJECTS CONFIG_PROMETHEUS_SYSTEM_STATS_MAX_OBJECTS
+#define LABEL_LEN   48
+#define MAX_VALUES  3
+
+enum system_source {
+	SOURCE_THREADS,
+	SOURCE_MEM_SLABS,
+	SOURCE_HEAPS,
+	SOURCE_COUNT,
+};
+
+/* Statistics of an object, read at the start of a scrape */
+struct system_object {
+	char label[LABEL_LEN];
+	uint64_t values[MAX_VALUES];
+#if defined(CONFIG_OBJ_CORE_STATS_THREAD) && defined(CONFIG_INIT_STACKS) && \
+	defined(CONFIG_THREAD_STACK_INFO)
+	/* Thread whose stack is scanned once the walk is over */
+	struct k_thread *thread;
+#endif
+};
+
+struct system_snapshot {
+	struct system_object objects[MAX_OBJECTS];
+	size_t count;
+};
+
+/* A metric family, exported for each object of the source */
+struct system_family {
+	const char *name;
+	const char *description;
+	enum prometheus_metric_type type;
+	const char *label_key;
+	uint8_t source;
+	uint8_t value;
+};
+
+struct system_metric {
+	union {
+		struct prometheus_counter counter;
+		struct prometheus_gauge gauge;
+	};
+};
+
+static const struct system_family families[] = {
+#if defined(CONFIG_OBJ_CORE_STATS_THREAD)
+	{ "zephyr_thread_cycles_total", "Cycles spent running the thread",
+	  PROMETHEUS_COUNTER, "thread", SOURCE_THREADS, 0 },
+#if defined(CONFIG_INIT_STACKS) && defined(CONFIG_THREAD_STACK_INFO)
+	{ "zephyr_thread_stack_unused_bytes", "Stack space never used by the thread",
+	  PROMETHEUS_GAUGE, "thread", SOURCE_THREADS, 1 },
+#endif
+#endif /* CONFIG_OBJ_CORE_STATS_THREAD */
+#if defined(CONFIG_OBJ_CORE_STATS_MEM_SLAB)
+	{ "zephyr_mem_slab_free_bytes", "Free bytes in the memory slab",
+	  PROMETHEUS_GAUGE, "slab", SOURCE_MEM_SLABS, 0 },
+	{ "zephyr_mem_slab_allocated_bytes", "Allocated bytes in the memory slab",
+	  PROMETHEUS_GAUGE, "slab", SOURCE_MEM_SLABS, 1 },
+	{ "zephyr_mem_slab_max_allocated_bytes", "Most bytes ever allocated in the memory slab",
+	  PROMETHEUS_GAUGE, "slab", SOURCE_MEM_SLABS, 2 },
+#endif /* CONFIG_OBJ_CORE_STATS_MEM_SLAB */
+#if defined(CONFIG_SYS_HEAP_RUNTIME_STATS)
+	{ "zephyr_heap_free_bytes", "Free bytes in the heap",
+	  PROMETHEUS_GAUGE, "heap", SOURCE_HEAPS, 0 },
+	{ "zephyr_heap_allocated_bytes", "Allocated bytes in the heap",
+	  PROMETHEUS_GAUGE, "heap", SOURCE_HEAPS, 1 },
+	{ "zephyr_heap_max_allocated_bytes", "Most bytes ever allocated in the heap",
+	  PROMETHEUS_GAUGE, "heap", SOURCE_HEAPS, 2 },
+#endif /* CONFIG_SYS_HEAP_RUNTIME_STATS */
+};
+
+#define NUM_METRICS (ARRAY_SIZE(families) * MAX_OBJECTS)
+
+static struct system_snapshot snapshots[SOURCE_COUNT];
+/* One more metric than needed, so that the array is not empty when only the
+ * log statistics are enabled. It is never registered.
+ */
+static struct system_metric metrics[NUM_METRICS + 1];
+
+#if defined(CONFIG_LOG_MODE_DEFERRED)
+static struct prometheus_counter log_dropped = {
+	.base.name = "zephyr_log_dropped_total",
+	.base.type = PROMETHEUS_COUNTER,
+	.base.description = "Log messages dropped",
+};
+#endif
+
+static int system_scrape(struct prometheus_collector *collector,
+			 struct prometheus_metric *metric, void *user_data);
+
+PROMETHEUS_COLLECTOR_DEFINE(prometheus_system_collector, system_scrape);
+
+/* Labels the object with its name, escaped for the exposition format, and its
+ * address, since several threads may have the same name.
+ */
+static void object_label(struct system_object *obj, const void *ptr, const char *name)
+{
+	char addr[sizeof("@0x") + 2 * sizeof(void *)];
+	size_t max, pos = 0;
+	const char *esc;
+
+	snprintk(addr, sizeof(addr), "@%p", ptr);
+	max = sizeof(obj->label) - strlen(addr) - 1;
+
+	for (; name != NULL && *name != '\0'; name++) {
+		switch (*name) {
+		case '"':
+			esc = "\\\"";
+			break;
+		case '\\':
+			esc = "\\\\";
+			break;
+		case '\n':
+			esc = "\\n";
+			break;
+		default:
+			esc = NULL;
+			break;
+		}
+
+		if (pos + (esc != NULL ? 2 : 1) > max) {
+			break;
+		}
+
+		if (esc != NULL) {
+			obj->label[pos++] = esc[0];
+			obj->label[pos++] = esc[1];
+		} else {
+			obj->label[pos++] = *name;
+		}
+	}
+
+	/* An object without a name is only labeled with its address */
+	strcpy(&obj->label[pos], pos > 0 ? addr : &addr[1]);
+}
+
+#if defined(CONFIG_OBJ_CORE_STATS_THREAD) || defined(CONFIG_OBJ_CORE_STATS_MEM_SLAB)
+/* The objects are walked under the object core lock, so that none of them is
+ * destroyed while being read. k_obj_core_stats_query() takes that same lock,
+ * the statistics are read with the accessors of each object type instead.
+ */
+static void snapshot_walk(uint32_t type_id, int (*func)(struct k_obj_core *, void *),
+			  struct system_snapshot *snapshot)
+{
+	struct k_obj_type *type = k_obj_type_find(type_id);
+
+	if (type != NULL) {
+		(void)k_obj_type_walk_locked(type, func, snapshot);
+	}
+}
+#endif
+
+#if defined(CONFIG_OBJ_CORE_STATS_THREAD)
+static int snapshot_thread(struct k_obj_core *obj_core, void *data)
+{
+	struct k_thread *thread = CONTAINER_OF(obj_core, struct k_thread, obj_core);
+	struct system_snapshot *snapshot = data;
+	struct system_object *obj = &snapshot->objects[snapshot->count];
+	k_thread_runtime_stats_t stats;
+
+	if (k_thread_runtime_stats_get(thread, &stats) < 0) {
+		return 0;
+	}
+
+	obj->values[0] = stats.execution_cycles;
+
+#if defined(CONFIG_INIT_STACKS) && defined(CONFIG_THREAD_STACK_INFO)
+	obj->thread = thread;
+#endif
+
+	object_label(obj, thread, k_thread_name_get(thread));
+
+	return ++snapshot->count == ARRAY_SIZE(snapshot->objects) ? 1 : 0;
+}
+
+#if defined(CONFIG_INIT_STACKS) && defined(CONFIG_THREAD_STACK_INFO)
+/* Scanning a stack takes time in proportion to its size, which is not spent
+ * with the interrupts locked. The stack of a thread exiting in the meantime is
+ * still scanned, this only requires the thread not to be freed.
+ */
+static void snapshot_stacks(struct system_snapshot *snapshot)
+{
+	for (size_t i = 0; i < snapshot->count; i++) {
+		struct system_object *obj = &snapshot->objects[i];
+		size_t unused = 0;
+
+		(void)k_thread_stack_space_get(obj->thread, &unused);
+		obj->values[1] = unused;
+	}
+}
+#endif
+#endif /* CONFIG_OBJ_CORE_STATS_THREAD */
+
+static void snapshot_memory(struct system_object *obj, const struct sys_memory_stats *stats)
+{
+	obj->values[0] = stats->free_bytes;
+	obj->values[1] = stats->allocated_bytes;
+	obj->values[2] = stats->max_allocated_bytes;
+}
+
+#if defined(CONFIG_OBJ_CORE_STATS_MEM_SLAB)
+static int snapshot_mem_slab(struct k_obj_core *obj_core, void *data)
+{
+	struct k_mem_slab *slab = CONTAINER_OF(obj_core, struct k_mem_slab, obj_core);
+	struct system_snapshot *snapshot = data;
+	struct system_object *obj = &snapshot->objects[snapshot->count];
+	struct sys_memory_stats stats;
+
+	if (k_mem_slab_runtime_stats_get(slab, &stats) < 0) {
+		return 0;
+	}
+
+	snapshot_memory(obj, &stats);
+	object_label(obj, slab, NULL);
+
+	return ++snapshot->count == ARRAY_SIZE(snapshot->objects) ? 1 : 0;
+}
+#endif /* CONFIG_OBJ_CORE_STATS_MEM_SLAB */
+
+#if defined(CONFIG_SYS_HEAP_RUNTIME_STATS)
+static void snapshot_heaps(struct system_snapshot *snapshot)
+{
+	STRUCT_SECTION_FOREACH(k_heap, heap) {
+		struct system_object *obj;
+		struct sys_memory_stats stats;
+
+		if (snapshot->count == ARRAY_SIZE(snapshot->objects)) {
+			break;
+		}
+
+		obj = &snapshot->objects[snapshot->count];
+
+		if (sys_heap_runtime_stats_get(&heap->heap, &stats) < 0) {
+			continue;
+		}
+
+		snapshot_memory(obj, &stats);
+		object_label(obj, heap, NULL);
+		snapshot->count++;
+	}
+}
+#endif /* CONFIG_SYS_HEAP_RUNTIME_STATS */
+
+static void snapshot_all(void)
+{
+	ARRAY_FOR_EACH_PTR(snapshots, snapshot) {
+		snapshot->count = 0;
+	}
+
+	IF_ENABLED(CONFIG_OBJ_CORE_STATS_THREAD,
+		   (snapshot_walk(K_OBJ_TYPE_THREAD_ID, snapshot_thread,
+				  &snapshots[SOURCE_THREADS]);))
+	IF_ENABLED(CONFIG_OBJ_CORE_STATS_MEM_SLAB,
+		   (snapshot_walk(K_OBJ_TYPE_MEM_SLAB_ID, snapshot_mem_slab,
+				  &snapshots[SOURCE_MEM_SLABS]);))
+	IF_ENABLED(CONFIG_SYS_HEAP_RUNTIME_STATS, (snapshot_heaps(&snapshots[SOURCE_HEAPS]);))
+
+#if defined(CONFIG_OBJ_CORE_STATS_THREAD) && defined(CONFIG_INIT_STACKS) && \
+	defined(CONFIG_THREAD_STACK_INFO)
+	snapshot_stacks(&snapshots[SOURCE_THREADS]);
+#endif
+}
+
+static int system_scrape(struct prometheus_collector *collector,
+			 struct prometheus_metric *metric, void *user_data)
+{
+	const struct system_family *family;
+	const struct system_object *obj;
+	struct system_metric *sm;
+	size_t idx;
+
+	ARG_UNUSED(user_data);
+
+	/* Every scrape starts with the head of the list, take a consistent
+	 * view of all the objects at that time.
+	 */
+	if (&metric->node == sys_slist_peek_head(&collector->metrics)) {
+		snapshot_all();
+	}
+
+#if defined(CONFIG_LOG_MODE_DEFERRED)
+	if (metric == &log_dropped.base) {
+		return prometheus_counter_set(&log_dropped, z_log_dropped_total());
+	}
+#endif
+
+	/* Leave the metrics registered by the application alone */
+	if (POINTER_TO_UINT(metric) < POINTER_TO_UINT(&metrics[0]) ||
+	    POINTER_TO_UINT(metric) >= POINTER_TO_UINT(&metrics[NUM_METRICS])) {
+		return 0;
+	}
+
+	sm = CONTAINER_OF(metric, struct system_metric, counter.base);
+
+	idx = sm - metrics;
+	family = &families[idx / MAX_OBJECTS];
+
+	if (idx % MAX_OBJECTS >= snapshots[family->source].count) {
+		/* No such object at the moment */
+		return -EAGAIN;
+	}
+
+	obj = &snapshots[family->source].objects[idx % MAX_OBJECTS];
+
+	if (family->type == PROMETHEUS_COUNTER) {
+		/* The slot may now hold another object, in which case the
+		 * counter goes backwards and is seen as reset by Prometheus.
+		 */
+		sm->counter.value = obj->values[family->value];
+		return 0;
+	}
+
+	return prometheus_gauge_set(&sm->gauge, (double)obj->values[family->value]);
+}
+
+static int prometheus_system_init(void)
+{
+	/* Metrics are prepended to the collector list, register them backwards
+	 * so that the objects of each family are listed in order.
+	 */
+	for (size_t i = NUM_METRICS; i-- > 0;) {
+		const struct system_family *family = &families[i / MAX_OBJECTS];
+		struct system_object *obj = &snapshots[family->source].objects[i % MAX_OBJECTS];
+		struct prometheus_metric *metric;
+
+		if (family->type == PROMETHEUS_COUNTER) {
+			metric = &metrics[i].counter.base;
+		} else {
+			metric = &metrics[i].gauge.base;
+		}
+
+		metric->name = family->name;
+		metric->description = family->description;
+		metric->type = family->type;
+		metric->labels[0].key = family->label_key;
+		/* Rewritten when the slot gets another object, which the
+		 * cached exposition detects from the label itself.
+		 */
+		metric->labels[0].value = obj->label;
+		metric->num_labels = 1;
+		metric->collector = &prometheus_system_collector;
+
+		(void)prometheus_collector_register_metric(&prometheus_system_collector, metric);
+	}
+
+#if defined(CONFIG_LOG_MODE_DEFERRED)
+	log_dropped.base.collector = &prometheus_system_collector;
+	(void)prometheus_collector_register_metric(&prometheus_system_collector,
+						   &log_dropped.base);
+#endif
+
+	return 0;
+}
+
+SYS_INIT(prometheus_system_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
@@ -133,6 +133,12 @@ static int cmd_net_mem(const struct shell *sh, size_t argc, char *argv[])
 
 	PR("%p\t%d\t%ld\t%d\tTX DATA (%s)\n", tx_data, tx_data->buf_count,
 	   atomic_get(&tx_data->avail_count), tx_data->max_used, tx_data->name);
+
+#if defined(CONFIG_NET_BUF_POOL_CACHE)
+	PR("Buffer cache hits/misses: RX DATA %ld/%ld, TX DATA %ld/%ld\n",
+	   atomic_get(&rx_data->cache_hits), atomic_get(&rx_data->cache_misses),
+	   atomic_get(&tx_data->cache_hits), atomic_get(&tx_data->cache_misses));
+#endif
 #else
 	PR("Address\t\tTotal\tName\n");
 
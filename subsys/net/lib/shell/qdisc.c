@@ -0,0 +1,155 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_shell);
+
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_mgmt.h>
+
+#include "net_shell_private.h"
+
+#if defined(CONFIG_NET_QDISC)
+#include <zephyr/net/net_qdisc.h>
+#endif
+
+#if !defined(CONFIG_NET_QDISC)
+static void print_qdisc_error(const struct shell *sh)
+{
+	PR_INFO("Set %s to enable %s support.\n", "CONFIG_NET_QDISC",
+		"queueing discipline");
+}
+#endif
+
+#if defined(CONFIG_NET_QDISC)
+static void qdisc_iface_cb(struct net_if *iface, void *user_data)
+{
+	const struct shell *sh = user_data;
+	struct net_qdisc_params params;
+	int ret;
+
+	ret = net_mgmt(NET_REQUEST_QDISC_GET_PARAMS, iface, &params, sizeof(params));
+	if (ret < 0) {
+		PR_WARNING("Cannot get parameters of interface %d (%d)\n",
+			   net_if_get_by_iface(iface), ret);
+		return;
+	}
+
+	if (params.rate == 0U) {
+		PR("[%d] rate unlimited, target %u us, interval %u us\n",
+		   net_if_get_by_iface(iface), params.target, params.interval);
+	} else {
+		PR("[%d] rate %u B/s, burst %u B, target %u us, interval %u us\n",
+		   net_if_get_by_iface(iface), params.rate, params.burst,
+		   params.target, params.interval);
+	}
+}
+#endif /* CONFIG_NET_QDISC */
+
+static int cmd_net_qdisc(const struct shell *sh, size_t argc, char *argv[])
+{
+#if defined(CONFIG_NET_QDISC)
+	struct net_if *iface;
+	int idx;
+
+	if (argc < 2) {
+		net_if_foreach(qdisc_iface_cb, (void *)sh);
+		return 0;
+	}
+
+	idx = get_iface_idx(sh, argv[1]);
+	if (idx < 0) {
+		return -ENOEXEC;
+	}
+
+	iface = net_if_get_by_index(idx);
+	if (iface == NULL) {
+		PR_WARNING("No such interface in index %d\n", idx);
+		return -ENOEXEC;
+	}
+
+	qdisc_iface_cb(iface, (void *)sh);
+#else
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	print_qdisc_error(sh);
+#endif
+
+	return 0;
+}
+
+static int cmd_net_qdisc_set(const struct shell *sh, size_t argc, char *argv[])
+{
+#if defined(CONFIG_NET_QDISC)
+	struct net_qdisc_params params;
+	struct net_if *iface;
+	int idx, ret;
+	int err = 0;
+
+	idx = get_iface_idx(sh, argv[1]);
+	if (idx < 0) {
+		return -ENOEXEC;
+	}
+
+	iface = net_if_get_by_index(idx);
+	if (iface == NULL) {
+		PR_WARNING("No such interface in index %d\n", idx);
+		return -ENOEXEC;
+	}
+
+	ret = net_mgmt(NET_REQUEST_QDISC_GET_PARAMS, iface, &params, sizeof(params));
+	if (ret < 0) {
+		PR_WARNING("Cannot get parameters of interface %d (%d)\n", idx, ret);
+		return -ENOEXEC;
+	}
+
+	params.rate = shell_strtoul(argv[2], 10, &err);
+	params.burst = shell_strtoul(argv[3], 10, &err);
+
+	if (argc > 4) {
+		params.target = shell_strtoul(argv[4], 10, &err);
+	}
+
+	if (argc > 5) {
+		params.interval = shell_strtoul(argv[5], 10, &err);
+	}
+
+	if (err != 0) {
+		PR_WARNING("Invalid parameter value\n");
+		return -ENOEXEC;
+	}
+
+	ret = net_mgmt(NET_REQUEST_QDISC_SET_PARAMS, iface, &params, sizeof(params));
+	if (ret < 0) {
+		PR_WARNING("Cannot set parameters of interface %d (%d)\n", idx, ret);
+		return -ENOEXEC;
+	}
+
+	qdisc_iface_cb(iface, (void *)sh);
+#else
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	print_qdisc_error(sh);
+#endif
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(net_cmd_qdisc,
+	SHELL_CMD_ARG(set, NULL,
+		      "Set the shaper and CoDel parameters of an interface.\n"
+		      "<index> <rate B/s, 0 for unlimited> <burst B> "
+		      "[<target us> [<interval us>]]",
+		      cmd_net_qdisc_set, 4, 2),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_SUBCMD_ADD((net), qdisc, &net_cmd_qdisc,
+		 "Show the TX queueing discipline parameters.\n"
+		 "[<index>]",
+		 cmd_net_qdisc, 1, 1);
@@ -423,6 +423,38 @@ static void print_tc_rx_stats(const struct shell *sh, struct net_if *iface)
 #endif /* NET_TC_RX_COUNT > 1 */
 }
 
+static void print_rps_stats(const struct shell *sh, struct net_if *iface)
+{
+#if defined(CONFIG_NET_TC_RX_RPS)
+	PR("RX packet steering:\n");
+	PR("CPU Recv pkts\n");
+
+	for (unsigned int i = 0; i < arch_num_cpus(); i++) {
+		PR("[%u] %d\n", i, GET_STAT(iface, rps.pkts[i]));
+	}
+#else
+	ARG_UNUSED(sh);
+	ARG_UNUSED(iface);
+#endif /* CONFIG_NET_TC_RX_RPS */
+}
+
+static void print_qdisc_stats(const struct shell *sh, struct net_if *iface)
+{
+#if defined(CONFIG_NET_QDISC)
+	net_stats_t count = GET_STAT(iface, qdisc.count);
+
+	PR("TX queueing:\n");
+	PR("Dropped by CoDel : %u\n", GET_STAT(iface, qdisc.dropped));
+	PR("Throttled        : %u\n", GET_STAT(iface, qdisc.throttled));
+	PR("Average delay    : %u us\n",
+	   count == 0 ? 0U : (uint32_t)(GET_STAT(iface, qdisc.delay_sum) / count));
+	PR("Maximum delay    : %u us\n", GET_STAT(iface, qdisc.delay_max));
+#else
+	ARG_UNUSED(sh);
+	ARG_UNUSED(iface);
+#endif /* CONFIG_NET_QDISC */
+}
+
 static void print_net_pm_stats(const struct shell *sh, struct net_if *iface)
 {
 #if defined(CONFIG_NET_STATISTICS_POWER_MANAGEMENT)
@@ -581,6 +613,8 @@ static void net_shell_print_statistics(struct net_if *iface, void *user_data)
 
 	print_tc_tx_stats(sh, iface);
 	print_tc_rx_stats(sh, iface);
+	print_rps_stats(sh, iface);
+	print_qdisc_stats(sh, iface);
 
 #if defined(CONFIG_NET_STATISTICS_ETHERNET) && \
 					defined(CONFIG_NET_STATISTICS_USER_API)
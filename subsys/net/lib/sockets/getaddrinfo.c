@@ -52,26 +52,20 @@ struct getaddrinfo_state {
 	uint16_t port;
 	uint16_t dns_id;
 	struct zsock_addrinfo *ai_arr;
+#if defined(CONFIG_NET_SOCKETS_DNS_PARALLEL)
+	/* Protects ai_arr, a cached answer is reported from the caller
+	 * thread while the other query may be answered by the resolver.
+	 */
+	struct k_spinlock lock;
+#endif
 };
 
-static void dns_resolve_cb(enum dns_resolve_status status,
-			   struct dns_addrinfo *info, void *user_data)
+static void getaddrinfo_append(struct getaddrinfo_state *state,
+			       struct dns_addrinfo *info)
 {
-	struct getaddrinfo_state *state = user_data;
 	struct zsock_addrinfo *ai;
 	int socktype = SOCK_STREAM;
 
-	NET_DBG("dns status: %d", status);
-
-	if (info == NULL) {
-		if (status == DNS_EAI_ALLDONE) {
-			status = 0;
-		}
-		state->status = status;
-		k_sem_give(&state->sem);
-		return;
-	}
-
 	if (state->idx >= AI_ARR_MAX) {
 		NET_DBG("getaddrinfo entries overflow");
 		return;
@@ -103,6 +97,25 @@ static void dns_resolve_cb(enum dns_resolve_status status,
 	state->idx++;
 }
 
+static void dns_resolve_cb(enum dns_resolve_status status,
+			   struct dns_addrinfo *info, void *user_data)
+{
+	struct getaddrinfo_state *state = user_data;
+
+	NET_DBG("dns status: %d", status);
+
+	if (info == NULL) {
+		if (status == DNS_EAI_ALLDONE) {
+			status = 0;
+		}
+		state->status = status;
+		k_sem_give(&state->sem);
+		return;
+	}
+
+	getaddrinfo_append(state, info);
+}
+
 static k_timeout_t recalc_timeout(k_timepoint_t end, k_timeout_t timeout)
 {
 	k_timepoint_t new_timepoint;
@@ -179,6 +192,136 @@ again:
 	return st;
 }
 
+#if defined(CONFIG_NET_SOCKETS_DNS_PARALLEL)
+struct getaddrinfo_query {
+	struct getaddrinfo_state *state;
+	enum dns_query_type qtype;
+	int status;
+	uint16_t dns_id;
+	bool pending;
+};
+
+static void dns_resolve_parallel_cb(enum dns_resolve_status status,
+				    struct dns_addrinfo *info, void *user_data)
+{
+	struct getaddrinfo_query *query = user_data;
+	struct getaddrinfo_state *state = query->state;
+	k_spinlock_key_t key;
+
+	NET_DBG("dns status: %d (type %d)", status, query->qtype);
+
+	key = k_spin_lock(&state->lock);
+
+	if (info == NULL) {
+		if (status == DNS_EAI_ALLDONE) {
+			status = 0;
+		}
+		query->status = status;
+		query->pending = false;
+		k_spin_unlock(&state->lock, key);
+		k_sem_give(&state->sem);
+		return;
+	}
+
+	getaddrinfo_append(state, info);
+
+	k_spin_unlock(&state->lock, key);
+}
+
+/* Send the A and AAAA queries at once and wait for both answers. A query
+ * that times out is retried with the same backoff as in exec_query(), while
+ * the answer of the other one is kept.
+ */
+static void exec_query_parallel(const char *host, struct getaddrinfo_state *ai_state,
+				int *st1, int *st2)
+{
+	struct getaddrinfo_query queries[] = {
+		{ .state = ai_state, .qtype = DNS_QUERY_TYPE_A, .status = DNS_EAI_INPROGRESS },
+		{ .state = ai_state, .qtype = DNS_QUERY_TYPE_AAAA, .status = DNS_EAI_INPROGRESS },
+	};
+	k_timepoint_t end = sys_timepoint_calc(K_MSEC(CONFIG_NET_SOCKETS_DNS_TIMEOUT));
+	k_timeout_t timeout = K_MSEC(MIN(CONFIG_NET_SOCKETS_DNS_TIMEOUT,
+					 CONFIG_NET_SOCKETS_DNS_BACKOFF_INTERVAL));
+	k_timepoint_t round_end;
+	int timeout_ms;
+	bool retry;
+	int ret;
+
+again:
+	timeout_ms = k_ticks_to_ms_ceil32(timeout.ticks);
+	round_end = sys_timepoint_calc(K_MSEC(timeout_ms + 100));
+
+	NET_DBG("Timeout %d", timeout_ms);
+
+	k_sem_reset(&ai_state->sem);
+
+	ARRAY_FOR_EACH_PTR(queries, query) {
+		if (query->status != DNS_EAI_INPROGRESS) {
+			continue;
+		}
+
+		query->pending = true;
+
+		ret = dns_get_addr_info(host, query->qtype, &query->dns_id,
+					dns_resolve_parallel_cb, query, timeout_ms);
+		if (ret == 0) {
+			continue;
+		}
+
+		query->pending = false;
+
+		if (ret == -EPFNOSUPPORT) {
+			query->status = DNS_EAI_ADDRFAMILY;
+		} else {
+			errno = -ret;
+			query->status = DNS_EAI_SYSTEM;
+		}
+	}
+
+	/* As in exec_query(), wait a bit longer than the DNS timeout so that
+	 * the resolver reports the timeout itself.
+	 */
+	while (queries[0].pending || queries[1].pending) {
+		if (k_sem_take(&ai_state->sem, sys_timepoint_timeout(round_end)) < 0) {
+			break;
+		}
+	}
+
+	retry = false;
+
+	ARRAY_FOR_EACH_PTR(queries, query) {
+		bool timed_out = query->pending;
+
+		if (timed_out) {
+			/* Reports DNS_EAI_CANCELED unless answered meanwhile */
+			(void)dns_cancel_addr_info(query->dns_id);
+			query->pending = false;
+		}
+
+		if (query->status != DNS_EAI_CANCELED &&
+		    query->status != DNS_EAI_INPROGRESS) {
+			/* Answered, or not sent at all */
+			continue;
+		}
+
+		if (!sys_timepoint_expired(end)) {
+			query->status = DNS_EAI_INPROGRESS;
+			retry = true;
+		} else if (timed_out) {
+			query->status = DNS_EAI_AGAIN;
+		}
+	}
+
+	if (retry) {
+		timeout = recalc_timeout(end, timeout);
+		goto again;
+	}
+
+	*st1 = queries[0].status;
+	*st2 = queries[1].status;
+}
+#endif /* CONFIG_NET_SOCKETS_DNS_PARALLEL */
+
 static int getaddrinfo_null_host(int port, const struct zsock_addrinfo *hints,
 				struct zsock_addrinfo *res)
 {
@@ -224,7 +367,7 @@ int z_impl_z_zsock_getaddrinfo_internal(const char *host, const char *service,
 	long int port = 0;
 	int st1 = DNS_EAI_ADDRFAMILY, st2 = DNS_EAI_ADDRFAMILY;
 	struct sockaddr *ai_addr;
-	struct getaddrinfo_state ai_state;
+	struct getaddrinfo_state ai_state = { 0 };
 
 	if (hints) {
 		family = hints->ai_family;
@@ -266,6 +409,13 @@ int z_impl_z_zsock_getaddrinfo_internal(const char *host, const char *service,
 	ai_state.dns_id = 0;
 	k_sem_init(&ai_state.sem, 0, K_SEM_MAX_LIMIT);
 
+#if defined(CONFIG_NET_SOCKETS_DNS_PARALLEL)
+	if (family == AF_UNSPEC) {
+		exec_query_parallel(host, &ai_state, &st1, &st2);
+		goto done;
+	}
+#endif
+
 	/* If family is AF_UNSPEC, then we query IPv4 address first
 	 * if IPv4 is enabled in the config.
 	 */
@@ -286,6 +436,9 @@ int z_impl_z_zsock_getaddrinfo_internal(const char *host, const char *service,
 		}
 	}
 
+#if defined(CONFIG_NET_SOCKETS_DNS_PARALLEL)
+done:
+#endif
 	for (uint16_t idx = 0; idx < ai_state.idx; idx++) {
 		ai_addr = &ai_state.ai_arr[idx]._ai_addr;
 		net_sin(ai_addr)->sin_port = htons(port);
@@ -474,6 +474,100 @@ fail:
 #include <zephyr/syscalls/zsock_sendmsg_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+/* The first message of a batch goes through the regular call path so that a
+ * socket still owned by the socket dispatcher gets bound to its real
+ * implementation. The remaining messages are then handled under a single
+ * acquisition of the socket lock.
+ */
+static int sock_sendmmsg_batch(int sock, struct mmsghdr *msgvec,
+			       unsigned int vlen, int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	unsigned int count = 1U;
+	ssize_t ret;
+	void *obj;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return count;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	for (; count < vlen; count++) {
+		ret = vtable->sendmsg(obj, &msgvec[count].msg_hdr, flags);
+		if (ret < 0) {
+			break;
+		}
+
+		msgvec[count].msg_len = ret;
+		sock_obj_core_update_send_stats(sock, ret);
+	}
+
+	k_mutex_unlock(lock);
+
+	return count;
+}
+
+int z_impl_zsock_sendmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+			  int flags)
+{
+	ssize_t ret;
+
+	if (vlen == 0U) {
+		return 0;
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(socket, sendmmsg, sock, msgvec, vlen, flags);
+
+	ret = z_impl_zsock_sendmsg(sock, &msgvec[0].msg_hdr, flags);
+	if (ret < 0) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(socket, sendmmsg, sock, -errno);
+		return -1;
+	}
+
+	msgvec[0].msg_len = ret;
+
+	ret = sock_sendmmsg_batch(sock, msgvec, vlen, flags);
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(socket, sendmmsg, sock, ret);
+
+	return ret;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_sendmmsg(int sock, struct mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	unsigned int count;
+	ssize_t ret;
+
+	K_OOPS(K_SYSCALL_MEMORY_ARRAY_WRITE(msgvec, vlen, sizeof(struct mmsghdr)));
+
+	/* Every message has to be marshalled separately from the user
+	 * memory, so the single message path is reused here. The caller
+	 * still saves one syscall transition per datagram.
+	 */
+	for (count = 0U; count < vlen; count++) {
+		ret = z_vrfy_zsock_sendmsg(sock, &msgvec[count].msg_hdr, flags);
+		if (ret < 0) {
+			break;
+		}
+
+		msgvec[count].msg_len = ret;
+	}
+
+	if (count == 0U && vlen > 0U) {
+		return -1;
+	}
+
+	return count;
+}
+#include <zephyr/syscalls/zsock_sendmmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
 ssize_t z_impl_zsock_recvfrom(int sock, void *buf, size_t max_len, int flags,
 			     struct sockaddr *src_addr, socklen_t *addrlen)
 {
@@ -710,6 +804,126 @@ fail:
 #include <zephyr/syscalls/zsock_recvmsg_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+/* The timeout is only checked between datagrams, a blocking receive of the
+ * next datagram is not interrupted by it (same as on Linux).
+ */
+static bool sock_recvmmsg_done(unsigned int count, int flags,
+			       k_timepoint_t end)
+{
+	if (count == 0U || (flags & ZSOCK_MSG_WAITFORONE)) {
+		return false;
+	}
+
+	return sys_timepoint_expired(end);
+}
+
+static int sock_recvmmsg_flags(unsigned int count, int flags)
+{
+	/* With ZSOCK_MSG_WAITFORONE only the first datagram is waited for,
+	 * the rest of the batch is collected from what is already queued.
+	 */
+	if (count > 0U && (flags & ZSOCK_MSG_WAITFORONE)) {
+		flags |= ZSOCK_MSG_DONTWAIT;
+	}
+
+	return flags & ~ZSOCK_MSG_WAITFORONE;
+}
+
+int z_impl_zsock_recvmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+			  int flags, int timeout)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	unsigned int count;
+	k_timepoint_t end;
+	ssize_t ret;
+	void *obj;
+
+	if (vlen == 0U) {
+		return 0;
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(socket, recvmmsg, sock, msgvec, vlen, flags, timeout);
+
+	end = sys_timepoint_calc(timeout < 0 ? K_FOREVER : K_MSEC(timeout));
+
+	/* See sock_sendmmsg_batch() for why the first message is special */
+	ret = z_impl_zsock_recvmsg(sock, &msgvec[0].msg_hdr,
+				   sock_recvmmsg_flags(0U, flags));
+	if (ret < 0) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(socket, recvmmsg, sock, msgvec, -errno);
+		return -1;
+	}
+
+	msgvec[0].msg_len = ret;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(socket, recvmmsg, sock, msgvec, 1);
+		return 1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	for (count = 1U; count < vlen; count++) {
+		if (sock_recvmmsg_done(count, flags, end)) {
+			break;
+		}
+
+		ret = vtable->recvmsg(obj, &msgvec[count].msg_hdr,
+				      sock_recvmmsg_flags(count, flags));
+		if (ret < 0) {
+			break;
+		}
+
+		msgvec[count].msg_len = ret;
+		sock_obj_core_update_recv_stats(sock, ret);
+	}
+
+	k_mutex_unlock(lock);
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(socket, recvmmsg, sock, msgvec, count);
+
+	return count;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_recvmmsg(int sock, struct mmsghdr *msgvec,
+					unsigned int vlen, int flags,
+					int timeout)
+{
+	unsigned int count;
+	k_timepoint_t end;
+	ssize_t ret;
+
+	K_OOPS(K_SYSCALL_MEMORY_ARRAY_WRITE(msgvec, vlen, sizeof(struct mmsghdr)));
+
+	end = sys_timepoint_calc(timeout < 0 ? K_FOREVER : K_MSEC(timeout));
+
+	for (count = 0U; count < vlen; count++) {
+		if (sock_recvmmsg_done(count, flags, end)) {
+			break;
+		}
+
+		ret = z_vrfy_zsock_recvmsg(sock, &msgvec[count].msg_hdr,
+					   sock_recvmmsg_flags(count, flags));
+		if (ret < 0) {
+			break;
+		}
+
+		msgvec[count].msg_len = ret;
+	}
+
+	if (count == 0U && vlen > 0U) {
+		return -1;
+	}
+
+	return count;
+}
+#include <zephyr/syscalls/zsock_recvmmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
 /* As this is limited function, we don't follow POSIX signature, with
  * "..." instead of last arg.
  */
@@ -0,0 +1,220 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_sock_connect, CONFIG_NET_SOCKETS_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/socket.h>
+
+struct connect_attempts {
+	struct zsock_pollfd fds[CONFIG_NET_SOCKETS_CONNECT_ATTEMPTS_MAX];
+	const struct zsock_addrinfo *next[2];
+	int count;
+	int error;
+	bool ipv4_turn;
+};
+
+static const struct zsock_addrinfo *next_of_family(const struct zsock_addrinfo *ai,
+						   bool ipv4)
+{
+	while (ai != NULL && (ai->ai_family == AF_INET) != ipv4) {
+		ai = ai->ai_next;
+	}
+
+	return ai;
+}
+
+/* Pick the next address to try, alternating between the address families
+ * and starting with IPv6 as described in RFC 8305 chapter 4.
+ */
+static const struct zsock_addrinfo *next_addr(struct connect_attempts *att)
+{
+	const struct zsock_addrinfo *ai;
+	bool ipv4 = att->ipv4_turn;
+
+	if (att->next[ipv4] == NULL) {
+		ipv4 = !ipv4;
+	}
+
+	ai = att->next[ipv4];
+	if (ai != NULL) {
+		att->next[ipv4] = next_of_family(ai->ai_next, ipv4);
+		att->ipv4_turn = !ipv4;
+	}
+
+	return ai;
+}
+
+static void attempt_remove(struct connect_attempts *att, int idx)
+{
+	(void)zsock_close(att->fds[idx].fd);
+
+	att->fds[idx] = att->fds[--att->count];
+}
+
+/* Returns 1 and the socket if connected right away, 0 if the attempt is in
+ * progress and -1 if it failed.
+ */
+static int attempt_start(struct connect_attempts *att, const struct zsock_addrinfo *ai,
+			 int *connected)
+{
+	int sock;
+	int ret;
+
+	sock = zsock_socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+	if (sock < 0) {
+		att->error = errno;
+		return -1;
+	}
+
+	ret = zsock_fcntl(sock, ZVFS_F_SETFL, ZVFS_O_NONBLOCK);
+	if (ret < 0) {
+		att->error = errno;
+		(void)zsock_close(sock);
+		return -1;
+	}
+
+	ret = zsock_connect(sock, ai->ai_addr, ai->ai_addrlen);
+	if (ret == 0) {
+		*connected = sock;
+		return 1;
+	}
+
+	if (errno != EINPROGRESS) {
+		NET_DBG("Connect to family %d failed (%d)", ai->ai_family, errno);
+		att->error = errno;
+		(void)zsock_close(sock);
+		return -1;
+	}
+
+	att->fds[att->count].fd = sock;
+	att->fds[att->count].events = ZSOCK_POLLOUT;
+	att->count++;
+
+	return 0;
+}
+
+static int timepoint_to_ms(k_timepoint_t timepoint)
+{
+	k_timeout_t timeout = sys_timepoint_timeout(timepoint);
+
+	if (K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+		return SYS_FOREVER_MS;
+	}
+
+	return k_ticks_to_ms_ceil32(timeout.ticks);
+}
+
+int zsock_connect_addrinfo(const struct zsock_addrinfo *res, int timeout_ms)
+{
+	struct connect_attempts att = {
+		.next = {
+			next_of_family(res, false),
+			next_of_family(res, true),
+		},
+		.error = EHOSTUNREACH,
+	};
+	k_timepoint_t end = sys_timepoint_calc(timeout_ms == SYS_FOREVER_MS ?
+					       K_FOREVER : K_MSEC(timeout_ms));
+	k_timepoint_t next_start = sys_timepoint_calc(K_NO_WAIT);
+	int sock = -1;
+	int ret;
+
+	while (sock < 0) {
+		bool more = (att.next[0] != NULL || att.next[1] != NULL) &&
+			    att.count < ARRAY_SIZE(att.fds);
+		k_timepoint_t wait_end = end;
+
+		/* Start the next attempt when the previous one is taking
+		 * too long or has failed, without giving up on it.
+		 */
+		if (more && sys_timepoint_expired(next_start)) {
+			ret = attempt_start(&att, next_addr(&att), &sock);
+			if (ret != 0) {
+				/* Connected, or failed right away and the
+				 * next address is tried.
+				 */
+				continue;
+			}
+
+			next_start = sys_timepoint_calc(
+				K_MSEC(CONFIG_NET_SOCKETS_CONNECT_ATTEMPT_DELAY));
+			continue;
+		}
+
+		if (att.count == 0) {
+			break;
+		}
+
+		if (sys_timepoint_expired(end)) {
+			att.error = ETIMEDOUT;
+			break;
+		}
+
+		if (more && sys_timepoint_cmp(next_start, end) < 0) {
+			wait_end = next_start;
+		}
+
+		ret = zsock_poll(att.fds, att.count, timepoint_to_ms(wait_end));
+		if (ret < 0) {
+			att.error = errno;
+			break;
+		}
+
+		for (int i = att.count - 1; ret > 0 && i >= 0; i--) {
+			socklen_t optlen = sizeof(int);
+			int error;
+
+			if (att.fds[i].revents == 0) {
+				continue;
+			}
+
+			ret--;
+
+			if (zsock_getsockopt(att.fds[i].fd, SOL_SOCKET, SO_ERROR, &error,
+					     &optlen) < 0) {
+				error = errno;
+			}
+
+			if (error == 0) {
+				sock = att.fds[i].fd;
+				att.fds[i] = att.fds[--att.count];
+				break;
+			}
+
+			NET_DBG("Connect attempt %d failed (%d)", att.fds[i].fd, error);
+			att.error = error;
+			attempt_remove(&att, i);
+			next_start = sys_timepoint_calc(K_NO_WAIT);
+		}
+	}
+
+	while (att.count > 0) {
+		attempt_remove(&att, att.count - 1);
+	}
+
+	if (sock < 0) {
+		errno = att.error;
+		return -1;
+	}
+
+	ret = zsock_fcntl(sock, ZVFS_F_GETFL, 0);
+	if (ret >= 0) {
+		ret = zsock_fcntl(sock, ZVFS_F_SETFL, ret & ~ZVFS_O_NONBLOCK);
+	}
+
+	if (ret < 0) {
+		att.error = errno;
+		(void)zsock_close(sock);
+		errno = att.error;
+		return -1;
+	}
+
+	return sock;
+}
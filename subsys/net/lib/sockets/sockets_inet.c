@@ -1530,6 +1530,273 @@ ssize_t zsock_recvmsg_ctx(struct net_context *ctx, struct msghdr *msg,
 	return -1;
 }
 
+/* Reference the unread part of the packet data, i.e. everything from the
+ * cursor onwards, so that it can be handed to the caller without copying.
+ * The packet buffers may be shared (e.g. by shallow clones), so they are
+ * left untouched: the fragment under the cursor is cloned with the consumed
+ * bytes pulled off, and the following fragments are chained to it by
+ * reference.
+ */
+static int pkt_ref_unread(struct net_pkt *pkt, struct net_buf **frags)
+{
+	struct net_buf *frag = pkt->cursor.buf;
+	struct net_buf *head;
+
+	*frags = NULL;
+
+	if (frag == NULL || net_pkt_remaining_data(pkt) == 0) {
+		return 0;
+	}
+
+	head = net_buf_clone(frag, K_NO_WAIT);
+	if (head == NULL) {
+		return -ENOMEM;
+	}
+
+	net_buf_pull(head, pkt->cursor.pos - frag->data);
+
+	if (frag->frags != NULL) {
+		head->frags = net_buf_ref(frag->frags);
+	}
+
+	*frags = head;
+
+	return 0;
+}
+
+static ssize_t zsock_recv_buf_ctx(struct net_context *ctx,
+				  struct net_buf **frags, int flags,
+				  struct sockaddr *src_addr,
+				  socklen_t *addrlen)
+{
+	enum net_sock_type sock_type = net_context_get_type(ctx);
+	k_timeout_t timeout = K_FOREVER;
+	struct net_pkt *pkt;
+	size_t recv_len;
+	int ret;
+
+	if (flags & ZSOCK_MSG_PEEK) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (sock_type == SOCK_STREAM) {
+		if (net_context_get_state(ctx) != NET_CONTEXT_CONNECTED) {
+			errno = ENOTCONN;
+			return -1;
+		}
+
+		if (sock_is_error(ctx)) {
+			errno = POINTER_TO_INT(ctx->user_data);
+			return -1;
+		}
+
+		if (sock_is_eof(ctx)) {
+			return 0;
+		}
+	}
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	} else {
+		net_context_get_option(ctx, NET_OPT_RCVTIMEO, &timeout, NULL);
+
+		ret = zsock_wait_data(ctx, &timeout);
+		if (ret < 0) {
+			errno = -ret;
+			return -1;
+		}
+	}
+
+	/* Only peek at the packet until its data has been referenced, so that
+	 * nothing is lost if that fails.
+	 */
+	pkt = k_fifo_peek_head(&ctx->recv_q);
+	if (pkt == NULL) {
+		if (sock_type == SOCK_STREAM && sock_is_eof(ctx)) {
+			return 0;
+		}
+
+		errno = EAGAIN;
+		return -1;
+	}
+
+	if (sock_type != SOCK_STREAM && src_addr != NULL && addrlen != NULL) {
+		ret = sock_get_pkt_src_addr(ctx, pkt, src_addr, *addrlen);
+		if (ret < 0) {
+			errno = -ret;
+			return -1;
+		}
+
+		*addrlen = src_addr->sa_family == AF_INET ?
+			   sizeof(struct sockaddr_in) : sizeof(struct sockaddr_in6);
+	}
+
+	recv_len = net_pkt_remaining_data(pkt);
+
+	ret = pkt_ref_unread(pkt, frags);
+	if (ret < 0) {
+		errno = -ret;
+		return -1;
+	}
+
+	pkt = k_fifo_get(&ctx->recv_q, K_NO_WAIT);
+
+	if (sock_type == SOCK_STREAM && net_pkt_eof(pkt)) {
+		sock_set_eof(ctx);
+	}
+
+	if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS) ||
+	    IS_ENABLED(CONFIG_TRACING_NET_CORE)) {
+		net_socket_update_tc_rx_time(pkt, k_cycle_get_32());
+	}
+
+	net_pkt_unref(pkt);
+
+	if (sock_type == SOCK_STREAM) {
+		net_context_update_recv_wnd(ctx, recv_len);
+	}
+
+	return recv_len;
+}
+
+static ssize_t zsock_send_buf_ctx(struct net_context *ctx,
+				  struct net_buf *frags, int flags,
+				  const struct sockaddr *dest_addr,
+				  socklen_t addrlen)
+{
+	k_timeout_t timeout = K_FOREVER;
+	uint32_t retry_timeout = WAIT_BUFS_INITIAL_MS;
+	k_timepoint_t buf_timeout, end;
+	int status;
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+		buf_timeout = sys_timepoint_calc(K_NO_WAIT);
+	} else {
+		net_context_get_option(ctx, NET_OPT_SNDTIMEO, &timeout, NULL);
+		buf_timeout = sys_timepoint_calc(MAX_WAIT_BUFS);
+	}
+	end = sys_timepoint_calc(timeout);
+
+	/* Register the callback before sending in order to receive the response
+	 * from the peer.
+	 */
+	status = net_context_recv(ctx, zsock_received_cb,
+				  K_NO_WAIT, ctx->user_data);
+	if (status < 0) {
+		errno = -status;
+		return -1;
+	}
+
+	while (1) {
+		status = net_context_send_buf(ctx, frags, dest_addr, addrlen,
+					      timeout);
+		if (status < 0) {
+			status = send_check_and_wait(ctx, status, buf_timeout,
+						     timeout, &retry_timeout);
+			if (status < 0) {
+				return status;
+			}
+
+			/* Update the timeout value in case loop is repeated. */
+			timeout = sys_timepoint_timeout(end);
+
+			continue;
+		}
+
+		break;
+	}
+
+	return status;
+}
+
+static struct net_context *zsock_buf_get_ctx(int sock, struct k_mutex **lock)
+{
+	const struct fd_op_vtable *vtable;
+	struct net_context *ctx;
+
+	ctx = zvfs_get_fd_obj_and_vtable(sock, &vtable, lock);
+	if (ctx == NULL) {
+		errno = EBADF;
+		return NULL;
+	}
+
+	/* Only native sockets keep their data in net_buf fragments */
+	if (vtable != (const struct fd_op_vtable *)&sock_fd_op_vtable ||
+	    net_if_is_ip_offloaded(net_context_get_iface(ctx))) {
+		errno = EOPNOTSUPP;
+		return NULL;
+	}
+
+	return ctx;
+}
+
+ssize_t zsock_recv_buf(int sock, struct net_buf **frags, int flags,
+		       struct sockaddr *src_addr, socklen_t *addrlen)
+{
+	struct net_context *ctx;
+	struct k_mutex *lock;
+	ssize_t ret;
+
+	if (frags == NULL) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	*frags = NULL;
+
+	ctx = zsock_buf_get_ctx(sock, &lock);
+	if (ctx == NULL) {
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	ret = zsock_recv_buf_ctx(ctx, frags, flags, src_addr, addrlen);
+
+	k_mutex_unlock(lock);
+
+	sock_obj_core_update_recv_stats(sock, ret);
+
+	return ret;
+}
+
+ssize_t zsock_send_buf(int sock, struct net_buf *frags, int flags,
+		       const struct sockaddr *dest_addr, socklen_t addrlen)
+{
+	struct net_context *ctx;
+	struct k_mutex *lock;
+	ssize_t ret;
+
+	if (frags == NULL) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	ctx = zsock_buf_get_ctx(sock, &lock);
+	if (ctx == NULL) {
+		ret = -1;
+		goto out;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	ret = zsock_send_buf_ctx(ctx, frags, flags, dest_addr, addrlen);
+
+	k_mutex_unlock(lock);
+
+	sock_obj_core_update_send_stats(sock, ret);
+
+out:
+	/* The caller's reference is consumed in all cases, the stack keeps
+	 * its own until the data has been transmitted.
+	 */
+	net_buf_unref(frags);
+
+	return ret;
+}
+
 static int zsock_poll_prepare_ctx(struct net_context *ctx,
 				  struct zsock_pollfd *pfd,
 				  struct k_poll_event **pev,
@@ -14,6 +14,7 @@ LOG_MODULE_REGISTER(net_sock_tls, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <zephyr/init.h>
 #include <zephyr/sys/util.h>
 #include <zephyr/net/socket.h>
+#include <zephyr/net_buf.h>
 #include <zephyr/random/random.h>
 #include <zephyr/internal/syscall_handler.h>
 #include <zephyr/sys/fdtable.h>
@@ -46,7 +47,9 @@ LOG_MODULE_REGISTER(net_sock_tls, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <mbedtls/ssl_cookie.h>
 #include <mbedtls/error.h>
 #include <mbedtls/platform.h>
+#include <mbedtls/platform_util.h>
 #include <mbedtls/ssl_cache.h>
+#include <mbedtls/ssl_ticket.h>
 #endif /* CONFIG_MBEDTLS */
 
 #include "sockets_internal.h"
@@ -143,6 +146,11 @@ __net_socket struct tls_context {
 	/** Session ended at the TLS/DTLS level. */
 	bool session_closed : 1;
 
+#if defined(CONFIG_NET_SOCKETS_TLS_RX_BUF)
+	/** Underlying socket cannot hand over its network buffers. */
+	bool rx_buf_unsupported : 1;
+#endif
+
 	/** Socket type. */
 	enum net_sock_type type;
 
@@ -223,6 +231,11 @@ __net_socket struct tls_context {
 	socklen_t dtls_peer_addrlen;
 #endif /* CONFIG_NET_SOCKETS_ENABLE_DTLS */
 
+#if defined(CONFIG_NET_SOCKETS_TLS_RX_BUF)
+	/** Received TCP data not yet consumed by mbedTLS. */
+	struct net_buf *rx_frags;
+#endif
+
 #if defined(CONFIG_MBEDTLS)
 	/** mbedTLS context. */
 	mbedtls_ssl_context ssl;
@@ -254,6 +267,30 @@ static struct tls_session_cache client_cache[CONFIG_NET_SOCKETS_TLS_MAX_CLIENT_S
 static mbedtls_ssl_cache_context server_cache;
 #endif
 
+#if defined(CONFIG_NET_SOCKETS_TLS_SESSION_TICKETS)
+#if defined(MBEDTLS_GCM_C)
+#define TLS_TICKET_CIPHER MBEDTLS_CIPHER_AES_256_GCM
+#elif defined(MBEDTLS_CCM_C)
+#define TLS_TICKET_CIPHER MBEDTLS_CIPHER_AES_256_CCM
+#else
+#define TLS_TICKET_CIPHER MBEDTLS_CIPHER_CHACHA20_POLY1305
+#endif
+
+#define TLS_TICKET_KEY_NAME_LEN 4
+#define TLS_TICKET_KEY_LEN 32
+#define TLS_TICKET_ROTATION_MS \
+	((int64_t)CONFIG_NET_SOCKETS_TLS_SESSION_TICKET_LIFETIME * MSEC_PER_SEC)
+
+static mbedtls_ssl_ticket_context server_ticket;
+static int64_t server_ticket_rotated;
+static bool server_ticket_ready;
+#endif
+
+/* mbedTLS is built without threading support, the server session cache and
+ * ticket keys shared by all the sockets are protected by this mutex.
+ */
+static struct k_mutex server_session_lock;
+
 /* A mutex for protecting TLS context allocation. */
 static struct k_mutex context_lock;
 
@@ -368,6 +405,7 @@ static int tls_init(void)
 	(void)memset(client_cache, 0, sizeof(client_cache));
 
 	k_mutex_init(&context_lock);
+	k_mutex_init(&server_session_lock);
 
 #if defined(MBEDTLS_SSL_CACHE_C)
 	mbedtls_ssl_cache_init(&server_cache);
@@ -436,6 +474,29 @@ static inline void tls_set_max_frag_len(mbedtls_ssl_config *config, enum net_soc
 static inline void tls_set_max_frag_len(mbedtls_ssl_config *config, enum net_sock_type type) {}
 #endif
 
+static void tls_rx_frags_flush(struct tls_context *tls)
+{
+#if defined(CONFIG_NET_SOCKETS_TLS_RX_BUF)
+	if (tls->rx_frags != NULL) {
+		net_buf_unref(tls->rx_frags);
+		tls->rx_frags = NULL;
+	}
+#else
+	ARG_UNUSED(tls);
+#endif
+}
+
+static bool tls_rx_frags_pending(struct tls_context *tls)
+{
+#if defined(CONFIG_NET_SOCKETS_TLS_RX_BUF)
+	return tls->rx_frags != NULL;
+#else
+	ARG_UNUSED(tls);
+
+	return false;
+#endif
+}
+
 /* Allocate TLS context. */
 static struct tls_context *tls_alloc(void)
 {
@@ -536,6 +597,7 @@ static int tls_release(struct tls_context *tls)
 #endif
 	mbedtls_ssl_config_free(&tls->config);
 	mbedtls_ssl_free(&tls->ssl);
+	tls_rx_frags_flush(tls);
 #if defined(MBEDTLS_X509_CRT_PARSE_C)
 	mbedtls_x509_crt_free(&tls->ca_chain);
 	mbedtls_x509_crt_free(&tls->own_cert);
@@ -722,14 +784,164 @@ exit:
 	mbedtls_ssl_session_free(&session);
 }
 
-static void tls_session_purge(void)
+#if defined(MBEDTLS_SSL_CACHE_C)
+static int tls_server_cache_get(void *data, unsigned char const *session_id,
+				size_t session_id_len,
+				mbedtls_ssl_session *session)
 {
-	tls_session_cache_reset();
+	int ret;
+
+	k_mutex_lock(&server_session_lock, K_FOREVER);
+	ret = mbedtls_ssl_cache_get(data, session_id, session_id_len, session);
+	k_mutex_unlock(&server_session_lock);
+
+	return ret;
+}
+
+static int tls_server_cache_set(void *data, unsigned char const *session_id,
+				size_t session_id_len,
+				const mbedtls_ssl_session *session)
+{
+	int ret;
+
+	k_mutex_lock(&server_session_lock, K_FOREVER);
+	ret = mbedtls_ssl_cache_set(data, session_id, session_id_len, session);
+	k_mutex_unlock(&server_session_lock);
+
+	return ret;
+}
+#endif /* MBEDTLS_SSL_CACHE_C */
+
+#if defined(CONFIG_NET_SOCKETS_TLS_SESSION_TICKETS)
+/* Must be called with server_session_lock held. */
+static int tls_server_ticket_rotate(void)
+{
+	unsigned char name[TLS_TICKET_KEY_NAME_LEN];
+	unsigned char key[TLS_TICKET_KEY_LEN];
+	int ret;
+
+	ret = tls_ctr_drbg_random(NULL, name, sizeof(name));
+	if (ret == 0) {
+		ret = tls_ctr_drbg_random(NULL, key, sizeof(key));
+	}
+
+	if (ret == 0) {
+		ret = mbedtls_ssl_ticket_rotate(&server_ticket, name, sizeof(name),
+						key, sizeof(key),
+						CONFIG_NET_SOCKETS_TLS_SESSION_TICKET_LIFETIME);
+	}
+
+	mbedtls_platform_zeroize(key, sizeof(key));
+
+	if (ret == 0) {
+		server_ticket_rotated = k_uptime_get();
+	}
+
+	return ret;
+}
+
+/* Must be called with server_session_lock held. mbedTLS only rotates the keys
+ * by itself when it has the time of day, so the key is rotated here both when
+ * writing and when parsing a ticket, so that an idle server stops accepting
+ * tickets encrypted with an expired key.
+ */
+static void tls_server_ticket_check_rotation(void)
+{
+	int ret;
+
+	if (k_uptime_get() - server_ticket_rotated < TLS_TICKET_ROTATION_MS) {
+		return;
+	}
+
+	ret = tls_server_ticket_rotate();
+	if (ret < 0) {
+		NET_WARN("Failed to rotate session ticket key, err: -0x%x", -ret);
+	}
+}
+
+static int tls_server_ticket_setup(void)
+{
+	int ret = 0;
+
+	k_mutex_lock(&server_session_lock, K_FOREVER);
+
+	if (!server_ticket_ready) {
+		mbedtls_ssl_ticket_init(&server_ticket);
+
+		ret = mbedtls_ssl_ticket_setup(&server_ticket, tls_ctr_drbg_random,
+					       NULL, TLS_TICKET_CIPHER,
+					       CONFIG_NET_SOCKETS_TLS_SESSION_TICKET_LIFETIME);
+		if (ret == 0) {
+			server_ticket_rotated = k_uptime_get();
+			server_ticket_ready = true;
+		} else {
+			NET_ERR("Failed to set up session tickets, err: -0x%x", -ret);
+			mbedtls_ssl_ticket_free(&server_ticket);
+		}
+	}
+
+	k_mutex_unlock(&server_session_lock);
+
+	return ret;
+}
+
+static int tls_server_ticket_write(void *data, const mbedtls_ssl_session *session,
+				   unsigned char *start, const unsigned char *end,
+				   size_t *tlen, uint32_t *lifetime)
+{
+	int ret;
+
+	k_mutex_lock(&server_session_lock, K_FOREVER);
+
+	tls_server_ticket_check_rotation();
+
+	ret = mbedtls_ssl_ticket_write(data, session, start, end, tlen, lifetime);
+
+	k_mutex_unlock(&server_session_lock);
+
+	return ret;
+}
+
+static int tls_server_ticket_parse(void *data, mbedtls_ssl_session *session,
+				   unsigned char *buf, size_t len)
+{
+	int ret;
+
+	k_mutex_lock(&server_session_lock, K_FOREVER);
+	tls_server_ticket_check_rotation();
+	ret = mbedtls_ssl_ticket_parse(data, session, buf, len);
+	k_mutex_unlock(&server_session_lock);
+
+	return ret;
+}
+#endif /* CONFIG_NET_SOCKETS_TLS_SESSION_TICKETS */
+
+static void tls_server_session_purge(void)
+{
+	k_mutex_lock(&server_session_lock, K_FOREVER);
 
 #if defined(MBEDTLS_SSL_CACHE_C)
 	mbedtls_ssl_cache_free(&server_cache);
 	mbedtls_ssl_cache_init(&server_cache);
 #endif
+
+#if defined(CONFIG_NET_SOCKETS_TLS_SESSION_TICKETS)
+	/* Replace both the current and the previous key, so that none of the
+	 * tickets issued so far is accepted anymore.
+	 */
+	if (server_ticket_ready) {
+		(void)tls_server_ticket_rotate();
+		(void)tls_server_ticket_rotate();
+	}
+#endif
+
+	k_mutex_unlock(&server_session_lock);
+}
+
+static void tls_session_purge(void)
+{
+	tls_session_cache_reset();
+	tls_server_session_purge();
 }
 
 static inline int time_left(uint32_t start, uint32_t timeout)
@@ -930,13 +1142,131 @@ static int tls_tx(void *ctx, const unsigned char *buf, size_t len)
 	return sent;
 }
 
+#if defined(CONFIG_NET_SOCKETS_TLS_RX_BUF)
+/* Serve mbedTLS from the fragments of the last TCP segment received. The
+ * segment is taken off the socket in a single call, and the record headers
+ * and bodies it carries are then copied straight out of the network buffers,
+ * instead of going through the socket layer for every read mbedTLS issues.
+ *
+ * Only the first fragment returned by zsock_recv_buf() is private, the
+ * following ones may still be shared with the TCP stack, so a fragment is
+ * only pulled once it is owned by the socket alone.
+ */
+static struct net_buf *tls_rx_frag_del(struct net_buf *frag)
+{
+	struct net_buf *next = frag->frags;
+
+	if (frag->ref == 1) {
+		return net_buf_frag_del(NULL, frag);
+	}
+
+	if (next != NULL) {
+		net_buf_ref(next);
+	}
+
+	net_buf_unref(frag);
+
+	return next;
+}
+
+static struct net_buf *tls_rx_frag_own(struct net_buf *frag)
+{
+	struct net_buf *clone;
+
+	if (frag->ref == 1) {
+		return frag;
+	}
+
+	clone = net_buf_clone(frag, K_NO_WAIT);
+	if (clone == NULL) {
+		return NULL;
+	}
+
+	if (frag->frags != NULL) {
+		clone->frags = net_buf_ref(frag->frags);
+	}
+
+	net_buf_unref(frag);
+
+	return clone;
+}
+
+static ssize_t tls_rx_buf(struct tls_context *tls_ctx, unsigned char *buf,
+			  size_t len)
+{
+	struct net_buf *frag;
+	ssize_t received;
+	size_t copied = 0;
+	size_t chunk;
+
+	if (tls_ctx->rx_frags == NULL) {
+		received = zsock_recv_buf(tls_ctx->sock, &tls_ctx->rx_frags,
+					  ZSOCK_MSG_DONTWAIT, NULL, NULL);
+		if (received <= 0) {
+			tls_rx_frags_flush(tls_ctx);
+			return received;
+		}
+	}
+
+	while (copied < len && tls_ctx->rx_frags != NULL) {
+		frag = tls_ctx->rx_frags;
+		chunk = MIN(len - copied, frag->len);
+
+		if (chunk == frag->len) {
+			memcpy(buf + copied, frag->data, chunk);
+			tls_ctx->rx_frags = tls_rx_frag_del(frag);
+			copied += chunk;
+			continue;
+		}
+
+		frag = tls_rx_frag_own(frag);
+		if (frag == NULL) {
+			break;
+		}
+
+		memcpy(buf + copied, net_buf_pull_mem(frag, chunk), chunk);
+		tls_ctx->rx_frags = frag;
+		copied += chunk;
+	}
+
+	/* Do not leave empty fragments behind, they would read as EOF */
+	while (tls_ctx->rx_frags != NULL && tls_ctx->rx_frags->len == 0U) {
+		tls_ctx->rx_frags = tls_rx_frag_del(tls_ctx->rx_frags);
+	}
+
+	/* A short read is fine, mbedTLS asks again for the rest */
+	if (copied == 0 && len > 0) {
+		errno = ENOMEM;
+		return -1;
+	}
+
+	return copied;
+}
+#endif /* CONFIG_NET_SOCKETS_TLS_RX_BUF */
+
 static int tls_rx(void *ctx, unsigned char *buf, size_t len)
 {
 	struct tls_context *tls_ctx = ctx;
 	ssize_t received;
 
+#if defined(CONFIG_NET_SOCKETS_TLS_RX_BUF)
+	if (!tls_ctx->rx_buf_unsupported) {
+		received = tls_rx_buf(tls_ctx, buf, len);
+		if (received >= 0 || errno != EOPNOTSUPP) {
+			goto out;
+		}
+
+		/* Offloaded or non-native socket, fall back to copying. */
+		tls_ctx->rx_buf_unsupported = true;
+	}
+#endif
+
 	received = zsock_recvfrom(tls_ctx->sock, buf, len,
 				  ZSOCK_MSG_DONTWAIT, NULL, 0);
+
+#if defined(CONFIG_NET_SOCKETS_TLS_RX_BUF)
+out:
+#endif
 	if (received < 0) {
 		if (errno == EAGAIN) {
 			return MBEDTLS_ERR_SSL_WANT_READ;
@@ -1169,6 +1499,7 @@ static int tls_mbedtls_reset(struct tls_context *context)
 	}
 
 	k_sem_reset(&context->tls_established);
+	tls_rx_frags_flush(context);
 
 #if defined(CONFIG_NET_SOCKETS_ENABLE_DTLS)
 	/* Server role: reset the address so that a new
@@ -1416,8 +1747,22 @@ static int tls_mbedtls_init(struct tls_context *context, bool is_server)
 #if defined(MBEDTLS_SSL_CACHE_C)
 	if (is_server && context->options.cache_enabled) {
 		mbedtls_ssl_conf_session_cache(&context->config, &server_cache,
-					       mbedtls_ssl_cache_get,
-					       mbedtls_ssl_cache_set);
+					       tls_server_cache_get,
+					       tls_server_cache_set);
+	}
+#endif
+
+#if defined(CONFIG_NET_SOCKETS_TLS_SESSION_TICKETS)
+	if (is_server && context->options.cache_enabled) {
+		ret = tls_server_ticket_setup();
+		if (ret != 0) {
+			return -ENOMEM;
+		}
+
+		mbedtls_ssl_conf_session_tickets_cb(&context->config,
+						    tls_server_ticket_write,
+						    tls_server_ticket_parse,
+						    &server_ticket);
 	}
 #endif
 
@@ -1948,11 +2293,15 @@ static int tls_opt_session_cache_get(struct tls_context *context,
 static int tls_opt_session_cache_purge_set(struct tls_context *context,
 					   const void *optval, socklen_t optlen)
 {
-	ARG_UNUSED(context);
 	ARG_UNUSED(optval);
 	ARG_UNUSED(optlen);
 
-	tls_session_purge();
+	/* Server sockets leave the sessions stored by the clients alone */
+	if (context->is_listening || context->options.role == MBEDTLS_SSL_IS_SERVER) {
+		tls_server_session_purge();
+	} else {
+		tls_session_purge();
+	}
 
 	return 0;
 }
@@ -2986,6 +3335,13 @@ static int ztls_poll_prepare_pollin(struct tls_context *ctx)
 		if (mbedtls_ssl_get_bytes_avail(&ctx->ssl) > 0) {
 			return -EALREADY;
 		}
+
+		/* Encrypted data already taken off the underlying socket won't
+		 * be signalled by it anymore.
+		 */
+		if (tls_rx_frags_pending(ctx)) {
+			return -EALREADY;
+		}
 	}
 
 	return 0;
@@ -3155,7 +3511,7 @@ static int ztls_poll_update_pollin(int fd, struct tls_context *ctx,
 	}
 
 	if (ctx->type == SOCK_STREAM) {
-		if (!(pfd->revents & ZSOCK_POLLIN)) {
+		if (!(pfd->revents & ZSOCK_POLLIN) && !tls_rx_frags_pending(ctx)) {
 			/* No new data on a socket. */
 			goto next;
 		}
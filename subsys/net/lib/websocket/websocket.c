@@ -602,6 +602,44 @@ static int sendmsg_all(int sock, const struct msghdr *message, int flags,
 }
 #endif /* !defined(CONFIG_NET_TEST) */
 
+/* XOR the data with the masking key, offset being the position of the data in
+ * the frame payload. The bulk of the data is processed a machine word at a
+ * time, the bytes before the first aligned word and after the last one are
+ * done separately.
+ */
+static void websocket_mask(uint8_t *data, size_t len, uint32_t masking_value,
+			   uint64_t offset)
+{
+	uint8_t key[sizeof(uint32_t)];
+	unsigned long word_mask;
+	size_t pos = 0;
+	size_t i;
+
+	sys_put_be32(masking_value, key);
+	offset %= sizeof(key);
+
+	while (pos < len && !IS_ALIGNED(&data[pos], sizeof(word_mask))) {
+		data[pos++] ^= key[offset];
+		offset = (offset + 1) % sizeof(key);
+	}
+
+	/* The word size being a multiple of the key size, the key position
+	 * is the same at the start of each word.
+	 */
+	for (i = 0; i < sizeof(word_mask); i++) {
+		((uint8_t *)&word_mask)[i] = key[(offset + i) % sizeof(key)];
+	}
+
+	for (; len - pos >= sizeof(word_mask); pos += sizeof(word_mask)) {
+		*(unsigned long *)&data[pos] ^= word_mask;
+	}
+
+	while (pos < len) {
+		data[pos++] ^= key[offset];
+		offset = (offset + 1) % sizeof(key);
+	}
+}
+
 static int websocket_prepare_and_send(struct websocket_context *ctx,
 				      uint8_t *header, size_t header_len,
 				      uint8_t *payload, size_t payload_len,
@@ -719,8 +757,6 @@ int websocket_send_msg(int ws_sock, const uint8_t *payload, size_t payload_len,
 
 	/* Add masking value if needed */
 	if (mask) {
-		int i;
-
 		ctx->masking_value = sys_rand32_get();
 
 		header[hdr_len++] |= ctx->masking_value >> 24;
@@ -736,9 +772,7 @@ int websocket_send_msg(int ws_sock, const uint8_t *payload, size_t payload_len,
 
 			memcpy(data_to_send, payload, payload_len);
 
-			for (i = 0; i < payload_len; i++) {
-				data_to_send[i] ^= ctx->masking_value >> (8 * (3 - i % 4));
-			}
+			websocket_mask(data_to_send, payload_len, ctx->masking_value, 0);
 		}
 	}
 
@@ -781,90 +815,100 @@ static uint32_t websocket_opcode2flag(uint8_t data)
 	return 0;
 }
 
-static int websocket_parse(struct websocket_context *ctx, struct websocket_buffer *payload)
+/* Parse one byte of the frame header */
+static int websocket_parse_header(struct websocket_context *ctx, uint8_t data)
 {
 	int len;
-	uint8_t data;
+
+	switch (ctx->parser_state) {
+	case WEBSOCKET_PARSER_STATE_OPCODE:
+		ctx->message_type = websocket_opcode2flag(data);
+		if ((data & 0x80) != 0) {
+			ctx->message_type |= WEBSOCKET_FLAG_FINAL;
+		}
+		ctx->parser_state = WEBSOCKET_PARSER_STATE_LENGTH;
+		break;
+	case WEBSOCKET_PARSER_STATE_LENGTH:
+		ctx->masked = (data & 0x80) != 0;
+		len = data & 0x7f;
+		if (len < 126) {
+			ctx->message_len = len;
+			if (ctx->masked) {
+				ctx->masking_value = 0;
+				ctx->parser_remaining = 4;
+				ctx->parser_state = WEBSOCKET_PARSER_STATE_MASK;
+			} else {
+				ctx->parser_remaining = ctx->message_len;
+				ctx->parser_state =
+					(ctx->parser_remaining == 0)
+						? WEBSOCKET_PARSER_STATE_OPCODE
+						: WEBSOCKET_PARSER_STATE_PAYLOAD;
+			}
+		} else {
+			ctx->message_len = 0;
+			ctx->parser_remaining = (len < 127) ? 2 : 8;
+			ctx->parser_state = WEBSOCKET_PARSER_STATE_EXT_LEN;
+		}
+		break;
+	case WEBSOCKET_PARSER_STATE_EXT_LEN:
+		ctx->parser_remaining--;
+		ctx->message_len |= ((uint64_t)data << (ctx->parser_remaining * 8));
+		if (ctx->parser_remaining == 0) {
+			if (ctx->masked) {
+				ctx->masking_value = 0;
+				ctx->parser_remaining = 4;
+				ctx->parser_state = WEBSOCKET_PARSER_STATE_MASK;
+			} else {
+				ctx->parser_remaining = ctx->message_len;
+				ctx->parser_state = WEBSOCKET_PARSER_STATE_PAYLOAD;
+			}
+		}
+		break;
+	case WEBSOCKET_PARSER_STATE_MASK:
+		ctx->parser_remaining--;
+		ctx->masking_value |= (data << (ctx->parser_remaining * 8));
+		if (ctx->parser_remaining == 0) {
+			if (ctx->message_len == 0) {
+				ctx->parser_remaining = 0;
+				ctx->parser_state = WEBSOCKET_PARSER_STATE_OPCODE;
+			} else {
+				ctx->parser_remaining = ctx->message_len;
+				ctx->parser_state = WEBSOCKET_PARSER_STATE_PAYLOAD;
+			}
+		}
+		break;
+	default:
+		return -EFAULT;
+	}
+
+#if (LOG_LEVEL >= LOG_LEVEL_DBG)
+	if ((ctx->parser_state == WEBSOCKET_PARSER_STATE_PAYLOAD) ||
+	    ((ctx->parser_state == WEBSOCKET_PARSER_STATE_OPCODE) &&
+	     (ctx->message_len == 0))) {
+		NET_DBG("[%p] %smasked, mask 0x%08x, type 0x%02x, msg %zd", ctx,
+			ctx->masked ? "" : "un",
+			ctx->masked ? ctx->masking_value : 0, ctx->message_type,
+			(size_t)ctx->message_len);
+	}
+#endif
+
+	return 0;
+}
+
+static int websocket_parse(struct websocket_context *ctx, struct websocket_buffer *payload)
+{
 	size_t parsed_count = 0;
+	int ret;
 
 	do {
 		if (parsed_count >= ctx->recv_buf.count) {
 			return parsed_count;
 		}
 		if (ctx->parser_state != WEBSOCKET_PARSER_STATE_PAYLOAD) {
-			data = ctx->recv_buf.buf[parsed_count++];
-
-			switch (ctx->parser_state) {
-			case WEBSOCKET_PARSER_STATE_OPCODE:
-				ctx->message_type = websocket_opcode2flag(data);
-				if ((data & 0x80) != 0) {
-					ctx->message_type |= WEBSOCKET_FLAG_FINAL;
-				}
-				ctx->parser_state = WEBSOCKET_PARSER_STATE_LENGTH;
-				break;
-			case WEBSOCKET_PARSER_STATE_LENGTH:
-				ctx->masked = (data & 0x80) != 0;
-				len = data & 0x7f;
-				if (len < 126) {
-					ctx->message_len = len;
-					if (ctx->masked) {
-						ctx->masking_value = 0;
-						ctx->parser_remaining = 4;
-						ctx->parser_state = WEBSOCKET_PARSER_STATE_MASK;
-					} else {
-						ctx->parser_remaining = ctx->message_len;
-						ctx->parser_state =
-							(ctx->parser_remaining == 0)
-								? WEBSOCKET_PARSER_STATE_OPCODE
-								: WEBSOCKET_PARSER_STATE_PAYLOAD;
-					}
-				} else {
-					ctx->message_len = 0;
-					ctx->parser_remaining = (len < 127) ? 2 : 8;
-					ctx->parser_state = WEBSOCKET_PARSER_STATE_EXT_LEN;
-				}
-				break;
-			case WEBSOCKET_PARSER_STATE_EXT_LEN:
-				ctx->parser_remaining--;
-				ctx->message_len |= ((uint64_t)data << (ctx->parser_remaining * 8));
-				if (ctx->parser_remaining == 0) {
-					if (ctx->masked) {
-						ctx->masking_value = 0;
-						ctx->parser_remaining = 4;
-						ctx->parser_state = WEBSOCKET_PARSER_STATE_MASK;
-					} else {
-						ctx->parser_remaining = ctx->message_len;
-						ctx->parser_state = WEBSOCKET_PARSER_STATE_PAYLOAD;
-					}
-				}
-				break;
-			case WEBSOCKET_PARSER_STATE_MASK:
-				ctx->parser_remaining--;
-				ctx->masking_value |= (data << (ctx->parser_remaining * 8));
-				if (ctx->parser_remaining == 0) {
-					if (ctx->message_len == 0) {
-						ctx->parser_remaining = 0;
-						ctx->parser_state = WEBSOCKET_PARSER_STATE_OPCODE;
-					} else {
-						ctx->parser_remaining = ctx->message_len;
-						ctx->parser_state = WEBSOCKET_PARSER_STATE_PAYLOAD;
-					}
-				}
-				break;
-			default:
-				return -EFAULT;
-			}
-
-#if (LOG_LEVEL >= LOG_LEVEL_DBG)
-			if ((ctx->parser_state == WEBSOCKET_PARSER_STATE_PAYLOAD) ||
-			    ((ctx->parser_state == WEBSOCKET_PARSER_STATE_OPCODE) &&
-			     (ctx->message_len == 0))) {
-				NET_DBG("[%p] %smasked, mask 0x%08x, type 0x%02x, msg %zd", ctx,
-					ctx->masked ? "" : "un",
-					ctx->masked ? ctx->masking_value : 0, ctx->message_type,
-					(size_t)ctx->message_len);
+			ret = websocket_parse_header(ctx, ctx->recv_buf.buf[parsed_count++]);
+			if (ret < 0) {
+				return ret;
 			}
-#endif
 		} else {
 			size_t remaining_in_recv_buf = ctx->recv_buf.count - parsed_count;
 			size_t payload_in_recv_buf =
@@ -935,6 +979,93 @@ static int timeout_to_ms(k_timeout_t *timeout)
 
 #endif /* !defined(CONFIG_NET_TEST) */
 
+static int websocket_recv_ctx_get(int ws_sock, struct websocket_context **ctx)
+{
+#if defined(CONFIG_NET_TEST)
+	struct test_data *test_data = zvfs_get_fd_obj(ws_sock, NULL, 0);
+
+	if (test_data == NULL) {
+		return -EBADF;
+	}
+
+	*ctx = test_data->ctx;
+#else
+	*ctx = zvfs_get_fd_obj(ws_sock, NULL, 0);
+	if (*ctx == NULL) {
+		return -EBADF;
+	}
+
+	if (!PART_OF_ARRAY(contexts, *ctx)) {
+		return -ENOENT;
+	}
+#endif /* CONFIG_NET_TEST */
+
+	return 0;
+}
+
+/* Read from the socket to the empty receive buffer */
+static int websocket_recv_buf_fill(int ws_sock, struct websocket_context *ctx,
+				   k_timepoint_t end)
+{
+	int ret;
+
+#if defined(CONFIG_NET_TEST)
+	struct test_data *test_data = zvfs_get_fd_obj(ws_sock, NULL, 0);
+	size_t input_len = MIN(ctx->recv_buf.size,
+			       test_data->input_len - test_data->input_pos);
+
+	if (input_len > 0) {
+		memcpy(ctx->recv_buf.buf,
+		       &test_data->input_buf[test_data->input_pos], input_len);
+		test_data->input_pos += input_len;
+		ret = input_len;
+	} else {
+		/* emulate timeout */
+		ret = -EAGAIN;
+	}
+#else
+	k_timeout_t tout = sys_timepoint_timeout(end);
+
+	ARG_UNUSED(ws_sock);
+
+	ret = wait_rx(ctx->real_sock, timeout_to_ms(&tout));
+	if (ret == 0) {
+		ret = zsock_recv(ctx->real_sock, ctx->recv_buf.buf,
+				 ctx->recv_buf.size, ZSOCK_MSG_DONTWAIT);
+		if (ret < 0) {
+			ret = -errno;
+		}
+	}
+#endif /* CONFIG_NET_TEST */
+
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (ret == 0) {
+		/* Socket closed */
+		return -ENOTCONN;
+	}
+
+	ctx->recv_buf.count = ret;
+
+	NET_DBG("[%p] Received %d bytes", ctx, ret);
+
+	return ret;
+}
+
+/* Drop the parsed bytes from the receive buffer */
+static void websocket_recv_buf_consume(struct websocket_context *ctx, size_t parsed_count)
+{
+	size_t left = ctx->recv_buf.count - parsed_count;
+
+	if (left > 0) {
+		memmove(ctx->recv_buf.buf, &ctx->recv_buf.buf[parsed_count], left);
+	}
+
+	ctx->recv_buf.count = left;
+}
+
 int websocket_recv_msg(int ws_sock, uint8_t *buf, size_t buf_len,
 		       uint32_t *message_type, uint64_t *remaining, int32_t timeout)
 {
@@ -954,55 +1085,16 @@ int websocket_recv_msg(int ws_sock, uint8_t *buf, size_t buf_len,
 
 	end = sys_timepoint_calc(tout);
 
-#if defined(CONFIG_NET_TEST)
-	struct test_data *test_data = zvfs_get_fd_obj(ws_sock, NULL, 0);
-
-	if (test_data == NULL) {
-		return -EBADF;
-	}
-
-	ctx = test_data->ctx;
-#else
-	ctx = zvfs_get_fd_obj(ws_sock, NULL, 0);
-	if (ctx == NULL) {
-		return -EBADF;
-	}
-
-	if (!PART_OF_ARRAY(contexts, ctx)) {
-		return -ENOENT;
+	ret = websocket_recv_ctx_get(ws_sock, &ctx);
+	if (ret < 0) {
+		return ret;
 	}
-#endif /* CONFIG_NET_TEST */
 
 	do {
 		size_t parsed_count;
 
 		if (ctx->recv_buf.count == 0) {
-#if defined(CONFIG_NET_TEST)
-			size_t input_len = MIN(ctx->recv_buf.size,
-					       test_data->input_len - test_data->input_pos);
-
-			if (input_len > 0) {
-				memcpy(ctx->recv_buf.buf,
-				       &test_data->input_buf[test_data->input_pos], input_len);
-				test_data->input_pos += input_len;
-				ret = input_len;
-			} else {
-				/* emulate timeout */
-				ret = -EAGAIN;
-			}
-#else
-			tout = sys_timepoint_timeout(end);
-
-			ret = wait_rx(ctx->real_sock, timeout_to_ms(&tout));
-			if (ret == 0) {
-				ret = zsock_recv(ctx->real_sock, ctx->recv_buf.buf,
-						 ctx->recv_buf.size, ZSOCK_MSG_DONTWAIT);
-				if (ret < 0) {
-					ret = -errno;
-				}
-			}
-#endif /* CONFIG_NET_TEST */
-
+			ret = websocket_recv_buf_fill(ws_sock, ctx, end);
 			if (ret < 0) {
 				if ((ret == -EAGAIN) && (payload.count > 0)) {
 					/* go to unmasking */
@@ -1010,15 +1102,6 @@ int websocket_recv_msg(int ws_sock, uint8_t *buf, size_t buf_len,
 				}
 				return ret;
 			}
-
-			if (ret == 0) {
-				/* Socket closed */
-				return -ENOTCONN;
-			}
-
-			ctx->recv_buf.count = ret;
-
-			NET_DBG("[%p] Received %d bytes", ctx, ret);
 		}
 
 		ret = websocket_parse(ctx, &payload);
@@ -1036,12 +1119,7 @@ int websocket_recv_msg(int ws_sock, uint8_t *buf, size_t buf_len,
 				*message_type = ctx->message_type;
 			}
 
-			size_t left = ctx->recv_buf.count - parsed_count;
-
-			if (left > 0) {
-				memmove(ctx->recv_buf.buf, &ctx->recv_buf.buf[parsed_count], left);
-			}
-			ctx->recv_buf.count = left;
+			websocket_recv_buf_consume(ctx, parsed_count);
 			break;
 		}
 
@@ -1051,18 +1129,106 @@ int websocket_recv_msg(int ws_sock, uint8_t *buf, size_t buf_len,
 
 	/* Unmask the data */
 	if (ctx->masked) {
-		uint8_t *mask_as_bytes = (uint8_t *)&ctx->masking_value;
-		size_t data_buf_offset = ctx->message_len - ctx->parser_remaining - payload.count;
+		websocket_mask(payload.buf, payload.count, ctx->masking_value,
+			       ctx->message_len - ctx->parser_remaining - payload.count);
+	}
+
+	return payload.count;
+}
+
+int websocket_recv_stream(int ws_sock, websocket_fragment_cb_t cb, void *user_data,
+			  int32_t timeout)
+{
+	struct websocket_context *ctx;
+	k_timeout_t tout = K_FOREVER;
+	k_timepoint_t end;
+	size_t delivered = 0;
+	bool frame_done = false;
+	int ret;
+
+	if (cb == NULL) {
+		return -EINVAL;
+	}
+
+	if (timeout != SYS_FOREVER_MS) {
+		tout = K_MSEC(timeout);
+	}
+
+	end = sys_timepoint_calc(tout);
+
+	ret = websocket_recv_ctx_get(ws_sock, &ctx);
+	if (ret < 0) {
+		return ret;
+	}
+
+	while (!frame_done) {
+		size_t parsed_count = 0;
+
+		if (ctx->recv_buf.count == 0) {
+			ret = websocket_recv_buf_fill(ws_sock, ctx, end);
+			if (ret < 0) {
+				if ((ret == -EAGAIN) && (delivered > 0)) {
+					break;
+				}
+				return ret;
+			}
+		}
 
-		for (size_t i = 0; i < payload.count; i++) {
-			size_t m = data_buf_offset % 4;
+		while (!frame_done && parsed_count < ctx->recv_buf.count) {
+			uint8_t *data = &ctx->recv_buf.buf[parsed_count];
+			size_t len;
 
-			payload.buf[i] ^= mask_as_bytes[3 - m];
-			data_buf_offset++;
+			if (ctx->parser_state != WEBSOCKET_PARSER_STATE_PAYLOAD) {
+				ret = websocket_parse_header(ctx, *data);
+				if (ret < 0) {
+					return ret;
+				}
+
+				parsed_count++;
+
+				/* Frame without payload, such as a ping */
+				if (ctx->parser_state == WEBSOCKET_PARSER_STATE_OPCODE) {
+					frame_done = true;
+					ret = cb(ws_sock, NULL, 0, ctx->message_type, 0, user_data);
+				}
+
+				continue;
+			}
+
+			/* The payload is unmasked in place and handed over
+			 * without being copied.
+			 */
+			len = MIN(ctx->recv_buf.count - parsed_count, ctx->parser_remaining);
+
+			if (ctx->masked) {
+				websocket_mask(data, len, ctx->masking_value,
+					       ctx->message_len - ctx->parser_remaining);
+			}
+
+			ctx->parser_remaining -= len;
+			if (ctx->parser_remaining == 0) {
+				ctx->parser_state = WEBSOCKET_PARSER_STATE_OPCODE;
+				frame_done = true;
+			}
+
+			parsed_count += len;
+			delivered += len;
+
+			ret = cb(ws_sock, data, len, ctx->message_type, ctx->parser_remaining,
+				 user_data);
+			if (ret < 0) {
+				break;
+			}
+		}
+
+		websocket_recv_buf_consume(ctx, parsed_count);
+
+		if (ret < 0) {
+			return ret;
 		}
 	}
 
-	return payload.count;
+	return delivered;
 }
 
 static int websocket_send(struct websocket_context *ctx, const uint8_t *buf,
@@ -312,14 +312,64 @@ static void udp_receiver_cleanup(void)
 	zperf_session_reset(SESSION_UDP);
 }
 
-static int udp_recv_data(struct net_socket_service_event *pev)
+#if CONFIG_NET_ZPERF_UDP_RX_BATCH > 1
+static int udp_recv_batch(int sock)
+{
+	static uint8_t bufs[CONFIG_NET_ZPERF_UDP_RX_BATCH][UDP_RECEIVER_BUF_SIZE];
+	static struct sockaddr addrs[CONFIG_NET_ZPERF_UDP_RX_BATCH];
+	static struct iovec iovs[CONFIG_NET_ZPERF_UDP_RX_BATCH];
+	static struct mmsghdr msgs[CONFIG_NET_ZPERF_UDP_RX_BATCH];
+	int ret;
+
+	for (int i = 0; i < ARRAY_SIZE(msgs); i++) {
+		iovs[i].iov_base = bufs[i];
+		iovs[i].iov_len = sizeof(bufs[i]);
+
+		msgs[i].msg_hdr.msg_name = &addrs[i];
+		msgs[i].msg_hdr.msg_namelen = sizeof(addrs[i]);
+		msgs[i].msg_hdr.msg_iov = &iovs[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+		msgs[i].msg_hdr.msg_control = NULL;
+		msgs[i].msg_hdr.msg_controllen = 0;
+	}
+
+	ret = zsock_recvmmsg(sock, msgs, ARRAY_SIZE(msgs),
+			     ZSOCK_MSG_DONTWAIT | ZSOCK_MSG_WAITFORONE, 0);
+	if (ret < 0) {
+		return ret;
+	}
+
+	for (int i = 0; i < ret; i++) {
+		udp_received(sock, &addrs[i], bufs[i], msgs[i].msg_len);
+	}
+
+	return ret;
+}
+#else
+static int udp_recv_batch(int sock)
 {
 	static uint8_t buf[UDP_RECEIVER_BUF_SIZE];
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+	int ret;
+
+	ret = zsock_recvfrom(sock, buf, sizeof(buf), ZSOCK_MSG_DONTWAIT,
+			     &addr, &addrlen);
+	if (ret < 0) {
+		return ret;
+	}
+
+	udp_received(sock, &addr, buf, ret);
+
+	return 1;
+}
+#endif /* CONFIG_NET_ZPERF_UDP_RX_BATCH > 1 */
+
+static int udp_recv_data(struct net_socket_service_event *pev)
+{
 	int ret = 1;
 	int family, sock_error;
-	struct sockaddr addr;
 	socklen_t optlen = sizeof(int);
-	socklen_t addrlen = sizeof(addr);
 
 	if (!udp_server_running) {
 		return -ENOENT;
@@ -342,8 +392,7 @@ static int udp_recv_data(struct net_socket_service_event *pev)
 	}
 
 	while (ret > 0) {
-		ret = zsock_recvfrom(pev->event.fd, buf, sizeof(buf), ZSOCK_MSG_DONTWAIT,
-				     &addr, &addrlen);
+		ret = udp_recv_batch(pev->event.fd);
 		if ((ret < 0) && (errno == EAGAIN)) {
 			ret = 0;
 			break;
@@ -357,8 +406,6 @@ static int udp_recv_data(struct net_socket_service_event *pev)
 				family == AF_INET ? 4 : 6, -ret);
 			goto error;
 		}
-
-		udp_received(pev->event.fd, &addr, buf, ret);
 	}
 	return ret;
 
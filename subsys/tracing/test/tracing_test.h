@@ -750,10 +750,14 @@ void sys_trace_k_event_init(struct k_event *event);
 #define sys_port_trace_socket_sendto_exit(sock, ret)
 #define sys_port_trace_socket_sendmsg_enter(sock, msg, flags)
 #define sys_port_trace_socket_sendmsg_exit(sock, ret)
+#define sys_port_trace_socket_sendmmsg_enter(sock, msgvec, vlen, flags)
+#define sys_port_trace_socket_sendmmsg_exit(sock, ret)
 #define sys_port_trace_socket_recvfrom_enter(sock, max_len, flags, addr, addrlen)
 #define sys_port_trace_socket_recvfrom_exit(sock, src_addr, addrlen, ret)
 #define sys_port_trace_socket_recvmsg_enter(sock, msg, flags)
 #define sys_port_trace_socket_recvmsg_exit(sock, msg, ret)
+#define sys_port_trace_socket_recvmmsg_enter(sock, msgvec, vlen, flags, timeout)
+#define sys_port_trace_socket_recvmmsg_exit(sock, msgvec, ret)
 #define sys_port_trace_socket_fcntl_enter(sock, cmd, flags)
 #define sys_port_trace_socket_fcntl_exit(sock, ret)
 #define sys_port_trace_socket_ioctl_enter(sock, req)
@@ -0,0 +1,172 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Measure the cost of parsing and building CoAP messages carrying a typical
+ * set of options, and of looking up these options. Run the option_index
+ * variant to compare the option lookups against a walk of the options.
+ */
+
+#include <inttypes.h>
+#include <string.h>
+
+#include <zephyr/ztest.h>
+#include <zephyr/net/coap.h>
+
+#define BENCH_ITERATIONS 4096
+#define BENCH_BUF_SIZE   128
+
+static const char bench_token[] = "token";
+static const uint8_t bench_content_format[] = {COAP_CONTENT_FORMAT_APP_CBOR};
+static const uint8_t bench_block2[] = {0x16};
+static const uint8_t bench_size1[] = {0x01, 0x00};
+
+/* Options in the reverse order, as the worst case of adding them one by one */
+static const struct coap_packet_option bench_options[] = {
+	{ COAP_OPTION_SIZE1, sizeof(bench_size1), bench_size1 },
+	{ COAP_OPTION_BLOCK2, sizeof(bench_block2), bench_block2 },
+	{ COAP_OPTION_URI_QUERY, 4, (const uint8_t *)"ep=1" },
+	{ COAP_OPTION_CONTENT_FORMAT, sizeof(bench_content_format), bench_content_format },
+	{ COAP_OPTION_URI_PATH, 1, (const uint8_t *)"5" },
+	{ COAP_OPTION_URI_PATH, 1, (const uint8_t *)"0" },
+	{ COAP_OPTION_URI_PATH, 5, (const uint8_t *)"32769" },
+	{ COAP_OPTION_OBSERVE, 0, NULL },
+	{ COAP_OPTION_URI_HOST, 9, (const uint8_t *)"localhost" },
+};
+
+static uint8_t bench_buf[BENCH_BUF_SIZE];
+static uint8_t bench_ref[BENCH_BUF_SIZE];
+static uint16_t bench_ref_len;
+
+static void bench_report(const char *name, uint32_t ops, uint32_t cycles)
+{
+	uint64_t ns = k_cyc_to_ns_floor64(cycles);
+
+	TC_PRINT("%s: %u operations in %" PRIu64 " us, %" PRIu64 " ns per operation\n",
+		 name, ops, ns / NSEC_PER_USEC, ns / ops);
+}
+
+static void bench_init(struct coap_packet *cpkt)
+{
+	zassert_ok(coap_packet_init(cpkt, bench_buf, sizeof(bench_buf), COAP_VERSION_1,
+				    COAP_TYPE_CON, strlen(bench_token), bench_token,
+				    COAP_METHOD_GET, 0x1234));
+}
+
+static void *bench_setup(void)
+{
+	struct coap_packet_option options[ARRAY_SIZE(bench_options)];
+	struct coap_packet cpkt;
+
+	memcpy(options, bench_options, sizeof(options));
+
+	bench_init(&cpkt);
+	zassert_ok(coap_packet_append_options(&cpkt, options, ARRAY_SIZE(options)));
+	zassert_ok(coap_packet_append_payload_marker(&cpkt));
+	zassert_ok(coap_packet_append_payload(&cpkt, (const uint8_t *)"payload", 7));
+
+	memcpy(bench_ref, cpkt.data, cpkt.offset);
+	bench_ref_len = cpkt.offset;
+
+	return NULL;
+}
+
+ZTEST(coap_packet_bench, test_build_one_by_one)
+{
+	struct coap_packet cpkt;
+	uint32_t start, cycles;
+
+	start = k_cycle_get_32();
+
+	for (int n = 0; n < BENCH_ITERATIONS; n++) {
+		bench_init(&cpkt);
+
+		for (int i = 0; i < ARRAY_SIZE(bench_options); i++) {
+			zassert_ok(coap_packet_append_option(&cpkt, bench_options[i].code,
+							     bench_options[i].value,
+							     bench_options[i].len));
+		}
+	}
+
+	cycles = k_cycle_get_32() - start;
+	zassert_mem_equal(cpkt.data, bench_ref, cpkt.offset, "Wrong options");
+	bench_report("Build, options one by one", BENCH_ITERATIONS, cycles);
+}
+
+ZTEST(coap_packet_bench, test_build_sorted)
+{
+	struct coap_packet_option options[ARRAY_SIZE(bench_options)];
+	struct coap_packet cpkt;
+	uint32_t start, cycles;
+
+	start = k_cycle_get_32();
+
+	for (int n = 0; n < BENCH_ITERATIONS; n++) {
+		memcpy(options, bench_options, sizeof(options));
+		bench_init(&cpkt);
+
+		zassert_ok(coap_packet_append_options(&cpkt, options, ARRAY_SIZE(options)));
+	}
+
+	cycles = k_cycle_get_32() - start;
+	zassert_mem_equal(cpkt.data, bench_ref, cpkt.offset, "Wrong options");
+	bench_report("Build, sorted options", BENCH_ITERATIONS, cycles);
+}
+
+ZTEST(coap_packet_bench, test_parse)
+{
+	struct coap_packet cpkt;
+	uint32_t start, cycles;
+
+	start = k_cycle_get_32();
+
+	for (int n = 0; n < BENCH_ITERATIONS; n++) {
+		memcpy(bench_buf, bench_ref, bench_ref_len);
+
+		zassert_ok(coap_packet_parse(&cpkt, bench_buf, bench_ref_len, NULL, 0));
+	}
+
+	cycles = k_cycle_get_32() - start;
+	bench_report("Parse", BENCH_ITERATIONS, cycles);
+}
+
+/* Options looked up when handling a request, the last ones being the worst
+ * case of a walk of the options.
+ */
+ZTEST(coap_packet_bench, test_find_options)
+{
+	static const uint16_t codes[] = {
+		COAP_OPTION_OBSERVE, COAP_OPTION_CONTENT_FORMAT, COAP_OPTION_ACCEPT,
+		COAP_OPTION_BLOCK1, COAP_OPTION_BLOCK2, COAP_OPTION_SIZE1,
+	};
+	const int rounds = BENCH_ITERATIONS / ARRAY_SIZE(codes);
+	struct coap_option options[4];
+	struct coap_packet cpkt;
+	uint32_t start, cycles;
+	int found = 0;
+
+	memcpy(bench_buf, bench_ref, bench_ref_len);
+	zassert_ok(coap_packet_parse(&cpkt, bench_buf, bench_ref_len, NULL, 0));
+
+	start = k_cycle_get_32();
+
+	for (int n = 0; n < rounds; n++) {
+		for (int i = 0; i < ARRAY_SIZE(codes); i++) {
+			int r = coap_find_options(&cpkt, codes[i], options, ARRAY_SIZE(options));
+
+			zassert_true(r >= 0, "Cannot find options (%d)", r);
+			found += r;
+		}
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	/* Observe, Content-Format, Block2 and Size1 are present */
+	zassert_equal(found, rounds * 4, "Wrong number of options found");
+	bench_report("Find options", rounds * ARRAY_SIZE(codes), cycles);
+}
+
+ZTEST_SUITE(coap_packet_bench, NULL, bench_setup, NULL, NULL, NULL);
@@ -0,0 +1,177 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Measure the cost of the HPACK header compression used by the HTTP/2 server:
+ * Huffman decoding of request header values, Huffman encoding, and encoding
+ * of the header blocks of a series of responses carrying the same headers,
+ * with the static table only and with the per-connection dynamic table. The
+ * size of the header blocks is reported along with the time spent.
+ */
+
+#include <inttypes.h>
+
+#include <zephyr/ztest.h>
+#include <zephyr/net/http/hpack.h>
+
+#define BENCH_ITERATIONS 1024
+
+static const char * const bench_strings[] = {
+	"www.example.com",
+	"/api/v1/sensors/temperature?format=json",
+	"Mozilla/5.0 (X11; Linux x86_64; rv:128.0) Gecko/20100101 Firefox/128.0",
+	"text/html,application/xhtml+xml,application/xml;q=0.9,*/*;q=0.8",
+	"gzip, deflate, br",
+	"en-US,en;q=0.5",
+	"no-cache",
+	"session=8f3a9c1e2b7d4f60; theme=dark",
+};
+
+static const struct {
+	const char *name;
+	const char *value;
+} bench_response[] = {
+	{ ":status", "200" },
+	{ "content-type", "application/json" },
+	{ "content-encoding", "gzip" },
+	{ "cache-control", "no-store, max-age=0" },
+	{ "server", "Zephyr" },
+	{ "access-control-allow-origin", "*" },
+	{ "x-content-type-options", "nosniff" },
+	{ "strict-transport-security", "max-age=31536000; includeSubDomains" },
+	{ "content-length", "1234" },
+};
+
+static uint8_t bench_encoded[ARRAY_SIZE(bench_strings)][128];
+static int bench_encoded_len[ARRAY_SIZE(bench_strings)];
+static uint8_t bench_buf[512];
+
+static struct http_hpack_header_buf bench_header;
+static struct http_hpack_encoder bench_encoder;
+
+static void *bench_setup(void)
+{
+	for (int i = 0; i < ARRAY_SIZE(bench_strings); i++) {
+		bench_encoded_len[i] = http_hpack_huffman_encode(bench_strings[i],
+								 strlen(bench_strings[i]),
+								 bench_encoded[i],
+								 sizeof(bench_encoded[i]));
+		zassert_true(bench_encoded_len[i] > 0, "Cannot encode string %d", i);
+	}
+
+	return NULL;
+}
+
+static void bench_report(const char *name, uint32_t ops, uint32_t cycles)
+{
+	uint64_t ns = k_cyc_to_ns_floor64(cycles);
+
+	TC_PRINT("%s: %u operations in %" PRIu64 " us, %" PRIu64 " ns per operation\n",
+		 name, ops, ns / NSEC_PER_USEC, ns / ops);
+}
+
+ZTEST(http_hpack_bench, test_huffman_decode)
+{
+	uint32_t start, cycles;
+	size_t bytes = 0;
+
+	start = k_cycle_get_32();
+
+	for (int n = 0; n < BENCH_ITERATIONS; n++) {
+		int i = n % ARRAY_SIZE(bench_strings);
+		int ret;
+
+		ret = http_hpack_huffman_decode(bench_encoded[i], bench_encoded_len[i],
+						bench_buf, sizeof(bench_buf));
+		zassert_equal(ret, strlen(bench_strings[i]), "Wrong decoded length");
+		bytes += ret;
+	}
+
+	cycles = k_cycle_get_32() - start;
+	bench_report("Huffman decode", BENCH_ITERATIONS, cycles);
+	TC_PRINT("%zu bytes decoded\n", bytes);
+}
+
+ZTEST(http_hpack_bench, test_huffman_encode)
+{
+	uint32_t start, cycles;
+
+	start = k_cycle_get_32();
+
+	for (int n = 0; n < BENCH_ITERATIONS; n++) {
+		int i = n % ARRAY_SIZE(bench_strings);
+		int ret;
+
+		ret = http_hpack_huffman_encode(bench_strings[i], strlen(bench_strings[i]),
+						bench_buf, sizeof(bench_buf));
+		zassert_equal(ret, bench_encoded_len[i], "Wrong encoded length");
+	}
+
+	cycles = k_cycle_get_32() - start;
+	bench_report("Huffman encode", BENCH_ITERATIONS, cycles);
+}
+
+static int bench_encode_response(bool dynamic)
+{
+	int len = 0;
+
+	for (int i = 0; i < ARRAY_SIZE(bench_response); i++) {
+		int ret;
+
+		bench_header.name = bench_response[i].name;
+		bench_header.name_len = strlen(bench_response[i].name);
+		bench_header.value = bench_response[i].value;
+		bench_header.value_len = strlen(bench_response[i].value);
+
+		if (dynamic) {
+			ret = http_hpack_encoder_encode_header(&bench_encoder, bench_buf + len,
+							       sizeof(bench_buf) - len,
+							       &bench_header);
+		} else {
+			ret = http_hpack_encode_header(bench_buf + len, sizeof(bench_buf) - len,
+						       &bench_header);
+		}
+
+		zassert_true(ret > 0, "Cannot encode header %d (%d)", i, ret);
+		len += ret;
+	}
+
+	return len;
+}
+
+static void bench_header_blocks(const char *name, bool dynamic)
+{
+	uint32_t start, cycles;
+	size_t first, bytes = 0;
+
+	http_hpack_encoder_init(&bench_encoder);
+
+	start = k_cycle_get_32();
+
+	first = bench_encode_response(dynamic);
+	bytes += first;
+
+	for (int n = 1; n < BENCH_ITERATIONS; n++) {
+		bytes += bench_encode_response(dynamic);
+	}
+
+	cycles = k_cycle_get_32() - start;
+	bench_report(name, BENCH_ITERATIONS, cycles);
+	TC_PRINT("First header block %zu bytes, %zu bytes on average\n", first,
+		 bytes / BENCH_ITERATIONS);
+}
+
+ZTEST(http_hpack_bench, test_header_block_static)
+{
+	bench_header_blocks("Header block, static table", false);
+}
+
+ZTEST(http_hpack_bench, test_header_block_dynamic)
+{
+	bench_header_blocks("Header block, dynamic table", true);
+}
+
+ZTEST_SUITE(http_hpack_bench, NULL, bench_setup, NULL, NULL, NULL);
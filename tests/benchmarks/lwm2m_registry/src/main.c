@@ -0,0 +1,188 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Measure the throughput of the LwM2M registry lookups with a device exposing
+ * a large number of object instances, as done for every resource read, write
+ * and notification. Run the linear variant, where all the instances share a
+ * single hash bucket, to compare against a plain list walk.
+ */
+
+#include <inttypes.h>
+
+#include <zephyr/ztest.h>
+#include <zephyr/net/lwm2m.h>
+
+#include "lwm2m_engine.h"
+#include "lwm2m_rw_senml_cbor.h"
+
+#define BENCH_OBJ_ID        32769
+#define BENCH_INST_COUNT    128
+#define BENCH_RES_COUNT     4
+#define BENCH_ITERATIONS    4096
+#define BENCH_COMPOSITE_LEN 8
+
+static struct lwm2m_engine_obj bench_obj;
+static struct lwm2m_engine_obj_field bench_fields[BENCH_RES_COUNT] = {
+	OBJ_FIELD_DATA(0, RW, FLOAT),
+	OBJ_FIELD_DATA(1, RW, FLOAT),
+	OBJ_FIELD_DATA(2, RW, FLOAT),
+	OBJ_FIELD_DATA(3, RW, FLOAT),
+};
+
+static struct lwm2m_engine_obj_inst bench_inst[BENCH_INST_COUNT];
+static struct lwm2m_engine_res bench_res[BENCH_INST_COUNT][BENCH_RES_COUNT];
+static struct lwm2m_engine_res_inst bench_res_inst[BENCH_INST_COUNT][BENCH_RES_COUNT];
+static double bench_value[BENCH_INST_COUNT][BENCH_RES_COUNT];
+
+static struct lwm2m_ctx bench_ctx;
+static struct lwm2m_message bench_msg;
+
+static struct lwm2m_engine_obj_inst *bench_obj_create(uint16_t obj_inst_id)
+{
+	int i = 0, j = 0;
+
+	if (obj_inst_id >= BENCH_INST_COUNT) {
+		return NULL;
+	}
+
+	init_res_instance(bench_res_inst[obj_inst_id], BENCH_RES_COUNT);
+
+	for (int res_id = 0; res_id < BENCH_RES_COUNT; res_id++) {
+		INIT_OBJ_RES_DATA(res_id, bench_res[obj_inst_id], i, bench_res_inst[obj_inst_id],
+				  j, &bench_value[obj_inst_id][res_id], sizeof(double));
+	}
+
+	bench_inst[obj_inst_id].resources = bench_res[obj_inst_id];
+	bench_inst[obj_inst_id].resource_count = i;
+
+	return &bench_inst[obj_inst_id];
+}
+
+static void *bench_setup(void)
+{
+	struct lwm2m_engine_obj_inst *obj_inst;
+
+	bench_obj.obj_id = BENCH_OBJ_ID;
+	bench_obj.version_major = 1;
+	bench_obj.version_minor = 0;
+	bench_obj.fields = bench_fields;
+	bench_obj.field_count = ARRAY_SIZE(bench_fields);
+	bench_obj.max_instance_count = BENCH_INST_COUNT;
+	bench_obj.create_cb = bench_obj_create;
+
+	lwm2m_register_obj(&bench_obj);
+
+	for (int i = 0; i < BENCH_INST_COUNT; i++) {
+		zassert_ok(lwm2m_create_obj_inst(BENCH_OBJ_ID, i, &obj_inst),
+			   "Cannot create instance %d", i);
+	}
+
+	return NULL;
+}
+
+static void bench_report(const char *name, uint32_t ops, uint32_t cycles)
+{
+	uint64_t ns = k_cyc_to_ns_floor64(cycles);
+
+	TC_PRINT("%s: %u operations in %" PRIu64 " us, %" PRIu64 " ns per operation\n",
+		 name, ops, ns / NSEC_PER_USEC, ns / ops);
+}
+
+ZTEST(lwm2m_registry_bench, test_instance_lookup)
+{
+	uint32_t start, cycles;
+
+	start = k_cycle_get_32();
+
+	for (int n = 0; n < BENCH_ITERATIONS; n++) {
+		int id = n % BENCH_INST_COUNT;
+
+		zassert_equal_ptr(get_engine_obj_inst(BENCH_OBJ_ID, id), &bench_inst[id]);
+	}
+
+	cycles = k_cycle_get_32() - start;
+	bench_report("Instance lookup", BENCH_ITERATIONS, cycles);
+}
+
+ZTEST(lwm2m_registry_bench, test_instance_iteration)
+{
+	struct lwm2m_engine_obj_inst *obj_inst;
+	uint32_t start, cycles;
+	int count = 0;
+
+	start = k_cycle_get_32();
+
+	for (int n = 0; n < BENCH_ITERATIONS / BENCH_INST_COUNT; n++) {
+		obj_inst = next_engine_obj_inst(BENCH_OBJ_ID, -1);
+
+		while (obj_inst) {
+			count++;
+			obj_inst = next_engine_obj_inst(BENCH_OBJ_ID, obj_inst->obj_inst_id);
+		}
+	}
+
+	cycles = k_cycle_get_32() - start;
+	zassert_equal(count, BENCH_ITERATIONS, "Wrong number of instances iterated");
+	bench_report("Instance iteration", count, cycles);
+}
+
+/* Setting a resource also looks for the observers to notify */
+ZTEST(lwm2m_registry_bench, test_resource_write)
+{
+	uint32_t start, cycles;
+
+	start = k_cycle_get_32();
+
+	for (int n = 0; n < BENCH_ITERATIONS; n++) {
+		int id = n % BENCH_INST_COUNT;
+
+		zassert_ok(lwm2m_set_f64(&LWM2M_OBJ(BENCH_OBJ_ID, id, BENCH_RES_COUNT - 1),
+					 (double)n));
+	}
+
+	cycles = k_cycle_get_32() - start;
+	bench_report("Resource write", BENCH_ITERATIONS, cycles);
+}
+
+ZTEST(lwm2m_registry_bench, test_composite_read)
+{
+	struct lwm2m_obj_path_list path_buf[BENCH_COMPOSITE_LEN];
+	sys_slist_t path_list;
+	sys_slist_t free_list;
+	uint32_t start, cycles;
+
+	/* Read the last instances registered, the worst case of a list walk */
+	lwm2m_engine_path_list_init(&path_list, &free_list, path_buf, ARRAY_SIZE(path_buf));
+
+	for (int i = 0; i < BENCH_COMPOSITE_LEN; i++) {
+		struct lwm2m_obj_path path = LWM2M_OBJ(BENCH_OBJ_ID,
+						       BENCH_INST_COUNT - BENCH_COMPOSITE_LEN + i,
+						       0);
+
+		zassert_ok(lwm2m_engine_add_path_to_list(&path_list, &free_list, &path));
+	}
+
+	start = k_cycle_get_32();
+
+	for (int n = 0; n < BENCH_ITERATIONS / BENCH_COMPOSITE_LEN; n++) {
+		memset(&bench_msg, 0, sizeof(bench_msg));
+		bench_msg.ctx = &bench_ctx;
+		bench_msg.out.writer = &senml_cbor_writer;
+		bench_msg.out.out_cpkt = &bench_msg.cpkt;
+		bench_msg.cpkt.data = bench_msg.msg_data;
+		bench_msg.cpkt.max_len = sizeof(bench_msg.msg_data);
+
+		zassert_ok(do_composite_read_op_for_parsed_list(&bench_msg,
+								LWM2M_FORMAT_APP_SENML_CBOR,
+								&path_list));
+	}
+
+	cycles = k_cycle_get_32() - start;
+	bench_report("Composite read", BENCH_ITERATIONS / BENCH_COMPOSITE_LEN, cycles);
+}
+
+ZTEST_SUITE(lwm2m_registry_bench, NULL, bench_setup, NULL, NULL, NULL);
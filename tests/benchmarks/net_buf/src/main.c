@@ -0,0 +1,97 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Measure the cost of allocating and freeing network buffers, one at a time
+ * and as fragment chains like the ones making up a large UDP datagram. Run
+ * the pool_cache variant to compare against the per-CPU buffer caches.
+ */
+
+#include <inttypes.h>
+
+#include <zephyr/ztest.h>
+#include <zephyr/net_buf.h>
+
+#define BENCH_BUF_COUNT  32
+#define BENCH_BUF_SIZE   128
+#define BENCH_CHAIN_LEN  8
+#define BENCH_ITERATIONS 4096
+
+NET_BUF_POOL_FIXED_DEFINE(bench_pool, BENCH_BUF_COUNT, BENCH_BUF_SIZE, 0, NULL);
+
+static void bench_report(const char *name, uint32_t ops, uint32_t cycles)
+{
+	uint64_t ns = k_cyc_to_ns_floor64(cycles);
+
+	TC_PRINT("%s: %u operations in %" PRIu64 " us, %" PRIu64 " ns per operation\n",
+		 name, ops, ns / NSEC_PER_USEC, ns / ops);
+}
+
+ZTEST(net_buf_bench, test_alloc_free)
+{
+	uint32_t start, cycles;
+
+	start = k_cycle_get_32();
+
+	for (int n = 0; n < BENCH_ITERATIONS; n++) {
+		struct net_buf *buf = net_buf_alloc(&bench_pool, K_NO_WAIT);
+
+		zassert_not_null(buf, "Cannot allocate buffer");
+		net_buf_unref(buf);
+	}
+
+	cycles = k_cycle_get_32() - start;
+	bench_report("Alloc and free", BENCH_ITERATIONS, cycles);
+}
+
+ZTEST(net_buf_bench, test_chain)
+{
+	uint32_t start, cycles;
+
+	start = k_cycle_get_32();
+
+	for (int n = 0; n < BENCH_ITERATIONS / BENCH_CHAIN_LEN; n++) {
+		struct net_buf *head = NULL;
+
+		for (int i = 0; i < BENCH_CHAIN_LEN; i++) {
+			struct net_buf *buf = net_buf_alloc(&bench_pool, K_NO_WAIT);
+
+			zassert_not_null(buf, "Cannot allocate buffer");
+			head = head ? net_buf_frag_add(head, buf) : buf;
+		}
+
+		net_buf_unref(head);
+	}
+
+	cycles = k_cycle_get_32() - start;
+	bench_report("Chain of single allocations", BENCH_ITERATIONS, cycles);
+}
+
+ZTEST(net_buf_bench, test_chain_bulk)
+{
+	uint32_t start, cycles;
+
+	start = k_cycle_get_32();
+
+	for (int n = 0; n < BENCH_ITERATIONS / BENCH_CHAIN_LEN; n++) {
+		struct net_buf *head = net_buf_alloc_bulk(&bench_pool, BENCH_BUF_SIZE,
+							  BENCH_CHAIN_LEN, K_NO_WAIT);
+
+		zassert_not_null(head, "Cannot allocate chain");
+		net_buf_unref(head);
+	}
+
+	cycles = k_cycle_get_32() - start;
+	bench_report("Bulk chain allocation", BENCH_ITERATIONS, cycles);
+
+#if defined(CONFIG_NET_BUF_POOL_CACHE)
+	TC_PRINT("Cache hits %ld, misses %ld\n", atomic_get(&bench_pool.cache_hits),
+		 atomic_get(&bench_pool.cache_misses));
+#endif
+	zassert_equal(atomic_get(&bench_pool.avail_count), BENCH_BUF_COUNT, "Buffers leaked");
+}
+
+ZTEST_SUITE(net_buf_bench, NULL, NULL, NULL, NULL, NULL);
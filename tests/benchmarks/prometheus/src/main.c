@@ -0,0 +1,197 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Measure the latency of a scrape of a collector holding a typical set of
+ * device metrics, formatted from scratch and with the exposition cache, where
+ * only a few metrics change between two scrapes.
+ */
+
+#include <inttypes.h>
+
+#include <zephyr/ztest.h>
+#include <zephyr/net/prometheus/collector.h>
+#include <zephyr/net/prometheus/counter.h>
+#include <zephyr/net/prometheus/formatter.h>
+#include <zephyr/net/prometheus/gauge.h>
+#include <zephyr/net/prometheus/histogram.h>
+
+#define BENCH_COUNTER_COUNT   64
+#define BENCH_GAUGE_COUNT     32
+#define BENCH_HISTOGRAM_COUNT 8
+#define BENCH_BUCKET_COUNT    4
+#define BENCH_METRIC_COUNT    (BENCH_COUNTER_COUNT + BENCH_GAUGE_COUNT + BENCH_HISTOGRAM_COUNT)
+#define BENCH_NAME_LEN        32
+#define BENCH_BUFFER_SIZE     16384
+#define BENCH_SCRAPES         256
+/* Metrics updated between two scrapes */
+#define BENCH_UPDATES         8
+
+PROMETHEUS_COLLECTOR_DEFINE(bench_collector);
+
+PROMETHEUS_EXPOSITION_CACHE_DEFINE(bench_text_cache, bench_collector, PROMETHEUS_FORMAT_TEXT,
+				   BENCH_METRIC_COUNT, BENCH_BUFFER_SIZE);
+PROMETHEUS_EXPOSITION_CACHE_DEFINE(bench_openmetrics_cache, bench_collector,
+				   PROMETHEUS_FORMAT_OPENMETRICS, BENCH_METRIC_COUNT,
+				   BENCH_BUFFER_SIZE);
+
+static struct prometheus_counter bench_counters[BENCH_COUNTER_COUNT];
+static struct prometheus_gauge bench_gauges[BENCH_GAUGE_COUNT];
+static struct prometheus_histogram bench_histograms[BENCH_HISTOGRAM_COUNT];
+static struct prometheus_histogram_bucket bench_buckets[BENCH_HISTOGRAM_COUNT][BENCH_BUCKET_COUNT];
+static char bench_names[BENCH_METRIC_COUNT][BENCH_NAME_LEN];
+static char bench_buffer[BENCH_BUFFER_SIZE];
+
+static struct prometheus_metric *bench_metric_init(struct prometheus_metric *metric,
+						   enum prometheus_metric_type type,
+						   const char *prefix, int idx)
+{
+	static int count;
+	char *name = bench_names[count++];
+
+	snprintk(name, BENCH_NAME_LEN, "%s_%d", prefix, idx);
+
+	metric->type = type;
+	metric->name = name;
+	metric->description = "Benchmark metric";
+	metric->labels[0].key = "interface";
+	metric->labels[0].value = "eth0";
+	metric->num_labels = 1;
+
+	return metric;
+}
+
+static void *bench_setup(void)
+{
+	struct prometheus_metric *metric;
+
+	for (int i = 0; i < BENCH_COUNTER_COUNT; i++) {
+		metric = bench_metric_init(&bench_counters[i].base, PROMETHEUS_COUNTER,
+					   "bench_packets", i);
+		zassert_ok(prometheus_collector_register_metric(&bench_collector, metric));
+	}
+
+	for (int i = 0; i < BENCH_GAUGE_COUNT; i++) {
+		metric = bench_metric_init(&bench_gauges[i].base, PROMETHEUS_GAUGE,
+					   "bench_level", i);
+		zassert_ok(prometheus_collector_register_metric(&bench_collector, metric));
+	}
+
+	for (int i = 0; i < BENCH_HISTOGRAM_COUNT; i++) {
+		for (int j = 0; j < BENCH_BUCKET_COUNT; j++) {
+			bench_buckets[i][j].upper_bound = 0.001 * (1 << (3 * j));
+		}
+
+		bench_histograms[i].buckets = bench_buckets[i];
+		bench_histograms[i].num_buckets = BENCH_BUCKET_COUNT;
+
+		metric = bench_metric_init(&bench_histograms[i].base, PROMETHEUS_HISTOGRAM,
+					   "bench_latency", i);
+		zassert_ok(prometheus_collector_register_metric(&bench_collector, metric));
+	}
+
+	return NULL;
+}
+
+static void bench_update(int n)
+{
+	for (int i = 0; i < BENCH_UPDATES; i++) {
+		int idx = (n * BENCH_UPDATES + i) % BENCH_COUNTER_COUNT;
+
+		(void)prometheus_counter_inc(&bench_counters[idx]);
+	}
+
+	(void)prometheus_gauge_set(&bench_gauges[n % BENCH_GAUGE_COUNT], n / 8.0);
+	(void)prometheus_histogram_observe(&bench_histograms[n % BENCH_HISTOGRAM_COUNT],
+					   n / 1000.0);
+}
+
+static void bench_report(const char *name, uint32_t ops, uint32_t cycles)
+{
+	uint64_t ns = k_cyc_to_ns_floor64(cycles);
+
+	TC_PRINT("%s: %u operations in %" PRIu64 " us, %" PRIu64 " ns per operation\n",
+		 name, ops, ns / NSEC_PER_USEC, ns / ops);
+}
+
+ZTEST(prometheus_bench, test_scrape)
+{
+	uint32_t start, cycles;
+
+	start = k_cycle_get_32();
+
+	for (int n = 0; n < BENCH_SCRAPES; n++) {
+		bench_update(n);
+
+		bench_buffer[0] = '\0';
+		zassert_ok(prometheus_format_exposition(&bench_collector, bench_buffer,
+							sizeof(bench_buffer)));
+	}
+
+	cycles = k_cycle_get_32() - start;
+	bench_report("Scrape", BENCH_SCRAPES, cycles);
+	TC_PRINT("Exposition of %zu bytes\n", strlen(bench_buffer));
+}
+
+ZTEST(prometheus_bench, test_scrape_cached)
+{
+	uint32_t start, cycles;
+
+	prometheus_exposition_cache_reset(&bench_text_cache);
+
+	start = k_cycle_get_32();
+
+	for (int n = 0; n < BENCH_SCRAPES; n++) {
+		bench_update(n);
+
+		zassert_ok(prometheus_format_exposition_cached(&bench_text_cache, bench_buffer,
+							       sizeof(bench_buffer)));
+	}
+
+	cycles = k_cycle_get_32() - start;
+	bench_report("Cached scrape", BENCH_SCRAPES, cycles);
+}
+
+ZTEST(prometheus_bench, test_scrape_cached_unchanged)
+{
+	uint32_t start, cycles;
+
+	zassert_ok(prometheus_format_exposition_cached(&bench_text_cache, bench_buffer,
+						       sizeof(bench_buffer)));
+
+	start = k_cycle_get_32();
+
+	for (int n = 0; n < BENCH_SCRAPES; n++) {
+		zassert_ok(prometheus_format_exposition_cached(&bench_text_cache, bench_buffer,
+							       sizeof(bench_buffer)));
+	}
+
+	cycles = k_cycle_get_32() - start;
+	bench_report("Cached scrape, no change", BENCH_SCRAPES, cycles);
+}
+
+ZTEST(prometheus_bench, test_scrape_openmetrics)
+{
+	uint32_t start, cycles;
+
+	prometheus_exposition_cache_reset(&bench_openmetrics_cache);
+
+	start = k_cycle_get_32();
+
+	for (int n = 0; n < BENCH_SCRAPES; n++) {
+		bench_update(n);
+
+		zassert_ok(prometheus_format_exposition_cached(&bench_openmetrics_cache,
+							       bench_buffer,
+							       sizeof(bench_buffer)));
+	}
+
+	cycles = k_cycle_get_32() - start;
+	bench_report("Cached OpenMetrics scrape", BENCH_SCRAPES, cycles);
+	TC_PRINT("Exposition of %zu bytes\n", strlen(bench_buffer));
+}
+
+ZTEST_SUITE(prometheus_bench, NULL, bench_setup, NULL, NULL, NULL);
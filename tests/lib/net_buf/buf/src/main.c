@@ -71,6 +71,7 @@ static void var_destroy(struct net_buf *buf);
 NET_BUF_POOL_HEAP_DEFINE(bufs_pool, 10, USER_DATA_HEAP, buf_destroy);
 NET_BUF_POOL_FIXED_DEFINE(fixed_pool, 10, FIXED_BUFFER_SIZE, USER_DATA_FIXED, fixed_destroy);
 NET_BUF_POOL_VAR_DEFINE(var_pool, 10, 1024, USER_DATA_VAR, var_destroy);
+NET_BUF_POOL_FIXED_DEFINE(bulk_pool, 8, FIXED_BUFFER_SIZE, USER_DATA_FIXED, NULL);
 
 static void buf_destroy(struct net_buf *buf)
 {
@@ -980,5 +981,83 @@ ZTEST(net_buf_tests, test_net_buf_fixed_append)
 	net_buf_unref(buf);
 }
 
+ZTEST(net_buf_tests, test_net_buf_alloc_bulk)
+{
+	struct net_buf *head, *frag;
+	int count = 0;
+
+	head = net_buf_alloc_bulk(&bulk_pool, 20, 5, K_NO_WAIT);
+	zassert_not_null(head, "Failed to get buffers");
+
+	for (frag = head; frag; frag = frag->frags) {
+		zassert_equal(frag->ref, 1, "Invalid buffer reference count");
+		zassert_equal(frag->size, FIXED_BUFFER_SIZE, "Invalid fixed buffer size");
+		count++;
+	}
+
+	zassert_equal(count, 5, "Invalid number of buffers in the chain");
+
+	/* Not enough buffers left, the ones already taken must be given back */
+	zassert_is_null(net_buf_alloc_bulk(&bulk_pool, 20, 5, K_NO_WAIT),
+			"Unexpected partial chain");
+
+	net_buf_unref(head);
+
+	head = net_buf_alloc_bulk(&bulk_pool, 20, bulk_pool.buf_count, K_NO_WAIT);
+	zassert_not_null(head, "Buffers missing from the pool");
+
+	net_buf_unref(head);
+}
+
+static struct net_buf *timer_buf;
+
+static void free_timer_expiry(struct k_timer *timer)
+{
+	net_buf_unref(timer_buf);
+}
+
+static K_TIMER_DEFINE(free_timer, free_timer_expiry, NULL);
+
+ZTEST(net_buf_tests, test_net_buf_free_to_waiter)
+{
+	struct net_buf *head, *buf;
+
+	head = net_buf_alloc_bulk(&bulk_pool, 0, bulk_pool.buf_count, K_NO_WAIT);
+	zassert_not_null(head, "Failed to get buffers");
+
+	/* A buffer freed while a thread waits for one must not stay cached */
+	timer_buf = head->frags;
+	head->frags = timer_buf->frags;
+	timer_buf->frags = NULL;
+	k_timer_start(&free_timer, K_MSEC(10), K_NO_WAIT);
+
+	buf = net_buf_alloc(&bulk_pool, TEST_TIMEOUT);
+	zassert_not_null(buf, "Freed buffer not handed to the waiting thread");
+
+	net_buf_unref(buf);
+	net_buf_unref(head);
+}
+
+#if defined(CONFIG_NET_BUF_POOL_CACHE) && defined(CONFIG_NET_BUF_POOL_USAGE)
+ZTEST(net_buf_tests, test_net_buf_pool_cache)
+{
+	atomic_val_t hits;
+	struct net_buf *buf;
+
+	buf = net_buf_alloc(&bulk_pool, K_NO_WAIT);
+	zassert_not_null(buf, "Failed to get buffer");
+	net_buf_unref(buf);
+
+	hits = atomic_get(&bulk_pool.cache_hits);
+
+	buf = net_buf_alloc(&bulk_pool, K_NO_WAIT);
+	zassert_not_null(buf, "Failed to get buffer");
+	zassert_equal(atomic_get(&bulk_pool.cache_hits), hits + 1, "Freed buffer not cached");
+	zassert_equal(atomic_get(&bulk_pool.avail_count), bulk_pool.buf_count - 1,
+		      "Invalid number of available buffers");
+
+	net_buf_unref(buf);
+}
+#endif
 
 ZTEST_SUITE(net_buf_tests, NULL, NULL, NULL, NULL, NULL);
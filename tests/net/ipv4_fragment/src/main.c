@@ -20,6 +20,8 @@ LOG_MODULE_REGISTER(net_ipv4_test, CONFIG_NET_IPV4_LOG_LEVEL);
 #include <zephyr/net_buf.h>
 #include <zephyr/net/net_ip.h>
 #include <zephyr/net/net_if.h>
+#include <zephyr/net/net_mgmt.h>
+#include <zephyr/net/net_stats.h>
 #include <zephyr/posix/fcntl.h>
 #include <zephyr/net/socket.h>
 #include <net_private.h>
@@ -30,6 +32,12 @@ LOG_MODULE_REGISTER(net_ipv4_test, CONFIG_NET_IPV4_LOG_LEVEL);
 /* Packet size for tests, excluding headers */
 #define IPV4_TEST_PACKET_SIZE 2048
 
+/* Largest multiple of the dummy data block fitting in a UDP datagram */
+#define IPV4_LARGE_PACKET_SIZE (255 * 256)
+
+/* Fragment payload length of a 1280 byte MTU link */
+#define IPV4_LARGE_FRAGMENT_SIZE ROUND_DOWN(1280 - NET_IPV4H_LEN, 8)
+
 /* Wait times for semaphores and buffers */
 #define WAIT_TIME K_MSEC(1100)
 #define ALLOC_TIMEOUT K_MSEC(500)
@@ -87,6 +95,20 @@ static const unsigned char ipv4_udp_frag[] = {
 	0xee, 0xff, 0x94, 0x12,
 };
 
+/* IPv4 UDP packet header of the fragments built by recv_udp_fragment() */
+static const unsigned char ipv4_udp_in[] = {
+	/* IPv4 header */
+	0x45, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00,
+	0x80, 0x11, 0x00, 0x00,
+	0xc0, 0xa8, 0x08, 0x02,
+	0xc0, 0xa8, 0x08, 0x01,
+
+	/* UDP header, without checksum */
+	0x63, 0x04, 0x11, 0x00,
+	0x00, 0x00, 0x00, 0x00,
+};
+
 /* IPv4 ICMP fragment assembly time exceeded packet (in response to ipv4_udp_frag) */
 static const unsigned char ipv4_icmp_reassembly_time[] = {
 	/* IPv4 Header */
@@ -361,7 +383,7 @@ static enum net_verdict udp_data_received(struct net_conn *conn, struct net_pkt
 	const struct net_ipv4_hdr *hdr = NET_IPV4_HDR(pkt);
 	uint8_t tmp_buf[256];
 	uint8_t verify_buf[256];
-	uint16_t i;
+	uint32_t i;
 	uint16_t pkt_len;
 	uint16_t pkt_offset;
 	uint8_t pkt_flags;
@@ -732,19 +754,12 @@ ZTEST(net_ipv4_fragment, test_tcp)
 		      "Packet size mismatch");
 }
 
-/* Test inserting only 1 fragment and ensuring that it is removed after the timeout elapses */
-ZTEST(net_ipv4_fragment, test_fragment_timeout)
+/* Create a packet holding the single fragment and put it into the interface */
+static void recv_single_fragment(void)
 {
 	struct net_pkt *pkt;
 	int ret;
-	uint8_t packets;
-	int sem_count;
-
-	/* Setup test variables */
-	active_test = TEST_SINGLE_FRAGMENT;
-	test_started = true;
 
-	/* Create a packet for the test */
 	pkt = net_pkt_alloc_with_buffer(iface1, sizeof(ipv4_udp_frag), AF_INET,
 					IPPROTO_UDP, ALLOC_TIMEOUT);
 	zassert_not_null(pkt, "Packet creation failure");
@@ -763,12 +778,25 @@ ZTEST(net_ipv4_fragment, test_fragment_timeout)
 	NET_IPV4_HDR(pkt)->chksum = net_calc_chksum_ipv4(pkt);
 	net_pkt_set_overwrite(pkt, false);
 
-	pkt_recv_expected_size = sizeof(ipv4_icmp_reassembly_time);
-
 	/* Directly put the packet into the interface */
 	net_pkt_set_iface(pkt, iface1);
 	ret = net_recv_data(net_pkt_iface(pkt), pkt);
 	zassert_equal(ret, 0, "Cannot receive data (%d)", ret);
+}
+
+/* Test inserting only 1 fragment and ensuring that it is removed after the timeout elapses */
+ZTEST(net_ipv4_fragment, test_fragment_timeout)
+{
+	uint8_t packets;
+	int sem_count;
+
+	/* Setup test variables */
+	active_test = TEST_SINGLE_FRAGMENT;
+	test_started = true;
+
+	pkt_recv_expected_size = sizeof(ipv4_icmp_reassembly_time);
+
+	recv_single_fragment();
 
 	/* Check number of pending reassembly packets */
 	k_sleep(K_MSEC(10));
@@ -803,6 +831,194 @@ ZTEST(net_ipv4_fragment, test_fragment_timeout)
 		      "Packet size mismatch");
 }
 
+/* Test that a duplicated fragment drops the whole reassembly */
+ZTEST(net_ipv4_fragment, test_fragment_duplicate)
+{
+	uint8_t packets;
+
+	/* Setup test variables */
+	active_test = TEST_SINGLE_FRAGMENT;
+	test_started = true;
+
+	recv_single_fragment();
+	recv_single_fragment();
+
+	k_sleep(K_MSEC(10));
+	packets = 0;
+	net_ipv4_frag_foreach(reassembly_foreach_cb, &packets);
+	zassert_equal(packets, 0, "Expected reassembly to be dropped");
+
+	/* The reassembly is dropped silently, without an ICMP error */
+	k_sleep(K_MSEC(1100));
+	zassert_equal(k_sem_count_get(&wait_data), 0, "Expected no lower-layer frame");
+	zassert_equal(k_sem_count_get(&wait_received_data), 0,
+		      "Expected no complete upper-layer packets");
+}
+
+/* Create a fragment of an incoming UDP datagram holding data_len bytes of
+ * dummy data, and put it into the interface.
+ */
+static void recv_udp_fragment(uint16_t id, uint16_t offset, uint16_t len, bool more,
+			      uint16_t data_len)
+{
+	struct net_ipv4_hdr *hdr;
+	struct net_pkt *pkt;
+	uint16_t pos = offset;
+	int ret;
+
+	pkt = net_pkt_alloc_with_buffer(iface1, NET_IPV4H_LEN + len, AF_INET, IPPROTO_UDP,
+					ALLOC_TIMEOUT);
+	zassert_not_null(pkt, "Packet creation failure");
+
+	net_pkt_set_family(pkt, AF_INET);
+	net_pkt_set_ip_hdr_len(pkt, sizeof(struct net_ipv4_hdr));
+
+	ret = net_pkt_write(pkt, ipv4_udp_in, NET_IPV4H_LEN);
+	zassert_equal(ret, 0, "IPv4 header append failed");
+
+	if (offset == 0) {
+		uint8_t udp_hdr[NET_UDPH_LEN];
+
+		memcpy(udp_hdr, &ipv4_udp_in[NET_IPV4H_LEN], sizeof(udp_hdr));
+		sys_put_be16(NET_UDPH_LEN + data_len, &udp_hdr[4]);
+
+		ret = net_pkt_write(pkt, udp_hdr, sizeof(udp_hdr));
+		zassert_equal(ret, 0, "UDP header append failed");
+		pos += sizeof(udp_hdr);
+	}
+
+	/* The dummy data restarts at every block of test_tmp_buf */
+	while (pos < offset + len) {
+		uint16_t block_pos = (pos - NET_UDPH_LEN) % sizeof(test_tmp_buf);
+		uint16_t chunk = MIN(offset + len - pos, sizeof(test_tmp_buf) - block_pos);
+
+		ret = net_pkt_write(pkt, &test_tmp_buf[block_pos], chunk);
+		zassert_equal(ret, 0, "IPv4 data append failed");
+		pos += chunk;
+	}
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	hdr = NET_IPV4_HDR(pkt);
+	hdr->len = htons(NET_IPV4H_LEN + len);
+	sys_put_be16(id, hdr->id);
+	sys_put_be16((offset / 8) | (more ? NET_IPV4_MORE_FRAG_MASK : 0), hdr->offset);
+	hdr->chksum = net_calc_chksum_ipv4(pkt);
+
+	net_pkt_set_overwrite(pkt, false);
+
+	net_pkt_set_iface(pkt, iface1);
+	ret = net_recv_data(net_pkt_iface(pkt), pkt);
+	zassert_equal(ret, 0, "Cannot receive data (%d)", ret);
+}
+
+static uint8_t pending_reassemblies(void)
+{
+	uint8_t packets = 0;
+
+	k_sleep(K_MSEC(10));
+	net_ipv4_frag_foreach(reassembly_foreach_cb, &packets);
+
+	return packets;
+}
+
+static net_stats_t fragment_errors(void)
+{
+	struct net_stats_ip_errors errors;
+	int ret;
+
+	ret = net_mgmt(NET_REQUEST_STATS_GET_IP_ERRORS, iface1, &errors, sizeof(errors));
+	zassert_equal(ret, 0, "Cannot get IP error statistics (%d)", ret);
+
+	return errors.fragerr;
+}
+
+/* Test reassembling a datagram of almost 64 KiB received over a 1280 byte MTU
+ * link, with its fragments delivered out of order
+ */
+ZTEST(net_ipv4_fragment, test_fragment_out_of_order)
+{
+	uint16_t payload_len = NET_UDPH_LEN + IPV4_LARGE_PACKET_SIZE;
+	uint16_t count = DIV_ROUND_UP(payload_len, IPV4_LARGE_FRAGMENT_SIZE);
+	uint16_t id = 0x5678;
+
+	zassert_true(count <= CONFIG_NET_IPV4_FRAGMENT_MAX_PKT, "Too many fragments");
+
+	pkt_id = htons(id);
+
+	/* Deliver the fragments in an order where the last one is in the middle */
+	for (uint16_t i = 0; i < count; i++) {
+		uint16_t n = ((i + 1) * 19) % count;
+		uint16_t offset = n * IPV4_LARGE_FRAGMENT_SIZE;
+
+		zassert_equal(k_sem_count_get(&wait_received_data), 0,
+			      "Packet received before its last fragment");
+
+		recv_udp_fragment(id, offset, MIN(payload_len - offset, IPV4_LARGE_FRAGMENT_SIZE),
+				  n < count - 1, IPV4_LARGE_PACKET_SIZE);
+	}
+
+	zassert_equal(k_sem_take(&wait_received_data, WAIT_TIME), 0,
+		      "Timeout waiting for packet to be received");
+	zassert_equal(pending_reassemblies(), 0, "Expected reassembly to be completed");
+	zassert_equal(upper_layer_packet_count, 1, "Expected 1 packet at upper layers");
+	zassert_equal(upper_layer_total_size, NET_IPV4H_LEN + payload_len,
+		      "Expected data received size mismatch at upper layers");
+}
+
+/* Test that a fragment overlapping a stored one drops the whole reassembly */
+ZTEST(net_ipv4_fragment, test_fragment_overlap)
+{
+	net_stats_t errors = fragment_errors();
+	uint16_t id = 0x6789;
+
+	recv_udp_fragment(id, 0, 16, true, 64);
+	zassert_equal(pending_reassemblies(), 1, "Expected fragment to be present in buffer");
+
+	recv_udp_fragment(id, 8, 16, true, 64);
+	zassert_equal(pending_reassemblies(), 0, "Expected reassembly to be dropped");
+	zassert_equal(fragment_errors(), errors + 1, "Expected one fragment error");
+
+	/* The fragment that would have completed the packet starts a new one */
+	recv_udp_fragment(id, 16, 56, false, 64);
+	zassert_equal(k_sem_take(&wait_received_data, WAIT_TIME), -EAGAIN,
+		      "Expected no complete upper-layer packets");
+	zassert_equal(pending_reassemblies(), 0, "Expected reassembly to time out");
+}
+
+/* Test that the fragments exceeding the reassembly memory budget are dropped,
+ * leaving the other reassemblies alone
+ */
+ZTEST(net_ipv4_fragment, test_fragment_budget)
+{
+	uint16_t half = ROUND_DOWN(NET_IPV4_FRAGMENT_MAX_BYTES / 2, 8);
+	net_stats_t errors = fragment_errors();
+
+	zassert_true(CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT >= 2, "Expected two reassemblies");
+
+	/* Fill the budget with two reassemblies */
+	recv_udp_fragment(0x789a, 0, half, true, IPV4_LARGE_PACKET_SIZE);
+	recv_udp_fragment(0x89ab, 0, NET_IPV4_FRAGMENT_MAX_BYTES - half, true,
+			  IPV4_LARGE_PACKET_SIZE);
+	zassert_equal(pending_reassemblies(), 2, "Expected both fragments to be stored");
+	zassert_equal(fragment_errors(), errors, "Expected no fragment error");
+
+	/* Any further data is over budget and drops its reassembly */
+	recv_udp_fragment(0x789a, half, 8, true, IPV4_LARGE_PACKET_SIZE);
+	zassert_equal(pending_reassemblies(), 1, "Expected one reassembly to be dropped");
+	zassert_equal(fragment_errors(), errors + 1, "Expected one fragment error");
+
+	/* The budget released by the dropped reassembly can be used again */
+	recv_udp_fragment(0x9abc, 0, 8, true, 64);
+	zassert_equal(pending_reassemblies(), 2, "Expected the fragment to be stored");
+	zassert_equal(fragment_errors(), errors + 1, "Expected no new fragment error");
+
+	/* Let the pending reassemblies time out */
+	k_sleep(K_MSEC(1100));
+	zassert_equal(pending_reassemblies(), 0, "Expected reassemblies to time out");
+}
+
 /* Test inserting large packet with do not fragment bit set */
 ZTEST(net_ipv4_fragment, test_do_not_fragment)
 {
@@ -25,6 +25,8 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_IPV6_LOG_LEVEL);
 #include <zephyr/net_buf.h>
 #include <zephyr/net/net_ip.h>
 #include <zephyr/net/net_if.h>
+#include <zephyr/net/net_mgmt.h>
+#include <zephyr/net/net_stats.h>
 
 #define NET_LOG_ENABLED 1
 #include "net_private.h"
@@ -2394,4 +2396,219 @@ ZTEST(net_ipv6_fragment, test_recv_ipv6_fragment)
 	net_icmp_cleanup_ctx(&ctx);
 }
 
+/* Largest multiple of 256 bytes of counter data fitting in an Echo Reply */
+#define IPV6_LARGE_PAYLOAD_LEN (255 * 256)
+
+/* Fragment payload length of a 1280 byte MTU link */
+#define IPV6_LARGE_FRAGMENT_SIZE (1280 - NET_IPV6H_LEN - NET_IPV6_FRAGH_LEN)
+
+/* Checksum of the Echo Reply of ipv6_reass_frag1 carrying data_len bytes of
+ * counter data
+ */
+static uint16_t echo_reply_chksum(uint16_t data_len)
+{
+	const uint8_t *echo = &ipv6_reass_frag1[NET_IPV6H_LEN + NET_IPV6_FRAGH_LEN];
+	uint32_t sum = ECHO_REPLY_H_LEN + data_len + IPPROTO_ICMPV6;
+	uint32_t i;
+
+	for (i = 0; i < 2 * NET_IPV6_ADDR_SIZE; i += 2) {
+		sum += sys_get_be16(&ipv6_reass_frag1[offsetof(struct net_ipv6_hdr, src) + i]);
+	}
+
+	sum += sys_get_be16(&echo[0]) + sys_get_be16(&echo[4]) + sys_get_be16(&echo[6]);
+
+	for (i = 0; i < data_len; i += 2) {
+		sum += (i & 0xff) << 8;
+		if (i + 1 < data_len) {
+			sum += (i + 1) & 0xff;
+		}
+	}
+
+	while (sum > 0xffff) {
+		sum = (sum & 0xffff) + (sum >> 16);
+	}
+
+	return ~sum;
+}
+
+/* Handle a fragment of the Echo Reply of ipv6_reass_frag1, carrying data_len
+ * bytes of counter data.
+ */
+static void recv_ipv6_fragment(uint32_t id, uint16_t offset, uint16_t len, bool more,
+			       uint16_t data_len)
+{
+	uint8_t hdr[NET_IPV6H_LEN + NET_IPV6_FRAGH_LEN];
+	struct net_ipv6_hdr ipv6_hdr;
+	struct net_pkt_cursor backup;
+	struct net_pkt *pkt;
+	uint16_t pos = offset;
+	int ret;
+
+	memcpy(hdr, ipv6_reass_frag1, sizeof(hdr));
+	sys_put_be16(NET_IPV6_FRAGH_LEN + len, &hdr[offsetof(struct net_ipv6_hdr, len)]);
+	sys_put_be16(offset | (more ? 1 : 0), &hdr[NET_IPV6H_LEN + 2]);
+	sys_put_be32(id, &hdr[NET_IPV6H_LEN + 4]);
+
+	pkt = net_pkt_alloc_with_buffer(iface1, sizeof(hdr) + len, AF_UNSPEC, 0, ALLOC_TIMEOUT);
+	zassert_not_null(pkt, "packet");
+
+	net_pkt_set_family(pkt, AF_INET6);
+	net_pkt_set_ip_hdr_len(pkt, sizeof(struct net_ipv6_hdr));
+	net_pkt_cursor_init(pkt);
+
+	memcpy(&ipv6_hdr, hdr, sizeof(struct net_ipv6_hdr));
+
+	ret = net_pkt_write(pkt, hdr, sizeof(struct net_ipv6_hdr) + 1);
+	zassert_true(ret == 0, "IPv6 header append failed");
+
+	net_pkt_cursor_backup(pkt, &backup);
+
+	ret = net_pkt_write(pkt, hdr + sizeof(struct net_ipv6_hdr) + 1, NET_IPV6_FRAGH_LEN - 1);
+	zassert_true(ret == 0, "IPv6 fragment header append failed");
+
+	if (offset == 0) {
+		uint8_t echo_hdr[ECHO_REPLY_H_LEN];
+
+		memcpy(echo_hdr, &ipv6_reass_frag1[sizeof(hdr)], sizeof(echo_hdr));
+		sys_put_be16(echo_reply_chksum(data_len), &echo_hdr[2]);
+
+		ret = net_pkt_write(pkt, echo_hdr, sizeof(echo_hdr));
+		zassert_true(ret == 0, "Echo reply header append failed");
+		pos += sizeof(echo_hdr);
+	}
+
+	while (pos < offset + len) {
+		ret = net_pkt_write_u8(pkt, pos - ECHO_REPLY_H_LEN);
+		zassert_true(ret == 0, "IPv6 data append failed");
+		pos++;
+	}
+
+	net_pkt_set_ipv6_hdr_prev(pkt, offsetof(struct net_ipv6_hdr, nexthdr));
+	net_pkt_set_ipv6_fragment_start(pkt, sizeof(struct net_ipv6_hdr));
+	net_pkt_set_overwrite(pkt, true);
+
+	net_pkt_cursor_restore(pkt, &backup);
+
+	ret = net_ipv6_handle_fragment_hdr(pkt, &ipv6_hdr, NET_IPV6_NEXTHDR_FRAG);
+	zassert_true(ret == NET_OK, "IPv6 fragment handling failed");
+}
+
+static void reassembly_foreach_cb(struct net_ipv6_reassembly *reass, void *user_data)
+{
+	uint8_t *count = user_data;
+
+	(*count)++;
+}
+
+static uint8_t pending_reassemblies(void)
+{
+	uint8_t count = 0;
+
+	net_ipv6_frag_foreach(reassembly_foreach_cb, &count);
+
+	return count;
+}
+
+static net_stats_t fragment_errors(void)
+{
+	struct net_stats_ip_errors errors;
+	int ret;
+
+	ret = net_mgmt(NET_REQUEST_STATS_GET_IP_ERRORS, iface1, &errors, sizeof(errors));
+	zassert_equal(ret, 0, "Cannot get IP error statistics (%d)", ret);
+
+	return errors.fragerr;
+}
+
+/* Test reassembling a packet of almost 64 KiB received over a 1280 byte MTU
+ * link, with its fragments delivered out of order
+ */
+ZTEST(net_ipv6_fragment, test_recv_ipv6_fragment_out_of_order)
+{
+	uint16_t payload_len = ECHO_REPLY_H_LEN + IPV6_LARGE_PAYLOAD_LEN;
+	uint16_t count = DIV_ROUND_UP(payload_len, IPV6_LARGE_FRAGMENT_SIZE);
+	struct net_icmp_ctx ctx;
+	uint32_t id = 0x12345678;
+	int ret;
+
+	zassert_true(count <= CONFIG_NET_IPV6_FRAGMENT_MAX_PKT, "Too many fragments");
+
+	ret = net_icmp_init_ctx(&ctx, NET_ICMPV6_ECHO_REPLY,
+				0, handle_ipv6_echo_reply);
+	zassert_equal(ret, 0, "Cannot register %s handler (%d)",
+		      STRINGIFY(NET_ICMPV6_ECHO_REPLY), ret);
+
+	test_recv_payload_len = IPV6_LARGE_PAYLOAD_LEN;
+	k_sem_reset(&wait_data);
+
+	/* Deliver the fragments in an order where the last one is in the middle */
+	for (uint16_t i = 0; i < count; i++) {
+		uint16_t n = ((i + 1) * 19) % count;
+		uint16_t offset = n * IPV6_LARGE_FRAGMENT_SIZE;
+
+		zassert_equal(k_sem_count_get(&wait_data), 0,
+			      "Packet received before its last fragment");
+
+		recv_ipv6_fragment(id, offset, MIN(payload_len - offset, IPV6_LARGE_FRAGMENT_SIZE),
+				   n < count - 1, IPV6_LARGE_PAYLOAD_LEN);
+	}
+
+	if (k_sem_take(&wait_data, WAIT_TIME)) {
+		NET_DBG("Timeout while waiting interface data");
+		zassert_true(false, "Timeout");
+	}
+
+	zassert_equal(pending_reassemblies(), 0, "Expected reassembly to be completed");
+
+	test_recv_payload_len = 1300U;
+	net_icmp_cleanup_ctx(&ctx);
+}
+
+/* Test that a fragment overlapping a stored one drops the whole reassembly */
+ZTEST(net_ipv6_fragment, test_recv_ipv6_fragment_overlap)
+{
+	net_stats_t errors = fragment_errors();
+	uint32_t id = 0x23456789;
+
+	recv_ipv6_fragment(id, 0, 16, true, 64);
+	zassert_equal(pending_reassemblies(), 1, "Expected fragment to be stored");
+
+	recv_ipv6_fragment(id, 8, 16, true, 64);
+	zassert_equal(pending_reassemblies(), 0, "Expected reassembly to be dropped");
+	zassert_equal(fragment_errors(), errors + 1, "Expected one fragment error");
+}
+
+/* Test that the fragments exceeding the reassembly memory budget are dropped,
+ * leaving the other reassemblies alone
+ */
+ZTEST(net_ipv6_fragment, test_recv_ipv6_fragment_budget)
+{
+	uint16_t half = ROUND_DOWN(NET_IPV6_FRAGMENT_MAX_BYTES / 2, 8);
+	net_stats_t errors = fragment_errors();
+
+	zassert_true(CONFIG_NET_IPV6_FRAGMENT_MAX_COUNT >= 2, "Expected two reassemblies");
+
+	/* Fill the budget with two reassemblies. None of the fragments starts
+	 * its packet, so no Time Exceeded error is sent when they time out.
+	 */
+	recv_ipv6_fragment(0x3456789a, 8, half, true, 0);
+	recv_ipv6_fragment(0x456789ab, 8, NET_IPV6_FRAGMENT_MAX_BYTES - half, true, 0);
+	zassert_equal(pending_reassemblies(), 2, "Expected both fragments to be stored");
+	zassert_equal(fragment_errors(), errors, "Expected no fragment error");
+
+	/* Any further data is over budget and drops its reassembly */
+	recv_ipv6_fragment(0x3456789a, 8 + half, 8, true, 0);
+	zassert_equal(pending_reassemblies(), 1, "Expected one reassembly to be dropped");
+	zassert_equal(fragment_errors(), errors + 1, "Expected one fragment error");
+
+	/* The budget released by the dropped reassembly can be used again */
+	recv_ipv6_fragment(0x56789abc, 8, 8, true, 0);
+	zassert_equal(pending_reassemblies(), 2, "Expected the fragment to be stored");
+	zassert_equal(fragment_errors(), errors + 1, "Expected no new fragment error");
+
+	/* Let the pending reassemblies time out */
+	k_sleep(K_MSEC(CONFIG_NET_IPV6_FRAGMENT_TIMEOUT * MSEC_PER_SEC + 100));
+	zassert_equal(pending_reassemblies(), 0, "Expected reassemblies to time out");
+}
+
 ZTEST_SUITE(net_ipv6_fragment, NULL, test_setup, NULL, NULL, NULL);
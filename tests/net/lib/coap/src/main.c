@@ -1282,6 +1282,93 @@ ZTEST(coap, test_build_options_out_of_order_1)
 	zassert_equal(cpkt.offset, 52, "Wrong data size");
 }
 
+ZTEST(coap, test_build_options_sorted)
+{
+	struct coap_packet cpkt;
+	struct coap_packet parsed;
+	struct coap_option opts[2];
+	static const char token[] = "token";
+	static const uint8_t size2[] = {0x80};
+	static const uint8_t content_format[] = {COAP_CONTENT_FORMAT_APP_JSON};
+	static const uint8_t uri_port[] = {0x16, 0x06};
+	static const uint8_t accept[] = {COAP_CONTENT_FORMAT_APP_CBOR};
+	static const uint8_t max_age[] = {0x03};
+	static const uint8_t size1[] = {0x40};
+	struct coap_packet_option options[] = {
+		{ COAP_OPTION_SIZE2, sizeof(size2), size2 },
+		{ COAP_OPTION_URI_QUERY, 6, (const uint8_t *)"query0" },
+		{ COAP_OPTION_URI_PATH, 4, (const uint8_t *)"path" },
+		{ COAP_OPTION_CONTENT_FORMAT, sizeof(content_format), content_format },
+		{ COAP_OPTION_URI_HOST, 8, (const uint8_t *)"hostname" },
+		{ COAP_OPTION_URI_PORT, sizeof(uri_port), uri_port },
+		{ COAP_OPTION_URI_QUERY, 6, (const uint8_t *)"query1" },
+		{ COAP_OPTION_ACCEPT, sizeof(accept), accept },
+		{ COAP_OPTION_OBSERVE, 0, NULL },
+		{ COAP_OPTION_MAX_AGE, sizeof(max_age), max_age },
+		{ COAP_OPTION_SIZE1, sizeof(size1), size1 },
+	};
+	uint8_t *data = data_buf[0];
+	int r;
+
+	/* Same options as test_build_options_out_of_order_1 */
+	static const uint8_t expected[] = {
+		0x45, 0x02, 0x12, 0x34, 't',  'o',  'k',  'e',	'n',  0x38, 'h',  'o',	's',
+		't',  'n',  'a',  'm',	'e',  0x30, 0x12, 0x16, 0x06, 'D',  'p',  'a',	't',
+		'h',  0x11, 0x32, 0x21, 0x03, 0x16, 'q',  'u',	'e',  'r',  'y',  0x30, 0x06,
+		'q',  'u',  'e',  'r',	'y',  0x31, 0x21, 0x3c, 0xb1, 0x80, 0xd1, 0x13, 0x40,
+	};
+
+	memset(data_buf[0], 0, ARRAY_SIZE(data_buf[0]));
+
+	r = coap_packet_init(&cpkt, data, COAP_BUF_SIZE, COAP_VERSION_1, COAP_TYPE_CON,
+			     strlen(token), token, COAP_METHOD_POST, 0x1234);
+	zassert_equal(r, 0, "Could not initialize packet");
+
+	r = coap_packet_append_options(&cpkt, options, ARRAY_SIZE(options));
+	zassert_equal(r, 0, "Could not append options");
+
+	ASSERT_OPTIONS(cpkt, 43, expected, 52);
+	zassert_equal(cpkt.delta, 60, "Wrong delta");
+
+	/* Repeated options are found in order */
+	r = coap_find_options(&cpkt, COAP_OPTION_URI_QUERY, opts, ARRAY_SIZE(opts));
+	zassert_equal(r, 2, "Could not find options");
+	zassert_mem_equal(opts[0].value, "query0", opts[0].len, "Wrong option content");
+	zassert_mem_equal(opts[1].value, "query1", opts[1].len, "Wrong option content");
+
+	r = coap_find_options(&cpkt, COAP_OPTION_OBSERVE, opts, ARRAY_SIZE(opts));
+	zassert_equal(r, 1, "Could not find option");
+	zassert_equal(opts[0].len, 0, "Wrong option len");
+
+	r = coap_find_options(&cpkt, COAP_OPTION_ETAG, opts, ARRAY_SIZE(opts));
+	zassert_equal(r, 0, "Found a missing option");
+
+	/* The options are found again after removing one */
+	r = coap_packet_remove_option(&cpkt, COAP_OPTION_URI_HOST);
+	zassert_equal(r, 0, "Could not remove option");
+
+	r = coap_find_options(&cpkt, COAP_OPTION_URI_PATH, opts, ARRAY_SIZE(opts));
+	zassert_equal(r, 1, "Could not find option");
+	zassert_mem_equal(opts[0].value, "path", opts[0].len, "Wrong option content");
+
+	r = coap_find_options(&cpkt, COAP_OPTION_URI_HOST, opts, ARRAY_SIZE(opts));
+	zassert_equal(r, 0, "Found a removed option");
+
+	/* And in a parsed packet */
+	memcpy(data_buf[1], expected, sizeof(expected));
+
+	r = coap_packet_parse(&parsed, data_buf[1], sizeof(expected), NULL, 0);
+	zassert_equal(r, 0, "Could not parse packet");
+
+	r = coap_find_options(&parsed, COAP_OPTION_SIZE1, opts, ARRAY_SIZE(opts));
+	zassert_equal(r, 1, "Could not find option");
+	zassert_equal(opts[0].value[0], 0x40, "Wrong option content");
+
+	r = coap_find_options(&parsed, COAP_OPTION_URI_QUERY, opts, ARRAY_SIZE(opts));
+	zassert_equal(r, 2, "Could not find options");
+	zassert_mem_equal(opts[1].value, "query1", opts[1].len, "Wrong option content");
+}
+
 #define ASSERT_OPTIONS_AND_PAYLOAD(cpkt, expected_opt_len, expected_data, expected_offset,         \
 				   expected_delta)                                                 \
 	do {                                                                                       \
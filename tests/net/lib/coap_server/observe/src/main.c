@@ -0,0 +1,312 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Loopback stress test of the CoAP server observer registry. A client socket
+ * registers as many observers as the service supports, each with its own
+ * token, and the test checks that a resource update reaches all of them.
+ */
+
+#include <inttypes.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/coap_service.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/ztest.h>
+
+#define SERVER_IPV4_ADDR "127.0.0.1"
+#define SERVER_PORT      5683
+#define TIMEOUT_S        2
+
+#define NUM_OBSERVERS CONFIG_COAP_SERVICE_OBSERVERS
+#define TOKEN_LEN     4
+
+static const char * const obs_path[] = { "obs", NULL };
+
+static bool notify_con;
+static int client_fd = -1;
+static ATOMIC_DEFINE(seen, NUM_OBSERVERS);
+
+static const uint16_t observe_service_port = SERVER_PORT;
+COAP_SERVICE_DEFINE(observe_service, SERVER_IPV4_ADDR, &observe_service_port,
+		    COAP_SERVICE_AUTOSTART);
+
+static int obs_get(struct coap_resource *resource, struct coap_packet *request,
+		   struct sockaddr *addr, socklen_t addr_len)
+{
+	uint8_t buf[CONFIG_COAP_SERVER_MESSAGE_SIZE];
+	uint8_t token[COAP_TOKEN_MAX_LEN];
+	struct coap_packet response;
+	uint8_t code = COAP_RESPONSE_CODE_CONTENT;
+	uint8_t tkl;
+	int observe;
+	int ret;
+
+	observe = coap_resource_parse_observe(resource, request, addr);
+	if (observe == -ENOMEM) {
+		code = COAP_RESPONSE_CODE_SERVICE_UNAVAILABLE;
+	}
+
+	tkl = coap_header_get_token(request, token);
+
+	ret = coap_packet_init(&response, buf, sizeof(buf), COAP_VERSION_1, COAP_TYPE_ACK, tkl,
+			       token, code, coap_header_get_id(request));
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (observe == 0) {
+		ret = coap_append_option_int(&response, COAP_OPTION_OBSERVE, resource->age);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return coap_resource_send(resource, &response, addr, addr_len, NULL);
+}
+
+static void obs_notify(struct coap_resource *resource, struct coap_observer *observer)
+{
+	uint8_t buf[CONFIG_COAP_SERVER_MESSAGE_SIZE];
+	struct coap_packet notification;
+
+	/* Called from the test thread by coap_resource_notify() */
+	zassert_ok(coap_packet_init(&notification, buf, sizeof(buf), COAP_VERSION_1,
+				    notify_con ? COAP_TYPE_CON : COAP_TYPE_NON_CON,
+				    observer->tkl, observer->token, COAP_RESPONSE_CODE_CONTENT,
+				    coap_next_id()));
+	zassert_ok(coap_append_option_int(&notification, COAP_OPTION_OBSERVE, resource->age));
+
+	zassert_ok(coap_resource_send(resource, &notification, &observer->addr,
+				      sizeof(struct sockaddr_in), NULL));
+}
+
+COAP_RESOURCE_DEFINE(obs_resource, observe_service, {
+	.path = obs_path,
+	.get = obs_get,
+	.notify = obs_notify,
+});
+
+static void client_send(uint8_t type, uint8_t code, uint16_t id, uint32_t token, int observe)
+{
+	struct sockaddr_in sa = {
+		.sin_family = AF_INET,
+		.sin_port = htons(SERVER_PORT),
+	};
+	uint8_t buf[CONFIG_COAP_SERVER_MESSAGE_SIZE];
+	uint8_t token_buf[TOKEN_LEN];
+	struct coap_packet cpkt;
+	ssize_t ret;
+
+	sys_put_be32(token, token_buf);
+	zassert_equal(zsock_inet_pton(AF_INET, SERVER_IPV4_ADDR, &sa.sin_addr), 1);
+
+	zassert_ok(coap_packet_init(&cpkt, buf, sizeof(buf), COAP_VERSION_1, type,
+				    code == COAP_CODE_EMPTY ? 0 : TOKEN_LEN, token_buf, code, id));
+
+	if (observe >= 0) {
+		zassert_ok(coap_append_option_int(&cpkt, COAP_OPTION_OBSERVE, observe));
+		zassert_ok(coap_packet_append_option(&cpkt, COAP_OPTION_URI_PATH,
+						     (const uint8_t *)obs_path[0],
+						     strlen(obs_path[0])));
+	}
+
+	ret = zsock_sendto(client_fd, cpkt.data, cpkt.offset, 0, (struct sockaddr *)&sa,
+			   sizeof(sa));
+	zassert_equal(ret, cpkt.offset, "Failed to send request (%d)", errno);
+}
+
+/* Receive a message and return its token, -1 if there is none */
+static int64_t client_recv(struct coap_packet *cpkt, uint8_t *buf, size_t len)
+{
+	uint8_t token[COAP_TOKEN_MAX_LEN];
+	ssize_t ret;
+
+	ret = zsock_recv(client_fd, buf, len, 0);
+	zassert_true(ret > 0, "Failed to receive message (%d)", errno);
+
+	zassert_ok(coap_packet_parse(cpkt, buf, ret, NULL, 0));
+
+	if (coap_header_get_token(cpkt, token) != TOKEN_LEN) {
+		return -1;
+	}
+
+	return sys_get_be32(token);
+}
+
+static void client_observe(uint32_t token, int observe, uint8_t expected_code)
+{
+	uint8_t buf[CONFIG_COAP_SERVER_MESSAGE_SIZE];
+	struct coap_packet response;
+	uint16_t id = coap_next_id();
+
+	client_send(COAP_TYPE_CON, COAP_METHOD_GET, id, token, observe);
+
+	zassert_equal(client_recv(&response, buf, sizeof(buf)), token, "Wrong token");
+	zassert_equal(coap_header_get_id(&response), id, "Wrong message ID");
+	zassert_equal(coap_header_get_code(&response), expected_code, "Wrong response code");
+}
+
+/* Collect the notifications sent for a resource update */
+static int receive_notifications(int expected)
+{
+	uint8_t buf[CONFIG_COAP_SERVER_MESSAGE_SIZE];
+	struct coap_packet cpkt;
+	int64_t token;
+	int count = 0;
+
+	memset(seen, 0, sizeof(seen));
+
+	while (count < expected) {
+		token = client_recv(&cpkt, buf, sizeof(buf));
+		zassert_true(token >= 0 && token < NUM_OBSERVERS, "Unexpected token");
+		zassert_false(atomic_test_and_set_bit(seen, (int)token), "Duplicate notification");
+		count++;
+
+		if (coap_header_get_type(&cpkt) == COAP_TYPE_CON) {
+			client_send(COAP_TYPE_ACK, COAP_CODE_EMPTY, coap_header_get_id(&cpkt),
+				    0, -1);
+		}
+	}
+
+	return count;
+}
+
+static bool pendings_cleared(void)
+{
+	for (int i = 0; i < CONFIG_COAP_SERVICE_PENDING_MESSAGES; i++) {
+		if (observe_service.data->pending[i].data != NULL) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+ZTEST(coap_server_observe, test_fan_out)
+{
+	uint32_t start, cycles;
+
+	start = k_cycle_get_32();
+	zassert_ok(coap_resource_notify(&obs_resource));
+	zassert_equal(receive_notifications(NUM_OBSERVERS), NUM_OBSERVERS);
+	cycles = k_cycle_get_32() - start;
+
+	TC_PRINT("Notified %d observers in %" PRIu64 " us\n", NUM_OBSERVERS,
+		 k_cyc_to_us_floor64(cycles));
+}
+
+ZTEST(coap_server_observe, test_fan_out_confirmable)
+{
+	notify_con = true;
+
+	zassert_ok(coap_resource_notify(&obs_resource));
+	zassert_equal(receive_notifications(NUM_OBSERVERS), NUM_OBSERVERS);
+
+	/* The server releases the pending messages when processing the ACKs */
+	for (int i = 0; i < TIMEOUT_S * MSEC_PER_SEC / 10 && !pendings_cleared(); i++) {
+		k_msleep(10);
+	}
+
+	zassert_true(pendings_cleared(), "Pending messages not acknowledged");
+
+	notify_con = false;
+}
+
+ZTEST(coap_server_observe, test_full)
+{
+	/* Same address but a new token, there is no room for it */
+	client_observe(NUM_OBSERVERS, 0, COAP_RESPONSE_CODE_SERVICE_UNAVAILABLE);
+
+	/* Registering again an existing observer is a refresh */
+	client_observe(0, 0, COAP_RESPONSE_CODE_CONTENT);
+}
+
+ZTEST(coap_server_observe, test_deregister)
+{
+	/* Deregister a quarter of the observers with a GET request, another
+	 * quarter with the API.
+	 */
+	for (int i = 0; i < NUM_OBSERVERS / 4; i++) {
+		client_observe(i, 1, COAP_RESPONSE_CODE_CONTENT);
+	}
+
+	for (int i = NUM_OBSERVERS / 4; i < NUM_OBSERVERS / 2; i++) {
+		uint8_t token[TOKEN_LEN];
+
+		sys_put_be32(i, token);
+		zassert_ok(coap_resource_remove_observer_by_token(&obs_resource, token,
+								  sizeof(token)));
+	}
+
+	zassert_ok(coap_resource_notify(&obs_resource));
+	zassert_equal(receive_notifications(NUM_OBSERVERS - NUM_OBSERVERS / 2),
+		      NUM_OBSERVERS - NUM_OBSERVERS / 2);
+
+	for (int i = 0; i < NUM_OBSERVERS / 2; i++) {
+		zassert_false(atomic_test_bit(seen, i), "Observer %d not removed", i);
+	}
+}
+
+static void *setup(void)
+{
+	struct timeval optval = {
+		.tv_sec = TIMEOUT_S,
+		.tv_usec = 0,
+	};
+	struct sockaddr_in sa = {
+		.sin_family = AF_INET,
+	};
+
+	zassert_equal(zsock_inet_pton(AF_INET, SERVER_IPV4_ADDR, &sa.sin_addr), 1);
+
+	client_fd = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	zassert_true(client_fd >= 0, "Failed to create client socket (%d)", errno);
+
+	zassert_ok(zsock_setsockopt(client_fd, SOL_SOCKET, SO_RCVTIMEO, &optval,
+				    sizeof(optval)));
+	zassert_ok(zsock_bind(client_fd, (struct sockaddr *)&sa, sizeof(sa)));
+
+	/* Wait for the server thread to start the service */
+	for (int i = 0; i < TIMEOUT_S * MSEC_PER_SEC / 10; i++) {
+		if (coap_service_is_running(&observe_service) == 1) {
+			break;
+		}
+
+		k_msleep(10);
+	}
+
+	zassert_equal(coap_service_is_running(&observe_service), 1, "Service not started");
+
+	return NULL;
+}
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	for (int i = 0; i < NUM_OBSERVERS; i++) {
+		client_observe(i, 0, COAP_RESPONSE_CODE_CONTENT);
+	}
+}
+
+static void after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	for (int i = 0; i < NUM_OBSERVERS; i++) {
+		uint8_t token[TOKEN_LEN];
+
+		sys_put_be32(i, token);
+		(void)coap_resource_remove_observer_by_token(&obs_resource, token,
+							     sizeof(token));
+	}
+
+	notify_con = false;
+}
+
+ZTEST_SUITE(coap_server_observe, NULL, setup, before, after, NULL);
@@ -156,6 +156,81 @@ ZTEST(net_dns_cache_test, test_different_type_not_returned)
 	zassert_equal(0, info_read.ai_family);
 }
 
+ZTEST(net_dns_cache_test, test_least_recently_used_removed)
+{
+	struct dns_addrinfo info_write = {.ai_family = AF_INET};
+	struct dns_addrinfo info_read = {0};
+	enum dns_query_type query_type = DNS_QUERY_TYPE_A;
+	char query[sizeof("example00.com")];
+
+	for (size_t i = 0; i < TEST_DNS_CACHE_SIZE; i++) {
+		snprintk(query, sizeof(query), "example%02u.com", (unsigned int)i);
+		zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write,
+					 TEST_DNS_CACHE_DEFAULT_TTL),
+			   "Cache entry adding should work.");
+	}
+
+	/* Using the oldest entry keeps it from being replaced */
+	zassert_equal(1, dns_cache_find(&test_dns_cache, "example00.com", query_type, &info_read,
+					1));
+	zassert_ok(dns_cache_add(&test_dns_cache, "example.com", &info_write,
+				 TEST_DNS_CACHE_DEFAULT_TTL),
+		   "Cache entry adding should work.");
+
+	zassert_equal(1, dns_cache_find(&test_dns_cache, "example00.com", query_type, &info_read,
+					1));
+	zassert_equal(0, dns_cache_find(&test_dns_cache, "example01.com", query_type, &info_read,
+					1));
+	zassert_equal(1, dns_cache_find(&test_dns_cache, "example.com", query_type, &info_read, 1));
+}
+
+ZTEST(net_dns_cache_test, test_remove)
+{
+	struct dns_addrinfo info_write = {.ai_family = AF_INET};
+	struct dns_addrinfo info_read = {0};
+	enum dns_query_type query_type = DNS_QUERY_TYPE_A;
+
+	zassert_ok(dns_cache_add(&test_dns_cache, "example.com", &info_write,
+				 TEST_DNS_CACHE_DEFAULT_TTL),
+		   "Cache entry adding should work.");
+	zassert_ok(dns_cache_add(&test_dns_cache, "example2.com", &info_write,
+				 TEST_DNS_CACHE_DEFAULT_TTL),
+		   "Cache entry adding should work.");
+	zassert_ok(dns_cache_remove(&test_dns_cache, "example.com"));
+	zassert_equal(0, dns_cache_find(&test_dns_cache, "example.com", query_type, &info_read, 1));
+	zassert_equal(1, dns_cache_find(&test_dns_cache, "example2.com", query_type, &info_read,
+					1));
+}
+
+ZTEST(net_dns_cache_test, test_negative_entry)
+{
+	struct dns_addrinfo info_write = {.ai_family = AF_INET};
+	struct dns_addrinfo info_read = {0};
+	const char *query = "example.com";
+
+	zassert_ok(dns_cache_add_negative(&test_dns_cache, query, DNS_QUERY_TYPE_A,
+					  TEST_DNS_CACHE_DEFAULT_TTL),
+		   "Negative cache entry adding should work.");
+	zassert_equal(-ENOENT,
+		      dns_cache_find(&test_dns_cache, query, DNS_QUERY_TYPE_A, &info_read, 1));
+	zassert_equal(0, dns_cache_find(&test_dns_cache, query, DNS_QUERY_TYPE_AAAA, &info_read, 1));
+
+	/* An answer replaces the negative entry */
+	zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write, TEST_DNS_CACHE_DEFAULT_TTL),
+		   "Cache entry adding should work.");
+	zassert_equal(1, dns_cache_find(&test_dns_cache, query, DNS_QUERY_TYPE_A, &info_read, 1));
+
+	/* And the other way round */
+	zassert_ok(dns_cache_add_negative(&test_dns_cache, query, DNS_QUERY_TYPE_A,
+					  TEST_DNS_CACHE_DEFAULT_TTL),
+		   "Negative cache entry adding should work.");
+	zassert_equal(-ENOENT,
+		      dns_cache_find(&test_dns_cache, query, DNS_QUERY_TYPE_A, &info_read, 1));
+
+	k_sleep(K_MSEC(TEST_DNS_CACHE_DEFAULT_TTL * 1000 + 1));
+	zassert_equal(0, dns_cache_find(&test_dns_cache, query, DNS_QUERY_TYPE_A, &info_read, 1));
+}
+
 ZTEST(net_dns_cache_test, test_only_expected_type_returned)
 {
 	struct dns_addrinfo info_write_a = {.ai_family = AF_INET};
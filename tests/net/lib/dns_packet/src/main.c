@@ -1287,6 +1287,49 @@ ZTEST(dns_packet, test_dns_invalid_answer)
 	zassert_equal(ret, -EINVAL, "DNS message answer check succeed (%d)", ret);
 }
 
+/* Domain: nx.example
+ * Type: standard response, No such name
+ * Authority: SOA, TTL 3600, minimum 300
+ */
+static uint8_t nxdomain_resp_ipv4[] = {
+	/* DNS msg header (12 bytes) */
+	0x12, 0x34, 0x81, 0x83, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00,
+	/* Query */
+	0x02, 0x6e, 0x78, 0x07, 0x65, 0x78, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x00,
+	0x00, 0x01, 0x00, 0x01,
+	/* SOA record of example */
+	0xc0, 0x0f, 0x00, 0x06, 0x00, 0x01, 0x00, 0x00, 0x0e, 0x10, 0x00, 0x1d,
+	/* MNAME ns.example, RNAME h.example */
+	0x02, 0x6e, 0x73, 0xc0, 0x0f, 0x01, 0x68, 0xc0, 0x0f,
+	/* Serial, refresh, retry, expire, minimum */
+	0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x1c, 0x20, 0x00, 0x00, 0x0e, 0x10,
+	0x00, 0x09, 0x3a, 0x80, 0x00, 0x00, 0x01, 0x2c,
+};
+
+ZTEST(dns_packet, test_dns_negative_ttl)
+{
+	struct dns_msg_t dns_msg = { 0 };
+	uint32_t ttl;
+	int ret;
+
+	dns_msg.msg = nxdomain_resp_ipv4;
+	dns_msg.msg_size = sizeof(nxdomain_resp_ipv4);
+
+	ret = dns_unpack_response_query(&dns_msg);
+	zassert_ok(ret, "DNS message query check failed (%d)", ret);
+
+	ret = dns_unpack_negative_ttl(&dns_msg, &ttl);
+	zassert_ok(ret, "DNS negative TTL not found (%d)", ret);
+	zassert_equal(ttl, 300, "Invalid negative TTL %u", ttl);
+
+	/* Without the authority section there is nothing to cache */
+	dns_msg.msg_size = dns_msg.answer_offset;
+	nxdomain_resp_ipv4[9] = 0x00;
+	ret = dns_unpack_negative_ttl(&dns_msg, &ttl);
+	nxdomain_resp_ipv4[9] = 0x01;
+	zassert_equal(ret, -ENOENT, "DNS negative TTL found (%d)", ret);
+}
+
 static uint8_t recursive_query_resp_ipv4[] = {
 	/* DNS msg header (12 bytes) */
 	0x74, 0xe1, 0x81, 0x80, 0x00, 0x01, 0x00, 0x01,
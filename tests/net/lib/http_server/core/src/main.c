@@ -2491,6 +2491,78 @@ ZTEST(server_function_tests_no_init, test_parse_http_frames)
 		      "Expected stream_identifier for the 2nd frame doesn't match");
 }
 
+ZTEST(server_function_tests_no_init, test_parse_range)
+{
+	static const struct {
+		const char *value;
+		int ret;
+		size_t start;
+		size_t end;
+	} cases[] = {
+		{ "bytes=0-9", 0, 0, 9 },
+		{ "bytes=10-", 0, 10, 29 },
+		{ "bytes=-5", 0, 25, 29 },
+		{ "bytes=-100", 0, 0, 29 },
+		{ "bytes=20-100", 0, 20, 29 },
+		{ "BYTES=1-1", 0, 1, 1 },
+		{ "bytes=30-", -ERANGE, 0, 0 },
+		{ "bytes=-0", -ERANGE, 0, 0 },
+		{ "bytes=9-0", -ENOENT, 0, 0 },
+		{ "bytes=0-1,5-6", -ENOENT, 0, 0 },
+		{ "bytes= 0-1", -ENOENT, 0, 0 },
+		{ "bytes=0-1x", -ENOENT, 0, 0 },
+		{ "items=0-1", -ENOENT, 0, 0 },
+	};
+	size_t start, end;
+	int ret;
+
+	for (int i = 0; i < ARRAY_SIZE(cases); i++) {
+		ret = http_server_parse_range(cases[i].value, 30, &start, &end);
+		zassert_equal(ret, cases[i].ret, "Unexpected result for %s", cases[i].value);
+
+		if (ret == 0) {
+			zassert_equal(start, cases[i].start, "Wrong start for %s", cases[i].value);
+			zassert_equal(end, cases[i].end, "Wrong end for %s", cases[i].value);
+		}
+	}
+}
+
+ZTEST(server_function_tests_no_init, test_etag_match)
+{
+	char etag[HTTP_SERVER_ETAG_MAX_LEN];
+	char list[64];
+
+	zassert_true(http_server_fs_etag("/www/index.html", 1234, 1, etag, sizeof(etag)) > 0,
+		     "Failed to generate ETag");
+	zassert_true(strncmp(etag, "W/\"4d2-", 7) == 0, "Unexpected ETag %s", etag);
+
+	zassert_true(http_server_etag_match(etag, etag), "ETag doesn't match itself");
+	zassert_true(http_server_etag_match("*", etag), "Wildcard doesn't match");
+
+	/* Weak comparison ignores the weakness indicator */
+	zassert_true(http_server_etag_match(etag + 2, etag), "Strong tag doesn't match");
+
+	snprintk(list, sizeof(list), "\"abc\", %s", etag);
+	zassert_true(http_server_etag_match(list, etag), "ETag in list doesn't match");
+
+	zassert_false(http_server_etag_match("\"abc\", W/\"def\"", etag), "Wrong ETag matches");
+	zassert_false(http_server_etag_match("", etag), "Empty list matches");
+
+	zassert_true(http_server_fs_etag("/www/index.html.gz", 1234, 1, list, sizeof(list)) > 0,
+		     "Failed to generate ETag");
+	zassert_false(http_server_etag_match(list, etag),
+		      "Compressed variant has the same ETag");
+
+	/* A file rewritten with the same size gets a new tag */
+	zassert_true(http_server_fs_etag("/www/index.html", 1234, 2, list, sizeof(list)) > 0,
+		     "Failed to generate ETag");
+	zassert_false(http_server_etag_match(list, etag), "New generation has the same ETag");
+
+	zassert_equal(http_server_fs_etag("/www/index.html", 1234, 0, list, sizeof(list)), 0,
+		      "ETag generated without a generation");
+	zassert_equal(list[0], '\0', "ETag generated without a generation");
+}
+
 #if DT_HAS_COMPAT_STATUS_OKAY(zephyr_ram_disk)
 
 #include <zephyr/fs/fs.h>
@@ -2513,6 +2585,7 @@ static struct http_resource_detail_static_fs static_file_resource_detail = {
 			.content_type = "text/html",
 		},
 	.fs_path = TEST_DIR_PATH,
+	.generation = 1,
 };
 
 HTTP_RESOURCE_DEFINE(static_file_resource, test_http_service, "/static_file.html",
@@ -2675,6 +2748,34 @@ static int setup_fs(const char *file_ending)
 	return test_mkdir(TEST_DIR_PATH, filename_buf);
 }
 
+static void static_fs_etag(const char *file_ending, char *etag, size_t etag_len)
+{
+	char fname[sizeof(TEST_DIR_PATH) + sizeof(TEST_FILE) + 5];
+	int ret;
+
+	snprintk(fname, sizeof(fname), "%s/%s%s", TEST_DIR_PATH, TEST_FILE, file_ending);
+
+	ret = http_server_fs_etag(fname, strlen(TEST_STATIC_FS_PAYLOAD),
+				 static_file_resource_detail.generation, etag, etag_len);
+	zassert_true(ret > 0, "Failed to generate ETag (%d)", ret);
+}
+
+static void test_static_fs_request(const char *request, const char *expected_response,
+				   size_t expected_len)
+{
+	size_t offset = 0;
+	int ret;
+
+	ret = zsock_send(client_fd, request, strlen(request), 0);
+	zassert_not_equal(ret, -1, "send() failed (%d)", errno);
+
+	memset(buf, 0, sizeof(buf));
+
+	test_read_data(&offset, expected_len);
+	zassert_mem_equal(buf, expected_response, expected_len,
+			  "Received data doesn't match expected response");
+}
+
 ZTEST(server_function_tests, test_http1_static_fs)
 {
 	static const char http1_request[] =
@@ -2683,26 +2784,256 @@ ZTEST(server_function_tests, test_http1_static_fs)
 		"User-Agent: curl/7.68.0\r\n"
 		"Accept: */*\r\n"
 		"\r\n";
-	static const char expected_response[] =
+	static const char expected_response_fmt[] =
 		"HTTP/1.1 200 OK\r\n"
 		"Content-Length: 30\r\n"
 		"Content-Type: text/html\r\n"
+		"ETag: %s\r\n"
 		"\r\n"
 		TEST_STATIC_FS_PAYLOAD;
+	char expected_response[sizeof(expected_response_fmt) + HTTP_SERVER_ETAG_MAX_LEN];
+	char etag[HTTP_SERVER_ETAG_MAX_LEN];
+	int len;
+	int ret;
+
+	ret = setup_fs("");
+	zassert_equal(ret, TC_PASS, "Failed to mount fs");
+
+	static_fs_etag("", etag, sizeof(etag));
+	len = snprintk(expected_response, sizeof(expected_response), expected_response_fmt, etag);
+
+	test_static_fs_request(http1_request, expected_response, len);
+}
+
+ZTEST(server_function_tests, test_http1_static_fs_range)
+{
+#define HTTP1_RANGE_REQUEST                                                                        \
+	"GET /static_file.html HTTP/1.1\r\n"                                                       \
+	"Host: 127.0.0.1:8080\r\n"                                                                 \
+	"Range: %s\r\n"                                                                            \
+	"\r\n"
+#define HTTP1_RANGE_RESPONSE                                                                       \
+	"HTTP/1.1 206 Partial Content\r\n"                                                         \
+	"Content-Length: %d\r\n"                                                                   \
+	"Content-Type: text/html\r\n"                                                              \
+	"ETag: %s\r\n"                                                                             \
+	"Content-Range: bytes %d-%d/30\r\n"                                                        \
+	"\r\n"                                                                                     \
+	"%.*s"
+	static const struct {
+		const char *range;
+		int start;
+		int end;
+	} ranges[] = {
+		{ "bytes=0-4", 0, 4 },
+		{ "bytes=7-", 7, 29 },
+		{ "bytes=-6", 24, 29 },
+		{ "bytes=25-100", 25, 29 },
+	};
+	static const char not_satisfiable_response[] =
+		"HTTP/1.1 416 Range Not Satisfiable\r\n"
+		"Content-Length: 0\r\n"
+		"Content-Range: bytes */30\r\n"
+		"\r\n";
+	char http1_request[sizeof(HTTP1_RANGE_REQUEST) + 16];
+	char expected_response[sizeof(HTTP1_RANGE_RESPONSE) + HTTP_SERVER_ETAG_MAX_LEN +
+			       sizeof(TEST_STATIC_FS_PAYLOAD)];
+	char etag[HTTP_SERVER_ETAG_MAX_LEN];
+	int len;
+	int ret;
+
+	ret = setup_fs("");
+	zassert_equal(ret, TC_PASS, "Failed to mount fs");
+
+	static_fs_etag("", etag, sizeof(etag));
+
+	for (int i = 0; i < ARRAY_SIZE(ranges); i++) {
+		int range_len = ranges[i].end - ranges[i].start + 1;
+
+		snprintk(http1_request, sizeof(http1_request), HTTP1_RANGE_REQUEST,
+			 ranges[i].range);
+		len = snprintk(expected_response, sizeof(expected_response), HTTP1_RANGE_RESPONSE,
+			       range_len, etag, ranges[i].start, ranges[i].end, range_len,
+			       TEST_STATIC_FS_PAYLOAD + ranges[i].start);
+
+		test_static_fs_request(http1_request, expected_response, len);
+	}
+
+	snprintk(http1_request, sizeof(http1_request), HTTP1_RANGE_REQUEST, "bytes=30-");
+	test_static_fs_request(http1_request, not_satisfiable_response,
+			       sizeof(not_satisfiable_response) - 1);
+}
+
+ZTEST(server_function_tests, test_http1_static_fs_if_none_match)
+{
+#define HTTP1_IF_NONE_MATCH_REQUEST                                                                \
+	"GET /static_file.html HTTP/1.1\r\n"                                                       \
+	"Host: 127.0.0.1:8080\r\n"                                                                 \
+	"If-None-Match: %s\r\n"                                                                    \
+	"\r\n"
+#define HTTP1_NOT_MODIFIED_RESPONSE                                                                \
+	"HTTP/1.1 304 Not Modified\r\n"                                                            \
+	"ETag: %s\r\n"                                                                             \
+	"\r\n"
+#define HTTP1_MODIFIED_RESPONSE                                                                    \
+	"HTTP/1.1 200 OK\r\n"                                                                      \
+	"Content-Length: 30\r\n"                                                                   \
+	"Content-Type: text/html\r\n"                                                              \
+	"ETag: %s\r\n"                                                                             \
+	"\r\n" TEST_STATIC_FS_PAYLOAD
+#define HTTP1_UNTAGGED_RESPONSE                                                                    \
+	"HTTP/1.1 200 OK\r\n"                                                                      \
+	"Content-Length: 30\r\n"                                                                   \
+	"Content-Type: text/html\r\n"                                                              \
+	"\r\n" TEST_STATIC_FS_PAYLOAD
+	char http1_request[sizeof(HTTP1_IF_NONE_MATCH_REQUEST) + HTTP_SERVER_ETAG_MAX_LEN];
+	char expected_response[sizeof(HTTP1_MODIFIED_RESPONSE) + HTTP_SERVER_ETAG_MAX_LEN];
+	char etag[HTTP_SERVER_ETAG_MAX_LEN];
+	int len;
+	int ret;
+
+	ret = setup_fs("");
+	zassert_equal(ret, TC_PASS, "Failed to mount fs");
+
+	static_fs_etag("", etag, sizeof(etag));
+
+	snprintk(http1_request, sizeof(http1_request), HTTP1_IF_NONE_MATCH_REQUEST, etag);
+	len = snprintk(expected_response, sizeof(expected_response),
+		       HTTP1_NOT_MODIFIED_RESPONSE, etag);
+	test_static_fs_request(http1_request, expected_response, len);
+
+	snprintk(http1_request, sizeof(http1_request), HTTP1_IF_NONE_MATCH_REQUEST, "*");
+	test_static_fs_request(http1_request, expected_response, len);
+
+	snprintk(http1_request, sizeof(http1_request), HTTP1_IF_NONE_MATCH_REQUEST,
+		 "\"0-00000000\"");
+	len = snprintk(expected_response, sizeof(expected_response), HTTP1_MODIFIED_RESPONSE,
+		       etag);
+	test_static_fs_request(http1_request, expected_response, len);
+
+	/* The file changed, the old tag is stale */
+	static_file_resource_detail.generation++;
+	snprintk(http1_request, sizeof(http1_request), HTTP1_IF_NONE_MATCH_REQUEST, etag);
+	static_fs_etag("", etag, sizeof(etag));
+	len = snprintk(expected_response, sizeof(expected_response), HTTP1_MODIFIED_RESPONSE,
+		       etag);
+	test_static_fs_request(http1_request, expected_response, len);
+
+	/* Without a generation there is no tag to validate the content */
+	static_file_resource_detail.generation = 0;
+	snprintk(http1_request, sizeof(http1_request), HTTP1_IF_NONE_MATCH_REQUEST, "*");
+	test_static_fs_request(http1_request, HTTP1_UNTAGGED_RESPONSE,
+			       sizeof(HTTP1_UNTAGGED_RESPONSE) - 1);
+
+	static_file_resource_detail.generation = 1;
+}
+
+/* Build a HTTP/2 GET request for the static file with one extra header */
+static size_t http2_static_fs_request(uint8_t *frame, size_t size, uint32_t stream_id,
+				      const char *name, const char *value)
+{
+	const struct http_header headers[] = {
+		{.name = ":method", .value = "GET"},
+		{.name = ":scheme", .value = "http"},
+		{.name = ":path", .value = "/static_file.html"},
+		{.name = ":authority", .value = "127.0.0.1:8080"},
+		{.name = name, .value = value},
+	};
+	static struct http_hpack_header_buf header;
+	size_t len = HTTP2_FRAME_HEADER_SIZE;
+	int ret;
+
+	for (int i = 0; i < ARRAY_SIZE(headers); i++) {
+		header.name = headers[i].name;
+		header.name_len = strlen(headers[i].name);
+		header.value = headers[i].value;
+		header.value_len = strlen(headers[i].value);
+
+		ret = http_hpack_encode_header(frame + len, size - len, &header);
+		zassert_true(ret > 0, "Failed to encode header %s (%d)", headers[i].name, ret);
+		len += ret;
+	}
+
+	sys_put_be24(len - HTTP2_FRAME_HEADER_SIZE, &frame[HTTP2_FRAME_LENGTH_OFFSET]);
+	frame[HTTP2_FRAME_TYPE_OFFSET] = HTTP2_HEADERS_FRAME;
+	frame[HTTP2_FRAME_FLAGS_OFFSET] = HTTP2_FLAG_END_HEADERS | HTTP2_FLAG_END_STREAM;
+	sys_put_be32(stream_id, &frame[HTTP2_FRAME_STREAM_ID_OFFSET]);
+
+	return len;
+}
+
+ZTEST(server_function_tests, test_http2_static_fs_range_if_none_match)
+{
+	static const uint8_t request_preface[] = {
+		TEST_HTTP2_MAGIC,
+		TEST_HTTP2_SETTINGS,
+		TEST_HTTP2_SETTINGS_ACK,
+	};
+	static const uint8_t request_goaway[] = {
+		TEST_HTTP2_GOAWAY,
+	};
+	static uint8_t request[128];
+	char etag[HTTP_SERVER_ETAG_MAX_LEN];
+	struct http_header expected_headers[3];
 	size_t offset = 0;
+	size_t len;
 	int ret;
 
 	ret = setup_fs("");
 	zassert_equal(ret, TC_PASS, "Failed to mount fs");
 
-	ret = zsock_send(client_fd, http1_request, strlen(http1_request), 0);
+	static_fs_etag("", etag, sizeof(etag));
+
+	ret = zsock_send(client_fd, request_preface, sizeof(request_preface), 0);
 	zassert_not_equal(ret, -1, "send() failed (%d)", errno);
 
 	memset(buf, 0, sizeof(buf));
 
-	test_read_data(&offset, sizeof(expected_response) - 1);
-	zassert_mem_equal(buf, expected_response, sizeof(expected_response) - 1,
-			  "Received data doesn't match expected response");
+	expect_http2_settings_frame(&offset, false);
+	expect_http2_settings_frame(&offset, true);
+
+	/* A single range is answered with partial content */
+	len = http2_static_fs_request(request, sizeof(request), TEST_STREAM_ID_1, "range",
+				      "bytes=7-11");
+	ret = zsock_send(client_fd, request, len, 0);
+	zassert_not_equal(ret, -1, "send() failed (%d)", errno);
+
+	expected_headers[0] = (struct http_header){.name = ":status", .value = "206"};
+	expected_headers[1] = (struct http_header){.name = "etag", .value = etag};
+	expected_headers[2] = (struct http_header){.name = "content-range",
+						   .value = "bytes 7-11/30"};
+	expect_http2_headers_frame(&offset, TEST_STREAM_ID_1, HTTP2_FLAG_END_HEADERS,
+				   expected_headers, 3);
+	expect_http2_data_frame(&offset, TEST_STREAM_ID_1, TEST_STATIC_FS_PAYLOAD + 7, 5,
+				HTTP2_FLAG_END_STREAM);
+
+	/* A range beyond the end of the file cannot be satisfied */
+	len = http2_static_fs_request(request, sizeof(request), TEST_STREAM_ID_2, "range",
+				      "bytes=30-");
+	ret = zsock_send(client_fd, request, len, 0);
+	zassert_not_equal(ret, -1, "send() failed (%d)", errno);
+
+	expected_headers[0] = (struct http_header){.name = ":status", .value = "416"};
+	expected_headers[1] = (struct http_header){.name = "content-range",
+						   .value = "bytes */30"};
+	expect_http2_headers_frame(&offset, TEST_STREAM_ID_2,
+				   HTTP2_FLAG_END_HEADERS | HTTP2_FLAG_END_STREAM,
+				   expected_headers, 2);
+
+	/* A matching entity tag means the client copy is still valid */
+	len = http2_static_fs_request(request, sizeof(request), TEST_STREAM_ID_2 + 2,
+				      "if-none-match", etag);
+	ret = zsock_send(client_fd, request, len, 0);
+	zassert_not_equal(ret, -1, "send() failed (%d)", errno);
+
+	expected_headers[0] = (struct http_header){.name = ":status", .value = "304"};
+	expected_headers[1] = (struct http_header){.name = "etag", .value = etag};
+	expect_http2_headers_frame(&offset, TEST_STREAM_ID_2 + 2,
+				   HTTP2_FLAG_END_HEADERS | HTTP2_FLAG_END_STREAM,
+				   expected_headers, 2);
+
+	ret = zsock_send(client_fd, request_goaway, sizeof(request_goaway), 0);
+	zassert_not_equal(ret, -1, "send() failed (%d)", errno);
 }
 
 ZTEST(server_function_tests, test_http1_static_fs_compression)
@@ -2719,13 +3050,16 @@ ZTEST(server_function_tests, test_http1_static_fs_compression)
 	"Content-Length: 30\r\n"                                                                   \
 	"Content-Type: text/html\r\n"                                                              \
 	"Content-Encoding: %s\r\n"                                                                 \
+	"ETag: %s\r\n"                                                                             \
 	"\r\n" TEST_STATIC_FS_PAYLOAD
 
 	static const char mixed_compression_str[] = "gzip, deflate, br";
 	static char http1_request[sizeof(HTTP1_COMPRESSION_REQUEST) +
 				  ARRAY_SIZE(mixed_compression_str)] = {0};
 	static char expected_response[sizeof(HTTP1_COMPRESSION_RESPONSE) +
-				      HTTP_COMPRESSION_MAX_STRING_LEN] = {0};
+				      HTTP_COMPRESSION_MAX_STRING_LEN +
+				      HTTP_SERVER_ETAG_MAX_LEN] = {0};
+	char etag[HTTP_SERVER_ETAG_MAX_LEN];
 	static const char *const file_ending_map[] = {[HTTP_GZIP] = ".gz",
 						      [HTTP_COMPRESS] = ".lzw",
 						      [HTTP_DEFLATE] = ".zz",
@@ -2746,8 +3080,9 @@ ZTEST(server_function_tests, test_http1_static_fs_compression)
 			"No file ending defined for compression");
 
 		sprintf(http1_request, HTTP1_COMPRESSION_REQUEST, http_compression_text(i));
+		static_fs_etag(file_ending_map[i], etag, sizeof(etag));
 		expected_response_size = sprintf(expected_response, HTTP1_COMPRESSION_RESPONSE,
-						 http_compression_text(i));
+						 http_compression_text(i), etag);
 
 		ret = setup_fs(file_ending_map[i]);
 		zassert_equal(ret, TC_PASS, "Failed to mount fs");
@@ -2765,8 +3100,9 @@ ZTEST(server_function_tests, test_http1_static_fs_compression)
 	offset = 0;
 	TC_PRINT("Testing mixed compression...\n");
 	sprintf(http1_request, HTTP1_COMPRESSION_REQUEST, mixed_compression_str);
+	static_fs_etag(file_ending_map[HTTP_BR], etag, sizeof(etag));
 	expected_response_size = sprintf(expected_response, HTTP1_COMPRESSION_RESPONSE,
-					 http_compression_text(HTTP_BR));
+					 http_compression_text(HTTP_BR), etag);
 	ret = setup_fs(file_ending_map[HTTP_BR]);
 	zassert_equal(ret, TC_PASS, "Failed to mount fs");
 
@@ -494,4 +494,165 @@ ZTEST(http2_hpack, test_http2_hpack_literal_not_indexed_decode)
 				 ARRAY_SIZE(test_enc_literal_not_indexed_headers));
 }
 
+ZTEST(http2_hpack, test_http2_hpack_long_value_encode)
+{
+	struct http_hpack_header_buf hdr = {
+		.name = "cookie",
+		.name_len = strlen("cookie"),
+	};
+	static char value[300];
+	int ret;
+
+	/* Characters with long codes, so that the value is sent as is, with
+	 * a length taking several bytes to encode.
+	 */
+	memset(value, '{', sizeof(value));
+	hdr.value = value;
+	hdr.value_len = sizeof(value);
+
+	ret = http_hpack_encode_header(test_buf, sizeof(test_buf), &hdr);
+	zassert_equal(ret, 5 + sizeof(value), "Wrong encoding length");
+	zassert_mem_equal(test_buf, ((uint8_t []){ 0x1f, 0x11, 0x7f, 0xad, 0x01 }), 5,
+			  "Header wrongly encoded");
+
+	memset(&hdr, 0, sizeof(hdr));
+	ret = http_hpack_decode_header(test_buf, 5 + sizeof(value), &hdr);
+	zassert_equal(ret, 5 + sizeof(value), "Wrong decoding length");
+	zassert_equal(hdr.value_len, sizeof(value), "Wrong decoded header value length");
+	zassert_mem_equal(hdr.value, value, sizeof(value), "Header value wrongly decoded");
+}
+
+#if defined(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE)
+static struct http_hpack_encoder test_encoder;
+
+static void test_hpack_verify_encode_dynamic(const struct example_headers *example,
+					     size_t num_examples)
+{
+	for (int i = 0; i < num_examples; i++) {
+		struct http_hpack_header_buf hdr = {
+			.name = example[i].name,
+			.value = example[i].value,
+			.name_len = strlen(example[i].name),
+			.value_len = strlen(example[i].value)
+		};
+		int ret;
+
+		ret = http_hpack_encoder_encode_header(&test_encoder, test_buf,
+						       sizeof(test_buf), &hdr);
+		zassert_equal(ret, example[i].encoded_len,
+			      "Wrong encoding length for header %d", i);
+		zassert_mem_equal(test_buf, example[i].encoded, ret,
+				  "Header %d wrongly encoded", i);
+	}
+}
+
+/* Responses from RFC7541 C.6, where the date changing with every response is
+ * not indexed, and so does not take an index in the dynamic table.
+ */
+static const struct example_headers test_enc_dynamic_headers[] = {
+	{ ":status", "302", /* Table size update first */
+	  { 0x3f, 0xe1, 0x01, 0x48, 0x82, 0x64, 0x02 },
+	  7 },
+	{ "cache-control", "private",
+	  { 0x58, 0x85, 0xae, 0xc3, 0x77, 0x1a, 0x4b },
+	  7 },
+	{ "date", "Mon, 21 Oct 2013 20:13:21 GMT",
+	  { 0x1f, 0x12, 0x96, 0xd0, 0x7a, 0xbe, 0x94, 0x10,
+	    0x54, 0xd4, 0x44, 0xa8, 0x20, 0x05, 0x95, 0x04,
+	    0x0b, 0x81, 0x66, 0xe0, 0x82, 0xa6, 0x2d, 0x1b,
+	    0xff },
+	  25 },
+	{ "location", "https://www.example.com",
+	  { 0x6e, 0x91, 0x9d, 0x29, 0xad, 0x17, 0x18, 0x63,
+	    0xc7, 0x8f, 0x0b, 0x97, 0xc8, 0xe9, 0xae, 0x82,
+	    0xae, 0x43, 0xd3 },
+	  19 },
+	{ ":status", "307", /* Huffman encoding is not shorter */
+	  { 0x48, 0x03, 0x33, 0x30, 0x37 },
+	  5 },
+	{ "cache-control", "private",
+	  { 0xc0 },
+	  1 },
+	{ "location", "https://www.example.com",
+	  { 0xbf },
+	  1 },
+	{ ":status", "302",
+	  { 0xc1 },
+	  1 },
+	{ ":status", "200", /* Static table */
+	  { 0x88 },
+	  1 },
+};
+
+ZTEST(http2_hpack, test_http2_hpack_dynamic_encode)
+{
+	http_hpack_encoder_init(&test_encoder);
+	http_hpack_encoder_set_max_size(&test_encoder, 256);
+
+	test_hpack_verify_encode_dynamic(test_enc_dynamic_headers,
+					 ARRAY_SIZE(test_enc_dynamic_headers));
+}
+
+static const struct example_headers test_enc_dynamic_eviction_headers[] = {
+	{ "custom-key", "custom-value", /* Table size update first */
+	  { 0x3f, 0x45, 0x40, 0x88, 0x25, 0xa8, 0x49, 0xe9,
+	    0x5b, 0xa9, 0x7d, 0x7f, 0x89, 0x25, 0xa8, 0x49,
+	    0xe9, 0x5b, 0xb8, 0xe8, 0xb4, 0xbf },
+	  22 },
+	{ "custom-key", "custom-value",
+	  { 0xbe },
+	  1 },
+	{ "custom-key", "custom-header", /* Evicts custom-value */
+	  { 0x7e, 0x89, 0x25, 0xa8, 0x49, 0xe9, 0x5a, 0x72,
+	    0x8e, 0x42, 0xd9 },
+	  11 },
+	{ "custom-key", "custom-value", /* Name from the dynamic table */
+	  { 0x7e, 0x89, 0x25, 0xa8, 0x49, 0xe9, 0x5b, 0xb8,
+	    0xe8, 0xb4, 0xbf },
+	  11 },
+};
+
+static const struct example_headers test_enc_dynamic_resize_headers[] = {
+	{ "custom-key", "custom-value", /* Smallest size, then final size */
+	  { 0x3f, 0x13, 0x3f, 0x45, 0x40, 0x88, 0x25, 0xa8,
+	    0x49, 0xe9, 0x5b, 0xa9, 0x7d, 0x7f, 0x89, 0x25,
+	    0xa8, 0x49, 0xe9, 0x5b, 0xb8, 0xe8, 0xb4, 0xbf },
+	  24 },
+};
+
+static const struct example_headers test_enc_dynamic_disabled_headers[] = {
+	{ "custom-key", "custom-value", /* Never indexed */
+	  { 0x20, 0x10, 0x88, 0x25, 0xa8, 0x49, 0xe9, 0x5b,
+	    0xa9, 0x7d, 0x7f, 0x89, 0x25, 0xa8, 0x49, 0xe9,
+	    0x5b, 0xb8, 0xe8, 0xb4, 0xbf },
+	  21 },
+};
+
+ZTEST(http2_hpack, test_http2_hpack_dynamic_eviction)
+{
+	/* Room for a single custom-key entry */
+	http_hpack_encoder_init(&test_encoder);
+	http_hpack_encoder_set_max_size(&test_encoder, 100);
+
+	test_hpack_verify_encode_dynamic(test_enc_dynamic_eviction_headers,
+					 ARRAY_SIZE(test_enc_dynamic_eviction_headers));
+	zassert_equal(test_encoder.count, 1, "Wrong number of entries");
+	zassert_equal(test_encoder.size, 54, "Wrong table size");
+
+	/* A decrease followed by an increase is signaled with both sizes. */
+	http_hpack_encoder_set_max_size(&test_encoder, 50);
+	http_hpack_encoder_set_max_size(&test_encoder, 100);
+	zassert_equal(test_encoder.count, 0, "Entry not evicted");
+
+	test_hpack_verify_encode_dynamic(test_enc_dynamic_resize_headers,
+					 ARRAY_SIZE(test_enc_dynamic_resize_headers));
+
+	http_hpack_encoder_set_max_size(&test_encoder, 0);
+
+	test_hpack_verify_encode_dynamic(test_enc_dynamic_disabled_headers,
+					 ARRAY_SIZE(test_enc_dynamic_disabled_headers));
+	zassert_equal(test_encoder.count, 0, "Entry added to a disabled table");
+}
+#endif /* CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE */
+
 ZTEST_SUITE(http2_hpack, NULL, NULL, NULL, NULL, NULL);
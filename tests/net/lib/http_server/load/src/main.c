@@ -0,0 +1,233 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Loopback load generator for the HTTP server. A number of client threads
+ * issue back-to-back HTTP/1.1 GET requests over persistent connections and
+ * the test reports the aggregate request rate and the latency distribution.
+ */
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/http/server.h>
+#include <zephyr/net/http/service.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/ztest.h>
+
+#define SERVER_IPV4_ADDR "127.0.0.1"
+#define SERVER_PORT      8080
+#define TIMEOUT_S        2
+
+#define LOAD_CLIENTS       CONFIG_HTTP_SERVER_MAX_CLIENTS
+#define LOAD_REQUESTS      200
+#define LOAD_STACK_SIZE    2048
+#define LOAD_THREAD_PRIO   K_PRIO_PREEMPT(8)
+
+#define LOAD_PAYLOAD "Hello, World!"
+
+static const char load_request[] =
+	"GET / HTTP/1.1\r\n"
+	"Host: 127.0.0.1:8080\r\n"
+	"\r\n";
+static const char load_response[] =
+	"HTTP/1.1 200 OK\r\n"
+	"Content-Type: text/html\r\n"
+	"Content-Length: 13\r\n"
+	"\r\n"
+	LOAD_PAYLOAD;
+
+static uint16_t load_http_service_port = SERVER_PORT;
+HTTP_SERVICE_DEFINE(load_http_service, SERVER_IPV4_ADDR,
+		    &load_http_service_port, LOAD_CLIENTS, LOAD_CLIENTS, NULL, NULL);
+
+static const char static_resource_payload[] = LOAD_PAYLOAD;
+struct http_resource_detail_static static_resource_detail = {
+	.common = {
+			.type = HTTP_RESOURCE_TYPE_STATIC,
+			.bitmask_of_supported_http_methods = BIT(HTTP_GET),
+		},
+	.static_data = static_resource_payload,
+	.static_data_len = sizeof(static_resource_payload) - 1,
+};
+
+HTTP_RESOURCE_DEFINE(static_resource, load_http_service, "/",
+		     &static_resource_detail);
+
+struct load_client {
+	struct k_thread thread;
+	int fd;
+	int failed;
+	uint32_t latency[LOAD_REQUESTS];
+};
+
+static K_THREAD_STACK_ARRAY_DEFINE(load_stacks, LOAD_CLIENTS, LOAD_STACK_SIZE);
+static struct load_client load_clients[LOAD_CLIENTS];
+static uint32_t latencies[LOAD_CLIENTS * LOAD_REQUESTS];
+static K_SEM_DEFINE(load_go, 0, LOAD_CLIENTS);
+
+static int load_connect(void)
+{
+	struct sockaddr_in sa = {
+		.sin_family = AF_INET,
+		.sin_port = htons(SERVER_PORT),
+	};
+	struct timeval optval = {
+		.tv_sec = TIMEOUT_S,
+		.tv_usec = 0,
+	};
+	int fd;
+	int ret;
+
+	fd = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	zassert_true(fd >= 0, "Failed to create client socket (%d)", errno);
+
+	ret = zsock_setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &optval, sizeof(optval));
+	zassert_ok(ret, "Failed to set timeout (%d)", errno);
+
+	ret = zsock_inet_pton(AF_INET, SERVER_IPV4_ADDR, &sa.sin_addr);
+	zassert_equal(ret, 1, "inet_pton() failed");
+
+	ret = zsock_connect(fd, (struct sockaddr *)&sa, sizeof(sa));
+	zassert_ok(ret, "Failed to connect (%d)", errno);
+
+	return fd;
+}
+
+static int load_one_request(int fd)
+{
+	char buf[sizeof(load_response)];
+	size_t offset = 0;
+	ssize_t ret;
+
+	ret = zsock_send(fd, load_request, sizeof(load_request) - 1, 0);
+	if (ret != sizeof(load_request) - 1) {
+		return -EIO;
+	}
+
+	while (offset < sizeof(load_response) - 1) {
+		ret = zsock_recv(fd, buf + offset, sizeof(load_response) - 1 - offset, 0);
+		if (ret <= 0) {
+			return -EIO;
+		}
+
+		offset += ret;
+	}
+
+	if (memcmp(buf, load_response, sizeof(load_response) - 1) != 0) {
+		return -EBADMSG;
+	}
+
+	return 0;
+}
+
+static void load_client_thread(void *p1, void *p2, void *p3)
+{
+	struct load_client *client = p1;
+	uint32_t start;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	k_sem_take(&load_go, K_FOREVER);
+
+	for (int i = 0; i < LOAD_REQUESTS; i++) {
+		start = k_cycle_get_32();
+
+		if (load_one_request(client->fd) < 0) {
+			client->failed++;
+			return;
+		}
+
+		client->latency[i] = k_cycle_get_32() - start;
+	}
+}
+
+static int latency_cmp(const void *a, const void *b)
+{
+	uint32_t la = *(const uint32_t *)a;
+	uint32_t lb = *(const uint32_t *)b;
+
+	return (la > lb) - (la < lb);
+}
+
+static uint64_t cycles_to_us(uint64_t cycles)
+{
+	return k_cyc_to_us_floor64(cycles);
+}
+
+ZTEST(server_load_tests, test_http1_keepalive_load)
+{
+	int64_t start, elapsed_ms;
+	size_t count = 0;
+
+	for (int i = 0; i < LOAD_CLIENTS; i++) {
+		struct load_client *client = &load_clients[i];
+
+		memset(client, 0, sizeof(*client));
+		client->fd = load_connect();
+
+		k_thread_create(&client->thread, load_stacks[i],
+				K_THREAD_STACK_SIZEOF(load_stacks[i]),
+				load_client_thread, client, NULL, NULL,
+				LOAD_THREAD_PRIO, 0, K_NO_WAIT);
+	}
+
+	start = k_uptime_get();
+
+	for (int i = 0; i < LOAD_CLIENTS; i++) {
+		k_sem_give(&load_go);
+	}
+
+	for (int i = 0; i < LOAD_CLIENTS; i++) {
+		zassert_ok(k_thread_join(&load_clients[i].thread, K_SECONDS(60)),
+			   "Load client %d did not finish", i);
+	}
+
+	elapsed_ms = MAX(k_uptime_delta(&start), 1);
+
+	for (int i = 0; i < LOAD_CLIENTS; i++) {
+		struct load_client *client = &load_clients[i];
+
+		(void)zsock_close(client->fd);
+		zassert_equal(client->failed, 0, "Load client %d failed", i);
+
+		memcpy(&latencies[count], client->latency, sizeof(client->latency));
+		count += ARRAY_SIZE(client->latency);
+	}
+
+	qsort(latencies, count, sizeof(latencies[0]), latency_cmp);
+
+	TC_PRINT("HTTP server load: %d workers, %d clients, %zu requests in %" PRId64 " ms\n",
+		 CONFIG_HTTP_SERVER_NUM_WORKERS, LOAD_CLIENTS, count, elapsed_ms);
+	TC_PRINT("  throughput: %" PRId64 " req/s\n",
+		 (int64_t)count * MSEC_PER_SEC / elapsed_ms);
+	TC_PRINT("  latency: p50 %" PRIu64 " us, p99 %" PRIu64 " us, max %" PRIu64 " us\n",
+		 cycles_to_us(latencies[count / 2]),
+		 cycles_to_us(latencies[(count * 99) / 100]),
+		 cycles_to_us(latencies[count - 1]));
+}
+
+static void *server_load_setup(void)
+{
+	zassert_ok(http_server_start(), "Failed to start the server");
+
+	/* Let the server thread set up the listening socket */
+	k_sleep(K_MSEC(100));
+
+	return NULL;
+}
+
+static void server_load_teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	(void)http_server_stop();
+}
+
+ZTEST_SUITE(server_load_tests, NULL, server_load_setup, NULL, NULL,
+	    server_load_teardown);
@@ -0,0 +1,151 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <zephyr/ztest.h>
+#include <zephyr/net/http/service.h>
+#include <zephyr/net/http/server.h>
+
+#define LOOKUP_ITERATIONS 1000
+
+static struct http_resource_detail item_detail = {
+	.type = HTTP_RESOURCE_TYPE_STATIC,
+	.bitmask_of_supported_http_methods = BIT(HTTP_GET),
+};
+
+static struct http_resource_detail static_detail = {
+	.type = HTTP_RESOURCE_TYPE_STATIC_FS,
+	.bitmask_of_supported_http_methods = BIT(HTTP_GET),
+};
+
+static struct http_resource_detail root_detail = {
+	.type = HTTP_RESOURCE_TYPE_STATIC,
+	.bitmask_of_supported_http_methods = BIT(HTTP_GET),
+};
+
+/* Each service exposes a REST-like tree of N items under /api/v1/, one
+ * wildcard resource and the root resource.
+ */
+#define ITEM_RESOURCE(i, _service)                                                                 \
+	HTTP_RESOURCE_DEFINE(_service##_item_##i, _service, "/api/v1/item" STRINGIFY(i),          \
+			     &item_detail)
+
+#define ROUTING_SERVICE(_service, _port, _count)                                                   \
+	static uint16_t _service##_port = _port;                                                   \
+	HTTP_SERVICE_DEFINE(_service, NULL, &_service##_port, 1, 1, NULL, NULL);                   \
+	HTTP_RESOURCE_DEFINE(_service##_root, _service, "/", &root_detail);                        \
+	HTTP_RESOURCE_DEFINE(_service##_static, _service, "/static/*", &static_detail);            \
+	LISTIFY(_count, ITEM_RESOURCE, (;), _service)
+
+ROUTING_SERVICE(service_16, 8016, 16);
+ROUTING_SERVICE(service_64, 8064, 64);
+ROUTING_SERVICE(service_256, 8256, 256);
+
+extern struct http_resource_detail *get_resource_detail(const struct http_service_desc *service,
+							const char *path,
+							int *path_len,
+							bool is_websocket);
+
+static void check_service(const struct http_service_desc *svc, int count)
+{
+	struct http_resource_detail *res;
+	char path[32];
+	int len;
+
+	for (int i = 0; i < count; i++) {
+		snprintf(path, sizeof(path), "/api/v1/item%d", i);
+
+		len = 0;
+		res = get_resource_detail(svc, path, &len, false);
+		zassert_equal(res, &item_detail, "Resource mismatch for %s", path);
+		zassert_equal(len, strlen(path), "Length mismatch for %s", path);
+
+		snprintf(path, sizeof(path), "/api/v1/item%d?x=1", i);
+
+		res = get_resource_detail(svc, path, &len, false);
+		zassert_equal(res, &item_detail, "Resource mismatch for %s", path);
+		zassert_equal(len, strchr(path, '?') - path, "Length mismatch for %s", path);
+	}
+
+	len = 0;
+	res = get_resource_detail(svc, "/", &len, false);
+	zassert_equal(res, &root_detail, "Resource mismatch for /");
+	zassert_equal(len, 1, "Length mismatch for /");
+
+	res = get_resource_detail(svc, "/static/css/main.css", &len, false);
+	zassert_equal(res, &static_detail, "Resource mismatch for static file");
+
+	len = 0;
+	res = get_resource_detail(svc, "/api/v1/item", &len, false);
+	zassert_is_null(res, "Resource found");
+	zassert_equal(len, 0, "Length set");
+
+	res = get_resource_detail(svc, "/api/v2/item0", &len, false);
+	zassert_is_null(res, "Resource found");
+
+	res = get_resource_detail(svc, "/static", &len, false);
+	zassert_is_null(res, "Resource found");
+
+	/* Items only exist on larger services */
+	snprintf(path, sizeof(path), "/api/v1/item%d", count);
+	res = get_resource_detail(svc, path, &len, false);
+	zassert_is_null(res, "Resource found");
+}
+
+ZTEST(http_routing, test_lookup)
+{
+	check_service(&service_16, 16);
+	check_service(&service_64, 64);
+	check_service(&service_256, 256);
+}
+
+static uint64_t lookup_time_ns(const struct http_service_desc *svc, const char *path)
+{
+	uint32_t start, cycles;
+	int len;
+
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < LOOKUP_ITERATIONS; i++) {
+		(void)get_resource_detail(svc, path, &len, false);
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	return k_cyc_to_ns_floor64(cycles) / LOOKUP_ITERATIONS;
+}
+
+static void bench_service(const struct http_service_desc *svc, int count)
+{
+	char last[32];
+
+	snprintf(last, sizeof(last), "/api/v1/item%d", count - 1);
+
+	/* Warm up, so that a lazily built index is not part of the measurement */
+	(void)lookup_time_ns(svc, "/");
+
+	TC_PRINT("%4d resources: first %6" PRIu64 " ns, last %6" PRIu64 " ns, miss %6" PRIu64
+		 " ns\n",
+		 count + 2,
+		 lookup_time_ns(svc, "/"),
+		 lookup_time_ns(svc, last),
+		 lookup_time_ns(svc, "/api/v1/missing"));
+}
+
+ZTEST(http_routing, test_lookup_benchmark)
+{
+	TC_PRINT("Resource lookup time (%s):\n",
+		 IS_ENABLED(CONFIG_HTTP_SERVER_RESOURCE_INDEX) ? "index" : "linear");
+
+	bench_service(&service_16, 16);
+	bench_service(&service_64, 64);
+	bench_service(&service_256, 256);
+}
+
+ZTEST_SUITE(http_routing, NULL, NULL, NULL, NULL, NULL);
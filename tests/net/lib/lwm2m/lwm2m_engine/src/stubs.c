@@ -24,6 +24,8 @@ DEFINE_FAKE_VALUE_FUNC(int, generate_notify_message, struct lwm2m_ctx *, struct
 		       void *);
 DEFINE_FAKE_VALUE_FUNC(int64_t, engine_observe_shedule_next_event, struct observe_node *, uint16_t,
 		       const int64_t);
+DEFINE_FAKE_VALUE_FUNC(int, engine_observe_align_notifications, struct lwm2m_ctx *,
+		       const int64_t);
 DEFINE_FAKE_VALUE_FUNC(int, handle_request, struct coap_packet *, struct lwm2m_message *);
 DEFINE_FAKE_VOID_FUNC(lwm2m_udp_receive, struct lwm2m_ctx *, uint8_t *, uint16_t,
 		      struct sockaddr *);
@@ -501,4 +501,54 @@ ZTEST(lwm2m_observation, test_add_path_to_list_duplicate)
 	run_insertion_test(insert_path_str, ARRAY_SIZE(insert_path_str), expected_path_str);
 }
 
+static void align_observer_add(struct lwm2m_ctx *ctx, struct observe_node *obs,
+			       struct lwm2m_obj_path_list *entry, int64_t last_timestamp,
+			       int64_t event_timestamp)
+{
+	memset(obs, 0, sizeof(*obs));
+	sys_slist_init(&obs->path_list);
+	entry->path = LWM2M_OBJ(LWM2M_OBJECT_DEVICE_ID);
+	sys_slist_append(&obs->path_list, &entry->node);
+	obs->last_timestamp = last_timestamp;
+	obs->event_timestamp = event_timestamp;
+	sys_slist_append(&ctx->observer, &obs->node);
+}
+
+ZTEST(lwm2m_observation, test_align_notifications)
+{
+	const int64_t window = MSEC_PER_SEC * CONFIG_LWM2M_ENGINE_NOTIFY_ALIGN_WINDOW;
+	const int64_t pmin = MSEC_PER_SEC * CONFIG_LWM2M_SERVER_DEFAULT_PMIN;
+	struct lwm2m_obj_path_list entries[4];
+	struct observe_node obs[4];
+	struct lwm2m_ctx ctx;
+	int64_t now;
+
+	if (window == 0 || pmin == 0) {
+		ztest_test_skip();
+	}
+
+	memset(&ctx, 0, sizeof(ctx));
+	sys_slist_init(&ctx.observer);
+	now = k_uptime_get();
+
+	/* Due, within the window, beyond the window, and within pmin */
+	align_observer_add(&ctx, &obs[0], &entries[0], now - 2 * window, now);
+	align_observer_add(&ctx, &obs[1], &entries[1], now - pmin, now + window / 2);
+	align_observer_add(&ctx, &obs[2], &entries[2], now - pmin, now + window + 1);
+	align_observer_add(&ctx, &obs[3], &entries[3], now - pmin + 1, now + window / 2);
+
+	zassert_equal(engine_observe_align_notifications(&ctx, now), 1);
+	zassert_equal(ctx.notify_stats.aligned, 1);
+	zassert_equal(obs[0].event_timestamp, now);
+	zassert_equal(obs[1].event_timestamp, now);
+	zassert_equal(obs[2].event_timestamp, now + window + 1);
+	zassert_equal(obs[3].event_timestamp, now + window / 2);
+
+	/* Nothing is brought forward when no notification is due */
+	obs[0].event_timestamp = now + window / 2;
+	obs[1].event_timestamp = now + window / 2;
+	zassert_equal(engine_observe_align_notifications(&ctx, now), 0);
+	zassert_equal(obs[1].event_timestamp, now + window / 2);
+}
+
 ZTEST_SUITE(lwm2m_observation, NULL, NULL, NULL, NULL, NULL);
@@ -5,6 +5,8 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <inttypes.h>
+
 #include <zephyr/ztest.h>
 #include <zephyr/misc/lorem_ipsum.h>
 #include <zephyr/net/socket.h>
@@ -20,12 +22,18 @@
 #define BUFFER_SIZE        128
 #define BROKER_BUFFER_SIZE 1500
 #define TIMEOUT            100
+#define QUEUE_BUFFER_SIZE  512
+#define QUEUE_MSG_COUNT    16
+#define BENCH_MSG_COUNT    64
 
 static uint8_t broker_buf[BROKER_BUFFER_SIZE];
 static size_t broker_offset;
 static uint8_t broker_topic[32];
 static uint8_t rx_buffer[BUFFER_SIZE];
 static uint8_t tx_buffer[BUFFER_SIZE];
+#if defined(CONFIG_MQTT_PUBLISH_QUEUE)
+static uint8_t tx_queue_buffer[QUEUE_BUFFER_SIZE];
+#endif
 static struct mqtt_client client_ctx;
 static struct sockaddr broker;
 int s_sock = -1, c_sock = -1;
@@ -41,6 +49,7 @@ static struct mqtt_test_ctx {
 	bool suback_handled;
 	bool unsuback_handled;
 	uint16_t msg_id;
+	int puback_count;
 	int payload_left;
 	const uint8_t *payload;
 } test_ctx;
@@ -497,8 +506,12 @@ static void mqtt_evt_handler(struct mqtt_client *const client,
 
 	case MQTT_EVT_PUBACK:
 		zassert_ok(evt->result, "MQTT PUBACK error %d", evt->result);
-		zassert_equal(evt->param.puback.message_id, test_ctx.msg_id,
-			      "Invalid packet ID received.");
+		/* No single packet ID to check with several messages in flight. */
+		if (test_ctx.msg_id != 0) {
+			zassert_equal(evt->param.puback.message_id, test_ctx.msg_id,
+				      "Invalid packet ID received.");
+		}
+		test_ctx.puback_count++;
 		test_ctx.puback_handled = true;
 
 		break;
@@ -572,6 +585,10 @@ static void client_init(struct mqtt_client *client)
 	client->rx_buf_size = sizeof(rx_buffer);
 	client->tx_buf = tx_buffer;
 	client->tx_buf_size = sizeof(tx_buffer);
+#if defined(CONFIG_MQTT_PUBLISH_QUEUE)
+	client->tx_queue_buf = tx_queue_buffer;
+	client->tx_queue_buf_size = sizeof(tx_queue_buffer);
+#endif
 }
 
 static void test_connect(void)
@@ -801,6 +818,173 @@ ZTEST(mqtt_client, test_mqtt_pubsub_long)
 	zassert_true(test_ctx.puback_handled, "MQTT client should receive puback");
 }
 
+#if defined(CONFIG_MQTT_PUBLISH_QUEUE)
+static void publish_param_init(struct mqtt_publish_param *param, uint16_t message_id)
+{
+	memset(param, 0, sizeof(*param));
+	param->message.topic.qos = MQTT_QOS_1_AT_LEAST_ONCE;
+	param->message.topic.topic.utf8 = (uint8_t *)get_mqtt_topic();
+	param->message.topic.topic.size = strlen(get_mqtt_topic());
+	param->message.payload.data = (uint8_t *)test_ctx.payload;
+	param->message.payload.len = strlen(test_ctx.payload);
+	param->message_id = message_id;
+}
+
+static void wait_for_pubacks(int count)
+{
+	int ret;
+
+	while (test_ctx.puback_count < count) {
+		client_wait(false);
+		ret = mqtt_input(&client_ctx);
+		zassert_ok(ret, "MQTT client input processing failed (%d)", ret);
+	}
+}
+
+ZTEST(mqtt_client, test_mqtt_publish_queue)
+{
+	struct mqtt_publish_param param;
+	int ret;
+
+	test_ctx.payload = payload_short;
+
+	test_connect();
+
+	for (int i = 0; i < QUEUE_MSG_COUNT; i++) {
+		publish_param_init(&param, i + 1);
+		ret = mqtt_publish_queue(&client_ctx, &param);
+		zassert_ok(ret, "MQTT client failed to queue publish (%d)", ret);
+	}
+
+	zassert_equal(mqtt_publish_queue(&client_ctx, &param), -EBUSY,
+		      "Packet ID already in flight should be rejected");
+
+	publish_param_init(&param, QUEUE_MSG_COUNT + 1);
+	zassert_equal(mqtt_publish_queue(&client_ctx, &param), -EAGAIN,
+		      "In-flight window should be full");
+
+	/* All the queued messages go out in a single write. */
+	ret = mqtt_publish_flush(&client_ctx);
+	zassert_ok(ret, "MQTT client failed to flush publish queue (%d)", ret);
+
+	for (int i = 0; i < QUEUE_MSG_COUNT; i++) {
+		broker_process(MQTT_PKT_TYPE_PUBLISH);
+	}
+
+	wait_for_pubacks(QUEUE_MSG_COUNT);
+
+	ret = mqtt_publish_queue(&client_ctx, &param);
+	zassert_ok(ret, "In-flight window should be open again (%d)", ret);
+
+	/* Disconnecting writes out the queued message first. */
+	ret = mqtt_disconnect(&client_ctx, NULL);
+	zassert_ok(ret, "MQTT client failed to disconnect (%d)", ret);
+	broker_process(MQTT_PKT_TYPE_PUBLISH);
+	broker_process(MQTT_PKT_TYPE_DISCONNECT);
+}
+
+ZTEST(mqtt_client, test_mqtt_publish_inflight)
+{
+	struct mqtt_publish_param param;
+	int ret;
+
+	test_ctx.payload = payload_short;
+	test_ctx.puback_count = 0;
+
+	test_connect();
+
+	/* Messages sent directly take a slot of the in-flight window too. */
+	for (int i = 0; i < QUEUE_MSG_COUNT; i++) {
+		publish_param_init(&param, i + 1);
+		ret = mqtt_publish(&client_ctx, &param);
+		zassert_ok(ret, "MQTT client failed to publish (%d)", ret);
+		broker_process(MQTT_PKT_TYPE_PUBLISH);
+	}
+
+	param.dup_flag = 1U;
+	ret = mqtt_publish(&client_ctx, &param);
+	zassert_ok(ret, "Retransmission should keep its slot (%d)", ret);
+	broker_process(MQTT_PKT_TYPE_PUBLISH);
+
+	publish_param_init(&param, QUEUE_MSG_COUNT + 1);
+	zassert_equal(mqtt_publish(&client_ctx, &param), -EAGAIN,
+		      "In-flight window should be full");
+	zassert_equal(mqtt_publish_queue(&client_ctx, &param), -EAGAIN,
+		      "In-flight window should be full");
+
+	wait_for_pubacks(QUEUE_MSG_COUNT + 1);
+
+	ret = mqtt_publish(&client_ctx, &param);
+	zassert_ok(ret, "In-flight window should be open again (%d)", ret);
+	broker_process(MQTT_PKT_TYPE_PUBLISH);
+	wait_for_pubacks(QUEUE_MSG_COUNT + 2);
+
+	ret = mqtt_disconnect(&client_ctx, NULL);
+	zassert_ok(ret, "MQTT client failed to disconnect (%d)", ret);
+	broker_process(MQTT_PKT_TYPE_DISCONNECT);
+}
+
+static void bench_report(const char *name, uint32_t ops, uint32_t cycles)
+{
+	uint64_t ns = k_cyc_to_ns_floor64(cycles);
+
+	TC_PRINT("%s: %u messages in %" PRIu64 " us, %" PRIu64 " ns per message\n",
+		 name, ops, ns / NSEC_PER_USEC, ns / ops);
+}
+
+/* Compare publishing through the loopback broker one message at a time with
+ * a full in-flight window written out in batches.
+ */
+ZTEST(mqtt_client, test_mqtt_publish_queue_throughput)
+{
+	struct mqtt_publish_param param;
+	uint32_t start, cycles;
+	int ret;
+
+	test_ctx.payload = payload_short;
+
+	test_connect();
+
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < BENCH_MSG_COUNT; i++) {
+		publish_param_init(&param, i + 1);
+		ret = mqtt_publish(&client_ctx, &param);
+		zassert_ok(ret, "MQTT client failed to publish (%d)", ret);
+		broker_process(MQTT_PKT_TYPE_PUBLISH);
+		wait_for_pubacks(i + 1);
+	}
+
+	cycles = k_cycle_get_32() - start;
+	bench_report("Stop and wait", BENCH_MSG_COUNT, cycles);
+
+	test_ctx.puback_count = 0;
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < BENCH_MSG_COUNT; i += QUEUE_MSG_COUNT) {
+		for (int j = 0; j < QUEUE_MSG_COUNT; j++) {
+			publish_param_init(&param, i + j + 1);
+			ret = mqtt_publish_queue(&client_ctx, &param);
+			zassert_ok(ret, "MQTT client failed to queue publish (%d)", ret);
+		}
+
+		ret = mqtt_publish_flush(&client_ctx);
+		zassert_ok(ret, "MQTT client failed to flush publish queue (%d)", ret);
+
+		for (int j = 0; j < QUEUE_MSG_COUNT; j++) {
+			broker_process(MQTT_PKT_TYPE_PUBLISH);
+		}
+
+		wait_for_pubacks(i + QUEUE_MSG_COUNT);
+	}
+
+	cycles = k_cycle_get_32() - start;
+	bench_report("Publish queue", BENCH_MSG_COUNT, cycles);
+
+	test_disconnect();
+}
+#endif /* CONFIG_MQTT_PUBLISH_QUEUE */
+
 static void mqtt_tests_before(void *fixture)
 {
 	ARG_UNUSED(fixture);
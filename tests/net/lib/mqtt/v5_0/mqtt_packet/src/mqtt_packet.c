@@ -1070,6 +1070,71 @@ ZTEST(mqtt_5_packet, test_mqtt_5_publish)
 	run_packet_tests(publish_tests, ARRAY_SIZE(publish_tests));
 }
 
+#if defined(CONFIG_MQTT_TOPIC_ALIAS_AUTO)
+static uint8_t expect_publish_alias_new[] = {
+	0x32, 0x1e, ENCODED_PUBLISH_TOPIC, ENCODED_MID,
+	/* Properties */
+	0x03, 0x23, 0x00, 0x01,
+	/* Payload */
+	ENCODED_PUBLISH_PAYLOAD,
+};
+
+static uint8_t expect_publish_alias_reuse[] = {
+	0x32, 0x14, 0x00, 0x00, ENCODED_MID,
+	/* Properties */
+	0x03, 0x23, 0x00, 0x01,
+	/* Payload */
+	ENCODED_PUBLISH_PAYLOAD,
+};
+
+static void test_publish_alias_auto(const uint8_t *expected, uint16_t expected_len,
+				    bool expect_new)
+{
+	struct mqtt_publish_param param = {
+		PUBLISH_COMMON,
+	};
+	struct buf_ctx buf;
+	int ret;
+
+	zassert_equal(publish_topic_alias_apply(&client, &param), expect_new,
+		      "Unexpected topic alias assignment");
+
+	buf.cur = client.tx_buf;
+	buf.end = client.tx_buf + client.tx_buf_size;
+
+	ret = publish_encode(&client, &param, &buf);
+	zassert_ok(ret, "publish_encode failed");
+
+	memcpy(buf.end, param.message.payload.data, param.message.payload.len);
+	buf.end += param.message.payload.len;
+
+	zassert_ok(validate_buffers(&buf, expected, expected_len),
+		   "Invalid packet content");
+}
+
+ZTEST(mqtt_5_packet, test_mqtt_5_publish_topic_alias_auto)
+{
+	struct mqtt_publish_param param = {
+		PUBLISH_COMMON,
+	};
+
+	/* No alias until the server announced its Topic Alias Maximum. */
+	zassert_false(publish_topic_alias_apply(&client, &param),
+		      "Topic alias assigned without server support");
+	zassert_equal(param.prop.topic_alias, 0, "Topic alias should not be set");
+
+	client.internal.tx_topic_alias_max = 1;
+
+	/* The first message carries the topic and the new alias, the next
+	 * ones only the alias.
+	 */
+	test_publish_alias_auto(expect_publish_alias_new,
+				sizeof(expect_publish_alias_new), true);
+	test_publish_alias_auto(expect_publish_alias_reuse,
+				sizeof(expect_publish_alias_reuse), false);
+}
+#endif /* CONFIG_MQTT_TOPIC_ALIAS_AUTO */
+
 static void test_msg_puback(struct mqtt_test *test)
 {
 	struct mqtt_puback_param *exp_param =
@@ -7,6 +7,7 @@
 #include <zephyr/ztest.h>
 
 #include <zephyr/net/prometheus/counter.h>
+#include <zephyr/net/prometheus/gauge.h>
 #include <zephyr/net/prometheus/collector.h>
 #include <zephyr/net/prometheus/formatter.h>
 
@@ -19,6 +20,41 @@ PROMETHEUS_COUNTER_DEFINE(test_counter2, "Test counter 2",
 
 PROMETHEUS_COLLECTOR_DEFINE(test_custom_collector);
 
+PROMETHEUS_COUNTER_DEFINE(test_requests_total, "Test requests",
+			  ({ .key = "method", .value = "get" }), NULL);
+PROMETHEUS_GAUGE_DEFINE(test_temperature, "Test temperature",
+			({ .key = "sensor", .value = "cpu" }), NULL);
+
+PROMETHEUS_COLLECTOR_DEFINE(test_cached_collector);
+
+/* Two series of the same family, and a metric without labels */
+static struct prometheus_gauge test_fan_front = {
+	.base.name = "test_fan_rpm",
+	.base.type = PROMETHEUS_GAUGE,
+	.base.description = "Test fan speed",
+	.base.labels[0] = { .key = "fan", .value = "front" },
+	.base.num_labels = 1,
+};
+static struct prometheus_gauge test_fan_rear = {
+	.base.name = "test_fan_rpm",
+	.base.type = PROMETHEUS_GAUGE,
+	.base.description = "Test fan speed",
+	.base.labels[0] = { .key = "fan", .value = "rear" },
+	.base.num_labels = 1,
+};
+static struct prometheus_counter test_boots = {
+	.base.name = "test_boots",
+	.base.type = PROMETHEUS_COUNTER,
+	.base.description = "Test boots",
+};
+
+PROMETHEUS_COLLECTOR_DEFINE(test_family_collector);
+
+PROMETHEUS_EXPOSITION_CACHE_DEFINE(test_text_cache, test_cached_collector,
+				   PROMETHEUS_FORMAT_TEXT, 2, MAX_BUFFER_SIZE);
+PROMETHEUS_EXPOSITION_CACHE_DEFINE(test_openmetrics_cache, test_cached_collector,
+				   PROMETHEUS_FORMAT_OPENMETRICS, 2, MAX_BUFFER_SIZE);
+
 /**
  * @brief Test Prometheus formatter
  * @details The test shall increment the counter value by 1 and check if the
@@ -63,4 +99,142 @@ ZTEST(test_formatter, test_prometheus_formatter_simple)
 		      exposed, formatted);
 }
 
-ZTEST_SUITE(test_formatter, NULL, NULL, NULL, NULL, NULL);
+/**
+ * @brief Test the cached Prometheus formatter
+ * @details The test shall format the exposition of a collector with a cache,
+ * update one of the metrics and check that both the unchanged and the updated
+ * metrics match the uncached formatting.
+ */
+ZTEST(test_formatter, test_prometheus_formatter_cached)
+{
+	static char formatted[MAX_BUFFER_SIZE];
+	static char cached[MAX_BUFFER_SIZE];
+	int ret;
+
+	prometheus_collector_register_metric(&test_cached_collector, &test_requests_total.base);
+	prometheus_collector_register_metric(&test_cached_collector, &test_temperature.base);
+
+	for (int i = 0; i < 3; i++) {
+		if (i > 0) {
+			zassert_ok(prometheus_counter_inc(&test_requests_total));
+		}
+
+		if (i > 1) {
+			zassert_ok(prometheus_gauge_set(&test_temperature, 42.5));
+		}
+
+		formatted[0] = '\0';
+		ret = prometheus_format_exposition(&test_cached_collector, formatted,
+						   sizeof(formatted));
+		zassert_ok(ret, "Error formatting exposition data");
+
+		ret = prometheus_format_exposition_cached(&test_text_cache, cached,
+							  sizeof(cached));
+		zassert_ok(ret, "Error formatting cached exposition data");
+
+		zassert_equal(strcmp(cached, formatted), 0,
+			      "Cached exposition differs (expected\n\"%s\", got\n\"%s\")",
+			      formatted, cached);
+	}
+
+	/* A label rewritten along with the value must not reuse the old text */
+	test_temperature.base.labels[0].value = "gpu";
+	zassert_ok(prometheus_gauge_set(&test_temperature, 50.0));
+
+	formatted[0] = '\0';
+	ret = prometheus_format_exposition(&test_cached_collector, formatted, sizeof(formatted));
+	zassert_ok(ret, "Error formatting exposition data");
+
+	ret = prometheus_format_exposition_cached(&test_text_cache, cached, sizeof(cached));
+	zassert_ok(ret, "Error formatting cached exposition data");
+	zassert_equal(strcmp(cached, formatted), 0,
+		      "Cached exposition differs (expected\n\"%s\", got\n\"%s\")", formatted,
+		      cached);
+
+	/* The output does not fit, and the next scrape formats from scratch */
+	ret = prometheus_format_exposition_cached(&test_text_cache, cached, 32);
+	zassert_equal(ret, -ENOMEM, "Buffer overflow not detected");
+
+	ret = prometheus_format_exposition_cached(&test_text_cache, cached, sizeof(cached));
+	zassert_ok(ret, "Error formatting cached exposition data");
+	zassert_equal(strcmp(cached, formatted), 0, "Cached exposition differs");
+}
+
+/**
+ * @brief Test the compact OpenMetrics format
+ * @details The test shall format the exposition in the OpenMetrics format and
+ * compare it with the expected output.
+ */
+ZTEST(test_formatter, test_prometheus_formatter_openmetrics)
+{
+	char formatted[MAX_BUFFER_SIZE];
+	char exposed[] = "# TYPE test_temperature gauge\n"
+			 "test_temperature{sensor=\"cpu\"} 20.000000\n"
+			 "# TYPE test_requests counter\n"
+			 "test_requests_total{method=\"get\"} 7\n"
+			 "# EOF\n";
+	int ret;
+
+	prometheus_collector_register_metric(&test_cached_collector, &test_requests_total.base);
+	prometheus_collector_register_metric(&test_cached_collector, &test_temperature.base);
+
+	zassert_ok(prometheus_counter_set(&test_requests_total, 7));
+	zassert_ok(prometheus_gauge_set(&test_temperature, 20.0));
+
+	prometheus_exposition_cache_reset(&test_openmetrics_cache);
+
+	/* The second scrape is served from the cache */
+	for (int i = 0; i < 2; i++) {
+		ret = prometheus_format_exposition_cached(&test_openmetrics_cache, formatted,
+							  sizeof(formatted));
+		zassert_ok(ret, "Error formatting exposition data");
+
+		zassert_equal(strcmp(formatted, exposed), 0,
+			      "Exposition format is not as expected (expected\n\"%s\", "
+			      "got\n\"%s\")", exposed, formatted);
+	}
+}
+
+/**
+ * @brief Test the formatting of metric families
+ * @details The test shall format metrics sharing the same name as a single
+ * family with one HELP and TYPE header, and a metric without labels as a bare
+ * sample.
+ */
+ZTEST(test_formatter, test_prometheus_formatter_family)
+{
+	char formatted[MAX_BUFFER_SIZE] = { 0 };
+	char exposed[] = "# HELP test_boots Test boots\n"
+			 "# TYPE test_boots counter\n"
+			 "test_boots 3\n"
+			 "# HELP test_fan_rpm Test fan speed\n"
+			 "# TYPE test_fan_rpm gauge\n"
+			 "test_fan_rpm{fan=\"front\"} 1200.000000\n"
+			 "test_fan_rpm{fan=\"rear\"} 900.000000\n";
+	int ret;
+
+	prometheus_collector_register_metric(&test_family_collector, &test_fan_rear.base);
+	prometheus_collector_register_metric(&test_family_collector, &test_fan_front.base);
+	prometheus_collector_register_metric(&test_family_collector, &test_boots.base);
+
+	zassert_ok(prometheus_gauge_set(&test_fan_front, 1200.0));
+	zassert_ok(prometheus_gauge_set(&test_fan_rear, 900.0));
+	zassert_ok(prometheus_counter_set(&test_boots, 3));
+
+	ret = prometheus_format_exposition(&test_family_collector, formatted, sizeof(formatted));
+	zassert_ok(ret, "Error formatting exposition data");
+
+	zassert_equal(strcmp(formatted, exposed), 0,
+		      "Exposition format is not as expected (expected\n\"%s\", got\n\"%s\")",
+		      exposed, formatted);
+}
+
+static void after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	/* Restore the label rewritten by the cached test, even if it failed */
+	test_temperature.base.labels[0].value = "cpu";
+}
+
+ZTEST_SUITE(test_formatter, NULL, NULL, NULL, after, NULL);
@@ -0,0 +1,109 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+
+#include <zephyr/net/prometheus/collector.h>
+#include <zephyr/net/prometheus/formatter.h>
+
+#define MAX_BUFFER_SIZE 16384
+
+K_HEAP_DEFINE(test_heap, 1024);
+K_MEM_SLAB_DEFINE(test_slab, 32, 4, 4);
+
+static char formatted[MAX_BUFFER_SIZE];
+
+static int count_lines(const char *text, const char *prefix)
+{
+	int count = 0;
+
+	for (const char *line = text; line != NULL && *line != '\0';) {
+		if (strncmp(line, prefix, strlen(prefix)) == 0) {
+			count++;
+		}
+
+		line = strchr(line, '\n');
+		if (line != NULL) {
+			line++;
+		}
+	}
+
+	return count;
+}
+
+static void scrape(void)
+{
+	int ret;
+
+	formatted[0] = '\0';
+	ret = prometheus_format_exposition(&prometheus_system_collector, formatted,
+					   sizeof(formatted));
+	zassert_ok(ret, "Error formatting exposition data");
+}
+
+/**
+ * @brief Test the thread statistics
+ * @details The test shall check that the running thread is exported, and
+ * that the series of all threads are grouped under a single header.
+ */
+ZTEST(test_system, test_prometheus_system_threads)
+{
+	char line[128];
+	int ret;
+
+	scrape();
+
+	/* The threads are labeled with their name and address */
+	ret = snprintk(line, sizeof(line), "zephyr_thread_cycles_total{thread=\"%s@%p\"} ",
+		       k_thread_name_get(k_current_get()), k_current_get());
+	zassert_true(ret > 0 && ret < sizeof(line), "Line truncated");
+	zassert_equal(count_lines(formatted, line), 1, "Current thread not found in\n%s",
+		      formatted);
+
+	zassert_equal(count_lines(formatted, "# HELP zephyr_thread_cycles_total "), 1,
+		      "Thread series not grouped");
+	zassert_true(count_lines(formatted, "zephyr_thread_stack_unused_bytes{") > 1,
+		     "Thread stacks not found");
+}
+
+/**
+ * @brief Test the memory statistics
+ * @details The test shall allocate from a heap and a memory slab and check
+ * that the allocations are seen by the next scrape.
+ */
+ZTEST(test_system, test_prometheus_system_memory)
+{
+	char heap_line[80];
+	char slab_line[80];
+	void *block;
+	void *ptr;
+	int ret;
+
+	ret = snprintk(heap_line, sizeof(heap_line),
+		       "zephyr_heap_allocated_bytes{heap=\"%p\"} 0.000000", &test_heap);
+	zassert_true(ret > 0 && ret < sizeof(heap_line), "Line truncated");
+	ret = snprintk(slab_line, sizeof(slab_line),
+		       "zephyr_mem_slab_allocated_bytes{slab=\"%p\"} 32.000000", &test_slab);
+	zassert_true(ret > 0 && ret < sizeof(slab_line), "Line truncated");
+
+	scrape();
+	zassert_equal(count_lines(formatted, heap_line), 1, "Heap not found in\n%s", formatted);
+	zassert_equal(count_lines(formatted, slab_line), 0, "Slab already allocated");
+
+	ptr = k_heap_alloc(&test_heap, 64, K_NO_WAIT);
+	zassert_not_null(ptr, "Cannot allocate from heap");
+	zassert_ok(k_mem_slab_alloc(&test_slab, &block, K_NO_WAIT));
+
+	scrape();
+	zassert_equal(count_lines(formatted, heap_line), 0, "Heap allocation not seen");
+	zassert_equal(count_lines(formatted, slab_line), 1, "Slab allocation not seen in\n%s",
+		      formatted);
+
+	k_mem_slab_free(&test_slab, block);
+	k_heap_free(&test_heap, ptr);
+}
+
+ZTEST_SUITE(test_system, NULL, NULL, NULL, NULL, NULL);
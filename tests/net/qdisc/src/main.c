@@ -0,0 +1,284 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_qdisc_test, CONFIG_NET_TC_LOG_LEVEL);
+
+#include <inttypes.h>
+#include <string.h>
+
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/ztest.h>
+#include <zephyr/net/dummy.h>
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_mgmt.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/net_qdisc.h>
+
+#define PKT_LEN       100
+#define BULK_COUNT    16
+#define SHAPED_COUNT  30
+#define CODEL_COUNT   24
+#define MAX_SENT      32
+#define WAIT_TIME     K_SECONDS(2)
+#define ALLOC_TIMEOUT K_MSEC(100)
+
+/* The test packets look like IPv4 UDP packets. The flow is given by the last
+ * byte of the source address, and the payload starts with a sequence number.
+ */
+#define FLOW_OFFSET 15
+#define SEQ_OFFSET  (NET_IPV4H_LEN + NET_UDPH_LEN)
+
+#define BULK_FLOW        1
+#define INTERACTIVE_FLOW 2
+#define INTERACTIVE_SEQ  1000
+
+static struct net_if *test_iface;
+
+static K_SEM_DEFINE(send_entered, 0, 1);
+static K_SEM_DEFINE(send_gate, 0, 1);
+static K_SEM_DEFINE(send_done, 0, 1);
+static bool send_block;
+static int32_t send_delay;
+
+static uint16_t sent_seq[MAX_SENT];
+static int sent_count;
+static int sent_expected;
+
+static int iface_send(const struct device *dev, struct net_pkt *pkt)
+{
+	uint16_t seq = 0U;
+
+	ARG_UNUSED(dev);
+
+	if (send_block) {
+		send_block = false;
+		k_sem_give(&send_entered);
+		(void)k_sem_take(&send_gate, WAIT_TIME);
+	}
+
+	if (send_delay > 0) {
+		k_msleep(send_delay);
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	if (net_pkt_skip(pkt, SEQ_OFFSET) == 0) {
+		(void)net_pkt_read_be16(pkt, &seq);
+	}
+
+	if (sent_count < MAX_SENT) {
+		sent_seq[sent_count] = seq;
+	}
+
+	if (++sent_count == sent_expected) {
+		k_sem_give(&send_done);
+	}
+
+	return 0;
+}
+
+static void iface_init(struct net_if *iface)
+{
+	static uint8_t mac[6] = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x02 };
+
+	net_if_set_link_addr(iface, mac, sizeof(mac), NET_LINK_DUMMY);
+}
+
+static struct dummy_api iface_api = {
+	.iface_api.init = iface_init,
+	.send = iface_send,
+};
+
+NET_DEVICE_INIT(net_qdisc_test, "qdisc_test", NULL, NULL, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &iface_api, DUMMY_L2,
+		NET_L2_GET_CTX_TYPE(DUMMY_L2), 1500);
+
+static void send_pkt(uint8_t flow, uint16_t seq)
+{
+	uint8_t data[PKT_LEN] = {
+		/* IPv4 header, 192.0.2.x -> 192.0.2.100 */
+		0x45, 0x00, 0x00, PKT_LEN, 0x00, 0x00, 0x00, 0x00,
+		0x40, IPPROTO_UDP, 0x00, 0x00, 0xc0, 0x00, 0x02, 0x00,
+		0xc0, 0x00, 0x02, 0x64,
+		/* UDP header, port 4000 -> 5000 */
+		0x0f, 0xa0, 0x13, 0x88, 0x00, PKT_LEN - NET_IPV4H_LEN, 0x00, 0x00,
+	};
+	struct net_pkt *pkt;
+
+	data[FLOW_OFFSET] = flow;
+	sys_put_be16(seq, &data[SEQ_OFFSET]);
+
+	pkt = net_pkt_alloc_with_buffer(test_iface, sizeof(data), AF_UNSPEC, 0,
+					ALLOC_TIMEOUT);
+	zassert_not_null(pkt, "Cannot allocate packet %u", seq);
+
+	zassert_ok(net_pkt_write(pkt, data, sizeof(data)), "Cannot write packet");
+	net_pkt_set_family(pkt, AF_INET);
+	net_pkt_cursor_init(pkt);
+
+	zassert_equal(net_if_send_data(test_iface, pkt), NET_OK, "Cannot send packet %u", seq);
+}
+
+static void expect_sent(int count)
+{
+	sent_count = 0;
+	sent_expected = count;
+	k_sem_reset(&send_done);
+}
+
+static void set_params(uint32_t rate, uint32_t burst, uint32_t target, uint32_t interval)
+{
+	struct net_qdisc_params params = {
+		.rate = rate,
+		.burst = burst,
+		.target = target,
+		.interval = interval,
+	};
+
+	zassert_ok(net_mgmt(NET_REQUEST_QDISC_SET_PARAMS, test_iface, &params,
+			    sizeof(params)), "Cannot set parameters");
+}
+
+ZTEST(net_qdisc, test_fair_queueing)
+{
+	int pos;
+
+	expect_sent(BULK_COUNT + 1);
+
+	/* Hold the first packet in the driver, so that the other ones are
+	 * all queued when the transmission resumes.
+	 */
+	send_block = true;
+	send_pkt(BULK_FLOW, 0);
+	zassert_ok(k_sem_take(&send_entered, WAIT_TIME), "First packet not sent");
+
+	for (int i = 1; i < BULK_COUNT; i++) {
+		send_pkt(BULK_FLOW, i);
+	}
+
+	send_pkt(INTERACTIVE_FLOW, INTERACTIVE_SEQ);
+
+	k_sem_give(&send_gate);
+	zassert_ok(k_sem_take(&send_done, WAIT_TIME), "Only %d packets sent", sent_count);
+
+	for (pos = 0; pos < sent_count; pos++) {
+		if (sent_seq[pos] == INTERACTIVE_SEQ) {
+			break;
+		}
+	}
+
+	/* The bulk flow exhausts its quantum after two packets */
+	zassert_true(pos <= 3, "Interactive packet sent at position %d", pos);
+
+	/* The packets of a flow stay in order */
+	for (int i = 0, seq = 0; i < sent_count; i++) {
+		if (sent_seq[i] != INTERACTIVE_SEQ) {
+			zassert_equal(sent_seq[i], seq++, "Bulk flow reordered");
+		}
+	}
+
+	zassert_true(test_iface->stats.qdisc.count >= BULK_COUNT + 1,
+		     "Queueing delay not accounted");
+}
+
+ZTEST(net_qdisc, test_shaper)
+{
+	struct net_qdisc_params params;
+	int64_t start, elapsed;
+
+	/* Keep CoDel from dropping the packets delayed by the shaper */
+	set_params(10000, 1000, USEC_PER_SEC, USEC_PER_SEC);
+
+	zassert_ok(net_mgmt(NET_REQUEST_QDISC_GET_PARAMS, test_iface, &params,
+			    sizeof(params)), "Cannot get parameters");
+	zassert_equal(params.rate, 10000, "Wrong rate");
+	zassert_equal(params.burst, 1000, "Wrong burst");
+
+	expect_sent(SHAPED_COUNT);
+	start = k_uptime_get();
+
+	for (int i = 0; i < SHAPED_COUNT; i++) {
+		send_pkt(BULK_FLOW, i);
+	}
+
+	zassert_ok(k_sem_take(&send_done, WAIT_TIME), "Only %d packets sent", sent_count);
+	elapsed = k_uptime_delta(&start);
+
+	/* The burst is sent right away, the rest at 10000 bytes/s */
+	zassert_true(elapsed >= 150, "Shaped traffic sent in %" PRId64 " ms", elapsed);
+	zassert_true(test_iface->stats.qdisc.throttled > 0, "Throttling not accounted");
+
+	set_params(0, 0, CONFIG_NET_QDISC_TARGET, CONFIG_NET_QDISC_INTERVAL);
+}
+
+ZTEST(net_qdisc, test_codel_drop)
+{
+	net_stats_t dropped = test_iface->stats.qdisc.dropped;
+	int64_t timeout = k_uptime_get() + 2 * MSEC_PER_SEC;
+
+	/* A slow driver builds a standing queue well above the target */
+	set_params(0, 0, 1000, 2000);
+	send_delay = 2;
+
+	expect_sent(CODEL_COUNT);
+
+	for (int i = 0; i < CODEL_COUNT; i++) {
+		send_pkt(BULK_FLOW, i);
+	}
+
+	while (sent_count + (int)(test_iface->stats.qdisc.dropped - dropped) < CODEL_COUNT &&
+	       k_uptime_get() < timeout) {
+		k_msleep(10);
+	}
+
+	send_delay = 0;
+	dropped = test_iface->stats.qdisc.dropped - dropped;
+
+	zassert_true(dropped > 0, "No packet dropped");
+	zassert_equal(sent_count + (int)dropped, CODEL_COUNT, "Packets lost, %d sent %d dropped",
+		      sent_count, (int)dropped);
+
+	/* The packets returned after a drop are the next ones of the flow */
+	for (int i = 1; i < sent_count; i++) {
+		zassert_true(sent_seq[i] > sent_seq[i - 1], "Flow reordered");
+	}
+
+	set_params(0, 0, CONFIG_NET_QDISC_TARGET, CONFIG_NET_QDISC_INTERVAL);
+}
+
+ZTEST(net_qdisc, test_invalid_params)
+{
+	struct net_qdisc_params params = {
+		.target = 0,
+		.interval = CONFIG_NET_QDISC_INTERVAL,
+	};
+
+	zassert_equal(net_mgmt(NET_REQUEST_QDISC_SET_PARAMS, test_iface, &params,
+			       sizeof(params)), -EINVAL, "Zero target accepted");
+
+	params.target = CONFIG_NET_QDISC_INTERVAL + 1;
+	zassert_equal(net_mgmt(NET_REQUEST_QDISC_SET_PARAMS, test_iface, &params,
+			       sizeof(params)), -EINVAL, "Target above interval accepted");
+
+	params.target = CONFIG_NET_QDISC_TARGET;
+	params.rate = 1000;
+	zassert_equal(net_mgmt(NET_REQUEST_QDISC_SET_PARAMS, test_iface, &params,
+			       sizeof(params)), -EINVAL, "Zero burst accepted");
+}
+
+static void *setup(void)
+{
+	test_iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	zassert_not_null(test_iface, "No test interface");
+
+	net_if_up(test_iface);
+
+	return NULL;
+}
+
+ZTEST_SUITE(net_qdisc, NULL, setup, NULL, NULL, NULL);
@@ -544,6 +544,281 @@ static void test_route_preference(void)
 	net_route_del(route_entry);
 }
 
+static void test_route_longest_prefix_match(void)
+{
+	struct in6_addr prefix_48 = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0x1, 0, 0,
+					  0, 0, 0, 0, 0, 0, 0, 0 } } };
+	struct in6_addr prefix_64 = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0x1, 0, 0x1,
+					  0, 0, 0, 0, 0, 0, 0, 0 } } };
+	struct in6_addr host = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0x1, 0, 0x1,
+				     0, 0, 0, 0, 0, 0, 0, 0x1 } } };
+	struct in6_addr dst = host;
+	struct net_route_entry *route_48, *route_64, *route_128;
+
+	/* Add the longest prefix first, so that the route add does not
+	 * find an existing covering route for the same nexthop.
+	 */
+	route_128 = net_route_add(my_iface, &host, 128, &peer_addr,
+				  NET_IPV6_ND_INFINITE_LIFETIME,
+				  NET_ROUTE_PREFERENCE_MEDIUM);
+	zassert_not_null(route_128, "Route add failed");
+
+	route_64 = net_route_add(my_iface, &prefix_64, 64, &peer_addr,
+				 NET_IPV6_ND_INFINITE_LIFETIME,
+				 NET_ROUTE_PREFERENCE_MEDIUM);
+	zassert_not_null(route_64, "Route add failed");
+
+	route_48 = net_route_add(my_iface, &prefix_48, 48, &peer_addr,
+				 NET_IPV6_ND_INFINITE_LIFETIME,
+				 NET_ROUTE_PREFERENCE_MEDIUM);
+	zassert_not_null(route_48, "Route add failed");
+
+	zassert_equal_ptr(net_route_lookup(my_iface, &dst), route_128,
+			  "Host route not selected");
+
+	dst.s6_addr[15] = 0x2;
+	zassert_equal_ptr(net_route_lookup(my_iface, &dst), route_64,
+			  "/64 route not selected");
+	zassert_equal_ptr(net_route_lookup(NULL, &dst), route_64,
+			  "/64 route not selected for any interface");
+	zassert_is_null(net_route_lookup(peer_iface, &dst),
+			"Route found for wrong interface");
+
+	dst.s6_addr[7] = 0x2;
+	zassert_equal_ptr(net_route_lookup(my_iface, &dst), route_48,
+			  "/48 route not selected");
+
+	dst.s6_addr[5] = 0x2;
+	zassert_is_null(net_route_lookup(my_iface, &dst), "Route found");
+
+	zassert_ok(net_route_del(route_64), "Route del failed");
+
+	dst = host;
+	dst.s6_addr[15] = 0x2;
+	zassert_equal_ptr(net_route_lookup(my_iface, &dst), route_48,
+			  "/48 route not selected after /64 removal");
+	zassert_equal_ptr(net_route_lookup(my_iface, &host), route_128,
+			  "Host route not selected after /64 removal");
+
+	zassert_ok(net_route_del(route_128), "Route del failed");
+	zassert_equal_ptr(net_route_lookup(my_iface, &host), route_48,
+			  "/48 route not selected after host route removal");
+
+	zassert_ok(net_route_del(route_48), "Route del failed");
+	zassert_is_null(net_route_lookup(my_iface, &host), "Route found");
+}
+
+/* The linear lookup picks the last of several equally long matches in
+ * routing table slot order, or the first one for host routes.
+ */
+static struct net_route_entry *route_tie_winner(struct net_route_entry *a,
+						struct net_route_entry *b,
+						uint8_t prefix_len)
+{
+	bool a_first = POINTER_TO_UINT(net_route_get_nbr(a)) <
+		       POINTER_TO_UINT(net_route_get_nbr(b));
+
+	if (prefix_len == 128U) {
+		return a_first ? a : b;
+	}
+
+	return a_first ? b : a;
+}
+
+static void test_route_lookup_tie(void)
+{
+	static const uint8_t prefix_lens[] = { 64, 128 };
+	struct in6_addr dst = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0x2, 0, 0,
+				    0, 0, 0, 0, 0, 0, 0, 0x1 } } };
+	struct net_route_entry *route_my, *route_peer;
+	struct net_nbr *nbr;
+
+	/* Make the nexthop known on both interfaces, so that the same
+	 * prefix can be routed through either of them.
+	 */
+	nbr = net_ipv6_nbr_add(peer_iface, &peer_addr, &net_route_data_peer.ll_addr,
+			       false, NET_IPV6_NBR_STATE_REACHABLE);
+	zassert_not_null(nbr, "Cannot add peer to neighbor cache");
+
+	for (int i = 0; i < ARRAY_SIZE(prefix_lens); i++) {
+		route_my = net_route_add(my_iface, &dst, prefix_lens[i], &peer_addr,
+					 NET_IPV6_ND_INFINITE_LIFETIME,
+					 NET_ROUTE_PREFERENCE_MEDIUM);
+		zassert_not_null(route_my, "Route add failed");
+
+		route_peer = net_route_add(peer_iface, &dst, prefix_lens[i], &peer_addr,
+					   NET_IPV6_ND_INFINITE_LIFETIME,
+					   NET_ROUTE_PREFERENCE_MEDIUM);
+		zassert_not_null(route_peer, "Route add failed");
+
+		zassert_equal_ptr(net_route_lookup(NULL, &dst),
+				  route_tie_winner(route_my, route_peer, prefix_lens[i]),
+				  "Wrong route selected for a /%u tie", prefix_lens[i]);
+		zassert_equal_ptr(net_route_lookup(my_iface, &dst), route_my,
+				  "Route of the other interface selected");
+		zassert_equal_ptr(net_route_lookup(peer_iface, &dst), route_peer,
+				  "Route of the other interface selected");
+
+		zassert_ok(net_route_del(route_my), "Route del failed");
+		zassert_ok(net_route_del(route_peer), "Route del failed");
+	}
+
+	zassert_true(net_ipv6_nbr_rm(peer_iface, &peer_addr), "Cannot remove neighbor");
+}
+
+#define LOOKUP_ITERATIONS 1000
+
+static void test_route_lookup_benchmark(void)
+{
+	static struct in6_addr prefixes[MAX_ROUTES];
+	struct in6_addr miss = { { { 0xfd, 0xff, 0, 0, 0, 0, 0, 0,
+				     0, 0, 0, 0, 0, 0, 0, 0x1 } } };
+	struct in6_addr dst;
+	uint32_t start, cycles;
+	int i;
+
+	/* Disjoint prefixes of various lengths, fd00:<i>::/48..64 */
+	for (i = 0; i < max_routes; i++) {
+		memset(&prefixes[i], 0, sizeof(prefixes[i]));
+		prefixes[i].s6_addr[0] = 0xfd;
+		prefixes[i].s6_addr[2] = i >> 8;
+		prefixes[i].s6_addr[3] = i & 0xff;
+
+		test_routes[i] = net_route_add(my_iface, &prefixes[i], 48 + (i % 3) * 8,
+					       &peer_addr,
+					       NET_IPV6_ND_INFINITE_LIFETIME,
+					       NET_ROUTE_PREFERENCE_MEDIUM);
+		zassert_not_null(test_routes[i], "Route add failed");
+	}
+
+	for (i = 0; i < max_routes; i++) {
+		dst = prefixes[i];
+		dst.s6_addr[15] = 0x1;
+
+		zassert_equal_ptr(net_route_lookup(my_iface, &dst), test_routes[i],
+				  "Wrong route found");
+	}
+
+	start = k_cycle_get_32();
+
+	for (i = 0; i < LOOKUP_ITERATIONS; i++) {
+		dst = prefixes[i % max_routes];
+		dst.s6_addr[15] = 0x1;
+
+		(void)net_route_lookup(my_iface, &dst);
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	TC_PRINT("Route lookup (%s), %d routes: hit %u ns",
+		 IS_ENABLED(CONFIG_NET_ROUTE_TRIE) ? "trie" : "linear", max_routes,
+		 (uint32_t)(k_cyc_to_ns_floor64(cycles) / LOOKUP_ITERATIONS));
+
+	start = k_cycle_get_32();
+
+	for (i = 0; i < LOOKUP_ITERATIONS; i++) {
+		miss.s6_addr[14] = i >> 8;
+		miss.s6_addr[15] = i & 0xff;
+
+		(void)net_route_lookup(my_iface, &miss);
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	TC_PRINT(", miss %u ns\n",
+		 (uint32_t)(k_cyc_to_ns_floor64(cycles) / LOOKUP_ITERATIONS));
+
+	for (i = 0; i < max_routes; i++) {
+		zassert_ok(net_route_del(test_routes[i]), "Route del failed");
+	}
+}
+
+static struct net_pkt *flow_pkt(struct net_if *iface, struct in6_addr *src)
+{
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_alloc_with_buffer(iface, NET_IPV6H_LEN, AF_INET6, IPPROTO_UDP, K_NO_WAIT);
+	zassert_not_null(pkt, "Cannot allocate packet");
+
+	net_pkt_set_ipv6_hop_limit(pkt, 64);
+	zassert_ok(net_ipv6_create(pkt, src, &dest_addr), "Cannot create IPv6 header");
+	net_pkt_cursor_init(pkt);
+
+	return pkt;
+}
+
+static void test_route_flow_cache(void)
+{
+	struct in6_addr src = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0x2, 0, 0,
+				    0, 0, 0, 0, 0, 0, 0, 0x1 } } };
+	struct net_route_entry *route;
+	struct in6_addr *nexthop;
+	uint32_t start, slow, fast;
+	struct net_pkt *pkt;
+	int i;
+
+	if (!IS_ENABLED(CONFIG_NET_ROUTE_FLOW_CACHE)) {
+		return;
+	}
+
+	route_entry = net_route_add(my_iface, &dest_addr, 128, &peer_addr,
+				    NET_IPV6_ND_INFINITE_LIFETIME,
+				    NET_ROUTE_PREFERENCE_LOW);
+	zassert_not_null(route_entry, "Route add failed");
+
+	pkt = flow_pkt(peer_iface, &src);
+	zassert_false(net_route_flow_lookup(pkt), "Flow cached before forwarding");
+
+	/* Forward the first packet of the flow the regular way */
+	net_pkt_set_orig_iface(pkt, peer_iface);
+	net_pkt_set_iface(pkt, my_iface);
+	zassert_ok(net_route_packet(pkt, &peer_addr), "Cannot route packet");
+	k_sem_take(&wait_data, WAIT_TIME);
+
+	pkt = flow_pkt(peer_iface, &src);
+	zassert_true(net_route_flow_lookup(pkt), "Flow not cached");
+	zassert_equal_ptr(net_pkt_iface(pkt), my_iface, "Wrong interface");
+	zassert_equal_ptr(net_pkt_orig_iface(pkt), peer_iface, "Wrong original interface");
+	zassert_true(net_pkt_forwarding(pkt), "Packet not forwarded");
+
+	/* Benchmark the forwarding decision with and without the cache */
+	start = k_cycle_get_32();
+
+	for (i = 0; i < LOOKUP_ITERATIONS; i++) {
+		zassert_true(net_route_get_info(NULL, &dest_addr, &route, &nexthop));
+
+		net_ipv6_nbr_lock();
+		zassert_not_null(net_ipv6_nbr_lookup(NULL, nexthop));
+		net_ipv6_nbr_unlock();
+	}
+
+	slow = k_cycle_get_32() - start;
+	start = k_cycle_get_32();
+
+	for (i = 0; i < LOOKUP_ITERATIONS; i++) {
+		net_pkt_set_iface(pkt, peer_iface);
+		zassert_true(net_route_flow_lookup(pkt));
+	}
+
+	fast = k_cycle_get_32() - start;
+
+	TC_PRINT("Forwarding decision: route lookup %u ns, flow cache %u ns\n",
+		 (uint32_t)(k_cyc_to_ns_floor64(slow) / LOOKUP_ITERATIONS),
+		 (uint32_t)(k_cyc_to_ns_floor64(fast) / LOOKUP_ITERATIONS));
+
+	net_pkt_unref(pkt);
+
+	/* A flow received on another interface is a different flow */
+	pkt = flow_pkt(my_iface, &src);
+	zassert_false(net_route_flow_lookup(pkt), "Flow cached for wrong interface");
+	net_pkt_unref(pkt);
+
+	zassert_ok(net_route_del(route_entry), "Route del failed");
+
+	pkt = flow_pkt(peer_iface, &src);
+	zassert_false(net_route_flow_lookup(pkt), "Flow cached after route removal");
+	net_pkt_unref(pkt);
+}
 
 /*test case main entry*/
 ZTEST(route_test_suite, test_route)
@@ -566,6 +841,10 @@ ZTEST(route_test_suite, test_route)
 	test_route_del_many();
 	test_route_lifetime();
 	test_route_preference();
+	test_route_longest_prefix_match();
+	test_route_lookup_tie();
+	test_route_lookup_benchmark();
+	test_route_flow_cache();
 }
 
 ZTEST_SUITE(route_test_suite, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,369 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_rx_batch_test, CONFIG_NET_CORE_LOG_LEVEL);
+
+#include <inttypes.h>
+#include <string.h>
+
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/ztest.h>
+#include <zephyr/net/dummy.h>
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+
+#define PKT_LEN       64
+#define BATCH_SIZE    16
+#define BATCH_COUNT   4
+#define BENCH_ROUNDS  200
+#define FLOWS         16
+#define WAIT_TIME     K_SECONDS(1)
+#define ALLOC_TIMEOUT K_MSEC(100)
+
+/* The test packets look like IPv4 UDP packets, so that they can be steered
+ * by flow. The flow is given by the last byte of the source address and the
+ * source port, and the payload starts with a sequence number.
+ */
+#define FLOW_OFFSET 15
+#define SEQ_OFFSET  (NET_IPV4H_LEN + NET_UDPH_LEN)
+
+static struct net_if *test_iface;
+
+static K_SEM_DEFINE(recv_done, 0, 1);
+static atomic_t recv_count;
+static int recv_expected;
+
+/* Last sequence number received for each flow */
+static int recv_last_seq[FLOWS];
+static bool recv_in_order;
+
+#if defined(CONFIG_NET_TC_RX_RPS)
+/* CPU that processed each flow, and all the CPUs used */
+static int recv_cpu[FLOWS];
+static bool recv_same_cpu;
+static atomic_t recv_cpus;
+#endif
+
+static enum net_verdict iface_recv(struct net_if *iface, struct net_pkt *pkt)
+{
+	uint8_t hdr[SEQ_OFFSET + sizeof(uint16_t)];
+	uint8_t flow;
+	uint16_t seq;
+
+	ARG_UNUSED(iface);
+
+	if (net_pkt_read(pkt, hdr, sizeof(hdr)) < 0) {
+		recv_in_order = false;
+		goto out;
+	}
+
+	flow = hdr[FLOW_OFFSET] % FLOWS;
+	seq = sys_get_be16(&hdr[SEQ_OFFSET]);
+
+	if (seq <= recv_last_seq[flow]) {
+		recv_in_order = false;
+	}
+
+	recv_last_seq[flow] = seq;
+
+#if defined(CONFIG_NET_TC_RX_RPS)
+	int cpu = arch_curr_cpu()->id;
+
+	if (recv_cpu[flow] >= 0 && recv_cpu[flow] != cpu) {
+		recv_same_cpu = false;
+	}
+
+	recv_cpu[flow] = cpu;
+	atomic_or(&recv_cpus, BIT(cpu));
+#endif
+
+out:
+	net_pkt_unref(pkt);
+
+	if (atomic_inc(&recv_count) + 1 == recv_expected) {
+		k_sem_give(&recv_done);
+	}
+
+	return NET_OK;
+}
+
+static void iface_init(struct net_if *iface)
+{
+	static uint8_t mac[6] = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x01 };
+
+	net_if_set_link_addr(iface, mac, sizeof(mac), NET_LINK_DUMMY);
+}
+
+static int iface_send(const struct device *dev, struct net_pkt *pkt)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static struct dummy_api iface_api = {
+	.iface_api.init = iface_init,
+	.send = iface_send,
+	.recv = iface_recv,
+};
+
+NET_DEVICE_INIT(net_rx_batch_test, "rx_batch_test", NULL, NULL, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &iface_api, DUMMY_L2,
+		NET_L2_GET_CTX_TYPE(DUMMY_L2), 1500);
+
+/* The flow and the priority of a packet are derived from its sequence number.
+ * A fragment other than the first one has no UDP header, so the bytes where
+ * the ports would be vary from fragment to fragment.
+ */
+static struct net_pkt *create_frag_pkt(uint16_t seq, uint16_t frag)
+{
+	static uint8_t data[PKT_LEN] = {
+		/* IPv4 header, 192.0.2.x -> 192.0.2.100 */
+		0x45, 0x00, 0x00, PKT_LEN, 0x00, 0x00, 0x00, 0x00,
+		0x40, IPPROTO_UDP, 0x00, 0x00, 0xc0, 0x00, 0x02, 0x00,
+		0xc0, 0x00, 0x02, 0x64,
+		/* UDP header, port 4000 + x -> 5000 */
+		0x0f, 0x00, 0x13, 0x88, 0x00, PKT_LEN - NET_IPV4H_LEN, 0x00, 0x00,
+	};
+	uint8_t flow = seq % FLOWS;
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_rx_alloc_with_buffer(test_iface, sizeof(data), AF_UNSPEC,
+					   0, ALLOC_TIMEOUT);
+	zassert_not_null(pkt, "Cannot allocate packet %u", seq);
+
+	sys_put_be16(frag, &data[6]);
+	data[FLOW_OFFSET] = flow;
+	data[NET_IPV4H_LEN + 1] = (frag & NET_IPV4_FRAGH_OFFSET_MASK) ? seq : flow;
+	sys_put_be16(seq, &data[SEQ_OFFSET]);
+
+	zassert_ok(net_pkt_write(pkt, data, sizeof(data)), "Cannot write packet");
+	net_pkt_set_priority(pkt, seq % NET_MAX_PRIORITIES);
+
+	return pkt;
+}
+
+static struct net_pkt *create_pkt(uint16_t seq)
+{
+	return create_frag_pkt(seq, 0U);
+}
+
+static void reset_order(void)
+{
+	recv_in_order = true;
+
+	for (int i = 0; i < ARRAY_SIZE(recv_last_seq); i++) {
+		recv_last_seq[i] = -1;
+	}
+
+#if defined(CONFIG_NET_TC_RX_RPS)
+	recv_same_cpu = true;
+	atomic_clear(&recv_cpus);
+
+	for (int i = 0; i < ARRAY_SIZE(recv_cpu); i++) {
+		recv_cpu[i] = -1;
+	}
+#endif
+}
+
+static void expect_packets(int count)
+{
+	k_sem_reset(&recv_done);
+	atomic_set(&recv_count, 0);
+	recv_expected = count;
+}
+
+static void wait_packets(void)
+{
+	zassert_ok(k_sem_take(&recv_done, WAIT_TIME), "Only %ld of %d packets received",
+		   atomic_get(&recv_count), recv_expected);
+}
+
+ZTEST(net_rx_batch, test_batch)
+{
+	struct net_pkt *pkts[BATCH_SIZE];
+	uint16_t seq = 0;
+	int ret;
+
+	reset_order();
+
+	for (int i = 0; i < BATCH_COUNT; i++) {
+		for (int j = 0; j < BATCH_SIZE; j++, seq++) {
+			pkts[j] = create_pkt(seq);
+		}
+
+		expect_packets(BATCH_SIZE);
+
+		ret = net_recv_data_batch(test_iface, pkts, BATCH_SIZE);
+		zassert_equal(ret, BATCH_SIZE, "Batch not queued (%d)", ret);
+
+		wait_packets();
+	}
+
+	zassert_true(recv_in_order, "Packets reordered within a flow");
+}
+
+ZTEST(net_rx_batch, test_steering)
+{
+	uint16_t seq = 0;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_TC_RX_RPS);
+
+#if defined(CONFIG_NET_TC_RX_RPS)
+	reset_order();
+
+	for (int i = 0; i < BATCH_COUNT; i++) {
+		expect_packets(BATCH_SIZE);
+
+		for (int j = 0; j < BATCH_SIZE; j++, seq++) {
+			zassert_ok(net_recv_data(test_iface, create_pkt(seq)),
+				   "Packet not queued");
+		}
+
+		wait_packets();
+	}
+
+	zassert_true(recv_in_order, "Packets reordered within a flow");
+	zassert_true(recv_same_cpu, "Flow processed by several CPUs");
+
+	if (arch_num_cpus() > 1) {
+		atomic_val_t cpus = atomic_get(&recv_cpus);
+
+		zassert_true((cpus & (cpus - 1)) != 0,
+			     "All the flows processed by one CPU");
+	}
+#endif
+}
+
+ZTEST(net_rx_batch, test_steering_fragments)
+{
+	/* First, middle and last fragment of a datagram */
+	static const uint16_t frags[] = {
+		NET_IPV4_MORE_FRAG_MASK,
+		NET_IPV4_MORE_FRAG_MASK | 3U,
+		6U,
+	};
+	uint16_t seq = 0;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_TC_RX_RPS);
+
+#if defined(CONFIG_NET_TC_RX_RPS)
+	reset_order();
+
+	for (int i = 0; i < ARRAY_SIZE(frags); i++) {
+		expect_packets(FLOWS);
+
+		for (int j = 0; j < FLOWS; j++, seq++) {
+			zassert_ok(net_recv_data(test_iface, create_frag_pkt(seq, frags[i])),
+				   "Packet not queued");
+		}
+
+		wait_packets();
+	}
+
+	zassert_true(recv_in_order, "Fragments reordered within a datagram");
+	zassert_true(recv_same_cpu, "Datagram fragments processed by several CPUs");
+#endif
+}
+
+ZTEST(net_rx_batch, test_batch_iface_down)
+{
+	struct net_pkt *pkts[2];
+	int ret;
+
+	pkts[0] = create_pkt(0);
+	pkts[1] = create_pkt(1);
+
+	net_if_down(test_iface);
+
+	/* Nothing is consumed on error */
+	ret = net_recv_data_batch(test_iface, pkts, ARRAY_SIZE(pkts));
+	zassert_equal(ret, -ENETDOWN, "Batch queued on a down interface (%d)", ret);
+
+	net_if_up(test_iface);
+
+	net_pkt_unref(pkts[0]);
+	net_pkt_unref(pkts[1]);
+
+	/* Empty packets are released by the stack */
+	expect_packets(1);
+
+	pkts[0] = net_pkt_rx_alloc_on_iface(test_iface, ALLOC_TIMEOUT);
+	zassert_not_null(pkts[0], "Cannot allocate packet");
+	pkts[1] = create_pkt(1);
+
+	ret = net_recv_data_batch(test_iface, pkts, ARRAY_SIZE(pkts));
+	zassert_equal(ret, 1, "Unexpected number of packets queued (%d)", ret);
+
+	wait_packets();
+}
+
+/* Time needed to pass BATCH_SIZE packets to the stack and have them
+ * delivered to the interface, in cycles.
+ */
+static uint32_t bench_round(bool batch, uint16_t *seq)
+{
+	struct net_pkt *pkts[BATCH_SIZE];
+	uint32_t start;
+
+	for (int i = 0; i < BATCH_SIZE; i++, (*seq)++) {
+		pkts[i] = create_pkt(*seq);
+	}
+
+	reset_order();
+	expect_packets(BATCH_SIZE);
+	start = k_cycle_get_32();
+
+	if (batch) {
+		zassert_equal(net_recv_data_batch(test_iface, pkts, BATCH_SIZE), BATCH_SIZE,
+			      "Batch not queued");
+	} else {
+		for (int i = 0; i < BATCH_SIZE; i++) {
+			zassert_ok(net_recv_data(test_iface, pkts[i]), "Packet not queued");
+		}
+	}
+
+	wait_packets();
+
+	return k_cycle_get_32() - start;
+}
+
+static uint64_t bench_pps(bool batch)
+{
+	uint64_t cycles = 0;
+	uint16_t seq = 0;
+	uint64_t ns;
+
+	for (int i = 0; i < BENCH_ROUNDS; i++) {
+		cycles += bench_round(batch, &seq);
+	}
+
+	ns = MAX(k_cyc_to_ns_floor64(cycles), 1);
+
+	return (uint64_t)BENCH_ROUNDS * BATCH_SIZE * NSEC_PER_SEC / ns;
+}
+
+ZTEST(net_rx_batch, test_batch_benchmark)
+{
+	TC_PRINT("RX rate with %d RX queues: %" PRIu64 " pps per packet, %" PRIu64
+		 " pps in batches of %d\n",
+		 NET_TC_RX_COUNT, bench_pps(false), bench_pps(true), BATCH_SIZE);
+}
+
+static void *setup(void)
+{
+	test_iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	zassert_not_null(test_iface, "No test interface");
+
+	net_if_up(test_iface);
+
+	return NULL;
+}
+
+ZTEST_SUITE(net_rx_batch, NULL, setup, NULL, NULL, NULL);
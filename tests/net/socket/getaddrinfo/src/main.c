@@ -7,8 +7,10 @@
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
 
+#include <inttypes.h>
 #include <stdio.h>
 #include <zephyr/ztest_assert.h>
+#include <zephyr/sys/byteorder.h>
 #include <zephyr/sys/util.h>
 #include <zephyr/sys/sem.h>
 #include <zephyr/net/socket.h>
@@ -21,6 +23,10 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
 
 #define QUERY_HOST "www.zephyrproject.org"
 
+/* Answered by process_dns() with the loopback addresses */
+#define DUAL_HOST "dual.zephyrproject.org"
+#define DUAL_PORT 4242
+
 #define ANY_PORT 0
 #define MAX_BUF_SIZE 128
 #define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
@@ -48,6 +54,61 @@ static ZTEST_BMEM struct sys_sem wait_data;
 
 NET_BUF_POOL_DEFINE(test_dns_msg_pool, 1, 512, 0, NULL);
 
+/* Encoded DUAL_HOST, including the terminating root label */
+static const uint8_t dual_host_name[] = "\x04" "dual" "\x0d" "zephyrproject" "\x03" "org";
+
+/* Answer the A and AAAA queries for DUAL_HOST with 127.0.0.1 and ::1, by
+ * turning the query into a response with a single answer.
+ */
+static bool reply_dns_query(int sock, uint8_t *buf, int len,
+			    const struct sockaddr *addr, socklen_t addr_len)
+{
+	static const struct in_addr loopback4 = INADDR_LOOPBACK_INIT;
+	int offset = DNS_MSG_HEADER_SIZE + sizeof(dual_host_name);
+	uint16_t qtype;
+
+	if (len < offset + 4 ||
+	    len + 12 + sizeof(struct in6_addr) > MAX_BUF_SIZE ||
+	    memcmp(&buf[DNS_MSG_HEADER_SIZE], dual_host_name,
+		   sizeof(dual_host_name)) != 0) {
+		return false;
+	}
+
+	qtype = sys_get_be16(&buf[offset]);
+
+	/* Response, recursion desired and available, one answer */
+	buf[2] = 0x81;
+	buf[3] = 0x80;
+	sys_put_be16(1, &buf[6]);
+
+	/* Pointer to the name in the question */
+	buf[len++] = 0xc0;
+	buf[len++] = DNS_MSG_HEADER_SIZE;
+	sys_put_be16(qtype, &buf[len]);
+	len += 2;
+	sys_put_be16(DNS_CLASS_IN, &buf[len]);
+	len += 2;
+	/* TTL of zero, not to be cached */
+	sys_put_be32(0, &buf[len]);
+	len += 4;
+
+	if (qtype == DNS_RR_TYPE_A) {
+		sys_put_be16(sizeof(loopback4), &buf[len]);
+		len += 2;
+		memcpy(&buf[len], &loopback4, sizeof(loopback4));
+		len += sizeof(loopback4);
+	} else {
+		sys_put_be16(sizeof(in6addr_loopback), &buf[len]);
+		len += 2;
+		memcpy(&buf[len], &in6addr_loopback, sizeof(in6addr_loopback));
+		len += sizeof(in6addr_loopback);
+	}
+
+	(void)zsock_sendto(sock, buf, len, 0, addr, addr_len);
+
+	return true;
+}
+
 static bool check_dns_query(uint8_t *buf, int buf_len)
 {
 	struct dns_msg_t dns_msg;
@@ -156,6 +217,11 @@ static int process_dns(void)
 
 				NET_DBG("Received DNS query");
 
+				if (reply_dns_query(pollfds[idx].fd, recv_buf, ret,
+						    addr, addr_len)) {
+					continue;
+				}
+
 				ret = check_dns_query(recv_buf,
 						      sizeof(recv_buf));
 				if (ret) {
@@ -666,4 +732,58 @@ ZTEST(net_socket_getaddrinfo, test_getaddrinfo_null_host)
 	zsock_freeaddrinfo(res);
 }
 
+#if defined(CONFIG_NET_SOCKETS_CONNECT_ADDRINFO)
+ZTEST(net_socket_getaddrinfo, test_getaddrinfo_connect)
+{
+	struct zsock_addrinfo hints = {
+		.ai_socktype = SOCK_STREAM,
+	};
+	struct zsock_addrinfo *res = NULL;
+	struct sockaddr_in addr4;
+	struct sockaddr peer;
+	socklen_t peer_len = sizeof(peer);
+	bool ipv4 = false, ipv6 = false;
+	int64_t start, resolved;
+	int listener, sock, accepted;
+	int ret;
+
+	/* Only listen on IPv4, the IPv6 address is tried first and refused */
+	prepare_sock_tcp_v4("127.0.0.1", DUAL_PORT, &listener, &addr4);
+	zassert_ok(zsock_bind(listener, (struct sockaddr *)&addr4, sizeof(addr4)),
+		   "bind failed");
+	zassert_ok(zsock_listen(listener, 1), "listen failed");
+
+	start = k_uptime_get();
+
+	ret = zsock_getaddrinfo(DUAL_HOST, STRINGIFY(DUAL_PORT), &hints, &res);
+	zassert_equal(ret, 0, "Cannot resolve %s (%d)", DUAL_HOST, ret);
+
+	resolved = k_uptime_get();
+
+	for (struct zsock_addrinfo *ai = res; ai != NULL; ai = ai->ai_next) {
+		ipv4 |= ai->ai_family == AF_INET;
+		ipv6 |= ai->ai_family == AF_INET6;
+	}
+
+	zassert_true(ipv4 && ipv6, "Both address families not resolved");
+
+	sock = zsock_connect_addrinfo(res, 2 * MSEC_PER_SEC);
+	zassert_true(sock >= 0, "Cannot connect (%d)", errno);
+
+	TC_PRINT("Resolved in %" PRId64 " ms, connected %" PRId64 " ms after start\n",
+		 resolved - start, k_uptime_get() - start);
+
+	zassert_ok(zsock_getpeername(sock, &peer, &peer_len), "getpeername failed");
+	zassert_equal(peer.sa_family, AF_INET, "Connected to the wrong address");
+
+	accepted = zsock_accept(listener, NULL, NULL);
+	zassert_true(accepted >= 0, "accept failed (%d)", errno);
+
+	zsock_freeaddrinfo(res);
+	zsock_close(accepted);
+	zsock_close(sock);
+	zsock_close(listener);
+}
+#endif /* CONFIG_NET_SOCKETS_CONNECT_ADDRINFO */
+
 ZTEST_SUITE(net_socket_getaddrinfo, NULL, test_getaddrinfo_setup, NULL, NULL, NULL);
@@ -262,6 +262,69 @@ ZTEST_USER(net_socket_tcp, test_v4_send_recv)
 	k_sleep(TCP_TEARDOWN_TIMEOUT);
 }
 
+ZTEST(net_socket_tcp, test_v4_send_recv_buf)
+{
+	/* Test that recv_buf() hands out the unread part of a TCP stream */
+	int c_sock;
+	int s_sock;
+	int new_sock;
+	struct sockaddr_in c_saddr;
+	struct sockaddr_in s_saddr;
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+	static uint8_t data[sizeof(TEST_STR_LONG) - 1];
+	struct net_buf *buf;
+	size_t received;
+	ssize_t ret;
+
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, ANY_PORT, &c_sock, &c_saddr);
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, SERVER_PORT, &s_sock, &s_saddr);
+
+	test_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+
+	test_connect(c_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_send(c_sock, TEST_STR_LONG, sizeof(data), 0);
+
+	test_accept(s_sock, &new_sock, &addr, &addrlen);
+
+	ret = zsock_recv_buf(new_sock, &buf, ZSOCK_MSG_PEEK, NULL, NULL);
+	zassert_equal(ret, -1, "recv_buf with MSG_PEEK should've failed");
+	zassert_equal(errno, EINVAL, "incorrect errno");
+
+	/* Start in the middle of a segment */
+	ret = zsock_recv(new_sock, data, strlen(TEST_STR_SMALL), 0);
+	zassert_equal(ret, strlen(TEST_STR_SMALL), "recv failed (%d)", errno);
+	received = ret;
+
+	while (received < sizeof(data)) {
+		buf = NULL;
+		ret = zsock_recv_buf(new_sock, &buf, 0, NULL, NULL);
+		zassert_true(ret > 0, "recv_buf failed (%d)", errno);
+		zassert_not_null(buf, "no data");
+		zassert_equal(net_buf_frags_len(buf), ret, "wrong length");
+		zassert_true(received + ret <= sizeof(data), "too much data");
+
+		net_buf_linearize(&data[received], sizeof(data) - received,
+				  buf, 0, ret);
+		net_buf_unref(buf);
+		received += ret;
+	}
+
+	zassert_mem_equal(data, TEST_STR_LONG, sizeof(data), "wrong data");
+
+	test_close(c_sock);
+
+	ret = zsock_recv_buf(new_sock, &buf, 0, NULL, NULL);
+	zassert_equal(ret, 0, "recv_buf should've returned EOF");
+	zassert_is_null(buf, "unexpected data");
+
+	test_close(new_sock);
+	test_close(s_sock);
+
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+}
+
 ZTEST_USER(net_socket_tcp, test_v6_send_recv)
 {
 	/* Test if send() and recv() work on a ipv6 stream socket. */
@@ -7,6 +7,8 @@
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
 
+#include <inttypes.h>
+
 #include <zephyr/ztest_assert.h>
 #include <zephyr/posix/fcntl.h>
 #include <zephyr/net/loopback.h>
@@ -1814,6 +1816,222 @@ ZTEST(net_socket_tls, test_poll_dtls_pollerr)
 	k_msleep(10);
 }
 
+#define THROUGHPUT_LEN   (16 * 1024)
+#define THROUGHPUT_CHUNK 256
+#define THROUGHPUT_READ  100
+
+static uint8_t throughput_byte(size_t off)
+{
+	return off % 251;
+}
+
+static void throughput_work_handler(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct send_data *test_data =
+		CONTAINER_OF(dwork, struct send_data, tx_work);
+	uint8_t tx_buf[THROUGHPUT_CHUNK];
+
+	for (size_t off = 0; off < test_data->datalen; off += sizeof(tx_buf)) {
+		for (size_t i = 0; i < sizeof(tx_buf); i++) {
+			tx_buf[i] = throughput_byte(off + i);
+		}
+
+		test_send(test_data->sock, tx_buf, sizeof(tx_buf), 0);
+	}
+}
+
+/* Stream data over a loopback TLS connection, reading it back in pieces
+ * smaller than the records, and report the throughput. Compare the
+ * rx_buf variant against the default one.
+ */
+ZTEST(net_socket_tls, test_throughput)
+{
+	struct send_data test_data = {
+		.datalen = THROUGHPUT_LEN,
+	};
+	uint8_t rx_buf[THROUGHPUT_READ];
+	struct zsock_pollfd fds[1];
+	uint32_t start, cycles;
+	uint64_t us;
+	size_t off = 0;
+	int ret;
+
+	test_prepare_tls_connection(AF_INET);
+
+	fds[0].fd = new_sock;
+	fds[0].events = ZSOCK_POLLIN;
+
+	start = k_cycle_get_32();
+
+	test_data.sock = c_sock;
+	k_work_init_delayable(&test_data.tx_work, throughput_work_handler);
+	test_work_reschedule(&test_data.tx_work, K_NO_WAIT);
+
+	/* Poll before every read, the data already taken off the TCP socket
+	 * must still be reported.
+	 */
+	while (off < THROUGHPUT_LEN) {
+		ret = zsock_poll(fds, 1, 1000);
+		zassert_equal(ret, 1, "poll() should've report event");
+		zassert_equal(fds[0].revents, ZSOCK_POLLIN, "No POLLIN event");
+
+		ret = zsock_recv(new_sock, rx_buf, sizeof(rx_buf), ZSOCK_MSG_DONTWAIT);
+		zassert_true(ret > 0, "recv() failed (%d)", errno);
+
+		for (int i = 0; i < ret; i++) {
+			zassert_equal(rx_buf[i], throughput_byte(off + i),
+				      "Invalid data received at %zu", off + i);
+		}
+
+		off += ret;
+	}
+
+	cycles = k_cycle_get_32() - start;
+	us = MAX(k_cyc_to_us_floor64(cycles), 1);
+
+	TC_PRINT("Received %u bytes in %" PRIu64 " us, %" PRIu64 " kB/s\n",
+		 THROUGHPUT_LEN, us, (uint64_t)THROUGHPUT_LEN * USEC_PER_MSEC / us);
+
+	test_work_wait(&test_data.tx_work);
+
+	ret = zsock_recv(new_sock, rx_buf, sizeof(rx_buf), ZSOCK_MSG_DONTWAIT);
+	zassert_equal(ret, -1, "recv() should've failed");
+	zassert_equal(errno, EAGAIN, "Unexpected errno value: %d", errno);
+
+	test_sockets_close();
+
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+}
+
+#if defined(CONFIG_MBEDTLS_SSL_CACHE_C) || defined(CONFIG_NET_SOCKETS_TLS_SESSION_TICKETS)
+#define RESUMPTION_ROUNDS 3
+#define MASTER_SECRET_LEN 48
+
+static void test_session_cache_enable(int sock)
+{
+	int optval = TLS_SESSION_CACHE_ENABLED;
+
+	zassert_equal(zsock_setsockopt(sock, SOL_TLS, TLS_SESSION_CACHE,
+				       &optval, sizeof(optval)),
+		      0, "Failed to enable session cache");
+}
+
+/* Record the master secret, which a resumed session shares with the
+ * handshake that created it.
+ */
+static void test_session_export_keys(void *p_expkey, mbedtls_ssl_key_export_type type,
+				     const unsigned char *secret, size_t secret_len,
+				     const unsigned char client_random[32],
+				     const unsigned char server_random[32],
+				     mbedtls_tls_prf_types tls_prf_type)
+{
+	ARG_UNUSED(client_random);
+	ARG_UNUSED(server_random);
+	ARG_UNUSED(tls_prf_type);
+
+	if (type == MBEDTLS_SSL_KEY_EXPORT_TLS12_MASTER_SECRET) {
+		memcpy(p_expkey, secret, MIN(secret_len, MASTER_SECRET_LEN));
+	}
+}
+
+/* Connect a new client to the server socket, and return the handshake time
+ * along with the master secret of the session.
+ */
+static uint32_t test_session_connect(struct sockaddr_in *s_saddr, uint8_t *master)
+{
+	static const uint8_t no_master[MASTER_SECRET_LEN];
+	struct connect_data test_data;
+	struct sockaddr_in c_saddr;
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+	mbedtls_ssl_context *ssl;
+	uint32_t start, cycles;
+
+	prepare_sock_tls_v4(MY_IPV4_ADDR, ANY_PORT, &c_sock, &c_saddr,
+			    IPPROTO_TLS_1_2);
+	test_config_psk(-1, c_sock);
+	test_session_cache_enable(c_sock);
+
+	ssl = ztls_get_mbedtls_ssl_context(c_sock);
+	zassert_not_null(ssl, "No TLS context");
+	memset(master, 0, MASTER_SECRET_LEN);
+	mbedtls_ssl_set_export_keys_cb(ssl, test_session_export_keys, master);
+
+	start = k_cycle_get_32();
+
+	test_data.sock = c_sock;
+	test_data.addr = (struct sockaddr *)s_saddr;
+	k_work_init_delayable(&test_data.work, client_connect_work_handler);
+	test_work_reschedule(&test_data.work, K_NO_WAIT);
+
+	test_accept(s_sock, &new_sock, &addr, &addrlen);
+	test_work_wait(&test_data.work);
+
+	cycles = k_cycle_get_32() - start;
+
+	zassert_true(memcmp(master, no_master, sizeof(no_master)) != 0,
+		     "Master secret not exported");
+
+	test_close(c_sock);
+	c_sock = -1;
+	test_close(new_sock);
+	new_sock = -1;
+
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+
+	return cycles;
+}
+
+ZTEST(net_socket_tls, test_session_resumption)
+{
+	uint8_t master[RESUMPTION_ROUNDS + 2][MASTER_SECRET_LEN];
+	uint32_t cycles[RESUMPTION_ROUNDS];
+	struct sockaddr_in s_saddr;
+	uint64_t resumed_us = 0;
+
+	prepare_sock_tls_v4(MY_IPV4_ADDR, SERVER_PORT, &s_sock, &s_saddr,
+			    IPPROTO_TLS_1_2);
+	test_config_psk(s_sock, -1);
+	test_session_cache_enable(s_sock);
+	test_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+
+	for (int i = 0; i < RESUMPTION_ROUNDS; i++) {
+		cycles[i] = test_session_connect(&s_saddr, master[i]);
+	}
+
+	/* A resumed session keeps the master secret of the full handshake */
+	for (int i = 1; i < RESUMPTION_ROUNDS; i++) {
+		zassert_mem_equal(master[i], master[0], sizeof(master[0]),
+				  "Session %d not resumed", i);
+		resumed_us += k_cyc_to_us_floor64(cycles[i]);
+	}
+
+	TC_PRINT("Full handshake %" PRIu64 " us, resumed handshake %" PRIu64 " us\n",
+		 k_cyc_to_us_floor64(cycles[0]), resumed_us / (RESUMPTION_ROUNDS - 1));
+
+	/* Purging the server socket keeps the session stored by the client,
+	 * which the server must now refuse to resume.
+	 */
+	zassert_equal(zsock_setsockopt(s_sock, SOL_TLS, TLS_SESSION_CACHE_PURGE,
+				       &(int){ 0 }, sizeof(int)),
+		      0, "Failed to purge session cache");
+
+	(void)test_session_connect(&s_saddr, master[RESUMPTION_ROUNDS]);
+	zassert_true(memcmp(master[RESUMPTION_ROUNDS], master[0], sizeof(master[0])) != 0,
+		     "Session resumed after purge");
+
+	/* The session of the full handshake is resumed again */
+	(void)test_session_connect(&s_saddr, master[RESUMPTION_ROUNDS + 1]);
+	zassert_mem_equal(master[RESUMPTION_ROUNDS + 1], master[RESUMPTION_ROUNDS],
+			  sizeof(master[0]), "Session not resumed after purge");
+
+	test_sockets_close();
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+}
+#endif
+
 static void *tls_tests_setup(void)
 {
 	k_work_queue_init(&tls_test_work_queue);
@@ -3106,6 +3106,161 @@ ZTEST(net_socket_udp, test_40_clamp_udp_tcp_port_range)
 #endif
 }
 
+#define MMSG_COUNT 4
+
+ZTEST(net_socket_udp, test_41_v4_sendmmsg_recvmmsg)
+{
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	/* One more receive slot than datagrams sent */
+	struct mmsghdr msgs[MMSG_COUNT + 1] = { 0 };
+	struct iovec tx_iov[MMSG_COUNT];
+	struct iovec rx_iov[MMSG_COUNT + 1];
+	uint8_t tx_data[MMSG_COUNT];
+	uint8_t rx_data[MMSG_COUNT + 1][8];
+	int rv;
+
+	prepare_sock_udp_v4(MY_IPV4_ADDR, CLIENT_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v4(MY_IPV4_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	rv = zsock_bind(server_sock, (struct sockaddr *)&server_addr,
+			sizeof(server_addr));
+	zassert_equal(rv, 0, "bind failed");
+
+	rv = zsock_connect(client_sock, (struct sockaddr *)&server_addr,
+			   sizeof(server_addr));
+	zassert_equal(rv, 0, "connect failed");
+
+	for (int i = 0; i < MMSG_COUNT; i++) {
+		tx_data[i] = 'a' + i;
+		tx_iov[i].iov_base = &tx_data[i];
+		tx_iov[i].iov_len = sizeof(tx_data[i]);
+		msgs[i].msg_hdr.msg_iov = &tx_iov[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	rv = zsock_sendmmsg(client_sock, msgs, MMSG_COUNT, 0);
+	zassert_equal(rv, MMSG_COUNT, "sendmmsg failed (%d)", errno);
+
+	for (int i = 0; i < MMSG_COUNT; i++) {
+		zassert_equal(msgs[i].msg_len, sizeof(tx_data[i]), "wrong msg_len");
+	}
+
+	/* Give the packets a chance to go through the net stack */
+	k_msleep(10);
+
+	memset(msgs, 0, sizeof(msgs));
+
+	for (int i = 0; i < MMSG_COUNT + 1; i++) {
+		rx_iov[i].iov_base = rx_data[i];
+		rx_iov[i].iov_len = sizeof(rx_data[i]);
+		msgs[i].msg_hdr.msg_iov = &rx_iov[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	rv = zsock_recvmmsg(server_sock, msgs, MMSG_COUNT - 1,
+			    ZSOCK_MSG_WAITFORONE, -1);
+	zassert_equal(rv, MMSG_COUNT - 1, "recvmmsg failed (%d)", errno);
+
+	/* Only the queued datagram is returned with MSG_WAITFORONE, leaving
+	 * the last of the two slots unused.
+	 */
+	rv = zsock_recvmmsg(server_sock, &msgs[MMSG_COUNT - 1],
+			    ARRAY_SIZE(msgs) - (MMSG_COUNT - 1), ZSOCK_MSG_WAITFORONE, -1);
+	zassert_equal(rv, 1, "recvmmsg failed (%d)", errno);
+	zassert_equal(msgs[MMSG_COUNT].msg_len, 0, "unused slot written");
+
+	for (int i = 0; i < MMSG_COUNT; i++) {
+		zassert_equal(msgs[i].msg_len, 1, "wrong msg_len");
+		zassert_equal(rx_data[i][0], tx_data[i], "wrong data");
+	}
+
+	rv = zsock_recvmmsg(server_sock, msgs, MMSG_COUNT, ZSOCK_MSG_DONTWAIT, 0);
+	zassert_equal(rv, -1, "recvmmsg should've failed");
+	zassert_equal(errno, EAGAIN, "incorrect errno");
+
+	rv = zsock_close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = zsock_close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
+static K_SEM_DEFINE(zc_tx_done, 0, 2);
+
+static void zc_tx_destroy(struct net_buf *buf)
+{
+	net_buf_destroy(buf);
+	k_sem_give(&zc_tx_done);
+}
+
+NET_BUF_POOL_DEFINE(zc_tx_pool, 2, 32, 0, zc_tx_destroy);
+
+ZTEST(net_socket_udp, test_42_v4_send_recv_buf)
+{
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+	struct net_buf *buf, *frag;
+	uint8_t data[2 * STRLEN(TEST_STR_SMALL)];
+	int rv;
+
+	prepare_sock_udp_v4(MY_IPV4_ADDR, CLIENT_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v4(MY_IPV4_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	rv = zsock_bind(server_sock, (struct sockaddr *)&server_addr,
+			sizeof(server_addr));
+	zassert_equal(rv, 0, "bind failed");
+
+	rv = zsock_connect(client_sock, (struct sockaddr *)&server_addr,
+			   sizeof(server_addr));
+	zassert_equal(rv, 0, "connect failed");
+
+	buf = net_buf_alloc(&zc_tx_pool, K_NO_WAIT);
+	zassert_not_null(buf, "buf alloc failed");
+	frag = net_buf_alloc(&zc_tx_pool, K_NO_WAIT);
+	zassert_not_null(frag, "frag alloc failed");
+
+	net_buf_add_mem(buf, TEST_STR_SMALL, STRLEN(TEST_STR_SMALL));
+	net_buf_add_mem(frag, TEST_STR_SMALL, STRLEN(TEST_STR_SMALL));
+	net_buf_frag_add(buf, frag);
+
+	rv = zsock_send_buf(client_sock, buf, 0, NULL, 0);
+	zassert_equal(rv, sizeof(data), "send_buf failed (%d)", errno);
+
+	/* Both caller buffers are released once the packet has been sent */
+	zassert_ok(k_sem_take(&zc_tx_done, K_MSEC(100)), "no TX completion");
+	zassert_ok(k_sem_take(&zc_tx_done, K_MSEC(100)), "no TX completion");
+
+	buf = NULL;
+	rv = zsock_recv_buf(server_sock, &buf, 0, &addr, &addrlen);
+	zassert_equal(rv, sizeof(data), "recv_buf failed (%d)", errno);
+	zassert_not_null(buf, "no data");
+	zassert_equal(addrlen, sizeof(struct sockaddr_in), "unexpected addrlen");
+	zassert_equal(net_buf_frags_len(buf), sizeof(data), "wrong length");
+
+	net_buf_linearize(data, sizeof(data), buf, 0, sizeof(data));
+	zassert_mem_equal(data, TEST_STR_SMALL, STRLEN(TEST_STR_SMALL), "wrong data");
+	zassert_mem_equal(&data[STRLEN(TEST_STR_SMALL)], TEST_STR_SMALL,
+			  STRLEN(TEST_STR_SMALL), "wrong data");
+
+	net_buf_unref(buf);
+
+	rv = zsock_recv_buf(server_sock, &buf, ZSOCK_MSG_DONTWAIT, NULL, NULL);
+	zassert_equal(rv, -1, "recv_buf should've failed");
+	zassert_equal(errno, EAGAIN, "incorrect errno");
+	zassert_is_null(buf, "unexpected data");
+
+	rv = zsock_close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = zsock_close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
 static void after(void *arg)
 {
 	ARG_UNUSED(arg);
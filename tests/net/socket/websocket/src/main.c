@@ -13,6 +13,7 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_WEBSOCKET_LOG_LEVEL);
 #include <zephyr/net/net_ip.h>
 #include <zephyr/net/socket.h>
 #include <zephyr/net/websocket.h>
+#include <zephyr/sys/byteorder.h>
 #include <zephyr/sys/fdtable.h>
 
 #include "websocket_internal.h"
@@ -461,6 +462,150 @@ ZTEST(net_websocket, test_recv_in_small_buffer)
 			  "Invalid message, should be '%s' was '%s'", frame1_msg, recv_buf);
 }
 
+struct stream_data {
+	size_t len;
+	uint64_t remaining;
+	uint32_t msg_type;
+	int fragments;
+};
+
+static int stream_cb(int ws_sock, const uint8_t *data, size_t len,
+		     uint32_t message_type, uint64_t remaining, void *user_data)
+{
+	struct stream_data *stream = user_data;
+
+	zassert_true(stream->len + len <= sizeof(recv_buf), "Stream overflow");
+
+	if (len > 0) {
+		memcpy(&recv_buf[stream->len], data, len);
+	}
+
+	stream->len += len;
+	stream->remaining = remaining;
+	stream->msg_type = message_type;
+	stream->fragments++;
+
+	return 0;
+}
+
+static int test_recv_stream_buf(uint8_t *input_buf, size_t input_len,
+				struct websocket_context *ctx,
+				struct stream_data *stream)
+{
+	static struct test_data test_data;
+	int fd, ret;
+
+	test_data.ctx = ctx;
+	test_data.input_buf = input_buf;
+	test_data.input_len = input_len;
+	test_data.input_pos = 0;
+
+	fd = test_fd_alloc(&test_data);
+
+	ret = websocket_recv_stream(fd, stream_cb, stream, 0);
+
+	zvfs_free_fd(fd);
+
+	return ret;
+}
+
+ZTEST(net_websocket, test_recv_stream)
+{
+	struct websocket_context ctx;
+	struct stream_data stream = { 0 };
+	int ret;
+
+	memset(&ctx, 0, sizeof(ctx));
+
+	ctx.recv_buf.buf = temp_recv_buf;
+	ctx.recv_buf.size = sizeof(temp_recv_buf);
+
+	memcpy(feed_buf, &frame1, sizeof(frame1));
+
+	/* The payload is handed over as each byte arrives */
+	for (int i = 0; i < sizeof(frame1); i++) {
+		ret = test_recv_stream_buf(&feed_buf[i], 1, &ctx, &stream);
+		if (i < FRAME1_HDR_SIZE) {
+			zassert_equal(ret, -EAGAIN, "[%d] Header parse failed (ret %d)", i, ret);
+		} else {
+			zassert_equal(ret, 1, "[%d] Payload not handed over (ret %d)", i, ret);
+		}
+	}
+
+	zassert_equal(stream.len, sizeof(frame1_msg) - 1, "Invalid amount of data read");
+	zassert_equal(stream.fragments, sizeof(frame1_msg) - 1, "Invalid number of fragments");
+	zassert_mem_equal(recv_buf, frame1_msg, sizeof(frame1_msg) - 1,
+			  "Invalid message, should be '%s' was '%s'", frame1_msg, recv_buf);
+	zassert_equal(stream.remaining, 0, "Msg not empty");
+	zassert_equal(stream.msg_type & WEBSOCKET_FLAG_TEXT, WEBSOCKET_FLAG_TEXT,
+		      "Msg is not text");
+}
+
+ZTEST(net_websocket, test_recv_stream_empty_ping)
+{
+	struct websocket_context ctx;
+	struct stream_data stream = { 0 };
+	int ret;
+
+	memset(&ctx, 0, sizeof(ctx));
+
+	ctx.recv_buf.buf = temp_recv_buf;
+	ctx.recv_buf.size = sizeof(temp_recv_buf);
+
+	memcpy(feed_buf, &ping, sizeof(ping));
+
+	ret = test_recv_stream_buf(feed_buf, sizeof(ping), &ctx, &stream);
+
+	zassert_equal(ret, 0, "Msg not empty (ret %d)", ret);
+	zassert_equal(stream.fragments, 1, "Empty frame not handed over");
+	zassert_equal(stream.msg_type & WEBSOCKET_FLAG_PING, WEBSOCKET_FLAG_PING,
+		      "Msg is not ping");
+}
+
+/* A masked frame larger than the receive buffer, fed in chunks that are not
+ * aligned with the masking key nor with machine words.
+ */
+ZTEST(net_websocket, test_recv_stream_large_masked)
+{
+	static uint8_t frame[MAX_HEADER_LEN + sizeof(lorem_ipsum)];
+	static const uint8_t key[] = { 0xe1, 0x7e, 0x8e, 0xb9 };
+	const size_t msg_len = sizeof(lorem_ipsum) - 1;
+	const size_t chunk = 37;
+	struct websocket_context ctx;
+	struct stream_data stream = { 0 };
+	size_t frame_len = 0, pos;
+	int ret;
+
+	frame[frame_len++] = 0x82;
+	frame[frame_len++] = 0x80 | 126;
+	sys_put_be16(msg_len, &frame[frame_len]);
+	frame_len += 2;
+	memcpy(&frame[frame_len], key, sizeof(key));
+	frame_len += sizeof(key);
+
+	for (size_t i = 0; i < msg_len; i++) {
+		frame[frame_len++] = lorem_ipsum[i] ^ key[i % sizeof(key)];
+	}
+
+	memset(&ctx, 0, sizeof(ctx));
+
+	ctx.recv_buf.buf = temp_recv_buf;
+	ctx.recv_buf.size = 64;
+
+	for (pos = 0; pos < frame_len; pos += chunk) {
+		ret = test_recv_stream_buf(&frame[pos], MIN(chunk, frame_len - pos), &ctx,
+					   &stream);
+		zassert_true(ret >= 0, "[%zd] Cannot read data (%d)", pos, ret);
+	}
+
+	zassert_equal(stream.len, msg_len, "Received %zd bytes instead of %zd",
+		      stream.len, msg_len);
+	zassert_mem_equal(recv_buf, lorem_ipsum, msg_len, "Invalid message");
+	zassert_equal(stream.remaining, 0, "Msg not empty");
+	zassert_equal(stream.msg_type, WEBSOCKET_FLAG_BINARY | WEBSOCKET_FLAG_FINAL,
+		      "Msg is not a final binary frame");
+}
+
 static void *setup(void)
 {
 	k_thread_system_pool_assign(k_current_get());